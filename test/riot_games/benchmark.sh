@@ -0,0 +1,54 @@
+#!/bin/bash
+
+../umison -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -O2 -I../../rapidjson/include -o benchmark_numbers benchmark_numbers.cpp
+
+./benchmark_numbers
+
+g++ -O2 -I../../rapidjson/include -o benchmark_escaping benchmark_escaping.cpp
+
+./benchmark_escaping
+
+g++ -O2 -I../../rapidjson/include -o benchmark_iov benchmark_iov.cpp riot_games.cpp
+
+./benchmark_iov
+
+g++ -O2 -I../../rapidjson/include -o benchmark_read_rapidjson benchmark_read.cpp riot_games.cpp
+
+../umison --engine rapidjson-sax -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -O2 -I../../rapidjson/include -o benchmark_read_sax benchmark_read.cpp riot_games.cpp
+
+../umison --engine native -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -O2 -c -o riot_games_native.o riot_games.cpp
+
+g++ -O2 -o benchmark_read_native benchmark_read.cpp riot_games_native.o
+
+../umison --engine native-table -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -O2 -c -o riot_games_native_table.o riot_games.cpp
+
+g++ -O2 -o benchmark_read_native_table benchmark_read.cpp riot_games_native_table.o
+
+../umison --engine native-simd -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -O2 -o benchmark_read_native_simd benchmark_read.cpp riot_games.cpp
+
+g++ -O2 -o benchmark_index benchmark_index.cpp
+
+./benchmark_read_rapidjson rapidjson
+
+./benchmark_read_sax rapidjson-sax
+
+./benchmark_read_native native
+
+./benchmark_read_native_simd native-simd
+
+./benchmark_read_native_table native-table
+
+# code generated by the unrolled and the table driven engines
+size riot_games_native.o riot_games_native_table.o
+
+./benchmark_index
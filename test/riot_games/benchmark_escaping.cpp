@@ -0,0 +1,138 @@
+// Compares the string escaping of the generated writers with an escaping done byte by
+// byte, on the strings of the test_*.json files. The generated .cpp is included to
+// reach its internal functions.
+#include "riot_games.cpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  // contents of the strings of a json, escapes are kept as they are
+  void collect_strings(const std::string &file, std::vector<std::string> &strings) {
+    std::ifstream fi(file);
+    std::stringstream buffer;
+    buffer << fi.rdbuf();
+    std::string text(buffer.str());
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      if (text[i] != '"') {
+        continue;
+      }
+      std::size_t end = i + 1;
+      while (end < text.size() && text[end] != '"') {
+        end += text[end] == '\\' ? 2 : 1;
+      }
+      strings.push_back(text.substr(i + 1, end - i - 1));
+      i = end;
+    }
+  }
+
+  void escape_byte_by_byte(const std::string &value, std::string &output) {
+    static const char hex[] = "0123456789abcdef";
+    output += '"';
+    for (char ch : value) {
+      unsigned char c = static_cast<unsigned char>(ch);
+      switch (c) {
+        case '"': output += "\\\""; break;
+        case '\\': output += "\\\\"; break;
+        case '\b': output += "\\b"; break;
+        case '\f': output += "\\f"; break;
+        case '\n': output += "\\n"; break;
+        case '\r': output += "\\r"; break;
+        case '\t': output += "\\t"; break;
+        default:
+          if (c < 0x20) {
+            output += "\\u00";
+            output += hex[c >> 4];
+            output += hex[c & 0xf];
+          } else {
+            output += ch;
+          }
+          break;
+      }
+    }
+    output += '"';
+  }
+
+  template<typename Function>
+  void run(const char *name, const std::vector<std::string> &strings, std::size_t bytes, Function function) {
+    std::size_t check = 0;
+    const int rounds = 200;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+      check += function(strings);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("%-34s %9.1f MB/s (%zu)\n", name, rounds * bytes / elapsed.count() / (1024 * 1024), check % 10);
+  }
+
+  void run_all(const char *title, const std::vector<std::string> &strings) {
+    std::size_t bytes = 0;
+    for (const std::string &value : strings) {
+      bytes += value.size();
+    }
+    printf("%s: %zu strings, %zu bytes\n", title, strings.size(), bytes);
+    std::string output;
+    run("escape byte by byte", strings, bytes, [&output](const std::vector<std::string> &values) {
+      output.clear();
+      for (const std::string &value : values) {
+        escape_byte_by_byte(value, output);
+      }
+      return output.size();
+    });
+    run("umison_writer::string", strings, bytes, [&output](const std::vector<std::string> &values) {
+      output.clear();
+      __internal__umison::umison_writer out(__internal__umison::umison_string_output, &output);
+      for (const std::string &value : values) {
+        out.string(value.data(), value.size());
+      }
+      out.flush();
+      return output.size();
+    });
+    run("scan umison_clean_run_scalar", strings, bytes, [](const std::vector<std::string> &values) {
+      std::size_t clean = 0;
+      for (const std::string &value : values) {
+        clean += __internal__umison::umison_clean_run_scalar(value.data(), value.size());
+      }
+      return clean;
+    });
+    run("scan umison_clean_run", strings, bytes, [](const std::vector<std::string> &values) {
+      std::size_t clean = 0;
+      for (const std::string &value : values) {
+        clean += __internal__umison::umison_clean_run(value.data(), value.size());
+      }
+      return clean;
+    });
+  }
+}
+
+int main(int argc, char** argv) {
+  const char *files[] = {"test_champion.json", "test_featured_games.json", "test_get_leagues_by_symmoner_ids.json",
+                         "test_get_spectator_game_info.json", "test_recent_game_by_summoner_ids.json"};
+  std::vector<std::string> strings;
+  for (const char *file : files) {
+    collect_strings(file, strings);
+  }
+  run_all("strings of the test files", strings);
+  // the same text in strings of 4KB, like long descriptions
+  std::vector<std::string> long_strings(1);
+  for (const std::string &value : strings) {
+    if (long_strings.back().size() >= 4096) {
+      long_strings.emplace_back();
+    }
+    long_strings.back() += value;
+    long_strings.back() += ' ';
+  }
+  run_all("strings of 4KB", long_strings);
+#if defined(__AVX2__)
+  printf("umison_clean_run uses AVX2\n");
+#elif defined(__SSE2__)
+  printf("umison_clean_run uses SSE2\n");
+#else
+  printf("umison_clean_run uses the scalar scan\n");
+#endif
+  return 0;
+}
@@ -0,0 +1,90 @@
+// Times the first stage of the native-simd engine, the index of the structural chars, with
+// each classifier the CPU has, and the whole read with the index. The generated .cpp is
+// included to reach its internal functions.
+#include "riot_games.cpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  std::string read_file(const char *file) {
+    std::ifstream fi(file);
+    std::stringstream buffer;
+    buffer << fi.rdbuf();
+    return buffer.str();
+  }
+
+  template<typename Function>
+  double gigabytes_per_second(std::size_t bytes, Function function) {
+    int rounds = static_cast<int>(200000000 / (bytes + 1)) + 1;
+    int check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+      check += function();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (check != rounds) {
+      printf("failed\n");
+    }
+    return bytes * static_cast<double>(rounds) / elapsed.count() / 1e9;
+  }
+
+  void index_text(const char *title, const std::string &text) {
+    std::vector<uint32_t> index;
+    std::ostringstream errors;
+    printf("%s: %zu bytes\n", title, text.size());
+    struct {
+      const char *name;
+      __internal__umison::native_classify classify;
+    } classifiers[] = {
+      {"index, scalar", __internal__umison::native_classify_scalar},
+#if defined(UMISON_INDEX_X86)
+      {"index, SSE2", __internal__umison::native_classify_sse2},
+      {__builtin_cpu_supports("avx2") ? "index, AVX2" : nullptr, __internal__umison::native_classify_avx2},
+#endif
+    };
+    for (auto &classifier : classifiers) {
+      if (classifier.name == nullptr) {
+        continue;
+      }
+      double speed = gigabytes_per_second(text.size(), [&]() {
+        return __internal__umison::native_build_index(text.c_str(), text.size(), index, errors,
+                                                      classifier.classify) ? 1 : 0;
+      });
+      printf("  %-36s %8.2f GB/s\n", classifier.name, speed);
+    }
+    printf("  %-36s %8zu\n", "tokens", index.size() - 1);
+  }
+
+  template<typename T>
+  void read_text(const char *file) {
+    std::string text(read_file(file));
+    index_text(file, text);
+    umison::parser_context context;
+    double speed = gigabytes_per_second(text.size(), [&]() {
+      T json;
+      return json.read_data(context, text) ? 1 : 0;
+    });
+    printf("  %-36s %8.2f GB/s\n", "read_data with a parser_context", speed);
+  }
+}
+
+int main(int argc, char** argv) {
+  read_text<umison::champion>("test_champion.json");
+  read_text<umison::featuredGames>("test_featured_games.json");
+  read_text<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json");
+  read_text<umison::getSpectatorGameInfo>("test_get_spectator_game_info.json");
+  read_text<umison::recent_game_by_summoner_id>("test_recent_game_by_summoner_ids.json");
+  // a dump of several MB, the leagues of the test in one array
+  std::string leagues(read_file("test_get_leagues_by_symmoner_ids.json"));
+  std::string dump("[");
+  for (int i = 0; i < 16; ++i) {
+    dump += (i > 0 ? "," : "") + leagues;
+  }
+  dump += "]";
+  index_text("16 copies of test_get_leagues_by_symmoner_ids.json", dump);
+  return 0;
+}
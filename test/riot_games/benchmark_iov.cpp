@@ -0,0 +1,117 @@
+// Compares write_data_to_string with serialize_iov on the test_*.json files, building
+// the output and then handing it to /dev/null with write or writev.
+#include "riot_games.h"
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+  std::string read_file(const char *file) {
+    std::ifstream fi(file);
+    std::stringstream buffer;
+    buffer << fi.rdbuf();
+    return buffer.str();
+  }
+
+  template<typename Function>
+  double run(Function function) {
+    const int rounds = 200;
+    std::size_t check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+      check += function();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    if (check == 0) {
+      printf("nothing written\n");
+    }
+    return elapsed.count() / rounds;
+  }
+
+  // writev takes at most IOV_MAX pieces at a time
+  std::size_t write_pieces(int fd, const std::vector<iovec> &iov) {
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < iov.size(); i += IOV_MAX) {
+      int count = static_cast<int>(iov.size() - i < IOV_MAX ? iov.size() - i : IOV_MAX);
+      ssize_t result = writev(fd, iov.data() + i, count);
+      if (result > 0) {
+        written += static_cast<std::size_t>(result);
+      }
+    }
+    return written;
+  }
+
+  template<typename T>
+  void compare(const char *title, const T &json, int fd) {
+    std::string output;
+    std::vector<iovec> iov;
+    umison::serialize_scratch scratch;
+    double string_time = run([&]() {
+      output.clear();
+      json.write_data_to_string(output);
+      return output.size();
+    });
+    double iov_time = run([&]() {
+      iov.clear();
+      scratch.clear();
+      json.serialize_iov(iov, scratch);
+      return iov.size();
+    });
+    double string_write_time = run([&]() {
+      output.clear();
+      json.write_data_to_string(output);
+      return static_cast<std::size_t>(write(fd, output.data(), output.size()));
+    });
+    double iov_write_time = run([&]() {
+      iov.clear();
+      scratch.clear();
+      json.serialize_iov(iov, scratch);
+      return write_pieces(fd, iov);
+    });
+    std::size_t pieces_bytes = 0;
+    for (const iovec &piece : iov) {
+      pieces_bytes += piece.iov_len;
+    }
+    printf("%s: %zu bytes, %zu pieces\n", title, output.size(), iov.size());
+    printf("  %-36s %9.2f us\n", "write_data_to_string", string_time);
+    printf("  %-36s %9.2f us\n", "serialize_iov", iov_time);
+    printf("  %-36s %9.2f us\n", "write_data_to_string + write", string_write_time);
+    printf("  %-36s %9.2f us\n", "serialize_iov + writev", iov_write_time);
+    printf("  %-36s %s\n", "same text", pieces_bytes == output.size() ? "yes" : "NO");
+  }
+
+  template<typename T>
+  void compare_file(const char *file, int fd) {
+    T json;
+    if (!json.read_data(read_file(file))) {
+      printf("%s can't be read\n", file);
+      return;
+    }
+    compare(file, json, fd);
+  }
+}
+
+int main(int argc, char** argv) {
+  int fd = open("/dev/null", O_WRONLY);
+  compare_file<umison::champion>("test_champion.json", fd);
+  compare_file<umison::featuredGames>("test_featured_games.json", fd);
+  compare_file<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json", fd);
+  compare_file<umison::getSpectatorGameInfo>("test_get_spectator_game_info.json", fd);
+  compare_file<umison::recent_game_by_summoner_id>("test_recent_game_by_summoner_ids.json", fd);
+  // long strings, like the descriptions of a catalog, are referenced instead of copied
+  umison::getSpectatorGameInfo spect;
+  std::string long_key(256 * 1024, 'k');
+  if (spect.read_data(read_file("test_get_spectator_game_info.json"))) {
+    spect.mutable_observers().set_encryptionKey(long_key);
+    compare("spectator game with a 256KB string", spect, fd);
+  }
+  close(fd);
+  return 0;
+}
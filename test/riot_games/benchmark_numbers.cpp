@@ -0,0 +1,81 @@
+// Compares the number formatting of the generated writers with the snprintf calls they
+// used before. The generated .cpp is included to reach its internal functions.
+#include "riot_games.cpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  template<typename Values, typename Format>
+  void run(const char *name, const Values &values, Format format) {
+    char buffer[64];
+    std::size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 5; ++round) {
+      for (auto value : values) {
+        bytes += static_cast<std::size_t>(format(value, buffer) - buffer);
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double count = 5.0 * values.size();
+    printf("%-28s %8.1f ns/number %9.1f MB/s\n", name, elapsed.count() * 1e9 / count,
+           bytes / elapsed.count() / (1024 * 1024));
+  }
+}
+
+int main(int argc, char** argv) {
+  std::mt19937_64 rng(2015);
+  std::vector<long long int> integers;
+  std::vector<double> doubles;
+  // ids, timestamps and small counters like the ones of the riot_games jsons
+  for (int i = 0; i < 1000000; ++i) {
+    switch (i % 4) {
+      case 0: integers.push_back(static_cast<long long int>(rng() % 100)); break;
+      case 1: integers.push_back(static_cast<long long int>(rng() % 100000000)); break;
+      case 2: integers.push_back(1420000000000LL + static_cast<long long int>(rng() % 100000000000LL)); break;
+      default: integers.push_back(-static_cast<long long int>(rng() % 1000000)); break;
+    }
+  }
+  // scores with two decimals, coordinates and random doubles
+  std::uniform_real_distribution<double> coordinates(-180.0, 180.0);
+  for (int i = 0; i < 1000000; ++i) {
+    switch (i % 3) {
+      case 0: doubles.push_back(static_cast<double>(rng() % 10000) / 100.0); break;
+      case 1: doubles.push_back(coordinates(rng)); break;
+      default: doubles.push_back(std::ldexp(static_cast<double>(rng() >> 11), static_cast<int>(rng() % 200) - 100)); break;
+    }
+  }
+
+  run("integer snprintf %lld", integers, [](long long int value, char *buffer) {
+    return buffer + snprintf(buffer, 64, "%lld", value);
+  });
+  run("integer umison_i64toa", integers, [](long long int value, char *buffer) {
+    return __internal__umison::umison_i64toa(value, buffer);
+  });
+  run("double snprintf %f", doubles, [](double value, char *buffer) {
+    return buffer + snprintf(buffer, 64, "%f", value);
+  });
+  run("double snprintf %.17g", doubles, [](double value, char *buffer) {
+    return buffer + snprintf(buffer, 64, "%.17g", value);
+  });
+  run("double umison_dtoa", doubles, [](double value, char *buffer) {
+    return __internal__umison::umison_dtoa(value, buffer);
+  });
+
+  // the shortest digits must read back to the same double
+  std::size_t lost = 0;
+  for (double value : doubles) {
+    char buffer[64];
+    *__internal__umison::umison_dtoa(value, buffer) = '\0';
+    if (strtod(buffer, nullptr) != value) {
+      ++lost;
+    }
+  }
+  printf("doubles not read back: %zu\n", lost);
+  return lost == 0 ? 0 : 1;
+}
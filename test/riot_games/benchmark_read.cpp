@@ -0,0 +1,243 @@
+// Times read_data on the test_*.json files, benchmark.sh builds it once per engine so the
+// engines can be compared on the same texts.
+#include "riot_games.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+  std::string read_file(const char *file) {
+    std::ifstream fi(file);
+    std::stringstream buffer;
+    buffer << fi.rdbuf();
+    return buffer.str();
+  }
+
+  template<typename Function>
+  double run(Function function) {
+    const int rounds = 500;
+    int check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+      check += function();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    if (check != rounds) {
+      printf("read failed\n");
+    }
+    return elapsed.count() / rounds;
+  }
+
+  template<typename T>
+  void compare_file(const char *file) {
+    std::string text(read_file(file));
+    std::ostringstream errors;
+    umison::parser_context context;
+    double read_time = run([&]() {
+      T json;
+      return json.read_data(text, errors) ? 1 : 0;
+    });
+    double context_time = run([&]() {
+      T json;
+      return json.read_data(context, text) ? 1 : 0;
+    });
+    double validate_time = run([&]() {
+      return T::validate(text.c_str(), text.size(), errors) ? 1 : 0;
+    });
+    printf("%s: %zu bytes\n", file, text.size());
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data", read_time, text.size() / read_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data with a parser_context", context_time,
+           text.size() / context_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "validate", validate_time, text.size() / validate_time);
+  }
+
+  // read_data_analytics only reads the members of the projection analytics of the schema
+  void compare_projection(const char *file) {
+    std::string text(read_file(file));
+    std::ostringstream errors;
+    double read_time = run([&]() {
+      umison::getSpectatorGameInfo json;
+      return json.read_data(text, errors) ? 1 : 0;
+    });
+    double projection_time = run([&]() {
+      umison::getSpectatorGameInfo json;
+      return json.read_data_analytics(text, errors) ? 1 : 0;
+    });
+    printf("%s: %zu bytes\n", file, text.size());
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data", read_time, text.size() / read_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data_analytics", projection_time,
+           text.size() / projection_time);
+  }
+
+  // read_data_prefix stops once the members it waits for have been read, the text has them
+  // first and then a long member unknown to the schema, eight copies of the game
+  void compare_prefix(const char *file) {
+    std::string game(read_file(file));
+    std::string text(game.substr(0, game.find_last_of('}')));
+    text += ",\"replays\":[";
+    for (int i = 0; i < 8; ++i) {
+      text += (i > 0 ? "," : "") + game;
+    }
+    text += "]}";
+    std::ostringstream errors;
+    bool validated = false;
+    double read_time = run([&]() {
+      umison::getSpectatorGameInfo json;
+      return json.read_data(text, errors) ? 1 : 0;
+    });
+    double prefix_time = run([&]() {
+      umison::getSpectatorGameInfo json;
+      return json.read_data_prefix(text, validated, errors) > 0 ? 1 : 0;
+    });
+    double projection_time = run([&]() {
+      umison::getSpectatorGameInfo json;
+      return json.read_data_analytics_prefix(text, validated, errors) > 0 ? 1 : 0;
+    });
+    printf("%s with 8 replays after the members: %zu bytes\n", file, text.size());
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data", read_time, text.size() / read_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data_prefix", prefix_time, text.size() / prefix_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data_analytics_prefix", projection_time,
+           text.size() / projection_time);
+  }
+
+  // One list with the entries of all the leagues of the file
+  std::string all_entries(const char *file) {
+    std::string leagues(read_file(file));
+    std::string text("{\"entries\":[");
+    bool first = true;
+    for (std::size_t at = leagues.find("\"entries\""); at != std::string::npos; at = leagues.find("\"entries\"", at)) {
+      std::size_t start = leagues.find('[', at) + 1;
+      std::size_t end = start;
+      for (int depth = 1; depth > 0; ++end) {
+        if (leagues[end] == '"') {
+          end = leagues.find('"', end + 1);
+        } else if (leagues[end] == '[') {
+          ++depth;
+        } else if (leagues[end] == ']') {
+          --depth;
+        }
+      }
+      if (leagues.find_first_not_of(" \n\r\t", start) != end - 1) {
+        text += (first ? "" : ",") + leagues.substr(start, end - 1 - start);
+        first = false;
+      }
+      at = end;
+    }
+    text += "]}";
+    return text;
+  }
+
+  // top_league_entries drops the entries under 700 points while they are read, league_entries
+  // reads all of them and they are dropped afterwards. The entries are the ones of all the
+  // leagues of the file
+  void compare_filter(const char *file) {
+    std::string text(all_entries(file));
+    std::ostringstream errors;
+    std::size_t kept = 0;
+    double read_time = run([&]() {
+      umison::league_entries json;
+      if (!json.read_data(text, errors)) {
+        return 0;
+      }
+      std::vector<__internal__umison::league_entry_dto> &entries = json.mutable_entries();
+      entries.erase(std::remove_if(entries.begin(), entries.end(), [](const __internal__umison::league_entry_dto &entry) {
+        return entry.get_leaguePoints() < 700;
+      }), entries.end());
+      kept = entries.size();
+      return 1;
+    });
+    double filter_time = run([&]() {
+      umison::top_league_entries json;
+      return json.read_data(text, errors) && json.get_entries().size() == kept ? 1 : 0;
+    });
+    printf("entries of %s, %zu kept: %zu bytes\n", file, kept, text.size());
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data and remove_if", read_time, text.size() / read_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data with a filter", filter_time, text.size() / filter_time);
+  }
+
+  // indexed_league_entries indexes the entries by playerOrTeamId while they are read, the
+  // entries of league_entries are put in an unordered_map afterwards. Every entry is looked up
+  void compare_index(const char *file) {
+    std::string text(all_entries(file));
+    std::ostringstream errors;
+    std::size_t found = 0;
+    double map_time = run([&]() {
+      umison::league_entries json;
+      if (!json.read_data(text, errors)) {
+        return 0;
+      }
+      std::unordered_map<std::string, const __internal__umison::league_entry_dto *> players;
+      for (auto &entry : json.get_entries()) {
+        players.emplace(std::string(entry.get_playerOrTeamId()), &entry);
+      }
+      found = 0;
+      for (auto &entry : json.get_entries()) {
+        found += players.find(std::string(entry.get_playerOrTeamId())) != players.end() ? 1 : 0;
+      }
+      return 1;
+    });
+    double index_time = run([&]() {
+      umison::indexed_league_entries json;
+      if (!json.read_data(text, errors)) {
+        return 0;
+      }
+      std::size_t indexed = 0;
+      for (auto &entry : json.get_entries()) {
+        indexed += json.find_entries_by_playerOrTeamId(entry.get_playerOrTeamId()) != nullptr ? 1 : 0;
+      }
+      return indexed == found ? 1 : 0;
+    });
+    printf("entries of %s, %zu looked up: %zu bytes\n", file, found, text.size());
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data and unordered_map", map_time, text.size() / map_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data with an index", index_time, text.size() / index_time);
+  }
+
+  // streamed_league_entries hands the entries one at a time to a callback, league_entries
+  // stores all of them and they are walked afterwards. Both sum the points of the entries
+  void compare_streaming(const char *file) {
+    std::string text("{\"name\":\"all\"," + all_entries(file).substr(1));
+    std::ostringstream errors;
+    long long int points = 0;
+    double read_time = run([&]() {
+      umison::league_entries json;
+      if (!json.read_data(text, errors)) {
+        return 0;
+      }
+      points = 0;
+      for (auto &entry : json.get_entries()) {
+        points += entry.get_leaguePoints();
+      }
+      return 1;
+    });
+    double streaming_time = run([&]() {
+      umison::streamed_league_entries json;
+      long long int streamed = 0;
+      auto on_entry = [&streamed](const __internal__umison::league_entry_dto &entry) {
+        streamed += entry.get_leaguePoints();
+      };
+      return json.read_data_streaming(text, on_entry, on_entry, errors) && streamed == points ? 1 : 0;
+    });
+    printf("entries of %s, %lld points: %zu bytes\n", file, points, text.size());
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data and a loop", read_time, text.size() / read_time);
+    printf("  %-36s %9.2f us %9.1f MB/s\n", "read_data_streaming", streaming_time, text.size() / streaming_time);
+  }
+}
+
+int main(int argc, char** argv) {
+  printf("engine: %s\n", argc > 1 ? argv[1] : "unknown");
+  compare_file<umison::champion>("test_champion.json");
+  compare_file<umison::featuredGames>("test_featured_games.json");
+  compare_file<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json");
+  compare_file<umison::getSpectatorGameInfo>("test_get_spectator_game_info.json");
+  compare_file<umison::recent_game_by_summoner_id>("test_recent_game_by_summoner_ids.json");
+  compare_projection("test_get_spectator_game_info.json");
+  compare_prefix("test_get_spectator_game_info.json");
+  compare_filter("test_get_leagues_by_symmoner_ids.json");
+  compare_index("test_get_leagues_by_symmoner_ids.json");
+  compare_streaming("test_get_leagues_by_symmoner_ids.json");
+  return 0;
+}
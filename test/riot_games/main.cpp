@@ -1,6 +1,46 @@
 #include "riot_games.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+// reads file, writes it, reads the output and writes it again, both outputs must match
+template<typename T>
+bool round_trip(const char *file, std::string &output) {
+  std::string input_text;
+  std::ifstream fi(file);
+  char buf[1024];
+  while(fi.getline(buf,1024)){
+    input_text += buf;
+  }
+  T first;
+  T second;
+  std::string second_output;
+  output.clear();
+  return !input_text.empty() && first.read_data(input_text) && first.write_data_to_string(output) &&
+         second.read_data(output) && second.write_data_to_string(second_output) && output == second_output;
+}
+
+// validate accepts file, as read_data does, and doesn't modify it
+template<typename T>
+bool validates(const char *file) {
+  std::string input_text;
+  std::ifstream fi(file);
+  char buf[1024];
+  while(fi.getline(buf,1024)){
+    input_text += buf;
+  }
+  std::string copy(input_text);
+  std::stringstream errors;
+  T json;
+  return !input_text.empty() && T::validate(input_text.c_str(), input_text.size(), errors) &&
+         errors.str().empty() && input_text == copy && json.read_data(input_text);
+}
 
 int main(int argc, char** argv) {
   // TEST 1
@@ -103,4 +143,838 @@ int main(int argc, char** argv) {
       std::cout << "Failed\n";
     }
   }
+  // TEST 6
+  {
+    std::cout << "[TEST 6] ";
+    std::string input_text;
+    std::ifstream fi("test_champion.json");
+    if(fi) {
+      char buf[1024];
+      while(fi.getline(buf,1024)){
+        input_text += buf;
+      }
+      std::vector<char> buffer(input_text.begin(), input_text.end());
+      buffer.push_back('\0');
+      umison::champion champ;
+      if(!champ.read_data_insitu(&buffer[0], input_text.size())) {
+        std::cout << "Failed\n";
+      } else {
+        std::cout << "Passed\n";
+      }
+    } else {
+      std::cout << "Failed\n";
+    }
+  }
+  // TEST 7
+  {
+    std::cout << "[TEST 7] ";
+    const char *files[] = {"test_champion.json", "test_get_leagues_by_symmoner_ids.json", "test_champion.json"};
+    umison::parser_context context;
+    bool passed = true;
+    for (const char *file : files) {
+      std::string input_text;
+      std::ifstream fi(file);
+      char buf[1024];
+      while(fi.getline(buf,1024)){
+        input_text += buf;
+      }
+      umison::champion champ;
+      umison::get_leagues_by_summoner_ids leagues;
+      if (std::string(file) == "test_champion.json") {
+        passed = passed && !input_text.empty() && champ.read_data(context, input_text);
+      } else {
+        passed = passed && !input_text.empty() && leagues.read_data(context, input_text);
+      }
+    }
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 8
+  {
+    static_assert(std::is_nothrow_move_constructible<umison::champion>::value, "champion must move without throwing");
+    static_assert(std::is_nothrow_move_constructible<__internal__umison::ChampionDto>::value,
+                  "ChampionDto must move without throwing");
+    std::cout << "[TEST 8] ";
+    std::string input_text;
+    std::ifstream fi("test_champion.json");
+    char buf[1024];
+    while(fi.getline(buf,1024)){
+      input_text += buf;
+    }
+    umison::champion champ;
+    bool passed = !input_text.empty() && champ.read_data(input_text);
+    std::size_t count = champ.get_champions().size();
+    umison::champion moved(std::move(champ));
+    passed = passed && count > 0 && moved.get_champions().size() == count;
+    moved.emplace_champions().set_id(42);
+    std::vector<__internal__umison::ChampionDto> champions(moved.get_champions());
+    champ.set_champions(std::move(champions));
+    passed = passed && champ.get_champions().size() == count + 1 && champ.get_champions().back().get_id() == 42;
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 9
+  {
+    std::cout << "[TEST 9] ";
+    std::string output;
+    bool passed = round_trip<umison::champion>("test_champion.json", output);
+    passed = passed && round_trip<umison::featuredGames>("test_featured_games.json", output);
+    passed = passed && round_trip<umison::recent_game_by_summoner_id>("test_recent_game_by_summoner_ids.json", output);
+    passed = passed && round_trip<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json", output);
+    passed = passed && round_trip<umison::getSpectatorGameInfo>("test_get_spectator_game_info.json", output);
+    umison::getSpectatorGameInfo spect;
+    std::string escaped;
+    passed = passed && spect.read_data(output);
+    spect.mutable_observers().set_encryptionKey("quote\" backslash\\ line\n tab\t \x01");
+    passed = passed && spect.write_data_to_string(escaped) &&
+             escaped.find("\"quote\\\" backslash\\\\ line\\n tab\\t \\u0001\"") != std::string::npos;
+    umison::getSpectatorGameInfo back;
+    passed = passed && back.read_data(escaped) &&
+             back.get_observers().get_encryptionKey() == spect.get_observers().get_encryptionKey();
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 10
+  {
+    std::cout << "[TEST 10] ";
+    std::string output;
+    umison::get_leagues_by_summoner_ids leagues;
+    bool passed = round_trip<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json", output) &&
+                  leagues.read_data(output) && leagues.serialized_size() == output.size();
+    std::vector<char> buffer(output.size());
+    passed = passed && leagues.write_to(buffer.data(), buffer.size()) == output.size() &&
+             std::string(buffer.data(), buffer.size()) == output;
+    std::stringstream errors;
+    passed = passed && leagues.write_to(buffer.data(), buffer.size() - 1, errors) == 0 && !errors.str().empty();
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 11
+  {
+    std::cout << "[TEST 11] ";
+    std::string output;
+    umison::get_leagues_by_summoner_ids leagues;
+    bool passed = round_trip<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json", output) &&
+                  leagues.read_data(output);
+    std::stringstream stream_output;
+    passed = passed && leagues.write_data_to_stream(stream_output) && stream_output.str() == output;
+    std::string callback_output;
+    std::size_t largest_block = 0;
+    passed = passed && leagues.write_data_to_callback([&](const char *data, std::size_t len) {
+      largest_block = std::max(largest_block, len);
+      callback_output.append(data, len);
+      return true;
+    }) && callback_output == output && largest_block <= 4096;
+    FILE *file = tmpfile();
+    passed = passed && file != nullptr && leagues.write_data_to_file(file) && fflush(file) == 0 &&
+             leagues.write_data_to_fd(fileno(file));
+    if (file != nullptr) {
+      std::string file_output(output.size() * 2 + 1, '\0');
+      rewind(file);
+      passed = passed && fread(&file_output[0], 1, file_output.size(), file) == output.size() * 2 &&
+               file_output.compare(0, output.size(), output) == 0 &&
+               file_output.compare(output.size(), output.size(), output) == 0;
+      fclose(file);
+    }
+    std::stringstream errors;
+    passed = passed && !leagues.write_data_to_callback([](const char *, std::size_t) { return false; }, errors) &&
+             !errors.str().empty();
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 12
+  {
+    std::cout << "[TEST 12] ";
+    std::string output;
+    umison::getSpectatorGameInfo spect;
+    bool passed = round_trip<umison::getSpectatorGameInfo>("test_get_spectator_game_info.json", output) &&
+                  spect.read_data(output);
+    std::string long_key(std::string(100, 'k') + "\n" + std::string(100, 'e'));
+    spect.mutable_observers().set_encryptionKey(long_key);
+    output.clear();
+    std::vector<iovec> iov;
+    umison::serialize_scratch scratch(256);
+    passed = passed && spect.write_data_to_string(output) && spect.serialize_iov(iov, scratch);
+    std::string joined;
+    std::size_t referenced = 0;
+    const char *key = spect.get_observers().get_encryptionKey().data();
+    for (const iovec &piece : iov) {
+      joined.append(static_cast<const char *>(piece.iov_base), piece.iov_len);
+      if (piece.iov_base == key || piece.iov_base == key + 101) {
+        ++referenced;
+      }
+    }
+    passed = passed && joined == output && referenced == 2;
+    // the scratch is reused after clear
+    std::size_t capacity = scratch.capacity();
+    iov.clear();
+    scratch.clear();
+    passed = passed && spect.serialize_iov(iov, scratch) && scratch.capacity() == capacity;
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 13
+  {
+    std::cout << "[TEST 13] ";
+    // unknown members are skipped whatever they hold
+    std::string text("{\"unknown\":{\"a\":[1,{\"b\":\"\\\"}\"}],\"c\":null},\"champions\":[{\"botMmEnabled\":false,"
+                     "\"id\":266,\"rankedPlayEnabled\":true,\"botEnabled\":false,\"active\":true,\"freeToPlay\":false,"
+                     "\"extra\":[[],{}]}]} \n");
+    umison::champion champ;
+    bool passed = champ.read_data(text) && champ.get_champions().size() == 1 &&
+                  champ.get_champions()[0].get_id() == 266 && champ.get_champions()[0].get_active();
+    // escapes are decoded, \u escapes to UTF-8
+    std::string input_text;
+    std::ifstream fi("test_get_spectator_game_info.json");
+    char buf[1024];
+    while(fi.getline(buf,1024)){
+      input_text += buf;
+    }
+    const std::string key("\"aaR7I5Im5f3wz0pEOP2diu737t9hBDx0\"");
+    std::size_t position = input_text.find(key);
+    passed = passed && position != std::string::npos;
+    if (position != std::string::npos) {
+      input_text.replace(position, key.size(), "\"a\\\"b\\\\\\/\\u00e9\\ud83d\\ude00\\n\"");
+    }
+    umison::getSpectatorGameInfo spect;
+    passed = passed && spect.read_data(input_text) &&
+             std::string(spect.get_observers().get_encryptionKey()) == "a\"b\\/\xc3\xa9\xf0\x9f\x98\x80\n";
+    // malformed texts are rejected
+    const char *malformed[] = {"{\"champions\":[]} x", "{\"champions\":[]", "{\"champions\":[],}", "{\"champions\" []}",
+                               "{\"champions\":[{\"id\":\"1}]}", "{\"champions\":[],\"a\":[1 2]}", ""};
+    for (const char *bad : malformed) {
+      std::stringstream errors;
+      umison::champion wrong;
+      passed = passed && !wrong.read_data(bad, errors) && !errors.str().empty();
+    }
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+#if defined(UMISON_LAZY_VIEWS)
+  // TEST 14
+  {
+    std::cout << "[TEST 14] ";
+    std::string input_text;
+    std::ifstream fi("test_featured_games.json");
+    char buf[1024];
+    while(fi.getline(buf,1024)){
+      input_text += buf;
+    }
+    umison::featuredGames fea;
+    umison::featuredGames_view view;
+    bool passed = fea.read_data(input_text) && view.read_data(input_text);
+    // the getters decode what the eager read has
+    passed = passed && view.get_clientRefreshInterval() == fea.get_clientRefreshInterval() &&
+             view.get_gameList().size() == fea.get_gameList().size() && !fea.get_gameList().empty();
+    if (passed) {
+      const auto &game = view.get_gameList().back();
+      const auto &eager = fea.get_gameList().back();
+      passed = game.get_gameId() == eager.get_gameId() && game.get_gameMode() == eager.get_gameMode() &&
+               game.get_observers().get_encryptionKey() == eager.get_observers().get_encryptionKey() &&
+               game.get_participants().size() == eager.get_participants().size();
+    }
+    // materialize writes the same json as the eager read
+    umison::featuredGames whole;
+    std::string eager_output;
+    std::string view_output;
+    passed = passed && view.materialize(whole) && whole.write_data_to_string(view_output) &&
+             fea.write_data_to_string(eager_output) && view_output == eager_output;
+    // read_data only checks there is an object, the errors are reported by materialize
+    std::stringstream errors;
+    umison::featuredGames_view partial;
+    passed = passed && !partial.read_data(" [1]", errors) && !errors.str().empty() &&
+             partial.read_data("{\"gameList\":[{\"gameId\":7}, 1]", errors) &&
+             partial.get_gameList().size() == 1 && partial.get_gameList()[0].get_gameId() == 7 &&
+             partial.get_clientRefreshInterval() == 0 && !partial.materialize(whole, errors);
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+#endif
+  // TEST 15
+  {
+    std::cout << "[TEST 15] ";
+    std::string input_text;
+    std::ifstream fi("test_get_spectator_game_info.json");
+    char buf[1024];
+    while(fi.getline(buf,1024)){
+      input_text += buf;
+    }
+    // the projection analytics reads the members it selects as read_data does
+    umison::getSpectatorGameInfo spect;
+    umison::getSpectatorGameInfo analytics;
+    bool passed = spect.read_data(input_text) && analytics.read_data_analytics(input_text) &&
+                  analytics.get_gameId() == spect.get_gameId() &&
+                  analytics.get_bannedChampions().size() == spect.get_bannedChampions().size() &&
+                  analytics.get_participants().size() == spect.get_participants().size() &&
+                  !spect.get_participants().empty();
+    for (std::size_t i = 0; passed && i < spect.get_participants().size(); ++i) {
+      passed = analytics.get_participants()[i].get_championId() == spect.get_participants()[i].get_championId();
+    }
+    for (std::size_t i = 0; passed && i < spect.get_bannedChampions().size(); ++i) {
+      passed = analytics.get_bannedChampions()[i].get_championId() == spect.get_bannedChampions()[i].get_championId() &&
+               analytics.get_bannedChampions()[i].get_pickTurn() == spect.get_bannedChampions()[i].get_pickTurn();
+    }
+    // a selected member of a wrong type is still an error
+    std::stringstream errors;
+    umison::getSpectatorGameInfo wrong;
+    passed = passed && !wrong.read_data_analytics("{\"gameId\":\"1\",\"participants\":[],\"bannedChampions\":[]}", errors) &&
+             !errors.str().empty();
+#if !defined(UMISON_PROJECTIONS_READ_WHOLE)
+    // the rest of the members are skipped, they are neither read nor required
+    passed = passed && analytics.get_gameMode().empty() && analytics.get_observers().get_encryptionKey().empty() &&
+             analytics.get_participants()[0].get_summonerName().empty() &&
+             analytics.get_participants()[0].get_runes().empty();
+    umison::getSpectatorGameInfo partial;
+    std::string text("{\"gameId\":7,\"observers\":1,\"participants\":[{\"championId\":3,\"runes\":{}}],"
+                     "\"bannedChampions\":[]}");
+    passed = passed && !partial.read_data(text, errors) && partial.read_data_analytics(text, errors) &&
+             partial.get_gameId() == 7 && partial.get_participants().size() == 1 &&
+             partial.get_participants()[0].get_championId() == 3;
+#endif
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 16
+  {
+    std::cout << "[TEST 16] ";
+    std::string input_text;
+    std::ifstream fi("test_get_spectator_game_info.json");
+    char buf[1024];
+    while(fi.getline(buf,1024)){
+      input_text += buf;
+    }
+    // read_data_prefix fills what read_data does, the text ends with the last member so all of it is validated
+    umison::getSpectatorGameInfo spect;
+    umison::getSpectatorGameInfo prefix;
+    bool validated = true;
+    std::size_t length = prefix.read_data_prefix(input_text, validated);
+    bool passed = spect.read_data(input_text) && length == input_text.size() && validated &&
+                  prefix.get_gameId() == spect.get_gameId() && prefix.get_gameMode() == spect.get_gameMode() &&
+                  prefix.get_participants().size() == spect.get_participants().size() &&
+                  prefix.get_bannedChampions().size() == spect.get_bannedChampions().size();
+    // a text missing a mandatory member is an error
+    std::stringstream errors;
+    umison::getSpectatorGameInfo missing;
+    passed = passed && missing.read_data_prefix("{\"gameId\":1}", validated, errors) == 0 && !errors.str().empty();
+#if !defined(UMISON_PREFIX_READ_WHOLE)
+    // the read stops after the last mandatory member, what follows is neither read nor validated
+    std::string text(input_text.substr(0, input_text.find_last_of('}')));
+    text.erase(text.find_last_not_of(" \n\r\t") + 1);
+    std::size_t end = text.size();
+    text += ",\"tail\":[1, tru";
+    umison::getSpectatorGameInfo stopped;
+    passed = passed && !umison::getSpectatorGameInfo().read_data(text, errors) &&
+             stopped.read_data_prefix(text, validated, errors) == end && !validated &&
+             stopped.get_gameId() == spect.get_gameId() &&
+             stopped.get_participants().size() == spect.get_participants().size();
+    // what follows the end of the object is validated as read_data does
+    passed = passed && umison::getSpectatorGameInfo().read_data_prefix(text.substr(0, end) + "} x", validated,
+                                                                       errors) == 0;
+#if !defined(UMISON_PROJECTIONS_READ_WHOLE)
+    // the one of a projection only waits for the members it selects
+    umison::getSpectatorGameInfo analytics;
+    text = "{\"gameId\":7,\"participants\":[{\"championId\":3}],\"bannedChampions\":[]";
+    end = text.size();
+    text += ",\"gameMode\":[tru";
+    passed = passed && analytics.read_data_analytics_prefix(text, validated, errors) == end && !validated &&
+             analytics.get_gameId() == 7 && analytics.get_participants().size() == 1;
+    // the end of the object is read when it follows the last member waited for
+    umison::getSpectatorGameInfo whole;
+    text = "{\"gameId\":7,\"participants\":[],\"bannedChampions\":[]} ";
+    passed = passed && whole.read_data_analytics_prefix(text, validated, errors) == text.size() && validated;
+#endif
+#endif
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 17
+  {
+    std::cout << "[TEST 17] ";
+    // the entries of top_league_entries below 700 points are dropped while they are read
+    std::string entry("{\"division\":\"I\",\"isFreshBlood\":false,\"isHotStreak\":true,\"isInactive\":false,"
+                      "\"isVeteran\":false,\"losses\":3,\"wins\":5,\"playerOrTeamId\":\"");
+    std::string text("{\"entries\":[" + entry + "1\",\"playerOrTeamName\":\"first\",\"leaguePoints\":750}," +
+                     entry + "2\",\"playerOrTeamName\":\"second\",\"leaguePoints\":100,"
+                     "\"miniSeries\":{\"losses\":1,\"progress\":\"WL\",\"target\":3,\"wins\":1}}," +
+                     entry + "3\",\"playerOrTeamName\":\"third\",\"leaguePoints\":700}]}");
+    umison::top_league_entries top;
+    bool passed = top.read_data(text) && top.get_entries().size() == 2 &&
+                  top.get_entries()[0].get_playerOrTeamName() == "first" &&
+                  top.get_entries()[0].get_division() == "I" && top.get_entries()[0].get_wins() == 5 &&
+                  top.get_entries()[1].get_playerOrTeamName() == "third" &&
+                  top.get_entries()[1].get_leaguePoints() == 700;
+    // an entry kept is still checked
+    std::stringstream errors;
+    umison::top_league_entries wrong;
+    passed = passed && !wrong.read_data("{\"entries\":[" + entry + "1\",\"playerOrTeamName\":5,\"leaguePoints\":750}]}",
+                                        errors) && !errors.str().empty();
+    // an entry dropped is checked too, the members the filter doesn't use are not stored
+    umison::top_league_entries dropped;
+    passed = passed && !dropped.read_data("{\"entries\":[" + entry + "1\",\"playerOrTeamName\":5,\"leaguePoints\":7}]}",
+                                          errors);
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 18
+  {
+    std::cout << "[TEST 18] ";
+    // every entry of the leagues is found by its playerOrTeamId, the index is filled while reading
+    std::string input_text;
+    std::ifstream fi("test_get_leagues_by_symmoner_ids.json");
+    char buf[1024];
+    while(fi.getline(buf,1024)){
+      input_text += buf;
+    }
+    umison::get_leagues_by_summoner_ids leagues;
+    bool passed = leagues.read_data(input_text) && !leagues.get_summoner_leagues().empty();
+    std::size_t found = 0;
+    for (auto &league : leagues.get_summoner_leagues()) {
+      for (auto &entry : league.second.get_entries()) {
+        auto *indexed = league.second.find_entries_by_playerOrTeamId(entry.get_playerOrTeamId());
+        passed = passed && indexed != nullptr && indexed->get_playerOrTeamId() == entry.get_playerOrTeamId();
+        ++found;
+      }
+      passed = passed && league.second.find_entries_by_playerOrTeamId("no such player") == nullptr;
+    }
+    passed = passed && found > 0;
+    // the entries dropped by the filter are not in the index
+    std::string entry("{\"division\":\"I\",\"isFreshBlood\":false,\"isHotStreak\":true,\"isInactive\":false,"
+                      "\"isVeteran\":false,\"losses\":3,\"wins\":5,\"playerOrTeamId\":\"");
+    umison::top_league_entries top;
+    passed = passed && top.read_data("{\"entries\":[" + entry + "1\",\"playerOrTeamName\":\"first\",\"leaguePoints\":750}," +
+                                     entry + "2\",\"playerOrTeamName\":\"second\",\"leaguePoints\":100}," +
+                                     entry + "1\",\"playerOrTeamName\":\"again\",\"leaguePoints\":800}]}") &&
+             top.find_entries_by_playerOrTeamId("2") == nullptr && top.find_entries_by_playerOrTeamId("1") != nullptr &&
+             top.find_entries_by_playerOrTeamId("1")->get_playerOrTeamName() == "first";
+    // the index is built again once the list changes
+    umison::top_league_entries copy(top);
+    copy.mutable_entries().emplace_back();
+    copy.mutable_entries().back().set_playerOrTeamId("3");
+    passed = passed && copy.find_entries_by_playerOrTeamId("3") == &copy.get_entries().back() &&
+             copy.find_entries_by_playerOrTeamId("1") == &copy.get_entries().front();
+    // a list of the same size set again and a key changed in place are found
+    std::vector<__internal__umison::league_entry_dto> first_entries(2);
+    std::vector<__internal__umison::league_entry_dto> second_entries(2);
+    first_entries[0].set_playerOrTeamId("a0");
+    first_entries[1].set_playerOrTeamId("a1");
+    second_entries[0].set_playerOrTeamId("b0");
+    second_entries[1].set_playerOrTeamId("b1");
+    umison::top_league_entries replaced;
+    replaced.set_entries(first_entries);
+    passed = passed && replaced.find_entries_by_playerOrTeamId("a1") == &replaced.get_entries()[1];
+    replaced.set_entries(second_entries);
+    passed = passed && replaced.find_entries_by_playerOrTeamId("a1") == nullptr &&
+             replaced.find_entries_by_playerOrTeamId("b1") == &replaced.get_entries()[1];
+    replaced.mutable_entries()[0].set_playerOrTeamId("zz");
+    passed = passed && replaced.find_entries_by_playerOrTeamId("zz") == &replaced.get_entries()[0] &&
+             replaced.find_entries_by_playerOrTeamId("b0") == nullptr;
+    // the copies keep the index, the const find of a changed list looks it up without the index
+    const umison::top_league_entries copied(replaced);
+    umison::top_league_entries moved(std::move(copy));
+    passed = passed && copied.find_entries_by_playerOrTeamId("zz") == &copied.get_entries()[0] &&
+             moved.find_entries_by_playerOrTeamId("3") == &moved.get_entries().back();
+    replaced.mutable_entries()[1].set_playerOrTeamId("yy");
+    const umison::top_league_entries &changed(replaced);
+    passed = passed && changed.find_entries_by_playerOrTeamId("yy") == &changed.get_entries()[1] &&
+             changed.find_entries_by_playerOrTeamId("b1") == nullptr;
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 19
+  {
+    std::cout << "[TEST 19] ";
+    bool passed = validates<umison::champion>("test_champion.json") &&
+                  validates<umison::featuredGames>("test_featured_games.json") &&
+                  validates<umison::get_leagues_by_summoner_ids>("test_get_leagues_by_symmoner_ids.json") &&
+                  validates<umison::getSpectatorGameInfo>("test_get_spectator_game_info.json") &&
+                  validates<umison::recent_game_by_summoner_id>("test_recent_game_by_summoner_ids.json");
+    // a wrong type, a missing mandatory member, a bad element and a text after the root are
+    // rejected as read_data rejects them
+    std::string wrong[] = {
+      "{\"champions\":[{\"active\":1,\"freeToPlay\":false,\"id\":266,\"rankedPlayEnabled\":true}]}",
+      "{\"champions\":[{\"active\":true,\"id\":266,\"rankedPlayEnabled\":true}]}",
+      "{\"champions\":[{\"active\":true,\"freeToPlay\":false,\"id\":266,\"rankedPlayEnabled\":true},3]}",
+      "{\"champions\":[]} []",
+      "{\"champions\":{}}",
+      "{}",
+    };
+    for (auto &text : wrong) {
+      std::stringstream errors;
+      umison::champion json;
+      passed = passed && !umison::champion::validate(text.c_str(), text.size(), errors) && !errors.str().empty() &&
+               !json.read_data(text, errors);
+    }
+    // the optional members may be missing and the unknown ones are skipped
+    std::string right("{\"champions\":[{\"active\":true,\"freeToPlay\":false,\"id\":266,\"rankedPlayEnabled\":true,"
+                      "\"other\":[{\"a\":\"\\u00e9\"}]}]}");
+    passed = passed && umison::champion::validate(right.c_str(), right.size());
+    // only len chars are read, the text needs no '\0' after it and a cut text is rejected
+    std::unique_ptr<char[]> exact(new char[right.size()]);
+    std::memcpy(exact.get(), right.data(), right.size());
+    passed = passed && umison::champion::validate(exact.get(), right.size());
+    for (std::size_t cut : {right.size() - 1, right.find("266") + 2, right.find("true") + 2, std::size_t(42)}) {
+      std::unique_ptr<char[]> part(new char[cut]);
+      std::memcpy(part.get(), right.data(), cut);
+      std::stringstream cut_errors;
+      passed = passed && !umison::champion::validate(part.get(), cut, cut_errors);
+    }
+    // the maps drop the objects that can't be read, the rest of the text is still checked
+    std::string leagues("{\"1\":[{\"entries\":5}],\"2\":7}");
+    std::string broken("{\"1\":[{\"entries\":5}],\"2\":[}");
+    std::stringstream errors;
+    passed = passed && umison::get_leagues_by_summoner_ids::validate(leagues.c_str(), leagues.size(), errors) &&
+             !umison::get_leagues_by_summoner_ids::validate(broken.c_str(), broken.size(), errors);
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 20
+  {
+    std::cout << "[TEST 20] ";
+    // the entries go one at a time to the callbacks and the lists are left empty, top only hands
+    // over the entries its filter accepts
+    std::string entry("{\"division\":\"I\",\"isFreshBlood\":false,\"isHotStreak\":true,\"isInactive\":false,"
+                      "\"isVeteran\":false,\"losses\":3,\"wins\":5,\"playerOrTeamId\":\"");
+    std::string text("{\"top\":[" + entry + "1\",\"playerOrTeamName\":\"first\",\"leaguePoints\":750}," +
+                     entry + "2\",\"playerOrTeamName\":\"second\",\"leaguePoints\":100}],\"entries\":[" +
+                     entry + "3\",\"playerOrTeamName\":\"third\",\"leaguePoints\":10,"
+                     "\"miniSeries\":{\"losses\":1,\"progress\":\"WL\",\"target\":3,\"wins\":1}}," +
+                     entry + "4\",\"playerOrTeamName\":\"fourth\",\"leaguePoints\":20}],\"name\":\"league\"}");
+    std::vector<std::string> entries;
+    std::vector<std::string> top;
+    int targets = 0;
+    auto on_entries = [&entries, &targets](const __internal__umison::league_entry_dto &element) {
+      entries.emplace_back(element.get_playerOrTeamName());
+      targets += element.get_miniSeries().get_target();
+    };
+    auto on_top = [&top](const __internal__umison::league_entry_dto &element) {
+      top.emplace_back(element.get_playerOrTeamName());
+    };
+    umison::streamed_league_entries streamed;
+    bool passed = streamed.read_data_streaming(text, on_entries, on_top) &&
+                  entries == std::vector<std::string>{"third", "fourth"} && targets == 3 &&
+                  top == std::vector<std::string>{"first"} && streamed.get_entries().empty() &&
+                  streamed.get_top().empty() && streamed.get_name() == "league";
+    // a wrong element or a missing mandatory member fails the read
+    std::stringstream errors;
+    umison::streamed_league_entries wrong;
+    passed = passed && !wrong.read_data_streaming("{\"entries\":[" + entry + "3\",\"leaguePoints\":\"10\"}],"
+                                                  "\"name\":\"league\"}", on_entries, on_top, errors) &&
+             !wrong.read_data_streaming("{\"entries\":[]}", on_entries, on_top, errors) && !errors.str().empty();
+#if !defined(UMISON_STREAMING_READ_WHOLE)
+    // the elements go to the callbacks while the text is read, the ones before an error are not taken back
+    entries.clear();
+    passed = passed && !wrong.read_data_streaming("{\"entries\":[" + entry + "5\",\"playerOrTeamName\":\"fifth\","
+                                                  "\"leaguePoints\":10}," + entry + "6\",\"playerOrTeamName\":\"sixth\","
+                                                  "\"leaguePoints\":\"20\"}],\"name\":\"league\"}", on_entries, on_top,
+                                                  errors) && entries == std::vector<std::string>{"fifth"};
+#endif
+    // read_data still stores the elements
+    umison::streamed_league_entries stored;
+    passed = passed && stored.read_data(text) && stored.get_entries().size() == 2 && stored.get_top().size() == 1;
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 21
+  {
+    std::cout << "[TEST 21] ";
+    // each event is read with the class its type names
+    std::string text("{\"frameInterval\":60000,\"frames\":[{\"timestamp\":0,\"events\":["
+                     "{\"type\":\"CHAMPION_KILL\",\"timestamp\":10,\"killerId\":1,\"victimId\":6,"
+                     "\"assistingParticipantIds\":[2,3]},"
+                     "{\"type\":\"WARD_PLACED\",\"timestamp\":20,\"creatorId\":4,\"wardType\":\"YELLOW_TRINKET\"}]},"
+                     "{\"timestamp\":60000,\"events\":[{\"type\":\"ITEM_PURCHASED\",\"timestamp\":60010,"
+                     "\"participantId\":5,\"itemId\":1055}]}],"
+                     "\"lastEvent\":{\"type\":\"ITEM_PURCHASED\",\"timestamp\":60010,\"participantId\":5,\"itemId\":1055}}");
+    using event = __internal__umison::timeline_event;
+    umison::match_timeline timeline;
+    bool passed = timeline.read_data(text) && timeline.get_frames().size() == 2 &&
+                  timeline.get_frames()[0].get_events().size() == 2 && timeline.get_lastEvent_umi_optional();
+    if (passed) {
+      const auto &kill = timeline.get_frames()[0].get_events()[0];
+      const auto &ward = timeline.get_frames()[0].get_events()[1];
+      const auto &item = timeline.get_frames()[1].get_events()[0];
+      passed = kill.which() == event::umison_case::champion_kill_event && kill.get_ward_placed_event() == nullptr &&
+               kill.get_champion_kill_event()->get_victimId() == 6 &&
+               kill.get_champion_kill_event()->get_assistingParticipantIds().size() == 2 &&
+               ward.which() == event::umison_case::ward_placed_event &&
+               ward.get_ward_placed_event()->get_wardType() == "YELLOW_TRINKET" &&
+               item.get_item_event() != nullptr && item.get_item_event()->get_itemId() == 1055 &&
+               timeline.get_lastEvent().which() == event::umison_case::item_event;
+    }
+    // the tag is written first and the output reads back the same
+    std::string output;
+    std::string second_output;
+    umison::match_timeline second;
+    passed = passed && timeline.write_data_to_string(output) && output.find("{\"type\":\"CHAMPION_KILL\",") != std::string::npos &&
+             second.read_data(output) && second.write_data_to_string(second_output) && output == second_output &&
+             umison::match_timeline::validate(output.c_str(), output.size());
+    // copies keep the case, an event holding no case can't be written
+    event copy(timeline.get_frames()[0].get_events()[1]);
+    event moved(std::move(copy));
+    copy = moved;
+    passed = passed && copy.get_ward_placed_event() != nullptr && moved.get_ward_placed_event()->get_creatorId() == 4;
+    copy.clear();
+    std::stringstream errors;
+    umison::match_timeline empty;
+    empty.set_frameInterval(1);
+    empty.emplace_frames().mutable_events().emplace_back();
+    passed = passed && copy.which() == event::umison_case::none && !empty.write_data_to_string(output, errors) &&
+             !errors.str().empty();
+#if !defined(UMISON_VARIANT_TAG_FIRST)
+    // the tag may come after the other members
+    umison::match_timeline later;
+    passed = passed && later.read_data("{\"frameInterval\":1,\"frames\":[{\"timestamp\":0,\"events\":[{\"timestamp\":10,"
+                                       "\"creatorId\":4,\"wardType\":\"SIGHT\",\"type\":\"WARD_PLACED\"}]}]}") &&
+             later.get_frames()[0].get_events()[0].get_ward_placed_event()->get_wardType() == "SIGHT";
+#endif
+    // an unknown or missing tag fails the read
+    std::vector<std::string> wrong = {
+      "{\"frameInterval\":1,\"frames\":[{\"timestamp\":0,\"events\":[{\"type\":\"BUILDING_KILL\",\"timestamp\":1}]}]}",
+      "{\"frameInterval\":1,\"frames\":[{\"timestamp\":0,\"events\":[{\"timestamp\":1,\"participantId\":5,\"itemId\":1}]}]}",
+      "{\"frameInterval\":1,\"frames\":[{\"timestamp\":0,\"events\":[{\"type\":3,\"timestamp\":1}]}]}",
+      "{\"frameInterval\":1,\"frames\":[{\"timestamp\":0,\"events\":[{\"type\":\"ITEM_PURCHASED\",\"timestamp\":1}]}]}",
+    };
+    for (auto &wrong_text : wrong) {
+      umison::match_timeline json;
+      passed = passed && !json.read_data(wrong_text, errors) &&
+               !umison::match_timeline::validate(wrong_text.c_str(), wrong_text.size(), errors);
+    }
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 22
+  {
+    std::cout << "[TEST 22] ";
+    // the enums are read from their values, the unknown tiers are the fallback
+    using queue = __internal__umison::league_queue;
+    using tier = __internal__umison::league_tier;
+    using rank = __internal__umison::league_position_rank;
+    std::string text("{\"queue\":\"RANKED_TEAM_3x3\",\"tier\":\"DIAMOND\",\"rank\":\"IV\"}");
+    umison::league_position position;
+    bool passed = position.read_data(text) && position.get_queue() == queue::RANKED_TEAM_3x3 &&
+                  position.get_tier() == tier::DIAMOND && position.get_rank_umi_optional() &&
+                  position.get_rank() == rank::IV;
+    umison::league_position unranked;
+    passed = passed && unranked.read_data("{\"queue\":\"RANKED_SOLO_\\u0035x5\",\"tier\":\"IRON\"}") &&
+             unranked.get_queue() == queue::RANKED_SOLO_5x5 && unranked.get_tier() == tier::UNRANKED &&
+             !unranked.get_rank_umi_optional();
+    // the standings share the enums
+    umison::league_standings standings;
+    passed = passed && standings.read_data("{\"standings\":[{\"queue\":\"RANKED_TEAM_5x5\",\"tier\":\"GOLD\"},"
+                                           "{\"queue\":\"RANKED_SOLO_5x5\",\"tier\":\"IRON\"}]}") &&
+             standings.get_standings().size() == 2 && standings.get_standings()[0].get_queue() == queue::RANKED_TEAM_5x5 &&
+             standings.get_standings()[0].get_tier() == tier::GOLD &&
+             standings.get_standings()[1].get_tier() == tier::UNRANKED;
+    // the values are written by name and the output reads back the same
+    std::string output;
+    std::string second_output;
+    umison::league_position second;
+    passed = passed && unranked.write_data_to_string(output) &&
+             output == "{\"queue\":\"RANKED_SOLO_5x5\",\"tier\":\"UNRANKED\"}" &&
+             output.size() == unranked.serialized_size();
+    output.clear();
+    passed = passed && position.write_data_to_string(output) &&
+             second.read_data(output) && second.write_data_to_string(second_output) && output == second_output &&
+             umison::league_position::validate(output.c_str(), output.size());
+    // a value out of the enum can't be written
+    std::stringstream errors;
+    umison::league_position out_of_range;
+    out_of_range.set_queue(static_cast<queue>(7));
+    passed = passed && !out_of_range.write_data_to_string(output, errors) && !errors.str().empty();
+    // the enums without fallback fail on the unknown values, any enum fails on other types
+    std::vector<std::string> wrong = {
+      "{\"queue\":\"NORMAL_5x5\",\"tier\":\"GOLD\"}",
+      "{\"queue\":\"RANKED_SOLO_5x5\",\"tier\":\"GOLD\",\"rank\":\"VI\"}",
+      "{\"queue\":\"RANKED_SOLO_5x5\",\"tier\":3}",
+      "{\"queue\":\"ranked_solo_5x5\",\"tier\":\"GOLD\"}",
+    };
+    for (auto &wrong_text : wrong) {
+      umison::league_position json;
+      passed = passed && !json.read_data(wrong_text, errors) &&
+               !umison::league_position::validate(wrong_text.c_str(), wrong_text.size(), errors);
+    }
+#if defined(UMISON_LAZY_VIEWS)
+    umison::league_position_view view;
+    passed = passed && view.read_data(text) && view.get_tier() == tier::DIAMOND && view.get_rank() == rank::IV;
+#endif
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 23
+  {
+    std::cout << "[TEST 23] ";
+    // the interned strings with the same text share one copy in the pool
+    std::string text("{\"games\":[{\"gameId\":1,\"gameMode\":\"CLASSIC\",\"gameType\":\"MATCHED_GAME\",\"platformId\":\"EUW1\"},"
+                     "{\"gameId\":2,\"gameMode\":\"ARAM\",\"gameType\":\"MATCHED_GAME\",\"platformId\":\"EUW1\"}],"
+                     "\"entries\":[{\"leaguePoints\":10,\"playerOrTeamId\":\"a\"},"
+                     "{\"leaguePoints\":20,\"playerOrTeamId\":\"b\"}]}");
+    umison::interned_games first;
+    umison::interned_games second;
+    bool passed = first.read_data(text) && second.read_data(text) && first.get_games().size() == 2 &&
+                  first.get_games()[0].get_gameType().data() == first.get_games()[1].get_gameType().data();
+    for (std::size_t i = 0; passed && i < first.get_games().size(); ++i) {
+      auto &game = first.get_games()[i];
+      passed = game.get_gameMode() == second.get_games()[i].get_gameMode() &&
+               game.get_gameMode().data() == second.get_games()[i].get_gameMode().data() &&
+               game.get_platformId().data() == first.get_games()[0].get_platformId().data() &&
+               !game.get_gameType().empty() && game.get_gameType() == game.get_gameType().str();
+    }
+    // the text set or escaped is interned as the read one
+    __internal__umison::interned_game info;
+    info.set_gameMode(first.get_games()[0].get_gameMode().str());
+    passed = passed && info.get_gameMode() == first.get_games()[0].get_gameMode() &&
+             info.get_gameMode().data() == first.get_games()[0].get_gameMode().data() && info.get_platformId().empty();
+    // the interned strings are written and sized as the strings
+    std::string output;
+    std::string second_output;
+    umison::interned_games again;
+    passed = passed && first.write_data_to_string(output) && output.size() == first.serialized_size() &&
+             again.read_data(output) && again.write_data_to_string(second_output) && output == second_output;
+    // an escaped text is interned as the decoded one
+    std::string escaped(text);
+    escaped.replace(escaped.find("\"CLASSIC\""), 9, "\"\\u0043LASSIC\"");
+    passed = passed && again.read_data(escaped) &&
+             again.get_games()[0].get_gameMode().data() == first.get_games()[0].get_gameMode().data() &&
+             again.get_games()[0].get_gameMode() == __internal__umison::umison_intern("CLASSIC");
+    // the index keys are found from the text
+    for (auto &entry : first.get_entries()) {
+      passed = passed && first.find_entries_by_playerOrTeamId(entry.get_playerOrTeamId().str()) == &entry;
+    }
+    passed = passed && first.find_entries_by_playerOrTeamId("c") == nullptr;
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 24
+  {
+    std::cout << "[TEST 24] ";
+    // the strings with a maximum length are kept inline in the object
+    std::string entry("{\"entries\":[{\"leaguePoints\":750,\"progress\":\"WLN\",\"division\":\"");
+    umison::ranked_entries ranked;
+    bool passed = ranked.read_data(entry + "IV\"},{\"leaguePoints\":3,\"division\":\"I\"}]}") &&
+                  ranked.get_entries().size() == 2;
+    for (auto &ranked_entry : ranked.get_entries()) {
+      auto &division = ranked_entry.get_division();
+      passed = passed && !division.empty() && division.size() <= 3 &&
+               static_cast<const void *>(division.data()) >= static_cast<const void *>(&ranked_entry) &&
+               static_cast<const void *>(division.data()) < static_cast<const void *>(&ranked_entry + 1);
+    }
+    passed = passed && ranked.get_entries()[0].get_progress_umi_optional() &&
+             ranked.get_entries()[0].get_progress() == "WLN" && !ranked.get_entries()[1].get_progress_umi_optional() &&
+             sizeof(decltype(ranked.get_entries().front().get_division())) < sizeof(std::string);
+    // the escaped text is decoded before its length is checked
+    umison::ranked_entries top;
+    passed = passed && top.read_data(entry + "\\u0049\\u0049I\"}]}") && top.get_entries().size() == 1 &&
+             top.get_entries()[0].get_division() == "III" && top.get_entries()[0].get_division() != "II" &&
+             top.get_entries()[0].get_division() == std::string("III");
+    // the longer strings are rejected by read_data and validate, and the setter
+    std::stringstream errors;
+    std::string longer(entry + "IIII\"}]}");
+    std::string longer_progress("{\"entries\":[{\"leaguePoints\":1,\"progress\":\"WLNWLN\",\"division\":\"I\"}]}");
+    umison::ranked_entries wrong;
+    passed = passed && !wrong.read_data(longer, errors) && !wrong.read_data(longer_progress, errors) &&
+             !umison::ranked_entries::validate(longer.c_str(), longer.size(), errors) &&
+             !umison::ranked_entries::validate(longer_progress.c_str(), longer_progress.size(), errors) &&
+             !errors.str().empty() &&
+             umison::ranked_entries::validate((entry + "IV\"}]}").c_str(), entry.size() + 6);
+    auto &first = top.mutable_entries()[0];
+    passed = passed && !first.set_division("IIII") && first.get_division() == "III" &&
+             first.set_division("IV") && first.get_division().str() == "IV";
+    // the inline strings are written and sized as the strings
+    std::string output;
+    std::string second_output;
+    umison::ranked_entries again;
+    passed = passed && ranked.write_data_to_string(output) && output.size() == ranked.serialized_size() &&
+             again.read_data(output) && again.write_data_to_string(second_output) && output == second_output;
+#if defined(UMISON_LAZY_VIEWS)
+    umison::ranked_entries_view view;
+    passed = passed && view.read_data(entry + "IV\"}]}") && view.get_entries()[0].get_division() == "IV";
+#endif
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
+  // TEST 25
+  {
+    std::cout << "[TEST 25] ";
+    // validate accepts what read_data accepts, a wrong member of an entry the filter rejects fails
+    // both as it does on the entries kept
+    std::string entry("{\"isFreshBlood\":false,\"isHotStreak\":true,\"isInactive\":false,\"isVeteran\":false,"
+                      "\"losses\":3,\"wins\":5,\"playerOrTeamName\":\"name\",\"playerOrTeamId\":\"");
+    std::string kept(entry + "1\",\"division\":\"I\",\"leaguePoints\":750}");
+    std::string texts[] = {
+      "{\"entries\":[" + kept + "," + entry + "2\",\"division\":\"II\",\"leaguePoints\":7}]}",
+      "{\"entries\":[" + kept + "," + entry + "2\",\"division\":9223372036854775808,\"leaguePoints\":7}]}",
+      "{\"entries\":[" + entry + "2\",\"division\":\"II\",\"leaguePoints\":7,\"miniSeries\":[]}," + kept + "]}",
+      "{\"entries\":[" + entry + "2\",\"division\":[1,{}],\"leaguePoints\":7}]}",
+      "{\"entries\":[" + entry + "1\",\"division\":9223372036854775808,\"leaguePoints\":750}]}",
+    };
+    bool passed = true;
+    int accepted = 0;
+    for (auto &text : texts) {
+      std::stringstream errors;
+      umison::top_league_entries json;
+      bool read = json.read_data(text, errors);
+      passed = passed && umison::top_league_entries::validate(text.c_str(), text.size(), errors) == read;
+      accepted += read ? 1 : 0;
+    }
+    passed = passed && accepted == 1;
+    if(!passed) {
+      std::cout << "Failed\n";
+    } else {
+      std::cout << "Passed\n";
+    }
+  }
 }
@@ -2,8 +2,50 @@
 
 ../umison --generate-custom-interface rapidjson -i riot_games.xml -e riot_games.h -p riot_games.cpp
 
-g++ -g -I../../rapidjson/include -o riot_games main.cpp riot_games.cpp
+g++ -g -DUMISON_PROJECTIONS_READ_WHOLE -DUMISON_PREFIX_READ_WHOLE -DUMISON_STREAMING_READ_WHOLE -I../../rapidjson/include -o riot_games main.cpp riot_games.cpp
 
 ./riot_games
 
+../umison --engine rapidjson-sax --generate-custom-interface rapidjson -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -DUMISON_VARIANT_TAG_FIRST -I../../rapidjson/include -o riot_games_sax main.cpp riot_games.cpp
+
+./riot_games_sax
+
+../umison --string-view -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -std=c++17 -DUMISON_PROJECTIONS_READ_WHOLE -DUMISON_PREFIX_READ_WHOLE -DUMISON_STREAMING_READ_WHOLE -I../../rapidjson/include -o riot_games_view main.cpp riot_games.cpp
+
+./riot_games_view
+
+../umison --engine native -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -o riot_games_native main.cpp riot_games.cpp
+
+./riot_games_native
+
+../umison --engine native --string-view -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -std=c++17 -o riot_games_native_view main.cpp riot_games.cpp
+
+./riot_games_native_view
+
+../umison --engine native-simd -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -o riot_games_native_simd main.cpp riot_games.cpp
+
+./riot_games_native_simd
+
+../umison --engine native-table -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -o riot_games_native_table main.cpp riot_games.cpp
+
+./riot_games_native_table
+
+../umison --engine native --lazy-views -i riot_games.xml -e riot_games.h -p riot_games.cpp
+
+g++ -g -DUMISON_LAZY_VIEWS -o riot_games_native_views main.cpp riot_games.cpp
+
+./riot_games_native_views
+
 # AFL_HARDEN=1 afl-g++ -O3 -fPIC -I../../rapidjson/include -o riot_games_afl afl_main.cpp riot_games.cpp
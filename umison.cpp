@@ -43,6 +43,8 @@ umi::umison::umison(int argc, char **argv) : m_inputStream(std::cin.rdbuf()),
     ("append-string,a", boost::program_options::value<std::string>(),
      "String to be appended in the internal namespace to avoid collisions with existing code")
     ("engine", boost::program_options::value<std::string>(), "Specify an output engine")
+    ("string-view", "Generate std::string_view strings pointing into the parsed buffer (C++17)")
+    ("lazy-views", "Generate views of the jsons decoding each member when its getter is called")
     ("generate-custom-interface", boost::program_options::value<std::string>(),
      "Specify an engine you want to create a custom read_data method");
 
@@ -98,6 +100,14 @@ umi::umison::umison(int argc, char **argv) : m_inputStream(std::cin.rdbuf()),
   if (variables_map.count("engine")) {
     m_engine = variables_map["engine"].as<std::string>();
   }
+
+  if (variables_map.count("string-view")) {
+    m_string_view = true;
+  }
+
+  if (variables_map.count("lazy-views")) {
+    m_lazy_views = true;
+  }
 }
 
 umi::umison::~umison() {
@@ -120,9 +130,22 @@ void umi::umison::run() {
     }
   }
   auto xml = std::make_shared<umi::umixml>(tmpString);
+  xml->string_view(m_string_view);
+  xml->lazy_views(m_lazy_views);
   std::shared_ptr<output_engine<std::ostream, std::ostream>> oe;
   if (m_engine.empty() || m_engine == "rapidjson") {
     oe = std::make_shared<umi::output_engine_rapid_json<std::ostream, std::ostream>>(m_h_stream, m_cpp_stream);
+  } else if (m_engine == "rapidjson-sax") {
+    oe = std::make_shared<umi::output_engine_rapid_json_sax<std::ostream, std::ostream>>(m_h_stream, m_cpp_stream);
+  } else if (m_engine == "native") {
+    oe = std::make_shared<umi::output_engine_native<std::ostream, std::ostream>>(m_h_stream, m_cpp_stream);
+  } else if (m_engine == "native-simd") {
+    oe = std::make_shared<umi::output_engine_native_simd<std::ostream, std::ostream>>(m_h_stream, m_cpp_stream);
+  } else if (m_engine == "native-table") {
+    oe = std::make_shared<umi::output_engine_native_table<std::ostream, std::ostream>>(m_h_stream, m_cpp_stream);
+  } else {
+    std::cerr << "Error: Unknown engine " << m_engine << "\n";
+    exit(-1);
   }
   oe->h_filename(m_h_filename);
   oe->additional_string(m_append_string);
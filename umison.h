@@ -122,6 +122,14 @@ namespace umi {
      * String engine
      * */
     std::string m_engine;
+    /**
+     * Strings are std::string_view on the parsed buffer
+     * */
+    bool m_string_view = false;
+    /**
+     * Generate the lazy views of the jsons
+     * */
+    bool m_lazy_views = false;
   };
 }
 
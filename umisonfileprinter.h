@@ -26,6 +26,7 @@
 #ifndef UMISON_UMISONFILEPRINTER_H
 #define UMISON_UMISONFILEPRINTER_H
 
+#include "umisontypetocpp.h"
 #include "umixml.h"
 #include "umixmltags.h"
 #include <string>
@@ -60,12 +61,33 @@ namespace umi {
      * \param stream used to output the json representation
      * \param headers vector of additional headers we want to include
      * \param methods vector of additional methods we want to include
+     * \param friends vector of the engine structs that reach the attributes of every struct
      * */
     void print(std::shared_ptr<umi::umixml> &ff, streamer &stream, const std::vector<std::string> &headers,
-               const std::vector<std::string> &methods) {
+               const std::vector<std::string> &methods, const std::vector<std::string> &friends) {
       auto &localAdditionalString = m_additional_string;
       stream << DISCLAIMER << "\n#pragma once\n"
-      << "\n#include <ostream>\n#include <string>\n#include <vector>\n#include <map>\n";
+      << "\n#include <ostream>\n#include <string>\n#include <vector>\n#include <map>\n#include <memory>\n#include <utility>\n"
+      << "#include <cstdio>\n#include <functional>\n"
+      << "#if !defined(_WIN32)\n#include <sys/uio.h>\n#endif\n";
+      if (ff->string_view()) {
+        stream << "#include <string_view>\n";
+      }
+      if (has_index(ff) || ff->interned() || ff->bounded()) {
+        stream << "#include <cstdint>\n";
+      }
+      if (ff->interned() || ff->bounded()) {
+        stream << "#include <cstring>\n";
+      }
+      if (ff->interned()) {
+        stream << "#include <atomic>\n#include <deque>\n#include <mutex>\n";
+      }
+      if (ff->bounded()) {
+        stream << "#include <type_traits>\n";
+      }
+      if (!ff->getVariantArray().empty()) {
+        stream << "#include <new>\n";
+      }
       if (!headers.empty()) {
         std::for_each(
           headers.begin(),
@@ -75,21 +97,36 @@ namespace umi {
           });
       }
       stream << "\n";
-      if (!ff->getClassMap().empty()) {
+      if (!ff->getClassMap().empty() || !ff->getEnumArray().empty() || ff->interned() || ff->bounded()) {
         stream << "// Internal namespace declaration\nnamespace __internal__umison"
-        << m_additional_string << " {\n\n"
-        << TABS << "// Forward declaration\n";
+        << m_additional_string << " {\n\n";
+        if (has_index(ff)) {
+          create_index_runtime(stream);
+        }
+        if (ff->interned()) {
+          create_intern_runtime(stream, ff->string_view());
+        }
+        if (ff->bounded()) {
+          create_inline_string_runtime(stream, ff->string_view());
+        }
+        create_enums(ff, stream);
+        stream << TABS << "// Forward declaration\n";
         auto classMap = ff->getClassMap();
         std::for_each(classMap.begin(),
                       classMap.end(),
                       [&stream](const auto &classMapIt) {
                         stream << TABS << "struct " << classMapIt.first << ";\n";
                       });
+        for (auto &variant: ff->getVariantArray()) {
+          stream << TABS << "struct " << variant->name() << ";\n";
+        }
         stream << "\n";
+        std::size_t position = 0;
         std::for_each(
           classMap.begin(),
           classMap.end(),
-          [&stream, &localAdditionalString, this](const auto &classMapIt) {
+          [&stream, &localAdditionalString, &friends, &ff, &position, this](const auto &classMapIt) {
+            this->create_variants(ff, position++, stream);
             stream << TABS << "// struct " << classMapIt.first << "\n"
             << TABS << "struct " << classMapIt.first << " {\n";
             this->set_public(stream);
@@ -98,6 +135,7 @@ namespace umi {
             this->create_properties(classMapIt.second, stream);
             stream << "\n";
             this->set_private(stream);
+            this->create_friends(friends, stream);
             stream << TABS << TABS << "// Attributes declaration\n";
             auto classChildren = classMapIt.second->getChildren();
             std::for_each(
@@ -110,9 +148,11 @@ namespace umi {
                   stream << TABS << TABS
                   << childrenIt->optional_name_type(localAdditionalString, true);
                 }
+                stream << childrenIt->index_header_type(localAdditionalString, TABS, 2);
               });
             stream << TABS << "};\n\n";
           });
+        create_variants(ff, position, stream);
         stream << "}\n\n"; // For the internal namespace
       }
 
@@ -126,10 +166,12 @@ namespace umi {
           stream << TABS << "struct " << jsonArrayIt->name() << ";\n";
         });
       stream << "\n";
+      create_parser_context(ff, stream);
+      create_serialize_scratch(stream);
       std::for_each(
         jsonArray.begin(),
         jsonArray.end(),
-        [&stream, &localAdditionalString, &methods, this](auto &jsonArrayIt) {
+        [&stream, &localAdditionalString, &methods, &friends, &ff, this](auto &jsonArrayIt) {
           stream << TABS << "// struct " << jsonArrayIt->name() << "\n"
           << TABS << "struct " << jsonArrayIt->name() << " {\n";
           this->set_public(stream);
@@ -140,19 +182,132 @@ namespace umi {
           << TABS << TABS << "bool read_data(const std::string &input_text);\n"
           << "\n" << TABS << TABS
           << "// read one input string and fill the data, errors are reported on out_stream\n"
-          << TABS << TABS << "bool read_data(const std::string &input_text, std::ostream &out_stream);\n"
-          << "\n" << TABS << TABS
+          << TABS << TABS << "bool read_data(const std::string &input_text, std::ostream &out_stream);\n";
+          for (auto &projection: ff->getProjections()) {
+            if (projection->json() != jsonArrayIt->name()) {
+              continue;
+            }
+            stream << "\n" << TABS << TABS
+            << "// read only the members of the projection " << projection->name()
+            << ", the rest are skipped,\n"
+            << TABS << TABS << "// errors are reported on stderr\n"
+            << TABS << TABS << "bool read_data_" << projection->name() << "(const std::string &input_text);\n"
+            << "\n" << TABS << TABS
+            << "// read only the members of the projection " << projection->name()
+            << ", errors are reported on out_stream\n"
+            << TABS << TABS << "bool read_data_" << projection->name()
+            << "(const std::string &input_text, std::ostream &out_stream);\n";
+          }
+          if (jsonArrayIt->read_prefix()) {
+            stream << "\n" << TABS << TABS
+            << "// read the text until the required members have been read, what is left is not looked\n"
+            << TABS << TABS << "// at. Returns the length read, 0 on errors reported on out_stream, validated is\n"
+            << TABS << TABS << "// set when the whole text was read and checked\n"
+            << TABS << TABS
+            << "std::size_t read_data_prefix(const std::string &input_text, bool &validated, std::ostream &out_stream);\n"
+            << "\n" << TABS << TABS
+            << "// read the text until the required members have been read, errors are reported on stderr\n"
+            << TABS << TABS << "std::size_t read_data_prefix(const std::string &input_text, bool &validated);\n";
+            for (auto &projection: ff->getProjections()) {
+              if (projection->json() != jsonArrayIt->name()) {
+                continue;
+              }
+              stream << "\n" << TABS << TABS
+              << "// read_data_prefix stopping once the members of the projection " << projection->name()
+              << " have been read\n"
+              << TABS << TABS << "std::size_t read_data_" << projection->name()
+              << "_prefix(const std::string &input_text, bool &validated, std::ostream &out_stream);\n"
+              << TABS << TABS << "std::size_t read_data_" << projection->name()
+              << "_prefix(const std::string &input_text, bool &validated);\n";
+            }
+          }
+          if (!jsonArrayIt->streaming_arguments().empty()) {
+            stream << "\n" << TABS << TABS
+            << "// read the text handing each element of the streamed lists to its callback instead of\n"
+            << TABS << TABS << "// storing it, the lists are left empty and the element is only valid during the call,\n"
+            << TABS << TABS << "// errors are reported on out_stream\n"
+            << TABS << TABS << "bool read_data_streaming(const std::string &input_text"
+            << jsonArrayIt->streaming_parameters(localAdditionalString) << ", std::ostream &out_stream);\n"
+            << "\n" << TABS << TABS
+            << "// read the text handing the elements of the streamed lists to their callbacks, errors are\n"
+            << TABS << TABS << "// reported on stderr\n"
+            << TABS << TABS << "bool read_data_streaming(const std::string &input_text"
+            << jsonArrayIt->streaming_parameters(localAdditionalString) << ");\n";
+          }
+          stream << "\n" << TABS << TABS
           << "// read one input file and fill the data, errors are reported on stderr\n"
           << TABS << TABS << "bool read_data_from_file(const std::string &input_file);\n"
           << "\n" << TABS << TABS
           << "// read one input file and fill the data, errors are reported on out_stream\n"
           << TABS << TABS << "bool read_data_from_file(const std::string &input_file, std::ostream &out_stream);\n"
           << "\n" << TABS << TABS
-          << "// writes the json into a string, errors are reported on out_stream"
-          << TABS << TABS << "bool write_data_to_string(std::string &output, std::ostream &out_stream) const;"
+          << "// parses buffer in place, buffer[len] must be '\\0' and its content is modified,\n"
+          << TABS << TABS;
+          if (ff->string_view()) {
+            stream << "// the strings point into buffer so it must outlive this object and its copies,\n"
+            << TABS << TABS;
+          }
+          stream << "// errors are reported on stderr\n"
+          << TABS << TABS << "bool read_data_insitu(char *buffer, std::size_t len);\n"
+          << "\n" << TABS << TABS
+          << "// parses buffer in place, errors are reported on out_stream\n"
+          << TABS << TABS << "bool read_data_insitu(char *buffer, std::size_t len, std::ostream &out_stream);\n"
+          << "\n" << TABS << TABS
+          << "// checks that text is a valid " << jsonArrayIt->name() << " without storing it, only the len\n"
+          << TABS << TABS << "// chars of text are read and they are not modified, errors are reported on stderr\n"
+          << TABS << TABS << "static bool validate(const char *text, std::size_t len);\n"
+          << "\n" << TABS << TABS
+          << "// checks text without storing it, errors are reported on out_stream\n"
+          << TABS << TABS << "static bool validate(const char *text, std::size_t len, std::ostream &out_stream);\n"
+          << "\n" << TABS << TABS
+          << "// read one input string reusing the memory of context, errors are kept on context\n";
+          if (ff->string_view()) {
+            stream << TABS << TABS << "// the strings point into context until its next read\n";
+          }
+          stream << TABS << TABS << "bool read_data(parser_context &context, const std::string &input_text);\n"
+          << "\n" << TABS << TABS
+          << "// length of the json written by write_data_to_string and write_to\n"
+          << TABS << TABS << "std::size_t serialized_size() const;\n"
+          << "\n" << TABS << TABS
+          << "// writes the json at buffer without allocating memory, returns its length or 0 when it\n"
+          << TABS << TABS << "// doesn't fit in capacity or has errors, errors are reported on out_stream\n"
+          << TABS << TABS
+          << "std::size_t write_to(char *buffer, std::size_t capacity, std::ostream &out_stream) const;\n"
+          << "\n" << TABS << TABS
+          << "// writes the json at buffer, errors are reported on stderr\n"
+          << TABS << TABS << "std::size_t write_to(char *buffer, std::size_t capacity) const;\n"
+          << "\n" << TABS << TABS
+          << "// appends the json to output, errors are reported on out_stream and leave output as it was\n"
+          << TABS << TABS << "bool write_data_to_string(std::string &output, std::ostream &out_stream) const;\n"
+          << "\n" << TABS << TABS
+          << "// appends the json to output, errors are reported on stderr\n"
+          << TABS << TABS << "bool write_data_to_string(std::string &output) const;\n"
+          << "\n" << TABS << TABS
+          << "// the json is written in blocks of at most 4096 chars so the memory used doesn't grow\n"
+          << TABS << TABS << "// with its size, errors are reported on out_stream or stderr and the blocks given\n"
+          << TABS << TABS << "// before an error are not taken back\n"
+          << TABS << TABS << "bool write_data_to_fd(int fd, std::ostream &out_stream) const;\n"
+          << TABS << TABS << "bool write_data_to_fd(int fd) const;\n"
+          << TABS << TABS << "bool write_data_to_file(FILE *file, std::ostream &out_stream) const;\n"
+          << TABS << TABS << "bool write_data_to_file(FILE *file) const;\n"
+          << TABS << TABS << "bool write_data_to_stream(std::ostream &output, std::ostream &out_stream) const;\n"
+          << TABS << TABS << "bool write_data_to_stream(std::ostream &output) const;\n"
+          << "\n" << TABS << TABS
+          << "// output gets every block and returns false to stop writing\n"
+          << TABS << TABS << "bool write_data_to_callback(const std::function<bool(const char *, std::size_t)> &output,\n"
+          << TABS << TABS << "                            std::ostream &out_stream) const;\n"
+          << TABS << TABS << "bool write_data_to_callback(const std::function<bool(const char *, std::size_t)> &output) const;\n"
+          << "#if !defined(_WIN32)\n"
           << "\n" << TABS << TABS
-          << "// writes the json into a string, errors are reported on stderr"
-          << TABS << TABS << "bool write_data_to_string(std::string &output) const;";
+          << "// appends the json to iov for writev, the long runs of the strings that need no escaping\n"
+          << TABS << TABS << "// point into this object and the rest of the text into scratch, neither must change while\n"
+          << TABS << TABS << "// iov is used. Errors are reported on out_stream and leave iov as it was\n"
+          << TABS << TABS
+          << "bool serialize_iov(std::vector<iovec> &iov, serialize_scratch &scratch, std::ostream &out_stream) const;\n"
+          << "\n" << TABS << TABS
+          << "// appends the json to iov for writev, errors are reported on stderr\n"
+          << TABS << TABS << "bool serialize_iov(std::vector<iovec> &iov, serialize_scratch &scratch) const;\n"
+          << "#endif\n";
 
           this->create_properties(jsonArrayIt, stream);
 
@@ -169,6 +324,7 @@ namespace umi {
           stream << "\n";
 
           this->set_private(stream);
+          this->create_friends(friends, stream);
           stream << TABS << TABS << "// Attributes declaration\n";
           auto classChildren = jsonArrayIt->getChildren();
           std::for_each(
@@ -181,438 +337,490 @@ namespace umi {
                 stream << TABS << TABS
                 << childrenIt->optional_name_type(localAdditionalString, true);
               }
+              stream << childrenIt->index_header_type(localAdditionalString, TABS, 2);
             }
           );
+          if (ff->string_view()) {
+            stream << TABS << TABS
+            << "// Buffer owned by read_data and read_data_from_file, the strings point into it,\n"
+            << TABS << TABS
+            << "// it is shared by the copies of this object, nested objects copied out do not keep it\n"
+            << TABS << TABS << "std::shared_ptr<std::vector<char>> umison_buffer;\n";
+          }
 
           stream << TABS << "};\n\n";
         }
       );
       stream << "}\n"; // For the umison namespace
-    }
-
-    template<typename stream_out>
-    void implement_type_declaration_writer_basic_types(
-        stream_out &stream, int indentation_level, const std::string &indentation) {
-      std::string indentation_base;
-      std::string indentation_base_1p;
-      std::string indentation_base_2p;
-      for (int i = 0; i < indentation_level; ++i) {
-        indentation_base += indentation;
+      if (ff->lazy_views()) {
+        create_views(ff, stream);
       }
-      indentation_base_1p = indentation_base + indentation;
-      indentation_base_2p = indentation_base_1p + indentation;
-      // int
-      stream << indentation_base
-             << "template<typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const int &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "char aux_array[512] = {};\n"
-             << indentation_base_1p
-             << "int aux_retval = snprintf(aux_array, sizeof(aux_array) - 1, \"%d\", arr);\n"
-             << indentation_base_1p
-             << "if (aux_retval < 0) {\n"
-             << indentation_base_2p
-             << "return false;\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "out_str += aux_array;\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
-      // long long int
-      stream << indentation_base
-             << "template<typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const long long int &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "char aux_array[512] = {};\n"
-             << indentation_base_1p
-             << "int aux_retval = snprintf(aux_array, sizeof(aux_array) - 1, \"%\"PRId64\"\", arr);\n"
-             << indentation_base_1p
-             << "if (aux_retval < 0) {\n"
-             << indentation_base_2p
-             << "return false;\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "out_str += aux_array;\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
-      // double
-      stream << indentation_base
-             << "template<typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const double &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "char aux_array[512] = {};\n"
-             << indentation_base_1p
-             << "int aux_retval = snprintf(aux_array, sizeof(aux_array) - 1, \"%f\", arr);\n"
-             << indentation_base_1p
-             << "if (aux_retval < 0) {\n"
-             << indentation_base_2p
-             << "return false;\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "out_str += aux_array;\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
-      // bool
-      stream << indentation_base
-             << "template<typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const bool &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "if (arr == true) {\n"
-             << indentation_base_2p
-             << "out_str += \"true\";\n"
-             << indentation_base_1p
-             << "} else {\n"
-             << indentation_base_2p
-             << "out_str += \"false\";\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
-      // std::string
-      stream << indentation_base
-             << "template<typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const std::string &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "out_str += \"\\\"\";\n"
-             << indentation_base_1p
-             << "out_str += arr;\n"
-             << indentation_base_1p
-             << "out_str += \"\\\"\";\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
     }
 
-    template<typename stream_out>
-    void forward_type_declaration_writer_custom_types(
-        std::shared_ptr<umi::umixml> &ff,
-        stream_out &stream,
-        int indentation_level,
-        const std::string &indentation) {
-      std::string indentation_base;
-      std::string indentation_base_1p;
-      std::string indentation_base_2p;
-      std::string additional_string;
-
-      if (!m_additional_string.empty()) {
-        additional_string += "::";
-        additional_string += m_additional_string;
-      }
-
-      for (int i = 0; i < indentation_level; ++i) {
-        indentation_base += indentation;
-      }
-      indentation_base_1p = indentation_base + indentation;
-      indentation_base_2p = indentation_base_1p + indentation;
-
-      for (auto &element : ff->getClassMap()) {
-        stream << indentation_base
-               << "template<typename Stream>\n"
-               << indentation_base
-               << "bool __write_type(const "
-               << "__internal__umison"
-               << additional_string
-               << "::"
-               << element.first
-               << " &arr, std::string &out_str, Stream &ss);\n";
+    /**
+     * Declares the enum classes of the enum members, one enumerator per value and the fallback
+     * */
+    void create_enums(std::shared_ptr<umi::umixml> &ff, streamer &stream) {
+      for (auto &enum_node: ff->getEnumArray()) {
+        auto enumerators = enum_node->enumerators();
+        stream << TABS << "// enum " << enum_node->name() << "\n"
+        << TABS << "enum class " << enum_node->name() << " : "
+        << (enumerators.size() <= 256 ? "unsigned char" : enumerators.size() <= 65536 ? "unsigned short" : "unsigned int")
+        << " {";
+        for (auto it = enumerators.begin(); it != enumerators.end(); ++it) {
+          stream << (it == enumerators.begin() ? "" : ", ") << *it;
+        }
+        stream << "};\n\n";
       }
     }
 
-    template<typename stream_out>
-    void implement_type_declaration_writer_custom_types(
-        std::shared_ptr<umi::umixml> &ff,
-        stream_out &stream,
-        int indentation_level,
-        const std::string &indentation) {
-      std::string indentation_base;
-      std::string indentation_base_1p;
-      std::string indentation_base_2p;
-      std::string additional_string;
-
-      if (!m_additional_string.empty()) {
-        additional_string += "::";
-        additional_string += m_additional_string;
-      }
-
-      for (int i = 0; i < indentation_level; ++i) {
-        indentation_base += indentation;
+    /**
+     * Type a lazy view keeps for one member, the classes are views too except the values of
+     * the maps, they are decoded with the map
+     *
+     * \param element member of the class
+     * \param additional string appended to the internal namespace
+     * */
+    static std::string view_type(const std::shared_ptr<umi::umixmltype> &element, const std::string &additional) {
+      type_to_cpp tcpp;
+      std::string ns("__internal__umison" + additional + "::");
+      std::string basic(tcpp.get_type(element->refclass()));
+      if (element->isEnum()) {
+        return ns + element->enum_type();
+      } else if (element->intern()) {
+        return ns + "umison_interned";
+      } else if (element->bounded()) {
+        return ns + "umison_inline_string<" + std::to_string(element->maxlen()) + ">";
+      } else if (element->variant()) {
+        return element->isList() ? "std::vector<" + ns + element->refclass() + ">" : ns + element->refclass();
+      } else if (element->isMap()) {
+        return "std::multimap<std::string, " + (basic.empty() ? ns + element->refclass() : basic) + ">";
+      } else if (element->isList()) {
+        return "std::vector<" + (basic.empty() ? ns + element->refclass() + "_view" : basic) + ">";
+      } else if (element->isRefClass()) {
+        return basic.empty() ? ns + element->refclass() + "_view" : basic;
+      } else if (element->isBoolean()) {
+        return tcpp.get_type(UMI_XMLTAGS_BOOLEAN);
+      } else if (element->isInteger32()) {
+        return tcpp.get_type(UMI_XMLTAGS_INTEGER32);
+      } else if (element->isInteger()) {
+        return tcpp.get_type(UMI_XMLTAGS_INTEGER);
+      } else if (element->isFloat()) {
+        return tcpp.get_type(UMI_XMLTAGS_FLOAT);
       }
-      indentation_base_1p = indentation_base + indentation;
-      indentation_base_2p = indentation_base_1p + indentation;
-
-      for (auto &element : ff->getClassMap()) {
-        stream << indentation_base
-               << "template<typename Stream>\n"
-               << indentation_base
-               << "bool __write_type(const "
-               << "__internal__umison"
-               << additional_string
-               << "::"
-               << element.first
-               << " &arr, std::string &out_str, Stream &ss) {\n";
-        stream << indentation_base_1p
-               << "out_str += \"{\";\n";
+      return tcpp.get_type(UMI_XMLTAGS_STRING);
+    }
 
-        for (auto &element_child : element.second->getChildren()) {
-          stream << indentation_base_1p
-                 << "if (!__write_type(\""
-                 << element_child->name()
-                 << "\", out_str, ss)) { return false; }\n"
-                 << indentation_base_1p
-                 << "out_str += \":\";\n"
-                 << indentation_base_1p
-                 << "if (!__write_type("
-                 << umi::umixmltype::attribute_prepocess(element_child->name())
-                 << ", out_str, ss)) { return false; }\n\n";
+    /**
+     * Declares the lazy views of the classes and of the jsons, the .cpp of the engine
+     * defines their methods
+     * */
+    void create_views(std::shared_ptr<umi::umixml> &ff, streamer &stream) {
+      stream << "\n// Lazy views, the members are decoded from the text when their getters are called\n";
+      auto &classMap = ff->getClassMap();
+      if (!classMap.empty()) {
+        stream << "namespace __internal__umison" << m_additional_string << " {\n\n";
+        for (auto &class_it: classMap) {
+          create_view(class_it.second, false, stream);
         }
-        stream << indentation_base_1p
-               << "out_str += \"}\";\n";
-        stream << indentation_base
-               << "}\n\n";
+        stream << "}\n\n";
       }
-
-    }
-
-    template<typename stream_out>
-    void implement_type_declaration_writer_list(
-        stream_out &stream, int indentation_level, const std::string &indentation) {
-      std::string indentation_base;
-      std::string indentation_base_1p;
-      std::string indentation_base_2p;
-      for (int i = 0; i < indentation_level; ++i) {
-        indentation_base += indentation;
+      stream << "namespace umison {\n\n";
+      for (auto &json: ff->getJsonArray()) {
+        create_view(json, true, stream);
       }
-      indentation_base_1p = indentation_base + indentation;
-      indentation_base_2p = indentation_base_1p + indentation;
-
-      stream << indentation_base
-             << "template<typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const std::vector<bool> &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "out_str += \"[\";\n"
-             << indentation_base_1p
-             << "std::size_t position;\n"
-             << indentation_base_1p
-             << "for (position = 0; position < arr.size(); ++position) { \n"
-             << indentation_base_2p
-             << "if (position > 0) { out_str += \",\"; }\n"
-             << indentation_base_2p
-             << "__write_type(static_cast<bool>(arr[position]), out_str, ss);\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "out_str += \"]\";\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
-      stream << indentation_base
-             << "template<typename Type, typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const std::vector<Type> &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "out_str += \"[\";\n"
-             << indentation_base_1p
-             << "std::size_t position;\n"
-             << indentation_base_1p
-             << "for (position = 0; position < arr.size(); ++position) { \n"
-             << indentation_base_2p
-             << "if (position > 0) { out_str += \",\"; }\n"
-             << indentation_base_2p
-             << "if (!__write_type(arr[position], out_str, ss)) { return false; }\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "out_str += \"]\";\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
+      stream << "}\n";
     }
 
-    template<typename stream_out>
-    void implement_type_declaration_writer_map(
-        stream_out &stream, int indentation_level, const std::string &indentation) {
-      std::string indentation_base;
-      std::string indentation_base_1p;
-      std::string indentation_base_2p;
-      for (int i = 0; i < indentation_level; ++i) {
-        indentation_base += indentation;
+    /**
+     * Declares the parser_context, the memory it keeps between reads is owned by
+     * an impl defined by the output engine on the .cpp
+     * */
+    void create_parser_context(std::shared_ptr<umi::umixml> &ff, streamer &stream) {
+      stream << TABS << "// Memory reused between reads of the jsons, the pools kept by the context never grow over\n"
+      << TABS << "// high_water_mark bytes so a rare huge document doesn't pin its memory. A context must not\n"
+      << TABS << "// be used by two threads at the same time\n"
+      << TABS << "struct parser_context {\n";
+      set_public(stream);
+      stream << TABS << TABS << "// Default constructor\n"
+      << TABS << TABS << "explicit parser_context(std::size_t high_water_mark = 1024 * 1024);\n\n"
+      << TABS << TABS << "// Destructor\n"
+      << TABS << TABS << "~parser_context();\n\n"
+      << TABS << TABS << "// errors reported by the last read\n"
+      << TABS << TABS << "std::string errors() const;\n\n"
+      << TABS << TABS << "// bytes kept between reads\n"
+      << TABS << TABS << "std::size_t capacity() const;\n\n"
+      << TABS << TABS << "// releases the memory kept between reads\n"
+      << TABS << TABS << "void shrink();\n\n";
+      set_private(stream);
+      stream << TABS << TABS << "parser_context(const parser_context &) = delete;\n"
+      << TABS << TABS << "parser_context &operator=(const parser_context &) = delete;\n\n";
+      for (auto &json: ff->getJsonArray()) {
+        stream << TABS << TABS << "friend struct " << json->name() << ";\n";
       }
-      indentation_base_1p = indentation_base + indentation;
-      indentation_base_2p = indentation_base_1p + indentation;
-      stream << indentation_base
-             << "template<typename Type, typename Stream>\n"
-             << indentation_base
-             << "bool __write_type(const std::map<std::string, Type> &arr, std::string &out_str, Stream &ss) {\n"
-             << indentation_base_1p
-             << "out_str += \"{\";\n"
-             << indentation_base_1p
-             << "std::size_t position;\n"
-             << indentation_base_1p
-             << "for (std::map<std::string, Type::const_iterator it = arr.begin(), position = 0; it != arr.end(); ++it, ++position) { \n"
-             << indentation_base_2p
-             << "if (position > 0) { out_str += \",\"; }\n"
-             << indentation_base_2p
-             << "if (!__write_type(it->first, out_str, ss)) { return false; }\n"
-             << indentation_base_2p
-             << "out_str += \":\";\n"
-             << indentation_base_2p
-             << "if (!__write_type(it->second, out_str, ss)) { return false; }\n"
-             << indentation_base_1p
-             << "}\n"
-             << indentation_base_1p
-             << "out_str += \"}\";\n"
-             << indentation_base_1p
-             << "return true;\n"
-             << indentation_base
-             << "}\n\n";
+      stream << "\n" << TABS << TABS << "struct impl;\n"
+      << TABS << TABS << "std::unique_ptr<impl> m_impl;\n"
+      << TABS << "};\n\n";
     }
-    template<typename stream_out>
-    void forward_type_declaration_writer(const std::string &type, stream_out &stream,
-                                         int indentation_level, const std::string &indentation) {
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
-      }
-      stream << "template<typename Stream>\n";
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
-      }
-      stream << "bool __write_type(const " << type << " &arr, std::string &out_str, Stream &ss);\n";
+
+    /**
+     * Declares the serialize_scratch, the memory for the text of serialize_iov that is
+     * not in the jsons
+     * */
+    void create_serialize_scratch(streamer &stream) {
+      stream << "#if !defined(_WIN32)\n"
+      << TABS << "// Memory for the text written by serialize_iov, it is kept after clear so the next\n"
+      << TABS << "// serialization reuses it\n"
+      << TABS << "struct serialize_scratch {\n";
+      set_public(stream);
+      stream << TABS << TABS << "// Default constructor\n"
+      << TABS << TABS << "explicit serialize_scratch(std::size_t block_size = 16384);\n\n"
+      << TABS << TABS << "// forgets the text given before, the pieces that point to it must not be used anymore\n"
+      << TABS << TABS << "void clear();\n\n"
+      << TABS << TABS << "// len bytes that stay in place until clear\n"
+      << TABS << TABS << "char *allocate(std::size_t len);\n\n"
+      << TABS << TABS << "// bytes kept\n"
+      << TABS << TABS << "std::size_t capacity() const;\n\n";
+      set_private(stream);
+      stream << TABS << TABS << "serialize_scratch(const serialize_scratch &) = delete;\n"
+      << TABS << TABS << "serialize_scratch &operator=(const serialize_scratch &) = delete;\n\n"
+      << TABS << TABS << "std::vector<std::vector<char>> m_blocks;\n"
+      << TABS << TABS << "std::size_t m_block;\n"
+      << TABS << TABS << "std::size_t m_used;\n"
+      << TABS << TABS << "std::size_t m_block_size;\n"
+      << TABS << "};\n"
+      << "#endif\n\n";
     }
 
-    template<typename stream_out>
-    void forward_list_declaration_writter(stream_out &stream, int indentation_level, const std::string &indentation) {
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
-      }
-      stream << "template<typename Stream>\n";
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
-      }
-      stream << "bool __write_type(const std::vector<bool> &arr, std::string &out_str, Stream &ss);\n";
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
+    /**
+     * Tells if a list of a class or json has an index
+     * */
+    static bool has_index(std::shared_ptr<umi::umixml> &ff) {
+      for (auto &class_it: ff->getClassMap()) {
+        for (auto &child: class_it.second->getChildren()) {
+          if (!child->index().empty()) {
+            return true;
+          }
+        }
       }
-      stream << "template<typename Type, typename Stream>\n";
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
+      for (auto &json: ff->getJsonArray()) {
+        for (auto &child: json->getChildren()) {
+          if (!child->index().empty()) {
+            return true;
+          }
+        }
       }
-      stream << "bool __write_type(const std::vector<Type> &arr, std::string &out_str, Stream &ss);\n";
+      return false;
     }
 
-    template<typename stream_out>
-    void forward_map_declaration_writter(stream_out &stream, int indentation_level, const std::string &indentation) {
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
-      }
-      stream << "template<typename Type, typename Stream>\n";
-      for (int i = 0; i < indentation_level; ++i) {
-        stream << indentation;
+    /**
+     * Declares the intern pool of the interned strings, shared by the whole process, and the
+     * handle the interned members hold, converted to the string views when they are used
+     * */
+    void create_intern_runtime(streamer &stream, bool string_view) {
+      stream << TABS << "// Handle of a string kept in the intern pool, the equal strings share one entry of the pool\n"
+      << TABS << "// so the handles are compared by address. The empty string has no entry\n"
+      << TABS << "class umison_interned {\n"
+      << TABS << "public:\n"
+      << TABS << TABS << "umison_interned() : m_entry(nullptr) {}\n\n"
+      << TABS << TABS << "explicit umison_interned(const std::string *entry) : m_entry(entry) {}\n\n"
+      << TABS << TABS << "const std::string &str() const {\n"
+      << TABS << TABS << TABS << "static const std::string empty;\n"
+      << TABS << TABS << TABS << "return m_entry != nullptr ? *m_entry : empty;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "operator const std::string &() const {\n"
+      << TABS << TABS << TABS << "return str();\n"
+      << TABS << TABS << "}\n\n";
+      if (string_view) {
+        stream << TABS << TABS << "operator std::string_view() const {\n"
+        << TABS << TABS << TABS << "return str();\n"
+        << TABS << TABS << "}\n\n";
       }
-      stream << "bool __write_type(const std::map<std::string, Type> &arr, std::string &out_str, Stream &ss);\n";
+      stream << TABS << TABS << "const char *data() const {\n"
+      << TABS << TABS << TABS << "return str().data();\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "std::size_t size() const {\n"
+      << TABS << TABS << TABS << "return m_entry != nullptr ? m_entry->size() : 0;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool empty() const {\n"
+      << TABS << TABS << TABS << "return m_entry == nullptr;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool operator==(const umison_interned &other) const {\n"
+      << TABS << TABS << TABS << "return m_entry == other.m_entry;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool operator!=(const umison_interned &other) const {\n"
+      << TABS << TABS << TABS << "return m_entry != other.m_entry;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "// the texts are compared with the string of the entry\n"
+      << TABS << TABS << "template<typename Text>\n"
+      << TABS << TABS << "bool operator==(const Text &text) const {\n"
+      << TABS << TABS << TABS << "return str() == text;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "template<typename Text>\n"
+      << TABS << TABS << "bool operator!=(const Text &text) const {\n"
+      << TABS << TABS << TABS << "return str() != text;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << "private:\n"
+      << TABS << TABS << "const std::string *m_entry;\n"
+      << TABS << "};\n\n"
+      << TABS << "// Table of a shard of the intern pool, open addressing with linear probing on the hash of\n"
+      << TABS << "// the text, the empty slots are nullptr\n"
+      << TABS << "struct umison_intern_table {\n"
+      << TABS << TABS << "explicit umison_intern_table(std::size_t capacity) :\n"
+      << TABS << TABS << TABS << "mask(capacity - 1), slots(new std::atomic<const std::string *>[capacity]()) {}\n\n"
+      << TABS << TABS << "std::size_t mask;\n"
+      << TABS << TABS << "std::unique_ptr<std::atomic<const std::string *>[]> slots;\n"
+      << TABS << "};\n\n"
+      << TABS << "// Shard of the intern pool, the lookups walk its table without the lock and the inserts\n"
+      << TABS << "// take it. The tables replaced when it grows are kept as a lookup may still walk them, the\n"
+      << TABS << "// strings are never removed so the handles stay valid until the process ends\n"
+      << TABS << "struct umison_intern_shard {\n"
+      << TABS << TABS << "std::mutex lock;\n"
+      << TABS << TABS << "std::atomic<umison_intern_table *> table{nullptr};\n"
+      << TABS << TABS << "std::vector<std::unique_ptr<umison_intern_table>> tables;\n"
+      << TABS << TABS << "std::deque<std::string> strings;\n"
+      << TABS << "};\n\n"
+      << TABS << "const int umison_intern_shards = 16;\n\n"
+      << TABS << "// FNV-1a of the text, the high bits choose the shard and the low bits the slot\n"
+      << TABS << "inline uint32_t umison_intern_hash(const char *text, std::size_t size) {\n"
+      << TABS << TABS << "uint32_t hash = 2166136261u;\n"
+      << TABS << TABS << "for (std::size_t i = 0; i < size; ++i) {\n"
+      << TABS << TABS << TABS << "hash ^= static_cast<unsigned char>(text[i]);\n"
+      << TABS << TABS << TABS << "hash *= 16777619u;\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "return hash ^ (hash >> 15);\n"
+      << TABS << "}\n\n"
+      << TABS << "// entry with the text, nullptr when the table has none\n"
+      << TABS << "inline const std::string *umison_intern_find(const umison_intern_table *table, const char *text,\n"
+      << TABS << "                                             std::size_t size, uint32_t hash) {\n"
+      << TABS << TABS << "if (table == nullptr) {\n"
+      << TABS << TABS << TABS << "return nullptr;\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "for (std::size_t i = hash & table->mask;; i = (i + 1) & table->mask) {\n"
+      << TABS << TABS << TABS << "const std::string *entry = table->slots[i].load(std::memory_order_acquire);\n"
+      << TABS << TABS << TABS << "if (entry == nullptr ||\n"
+      << TABS << TABS << TABS << TABS << "(entry->size() == size && std::memcmp(entry->data(), text, size) == 0)) {\n"
+      << TABS << TABS << TABS << TABS << "return entry;\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << "}\n"
+      << TABS << "}\n\n"
+      << TABS << "// publishes entry on the first empty slot, the lock of the shard is held\n"
+      << TABS << "inline void umison_intern_insert(umison_intern_table &table, const std::string *entry, uint32_t hash) {\n"
+      << TABS << TABS << "std::size_t i = hash & table.mask;\n"
+      << TABS << TABS << "while (table.slots[i].load(std::memory_order_relaxed) != nullptr) {\n"
+      << TABS << TABS << TABS << "i = (i + 1) & table.mask;\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "table.slots[i].store(entry, std::memory_order_release);\n"
+      << TABS << "}\n\n"
+      << TABS << "// Handle of the text in the pool shared by the whole process, it is added the first time\n"
+      << TABS << "inline umison_interned umison_intern(const char *text, std::size_t size) {\n"
+      << TABS << TABS << "if (size == 0) {\n"
+      << TABS << TABS << TABS << "return umison_interned();\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "static umison_intern_shard shards[umison_intern_shards];\n"
+      << TABS << TABS << "uint32_t hash = umison_intern_hash(text, size);\n"
+      << TABS << TABS << "umison_intern_shard &shard = shards[hash >> 28];\n"
+      << TABS << TABS << "umison_intern_table *table = shard.table.load(std::memory_order_acquire);\n"
+      << TABS << TABS << "const std::string *entry = umison_intern_find(table, text, size, hash);\n"
+      << TABS << TABS << "if (entry != nullptr) {\n"
+      << TABS << TABS << TABS << "return umison_interned(entry);\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "std::lock_guard<std::mutex> guard(shard.lock);\n"
+      << TABS << TABS << "table = shard.table.load(std::memory_order_relaxed);\n"
+      << TABS << TABS << "entry = umison_intern_find(table, text, size, hash);\n"
+      << TABS << TABS << "if (entry != nullptr) {\n"
+      << TABS << TABS << TABS << "return umison_interned(entry);\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "// the load stays under one half, the new table is filled before it is published\n"
+      << TABS << TABS << "if (table == nullptr || (shard.strings.size() + 1) * 2 > table->mask + 1) {\n"
+      << TABS << TABS << TABS << "std::size_t capacity = table == nullptr ? 64 : (table->mask + 1) * 2;\n"
+      << TABS << TABS << TABS << "std::unique_ptr<umison_intern_table> grown(new umison_intern_table(capacity));\n"
+      << TABS << TABS << TABS << "for (const std::string &moved : shard.strings) {\n"
+      << TABS << TABS << TABS << TABS << "umison_intern_insert(*grown, &moved, umison_intern_hash(moved.data(), moved.size()));\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "table = grown.get();\n"
+      << TABS << TABS << TABS << "shard.tables.push_back(std::move(grown));\n"
+      << TABS << TABS << TABS << "shard.table.store(table, std::memory_order_release);\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "shard.strings.emplace_back(text, size);\n"
+      << TABS << TABS << "entry = &shard.strings.back();\n"
+      << TABS << TABS << "umison_intern_insert(*table, entry, hash);\n"
+      << TABS << TABS << "return umison_interned(entry);\n"
+      << TABS << "}\n\n"
+      << TABS << "inline umison_interned umison_intern(const std::string &text) {\n"
+      << TABS << TABS << "return umison_intern(text.data(), text.size());\n"
+      << TABS << "}\n\n";
     }
 
-    template<typename stream_out>
-    void print_write_data_common_string(std::shared_ptr<umi::umixml> &ff, stream_out &stream) {
-      int actual_ind = 0;
-      std::vector<std::string> basic_types { "bool", "int" , "long long int", "double", "std::string" };
-      std::string additional_string;
-      std::string indentation;
-      std::string indentation_1p(indentation + TABS);
-
-      if (!m_additional_string.empty()) {
-        additional_string += "::";
-        additional_string += m_additional_string;
+    /**
+     * Declares the string with a maximum length the bounded members hold, its text is kept in
+     * the object so reading it doesn't allocate
+     * */
+    void create_inline_string_runtime(streamer &stream, bool string_view) {
+      stream << TABS << "// String of at most N characters kept inline, the text longer than N is rejected\n"
+      << TABS << "template<std::size_t N>\n"
+      << TABS << "class umison_inline_string {\n"
+      << TABS << "public:\n"
+      << TABS << TABS << "umison_inline_string() : m_data(), m_size(0) {}\n\n"
+      << TABS << TABS << "// false when the text is longer than N, the string is left as it was\n"
+      << TABS << TABS << "bool assign(const char *text, std::size_t size) {\n"
+      << TABS << TABS << TABS << "if (size > N) {\n"
+      << TABS << TABS << TABS << TABS << "return false;\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "if (size != 0) {\n"
+      << TABS << TABS << TABS << TABS << "std::memcpy(m_data, text, size);\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "m_size = static_cast<size_type>(size);\n"
+      << TABS << TABS << TABS << "return true;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "std::string str() const {\n"
+      << TABS << TABS << TABS << "return std::string(m_data, m_size);\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "operator std::string() const {\n"
+      << TABS << TABS << TABS << "return str();\n"
+      << TABS << TABS << "}\n\n";
+      if (string_view) {
+        stream << TABS << TABS << "operator std::string_view() const {\n"
+        << TABS << TABS << TABS << "return std::string_view(m_data, m_size);\n"
+        << TABS << TABS << "}\n\n";
       }
-
-      stream << "namespace __internal__umison" << additional_string << " {\n\n";
-      actual_ind += 1;
-      // Create forward declarations from basic types
-      stream << indentation_1p << "// Forward declaration of writing functions\n";
-      for(auto &ty : basic_types) {
-        forward_type_declaration_writer(ty, stream, actual_ind, TABS);
+      stream << TABS << TABS << "const char *data() const {\n"
+      << TABS << TABS << TABS << "return m_data;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "std::size_t size() const {\n"
+      << TABS << TABS << TABS << "return m_size;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool empty() const {\n"
+      << TABS << TABS << TABS << "return m_size == 0;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "static constexpr std::size_t capacity() {\n"
+      << TABS << TABS << TABS << "return N;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool equals(const char *text, std::size_t size) const {\n"
+      << TABS << TABS << TABS << "return size == m_size && (size == 0 || std::memcmp(m_data, text, size) == 0);\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool operator==(const umison_inline_string &other) const {\n"
+      << TABS << TABS << TABS << "return equals(other.m_data, other.m_size);\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool operator==(const std::string &text) const {\n"
+      << TABS << TABS << TABS << "return equals(text.data(), text.size());\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "bool operator==(const char *text) const {\n"
+      << TABS << TABS << TABS << "return equals(text, std::strlen(text));\n"
+      << TABS << TABS << "}\n\n";
+      if (string_view) {
+        stream << TABS << TABS << "bool operator==(std::string_view text) const {\n"
+        << TABS << TABS << TABS << "return equals(text.data(), text.size());\n"
+        << TABS << TABS << "}\n\n";
       }
-      forward_type_declaration_writer_custom_types(ff, stream, actual_ind, TABS);
-
-      forward_list_declaration_writter(stream, actual_ind, TABS);
-      forward_map_declaration_writter(stream, actual_ind, TABS);
-
-      stream << "\n";
-      implement_type_declaration_writer_basic_types(stream, actual_ind, TABS);
-      implement_type_declaration_writer_custom_types(ff, stream, actual_ind, TABS);
-      implement_type_declaration_writer_list(stream, actual_ind, TABS);
-      implement_type_declaration_writer_map(stream, actual_ind, TABS);
-
-      actual_ind -= 1;
-      // close namespace
-      stream << "}\n\n";
+      stream << TABS << TABS << "template<typename Text>\n"
+      << TABS << TABS << "bool operator!=(const Text &text) const {\n"
+      << TABS << TABS << TABS << "return !(*this == text);\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << "private:\n"
+      << TABS << TABS << "// the smallest integer holding N\n"
+      << TABS << TABS << "typedef typename std::conditional<(N < 256), uint8_t,\n"
+      << TABS << TABS << "    typename std::conditional<(N < 65536), uint16_t, std::size_t>::type>::type size_type;\n\n"
+      << TABS << TABS << "char m_data[N];\n"
+      << TABS << TABS << "size_type m_size;\n"
+      << TABS << "};\n\n";
     }
 
-    template<typename stream_out>
-    void print_write_data_on_string(std::shared_ptr<umi::umixml> &ff, stream_out &stream) {
-      int actual_ind = 0;
-      std::string additional_string;
-      std::string indentation;
-      std::string indentation_1p(indentation + TABS);
-
-      if (!m_additional_string.empty()) {
-        additional_string += "::";
-        additional_string += m_additional_string;
-      }
-
-      for (auto &json : ff->getJsonArray()) {
-        // bool write_data_to_string(std::string &output) const;
-        stream << indentation << "bool umison" << additional_string
-               << json->name()
-               << "::write_data_to_string(std::string &output) const {\n"
-               << indentation_1p << "return write_data_to_string(output, std::cerr);\n"
-               << indentation << "}\n\n";
-        // bool write_data_to_string(std::string &output, std::ostream &out_stream) const;
-        stream << indentation << "bool umison"  << additional_string
-               << json->name()
-               << "::write_data_to_string(std::string &output, std::ostream &out_stream) const {\n"
-               << indentation_1p << "char aux_array[512];\n";
-        actual_ind += 1;
-        if (json->getChildren().size() == 1) {
-
-        } else {
-          stream << indentation_1p << "output += \'{\';\n";
-
-          for (decltype(json->getChildren().size()) position = 0;
-               position < json->getChildren().size();
-              ++position) {
-            auto &child = json->getChildren()[position];
-            if (position > 0) {
-              stream << indentation_1p << "output << \",\";\n";
-            }
-            stream << child->write_to_string("output", true, TABS, actual_ind, "aux_array", 512, "out_stream");
-          }
-
-          stream << indentation_1p << "output += \'}\';\n";
-        }
-        actual_ind -= 1;
-        stream << indentation_1p << "return true;\n"
-               << indentation << "}\n";
-      }
+    /**
+     * Declares the index of the lists with an index attribute, an open addressing table of the
+     * positions of the elements. The engines fill it while the list is read and the find methods
+     * build it again when the list changed its size or storage since then
+     * */
+    void create_index_runtime(streamer &stream) {
+      stream << TABS << "// Index of a list by a member of its elements, open addressing with linear probing, the\n"
+      << TABS << "// slots keep the position of the element plus one, 0 when they are empty, and the hash of\n"
+      << TABS << "// its key. equal(position) tells if the element at position has the key looked for\n"
+      << TABS << "struct umison_index {\n"
+      << TABS << TABS << "struct slot {\n"
+      << TABS << TABS << TABS << "uint32_t position;\n"
+      << TABS << TABS << TABS << "uint32_t hash;\n"
+      << TABS << TABS << "};\n\n"
+      << TABS << TABS << "std::vector<slot> slots;\n"
+      << TABS << TABS << "std::size_t count = 0;\n"
+      << TABS << TABS << "// the index covers the whole list, the methods changing the list reset it\n"
+      << TABS << TABS << "bool valid = false;\n\n"
+      << TABS << TABS << "void clear() {\n"
+      << TABS << TABS << TABS << "slots.clear();\n"
+      << TABS << TABS << TABS << "count = 0;\n"
+      << TABS << TABS << TABS << "valid = false;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "void invalidate() {\n"
+      << TABS << TABS << TABS << "valid = false;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "// room for elements keys without growing, the load stays under one half\n"
+      << TABS << TABS << "void reserve(std::size_t elements) {\n"
+      << TABS << TABS << TABS << "std::size_t capacity = 16;\n"
+      << TABS << TABS << TABS << "while (capacity < elements * 2) {\n"
+      << TABS << TABS << TABS << TABS << "capacity *= 2;\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "if (capacity > slots.size()) {\n"
+      << TABS << TABS << TABS << TABS << "rehash(capacity);\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "// position plus one of the element with the key, 0 if there is none\n"
+      << TABS << TABS << "template<typename Equal>\n"
+      << TABS << TABS << "uint32_t find(uint32_t hash, Equal equal) const {\n"
+      << TABS << TABS << TABS << "if (slots.empty()) {\n"
+      << TABS << TABS << TABS << TABS << "return 0;\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "std::size_t mask = slots.size() - 1;\n"
+      << TABS << TABS << TABS << "for (std::size_t i = hash & mask; slots[i].position != 0; i = (i + 1) & mask) {\n"
+      << TABS << TABS << TABS << TABS << "if (slots[i].hash == hash && equal(slots[i].position - 1)) {\n"
+      << TABS << TABS << TABS << TABS << TABS << "return slots[i].position;\n"
+      << TABS << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "return 0;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "// adds the element at position, an element with the same key already there is kept\n"
+      << TABS << TABS << "template<typename Equal>\n"
+      << TABS << TABS << "void insert(uint32_t position, uint32_t hash, Equal equal) {\n"
+      << TABS << TABS << TABS << "if ((count + 1) * 2 > slots.size()) {\n"
+      << TABS << TABS << TABS << TABS << "rehash(slots.empty() ? 16 : slots.size() * 2);\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "std::size_t mask = slots.size() - 1;\n"
+      << TABS << TABS << TABS << "std::size_t i = hash & mask;\n"
+      << TABS << TABS << TABS << "for (; slots[i].position != 0; i = (i + 1) & mask) {\n"
+      << TABS << TABS << TABS << TABS << "if (slots[i].hash == hash && equal(slots[i].position - 1)) {\n"
+      << TABS << TABS << TABS << TABS << TABS << "return;\n"
+      << TABS << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "slots[i] = slot{position + 1, hash};\n"
+      << TABS << TABS << TABS << "++count;\n"
+      << TABS << TABS << "}\n\n"
+      << TABS << TABS << "// moves the slots to a table of capacity slots, a power of two, the hashes kept\n"
+      << TABS << TABS << "// spare reading the keys again\n"
+      << TABS << TABS << "void rehash(std::size_t capacity) {\n"
+      << TABS << TABS << TABS << "std::vector<slot> old(capacity, slot{0, 0});\n"
+      << TABS << TABS << TABS << "old.swap(slots);\n"
+      << TABS << TABS << TABS << "std::size_t mask = capacity - 1;\n"
+      << TABS << TABS << TABS << "for (const slot &moved : old) {\n"
+      << TABS << TABS << TABS << TABS << "if (moved.position != 0) {\n"
+      << TABS << TABS << TABS << TABS << TABS << "std::size_t i = moved.hash & mask;\n"
+      << TABS << TABS << TABS << TABS << TABS << "while (slots[i].position != 0) {\n"
+      << TABS << TABS << TABS << TABS << TABS << TABS << "i = (i + 1) & mask;\n"
+      << TABS << TABS << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << TABS << TABS << "slots[i] = moved;\n"
+      << TABS << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << TABS << "}\n"
+      << TABS << TABS << "}\n"
+      << TABS << "};\n\n"
+      << TABS << "// FNV-1a of the text of a key\n"
+      << TABS << "inline uint32_t umison_index_hash(const char *text, std::size_t size) {\n"
+      << TABS << TABS << "uint32_t hash = 2166136261u;\n"
+      << TABS << TABS << "for (std::size_t i = 0; i < size; ++i) {\n"
+      << TABS << TABS << TABS << "hash = (hash ^ static_cast<unsigned char>(text[i])) * 16777619u;\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "return hash;\n"
+      << TABS << "}\n\n"
+      << TABS << "// Fibonacci hash of an integer key, the high bits mix every bit of the key\n"
+      << TABS << "inline uint32_t umison_index_hash(long long int key) {\n"
+      << TABS << TABS << "return static_cast<uint32_t>((static_cast<unsigned long long int>(key) * 0x9E3779B97F4A7C15ull) >> 32);\n"
+      << TABS << "}\n\n";
     }
 
     /**
@@ -645,7 +853,115 @@ namespace umi {
 
     void create_destructors(const std::shared_ptr<umi::umixmltypeclass> &elem, streamer &stream) {
       stream << "\n" << TABS << TABS << "// Destructor\n"
-      << TABS << TABS << "virtual ~" << elem->name() << "() {}\n";
+      << TABS << TABS << "~" << elem->name() << "() = default;\n\n"
+      << TABS << TABS << "// Copy and move, moving never throws so the containers move the elements when they grow\n"
+      << TABS << TABS << elem->name() << "(const " << elem->name() << " &) = default;\n"
+      << TABS << TABS << elem->name() << "(" << elem->name() << " &&) noexcept = default;\n"
+      << TABS << TABS << elem->name() << " &operator=(const " << elem->name() << " &) = default;\n"
+      << TABS << TABS << elem->name() << " &operator=(" << elem->name() << " &&) noexcept = default;\n";
+    }
+
+    /**
+     * Defines the variants declared after position classes, a tagged union of the classes of its
+     * cases, umison_which tells the one alive
+     * */
+    void create_variants(std::shared_ptr<umi::umixml> &ff, std::size_t position, streamer &stream) {
+      for (auto &variant: ff->getVariantArray()) {
+        if (variant->position() != position) {
+          continue;
+        }
+        const std::string &name(variant->name());
+        auto &cases = variant->cases();
+        stream << TABS << "// struct " << name << ", one of its cases told apart by the member "
+        << variant->tag() << "\n"
+        << TABS << "struct " << name << " {\n";
+        set_public(stream);
+        stream << TABS << TABS << "// Cases, none until one is set\n"
+        << TABS << TABS << "enum class umison_case : unsigned char {\n"
+        << TABS << TABS << TABS << "none";
+        for (auto &variant_case: cases) {
+          stream << ",\n" << TABS << TABS << TABS << variant_case.refclass;
+        }
+        stream << "\n" << TABS << TABS << "};\n\n"
+        << TABS << TABS << "// Default constructor, holds no case\n"
+        << TABS << TABS << name << "() : umison_which(umison_case::none) {}\n\n"
+        << TABS << TABS << "// Destructor\n"
+        << TABS << TABS << "~" << name << "() {\n"
+        << TABS << TABS << TABS << "clear();\n"
+        << TABS << TABS << "}\n\n"
+        << TABS << TABS << "// Copy and move, moving never throws so the containers move the elements when they grow\n"
+        << TABS << TABS << name << "(const " << name << " &other) : umison_which(umison_case::none) {\n"
+        << TABS << TABS << TABS << "*this = other;\n"
+        << TABS << TABS << "}\n"
+        << TABS << TABS << name << "(" << name << " &&other) noexcept : umison_which(umison_case::none) {\n"
+        << TABS << TABS << TABS << "*this = std::move(other);\n"
+        << TABS << TABS << "}\n";
+        for (int moved = 0; moved < 2; ++moved) {
+          stream << TABS << TABS << name << " &operator=(" << (moved ? "" : "const ") << name
+          << (moved ? " &&other) noexcept {\n" : " &other) {\n")
+          << TABS << TABS << TABS << "if (this == &other) {\n"
+          << TABS << TABS << TABS << TABS << "return *this;\n"
+          << TABS << TABS << TABS << "}\n"
+          << TABS << TABS << TABS << "switch (other.umison_which) {\n";
+          for (auto &variant_case: cases) {
+            stream << TABS << TABS << TABS << "case umison_case::" << variant_case.refclass << ":\n"
+            << TABS << TABS << TABS << TABS << "mutable_" << variant_case.refclass << "() = "
+            << (moved ? "std::move(other.umison_" : "other.umison_") << variant_case.refclass
+            << (moved ? ");\n" : ";\n")
+            << TABS << TABS << TABS << TABS << "break;\n";
+          }
+          stream << TABS << TABS << TABS << "case umison_case::none:\n"
+          << TABS << TABS << TABS << TABS << "clear();\n"
+          << TABS << TABS << TABS << TABS << "break;\n"
+          << TABS << TABS << TABS << "}\n"
+          << TABS << TABS << TABS << "return *this;\n"
+          << TABS << TABS << "}\n";
+        }
+        stream << "\n" << TABS << TABS << "// Properties declaration\n"
+        << TABS << TABS << "inline umison_case which() const {\n"
+        << TABS << TABS << TABS << "return umison_which;\n"
+        << TABS << TABS << "}\n";
+        for (auto &variant_case: cases) {
+          const std::string &refclass(variant_case.refclass);
+          stream << TABS << TABS << "// case " << variant_case.value << ", nullptr when another case is held\n"
+          << TABS << TABS << "inline const " << refclass << " *get_" << refclass << "() const {\n"
+          << TABS << TABS << TABS << "return umison_which == umison_case::" << refclass << " ? &umison_" << refclass
+          << " : nullptr;\n"
+          << TABS << TABS << "}\n"
+          << TABS << TABS << "// case " << variant_case.value << ", the case held is destroyed when it is another one\n"
+          << TABS << TABS << "inline " << refclass << " &mutable_" << refclass << "() {\n"
+          << TABS << TABS << TABS << "if (umison_which != umison_case::" << refclass << ") {\n"
+          << TABS << TABS << TABS << TABS << "clear();\n"
+          << TABS << TABS << TABS << TABS << "new (&umison_" << refclass << ") " << refclass << "();\n"
+          << TABS << TABS << TABS << TABS << "umison_which = umison_case::" << refclass << ";\n"
+          << TABS << TABS << TABS << "}\n"
+          << TABS << TABS << TABS << "return umison_" << refclass << ";\n"
+          << TABS << TABS << "}\n";
+        }
+        stream << TABS << TABS << "// Destroys the case held\n"
+        << TABS << TABS << "inline void clear() {\n"
+        << TABS << TABS << TABS << "switch (umison_which) {\n";
+        for (auto &variant_case: cases) {
+          stream << TABS << TABS << TABS << "case umison_case::" << variant_case.refclass << ":\n"
+          << TABS << TABS << TABS << TABS << "umison_" << variant_case.refclass << ".~" << variant_case.refclass
+          << "();\n"
+          << TABS << TABS << TABS << TABS << "break;\n";
+        }
+        stream << TABS << TABS << TABS << "case umison_case::none:\n"
+        << TABS << TABS << TABS << TABS << "break;\n"
+        << TABS << TABS << TABS << "}\n"
+        << TABS << TABS << TABS << "umison_which = umison_case::none;\n"
+        << TABS << TABS << "}\n\n";
+        set_private(stream);
+        stream << TABS << TABS << "// Attributes declaration\n"
+        << TABS << TABS << "umison_case umison_which;\n"
+        << TABS << TABS << "union {\n";
+        for (auto &variant_case: cases) {
+          stream << TABS << TABS << TABS << variant_case.refclass << " umison_" << variant_case.refclass << ";\n";
+        }
+        stream << TABS << TABS << "};\n"
+        << TABS << "};\n\n";
+      }
     }
 
     void set_public(streamer &stream) {
@@ -656,6 +972,75 @@ namespace umi {
       stream << TABS << "private:\n";
     }
 
+    void create_view(const std::shared_ptr<umi::umixmltypeclass> &elem, bool json, streamer &stream) {
+      std::string name(elem->name() + "_view");
+      auto &children = elem->getChildren();
+      size_t words = std::max<size_t>((children.size() + 63) / 64, 1);
+      stream << TABS << "// struct " << name << "\n"
+      << TABS << "// " << elem->name() << " read from the text when its getters are called, each member is decoded\n"
+      << TABS << "// once and the members that can't be read keep their default values, materialize\n"
+      << TABS << "// reports them. The optional flags tell if the member is in the text. The text is shared\n"
+      << TABS << "// by the copies of the view and the views it returns, a view must not be used by two\n"
+      << TABS << "// threads at the same time\n"
+      << TABS << "struct " << name << " {\n";
+      set_public(stream);
+      stream << TABS << TABS << "// Default constructor, the view has no text\n"
+      << TABS << TABS << name << "();\n\n"
+      << TABS << TABS << "// view of the object at object, a position in text\n"
+      << TABS << TABS << name << "(std::shared_ptr<const std::string> text, const char *object);\n";
+      if (json) {
+        stream << "\n" << TABS << TABS
+        << "// keeps input_text, it must hold an object, errors are reported on out_stream\n"
+        << TABS << TABS << "bool read_data(std::string input_text, std::ostream &out_stream);\n"
+        << "\n" << TABS << TABS
+        << "// keeps input_text, it must hold an object, errors are reported on stderr\n"
+        << TABS << TABS << "bool read_data(std::string input_text);\n";
+      }
+      stream << "\n" << TABS << TABS
+      << "// decodes the whole object into out as read_data does, errors are reported on out_stream\n"
+      << TABS << TABS << "bool materialize(" << elem->name() << " &out, std::ostream &out_stream) const;\n"
+      << "\n" << TABS << TABS
+      << "// decodes the whole object into out, errors are reported on stderr\n"
+      << TABS << TABS << "bool materialize(" << elem->name() << " &out) const;\n"
+      << "\n" << TABS << TABS << "// Properties declaration\n";
+      for (auto &child: children) {
+        stream << TABS << TABS << "const " << view_type(child, m_additional_string) << " &get_" << child->name()
+        << "() const;\n";
+        if (child->optional()) {
+          stream << TABS << TABS << "bool get_" << child->optional_name() << "() const;\n";
+        }
+      }
+      stream << "\n";
+      set_private(stream);
+      stream << TABS << TABS << "// position of a member in the text, the object is walked up to it\n"
+      << TABS << TABS << "const char *umison_member(int index) const;\n\n"
+      << TABS << TABS << "std::shared_ptr<const std::string> umison_text;\n"
+      << TABS << TABS << "const char *umison_object;\n"
+      << TABS << TABS << "// where the walk of the object goes on, nullptr once it is over\n"
+      << TABS << TABS << "mutable const char *umison_scan;\n"
+      << TABS << TABS << "mutable const char *umison_members[" << std::max<size_t>(children.size(), 1) << "];\n"
+      << TABS << TABS << "mutable unsigned long long int umison_decoded[" << words << "];\n"
+      << TABS << TABS << "// Decoded members\n";
+      for (auto &child: children) {
+        stream << TABS << TABS << "mutable " << view_type(child, m_additional_string) << " "
+        << umi::umixmltype::attribute_prepocess(child->name()) << ";\n";
+      }
+      stream << TABS << "};\n\n";
+    }
+
+    void create_friends(const std::vector<std::string> &friends, streamer &stream) {
+      if (friends.empty()) {
+        return;
+      }
+      stream << TABS << TABS << "// Engine access to the attributes\n";
+      std::for_each(
+        friends.begin(),
+        friends.end(),
+        [&stream](const auto &name) {
+          stream << TABS << TABS << "friend struct " << name << ";\n";
+        });
+    }
+
     void create_properties(const std::shared_ptr<umi::umixmltypeclass> &elem, streamer &stream) {
       auto &localAdditionalString = m_additional_string;
       auto classChildren = elem->getChildren();
@@ -666,10 +1051,13 @@ namespace umi {
         [&stream, &localAdditionalString](const auto &child) {
           stream << child->getter_method(localAdditionalString, true, TABS, 2);
           stream << child->setter_method(localAdditionalString, true, TABS, 2);
+          stream << child->move_setter_method(localAdditionalString, true, TABS, 2);
+          stream << child->emplace_method(localAdditionalString, true, TABS, 2);
           stream << child->mutable_method(localAdditionalString, true, TABS, 2);
           stream << child->getter_method_optional(localAdditionalString, true, TABS, 2);
           stream << child->setter_method_optional(localAdditionalString, true, TABS, 2);
           stream << child->mutable_method_optional(localAdditionalString, true, TABS, 2);
+          stream << child->index_methods(localAdditionalString, TABS, 2);
           stream << "\n";
         });
 
@@ -40,5 +40,8 @@ namespace umi {
   template<typename T1, typename T2>
   class output_engine_rapid_json;
 
+  template<typename T1, typename T2>
+  class output_engine_rapid_json_sax;
+
 }
 #endif //UMISON_UMISONFORWARDDECLARATION_H
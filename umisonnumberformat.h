@@ -0,0 +1,398 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONNUMBERFORMAT_H
+#define UMISON_UMISONNUMBERFORMAT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Number formatting used by the generated writers instead of snprintf.
+   *
+   * The integers are written from a table of digit pairs once their length is known.
+   * The doubles use Grisu2 with the cached powers of ten of the table below, the digits
+   * are the shortest that read back to the same double except in a few cases where one
+   * more digit is written, the value never changes.
+   * */
+  class number_format {
+  public:
+    /**
+     * Prints the formatting functions, once per .cpp
+     * */
+    template<typename streamer>
+    static void print_runtime(streamer &out, const std::string &space, int level) {
+      std::string def_indentation;
+      for (int i = 0; i < level; ++i) {
+        def_indentation += space;
+      }
+      std::string def_1p_indentation(def_indentation + space);
+      std::string def_2p_indentation(def_1p_indentation + space);
+      std::string def_3p_indentation(def_2p_indentation + space);
+      std::string def_4p_indentation(def_3p_indentation + space);
+      out << def_indentation << "// Number formatting of the writers. The integers are written two digits at a time\n"
+      << def_indentation << "// from a table of pairs, the doubles with Grisu2 that gives the shortest digits that\n"
+      << def_indentation << "// read back to the same double in almost all the cases and never loses precision\n"
+      << def_indentation << "static const char umison_digit_pairs[201] =\n"
+      << def_1p_indentation << "\"00010203040506070809101112131415161718192021222324252627282930313233343536373839\"\n"
+      << def_1p_indentation << "\"40414243444546474849505152535455565758596061626364656667686970717273747576777879\"\n"
+      << def_1p_indentation << "\"8081828384858687888990919293949596979899\";\n"
+      << "\n"
+      << def_indentation << "inline int umison_count_digits(uint64_t value) {\n"
+      << def_1p_indentation << "int digits = 1;\n"
+      << def_1p_indentation << "for (;;) {\n"
+      << def_2p_indentation << "if (value < 10) {\n"
+      << def_3p_indentation << "return digits;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "if (value < 100) {\n"
+      << def_3p_indentation << "return digits + 1;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "if (value < 1000) {\n"
+      << def_3p_indentation << "return digits + 2;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "if (value < 10000) {\n"
+      << def_3p_indentation << "return digits + 3;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "value /= 10000;\n"
+      << def_2p_indentation << "digits += 4;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// writes value at buffer and returns the end, buffer needs 20 chars\n"
+      << def_indentation << "inline char *umison_u64toa(uint64_t value, char *buffer) {\n"
+      << def_1p_indentation << "char *end = buffer + umison_count_digits(value);\n"
+      << def_1p_indentation << "char *p = end;\n"
+      << def_1p_indentation << "while (value >= 100) {\n"
+      << def_2p_indentation << "const char *pair = umison_digit_pairs + (value % 100) * 2;\n"
+      << def_2p_indentation << "value /= 100;\n"
+      << def_2p_indentation << "*--p = pair[1];\n"
+      << def_2p_indentation << "*--p = pair[0];\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (value >= 10) {\n"
+      << def_2p_indentation << "const char *pair = umison_digit_pairs + value * 2;\n"
+      << def_2p_indentation << "*--p = pair[1];\n"
+      << def_2p_indentation << "*--p = pair[0];\n"
+      << def_1p_indentation << "} else {\n"
+      << def_2p_indentation << "*--p = static_cast<char>('0' + value);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return end;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// writes value at buffer and returns the end, buffer needs 21 chars\n"
+      << def_indentation << "inline char *umison_i64toa(int64_t value, char *buffer) {\n"
+      << def_1p_indentation << "uint64_t magnitude = static_cast<uint64_t>(value);\n"
+      << def_1p_indentation << "if (value < 0) {\n"
+      << def_2p_indentation << "*buffer++ = '-';\n"
+      << def_2p_indentation << "magnitude = 0 - magnitude;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return umison_u64toa(magnitude, buffer);\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Floating point with a 64 bits significand, value = f * 2^e\n"
+      << def_indentation << "struct umison_diy_fp {\n"
+      << def_1p_indentation << "uint64_t f;\n"
+      << def_1p_indentation << "int e;\n"
+      << def_indentation << "};\n"
+      << "\n"
+      << def_indentation << "inline umison_diy_fp umison_multiply(const umison_diy_fp &lhs, const umison_diy_fp &rhs) {\n"
+      << def_1p_indentation << "const uint64_t mask = 0xFFFFFFFFull;\n"
+      << def_1p_indentation << "uint64_t a = lhs.f >> 32;\n"
+      << def_1p_indentation << "uint64_t b = lhs.f & mask;\n"
+      << def_1p_indentation << "uint64_t c = rhs.f >> 32;\n"
+      << def_1p_indentation << "uint64_t d = rhs.f & mask;\n"
+      << def_1p_indentation << "uint64_t ac = a * c;\n"
+      << def_1p_indentation << "uint64_t bc = b * c;\n"
+      << def_1p_indentation << "uint64_t ad = a * d;\n"
+      << def_1p_indentation << "uint64_t bd = b * d;\n"
+      << def_1p_indentation << "uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask);\n"
+      << def_1p_indentation << "tmp += 1ull << 31;\n"
+      << def_1p_indentation << "umison_diy_fp retval = {ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), lhs.e + rhs.e + 64};\n"
+      << def_1p_indentation << "return retval;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "inline umison_diy_fp umison_normalize(umison_diy_fp value, int top_bit) {\n"
+      << def_1p_indentation << "while (!(value.f & (1ull << top_bit))) {\n"
+      << def_2p_indentation << "value.f <<= 1;\n"
+      << def_2p_indentation << "value.e--;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "value.f <<= 63 - top_bit;\n"
+      << def_1p_indentation << "value.e -= 63 - top_bit;\n"
+      << def_1p_indentation << "return value;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// 10^-k with k = -348 + 8 * i, normalized\n"
+      << def_indentation << "inline umison_diy_fp umison_cached_power(int e, int &k) {\n"
+      << def_1p_indentation << "static const uint64_t significands[] = {\n";
+      print_table(out, def_2p_indentation, cached_significands(), 3);
+      out << def_1p_indentation << "};\n"
+      << def_1p_indentation << "static const int16_t exponents[] = {\n";
+      print_table(out, def_2p_indentation, cached_exponents(), 12);
+      out << def_1p_indentation << "};\n"
+      << def_1p_indentation << "double dk = (-61 - e) * 0.30102999566398114 + 347;\n"
+      << def_1p_indentation << "int ik = static_cast<int>(dk);\n"
+      << def_1p_indentation << "if (dk - ik > 0.0) {\n"
+      << def_2p_indentation << "ik++;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "unsigned index = static_cast<unsigned>((ik >> 3) + 1);\n"
+      << def_1p_indentation << "k = -(-348 + static_cast<int>(index) * 8);\n"
+      << def_1p_indentation << "umison_diy_fp retval = {significands[index], exponents[index]};\n"
+      << def_1p_indentation << "return retval;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "inline void umison_grisu_round(char *buffer, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa,\n"
+      << def_4p_indentation << "               uint64_t wp_w) {\n"
+      << def_1p_indentation << "while (rest < wp_w && delta - rest >= ten_kappa &&\n"
+      << def_2p_indentation << "   (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {\n"
+      << def_2p_indentation << "buffer[len - 1]--;\n"
+      << def_2p_indentation << "rest += ten_kappa;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "inline void umison_digit_gen(const umison_diy_fp &w, const umison_diy_fp &mp, uint64_t delta, char *buffer,\n"
+      << def_4p_indentation << "             int &len, int &k) {\n"
+      << def_1p_indentation << "static const uint64_t pow10[] = {\n"
+      << def_2p_indentation << "1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,\n"
+      << def_2p_indentation << "1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,\n"
+      << def_2p_indentation << "100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,\n"
+      << def_2p_indentation << "1000000000000000000ull, 10000000000000000000ull\n"
+      << def_1p_indentation << "};\n"
+      << def_1p_indentation << "const int shift = -mp.e;\n"
+      << def_1p_indentation << "const uint64_t one = 1ull << shift;\n"
+      << def_1p_indentation << "const uint64_t wp_w = mp.f - w.f;\n"
+      << def_1p_indentation << "uint32_t p1 = static_cast<uint32_t>(mp.f >> shift);\n"
+      << def_1p_indentation << "uint64_t p2 = mp.f & (one - 1);\n"
+      << def_1p_indentation << "int kappa = umison_count_digits(p1);\n"
+      << def_1p_indentation << "len = 0;\n"
+      << def_1p_indentation << "while (kappa > 0) {\n"
+      << def_2p_indentation << "uint32_t d = static_cast<uint32_t>(p1 / pow10[kappa - 1]);\n"
+      << def_2p_indentation << "p1 = static_cast<uint32_t>(p1 % pow10[kappa - 1]);\n"
+      << def_2p_indentation << "if (d || len) {\n"
+      << def_3p_indentation << "buffer[len++] = static_cast<char>('0' + d);\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "kappa--;\n"
+      << def_2p_indentation << "uint64_t rest = (static_cast<uint64_t>(p1) << shift) + p2;\n"
+      << def_2p_indentation << "if (rest <= delta) {\n"
+      << def_3p_indentation << "k += kappa;\n"
+      << def_3p_indentation << "umison_grisu_round(buffer, len, delta, rest, pow10[kappa] << shift, wp_w);\n"
+      << def_3p_indentation << "return;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "for (;;) {\n"
+      << def_2p_indentation << "p2 *= 10;\n"
+      << def_2p_indentation << "delta *= 10;\n"
+      << def_2p_indentation << "char d = static_cast<char>(p2 >> shift);\n"
+      << def_2p_indentation << "if (d || len) {\n"
+      << def_3p_indentation << "buffer[len++] = static_cast<char>('0' + d);\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "p2 &= one - 1;\n"
+      << def_2p_indentation << "kappa--;\n"
+      << def_2p_indentation << "if (p2 < delta) {\n"
+      << def_3p_indentation << "k += kappa;\n"
+      << def_3p_indentation << "int index = -kappa;\n"
+      << def_3p_indentation << "umison_grisu_round(buffer, len, delta, p2, one, wp_w * (index < 20 ? pow10[index] : 0));\n"
+      << def_3p_indentation << "return;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "inline char *umison_write_exponent(int k, char *buffer) {\n"
+      << def_1p_indentation << "if (k < 0) {\n"
+      << def_2p_indentation << "*buffer++ = '-';\n"
+      << def_2p_indentation << "k = -k;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (k >= 100) {\n"
+      << def_2p_indentation << "*buffer++ = static_cast<char>('0' + k / 100);\n"
+      << def_2p_indentation << "k %= 100;\n"
+      << def_2p_indentation << "*buffer++ = umison_digit_pairs[k * 2];\n"
+      << def_2p_indentation << "*buffer++ = umison_digit_pairs[k * 2 + 1];\n"
+      << def_1p_indentation << "} else if (k >= 10) {\n"
+      << def_2p_indentation << "*buffer++ = umison_digit_pairs[k * 2];\n"
+      << def_2p_indentation << "*buffer++ = umison_digit_pairs[k * 2 + 1];\n"
+      << def_1p_indentation << "} else {\n"
+      << def_2p_indentation << "*buffer++ = static_cast<char>('0' + k);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return buffer;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// places the decimal point in the digits, value = digits * 10^k\n"
+      << def_indentation << "inline char *umison_prettify(char *buffer, int len, int k) {\n"
+      << def_1p_indentation << "const int kk = len + k;\n"
+      << def_1p_indentation << "if (k >= 0 && kk <= 21) {\n"
+      << def_2p_indentation << "// 1234e7 -> 12340000000.0\n"
+      << def_2p_indentation << "for (int i = len; i < kk; ++i) {\n"
+      << def_3p_indentation << "buffer[i] = '0';\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "buffer[kk] = '.';\n"
+      << def_2p_indentation << "buffer[kk + 1] = '0';\n"
+      << def_2p_indentation << "return buffer + kk + 2;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (kk > 0 && kk <= 21) {\n"
+      << def_2p_indentation << "// 1234e-2 -> 12.34\n"
+      << def_2p_indentation << "memmove(buffer + kk + 1, buffer + kk, static_cast<std::size_t>(len - kk));\n"
+      << def_2p_indentation << "buffer[kk] = '.';\n"
+      << def_2p_indentation << "return buffer + len + 1;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (kk > -6 && kk <= 0) {\n"
+      << def_2p_indentation << "// 1234e-6 -> 0.001234\n"
+      << def_2p_indentation << "const int offset = 2 - kk;\n"
+      << def_2p_indentation << "memmove(buffer + offset, buffer, static_cast<std::size_t>(len));\n"
+      << def_2p_indentation << "buffer[0] = '0';\n"
+      << def_2p_indentation << "buffer[1] = '.';\n"
+      << def_2p_indentation << "for (int i = 2; i < offset; ++i) {\n"
+      << def_3p_indentation << "buffer[i] = '0';\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return buffer + len + offset;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (len == 1) {\n"
+      << def_2p_indentation << "// 1e30\n"
+      << def_2p_indentation << "buffer[1] = 'e';\n"
+      << def_2p_indentation << "return umison_write_exponent(kk - 1, buffer + 2);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "// 1234e30 -> 1.234e33\n"
+      << def_1p_indentation << "memmove(buffer + 2, buffer + 1, static_cast<std::size_t>(len - 1));\n"
+      << def_1p_indentation << "buffer[1] = '.';\n"
+      << def_1p_indentation << "buffer[len + 1] = 'e';\n"
+      << def_1p_indentation << "return umison_write_exponent(kk - 1, buffer + len + 2);\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// writes a finite value at buffer and returns the end, buffer needs 25 chars\n"
+      << def_indentation << "inline char *umison_dtoa(double value, char *buffer) {\n"
+      << def_1p_indentation << "uint64_t bits;\n"
+      << def_1p_indentation << "memcpy(&bits, &value, sizeof(bits));\n"
+      << def_1p_indentation << "if (bits >> 63) {\n"
+      << def_2p_indentation << "*buffer++ = '-';\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "bits &= 0x7FFFFFFFFFFFFFFFull;\n"
+      << def_1p_indentation << "if (bits == 0) {\n"
+      << def_2p_indentation << "memcpy(buffer, \"0.0\", 3);\n"
+      << def_2p_indentation << "return buffer + 3;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "const uint64_t hidden = 1ull << 52;\n"
+      << def_1p_indentation << "const int biased_e = static_cast<int>(bits >> 52);\n"
+      << def_1p_indentation << "umison_diy_fp v = {bits & (hidden - 1), 1 - 1075};\n"
+      << def_1p_indentation << "if (biased_e != 0) {\n"
+      << def_2p_indentation << "v.f += hidden;\n"
+      << def_2p_indentation << "v.e = biased_e - 1075;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "// boundaries m- and m+ of the values that read back to value\n"
+      << def_1p_indentation << "umison_diy_fp plus = {(v.f << 1) + 1, v.e - 1};\n"
+      << def_1p_indentation << "plus = umison_normalize(plus, 53);\n"
+      << def_1p_indentation << "umison_diy_fp minus = {(v.f << 1) - 1, v.e - 1};\n"
+      << def_1p_indentation << "if (v.f == hidden) {\n"
+      << def_2p_indentation << "minus.f = (v.f << 2) - 1;\n"
+      << def_2p_indentation << "minus.e = v.e - 2;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "minus.f <<= minus.e - plus.e;\n"
+      << def_1p_indentation << "minus.e = plus.e;\n"
+      << def_1p_indentation << "int k = 0;\n"
+      << def_1p_indentation << "const umison_diy_fp cached = umison_cached_power(plus.e, k);\n"
+      << def_1p_indentation << "const umison_diy_fp w = umison_multiply(umison_normalize(v, 52), cached);\n"
+      << def_1p_indentation << "umison_diy_fp wp = umison_multiply(plus, cached);\n"
+      << def_1p_indentation << "umison_diy_fp wm = umison_multiply(minus, cached);\n"
+      << def_1p_indentation << "wm.f++;\n"
+      << def_1p_indentation << "wp.f--;\n"
+      << def_1p_indentation << "int len = 0;\n"
+      << def_1p_indentation << "umison_digit_gen(w, wp, wp.f - wm.f, buffer, len, k);\n"
+      << def_1p_indentation << "return umison_prettify(buffer, len, k);\n"
+      << def_indentation << "}\n";
+    }
+
+  protected:
+    template<typename streamer>
+    static void print_table(streamer &out, const std::string &def_indentation, const std::vector<std::string> &values,
+                            std::size_t per_line) {
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i % per_line == 0) {
+          out << def_indentation;
+        }
+        out << values[i];
+        if (i + 1 == values.size()) {
+          out << "\n";
+        } else if (i % per_line == per_line - 1) {
+          out << ",\n";
+        } else {
+          out << ", ";
+        }
+      }
+    }
+
+    /**
+     * Significands of 10^k normalized to 64 bits, k = -348 + 8 * i
+     * */
+    static std::vector<std::string> cached_significands() {
+      return {
+        "0xfa8fd5a0081c0288ull", "0xbaaee17fa23ebf76ull", "0x8b16fb203055ac76ull",
+        "0xcf42894a5dce35eaull", "0x9a6bb0aa55653b2dull", "0xe61acf033d1a45dfull",
+        "0xab70fe17c79ac6caull", "0xff77b1fcbebcdc4full", "0xbe5691ef416bd60cull",
+        "0x8dd01fad907ffc3cull", "0xd3515c2831559a83ull", "0x9d71ac8fada6c9b5ull",
+        "0xea9c227723ee8bcbull", "0xaecc49914078536dull", "0x823c12795db6ce57ull",
+        "0xc21094364dfb5637ull", "0x9096ea6f3848984full", "0xd77485cb25823ac7ull",
+        "0xa086cfcd97bf97f4ull", "0xef340a98172aace5ull", "0xb23867fb2a35b28eull",
+        "0x84c8d4dfd2c63f3bull", "0xc5dd44271ad3cdbaull", "0x936b9fcebb25c996ull",
+        "0xdbac6c247d62a584ull", "0xa3ab66580d5fdaf6ull", "0xf3e2f893dec3f126ull",
+        "0xb5b5ada8aaff80b8ull", "0x87625f056c7c4a8bull", "0xc9bcff6034c13053ull",
+        "0x964e858c91ba2655ull", "0xdff9772470297ebdull", "0xa6dfbd9fb8e5b88full",
+        "0xf8a95fcf88747d94ull", "0xb94470938fa89bcfull", "0x8a08f0f8bf0f156bull",
+        "0xcdb02555653131b6ull", "0x993fe2c6d07b7facull", "0xe45c10c42a2b3b06ull",
+        "0xaa242499697392d3ull", "0xfd87b5f28300ca0eull", "0xbce5086492111aebull",
+        "0x8cbccc096f5088ccull", "0xd1b71758e219652cull", "0x9c40000000000000ull",
+        "0xe8d4a51000000000ull", "0xad78ebc5ac620000ull", "0x813f3978f8940984ull",
+        "0xc097ce7bc90715b3ull", "0x8f7e32ce7bea5c70ull", "0xd5d238a4abe98068ull",
+        "0x9f4f2726179a2245ull", "0xed63a231d4c4fb27ull", "0xb0de65388cc8ada8ull",
+        "0x83c7088e1aab65dbull", "0xc45d1df942711d9aull", "0x924d692ca61be758ull",
+        "0xda01ee641a708deaull", "0xa26da3999aef774aull", "0xf209787bb47d6b85ull",
+        "0xb454e4a179dd1877ull", "0x865b86925b9bc5c2ull", "0xc83553c5c8965d3dull",
+        "0x952ab45cfa97a0b3ull", "0xde469fbd99a05fe3ull", "0xa59bc234db398c25ull",
+        "0xf6c69a72a3989f5cull", "0xb7dcbf5354e9beceull", "0x88fcf317f22241e2ull",
+        "0xcc20ce9bd35c78a5ull", "0x98165af37b2153dfull", "0xe2a0b5dc971f303aull",
+        "0xa8d9d1535ce3b396ull", "0xfb9b7cd9a4a7443cull", "0xbb764c4ca7a44410ull",
+        "0x8bab8eefb6409c1aull", "0xd01fef10a657842cull", "0x9b10a4e5e9913129ull",
+        "0xe7109bfba19c0c9dull", "0xac2820d9623bf429ull", "0x80444b5e7aa7cf85ull",
+        "0xbf21e44003acdd2dull", "0x8e679c2f5e44ff8full", "0xd433179d9c8cb841ull",
+        "0x9e19db92b4e31ba9ull", "0xeb96bf6ebadf77d9ull", "0xaf87023b9bf0ee6bull"
+      };
+    }
+
+    /**
+     * Binary exponents of cached_significands
+     * */
+    static std::vector<std::string> cached_exponents() {
+      return {
+        "-1220", "-1193", "-1166", "-1140", "-1113", "-1087", "-1060", "-1034", "-1007", "-980", "-954", "-927",
+        "-901", "-874", "-847", "-821", "-794", "-768", "-741", "-715", "-688", "-661", "-635", "-608",
+        "-582", "-555", "-529", "-502", "-475", "-449", "-422", "-396", "-369", "-343", "-316", "-289",
+        "-263", "-236", "-210", "-183", "-157", "-130", "-103", "-77", "-50", "-24", "3", "30",
+        "56", "83", "109", "136", "162", "189", "216", "242", "269", "295", "322", "348",
+        "375", "402", "428", "455", "481", "508", "534", "561", "588", "614", "641", "667",
+        "694", "720", "747", "774", "800", "827", "853", "880", "907", "933", "960", "986",
+        "1013", "1039", "1066"
+      };
+    }
+  };
+}
+
+#endif
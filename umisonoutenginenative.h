@@ -0,0 +1,2839 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONOUTENGINENATIVE_H
+#define UMISON_UMISONOUTENGINENATIVE_H
+
+#include "umisonoutenginerapidjson.h"
+#include "umisontypetocpp.h"
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Runtime shared by every parser created with the native engine, it is printed once
+   * in the internal namespace.
+   *
+   * The reader walks the text with one pointer, the generated parsers ask it for the
+   * value they expect and it answers false, without consuming anything, when the text
+   * holds a value of another type. Syntax errors are reported once and stop the read.
+   * */
+  static const char *native_runtime_code = R"umison(    // Deepest nesting of objects and arrays accepted by the reader
+    const int native_max_depth = 1024;
+
+    // Name of an object member, it points into the text or into the buffer of the reader
+    struct native_key {
+        const char *str;
+        std::size_t len;
+    };
+
+    // Number found in the text, it is converted once its type is known
+    struct native_number {
+        enum number_type {
+            int_value, uint_value, double_value
+        };
+        number_type type;
+        long long int i;
+        const char *end;
+    };
+
+    // Position of the reader, kept while a deferred member is read
+    struct native_position {
+        const char *p;
+        int depth;
+    };
+
+    inline bool native_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // Chars that end the part of a string that is copied as it is
+    inline bool native_string_stop(char c)
+    {
+        return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+    }
+
+    // Recursive descent reader over the chars from text to text_end, no terminator is needed
+    class native_reader {
+    public:
+        native_reader(const char *text, const char *text_end, std::ostream &ss) :
+            m_ss(ss), m_p(text), m_begin(text), m_end(text_end), m_depth(0), m_syntax_error(false)
+        {
+        }
+
+        std::ostream &out()
+        {
+            return m_ss;
+        }
+
+        int depth() const
+        {
+            return m_depth;
+        }
+
+        bool failed() const
+        {
+            return m_syntax_error;
+        }
+
+        // Skips the white space and returns the next char without consuming it
+        char peek()
+        {
+            const char *p = m_p;
+            while (at(p) == ' ' || at(p) == '\n' || at(p) == '\r' || at(p) == '\t') {
+                ++p;
+            }
+            m_p = p;
+            return at(p);
+        }
+
+        // Position of the next value, used to come back to it
+        const char *value()
+        {
+            peek();
+            return m_p;
+        }
+
+        // Reports a malformed text, only the first error is kept
+        bool fail(const char *error)
+        {
+            if (!m_syntax_error) {
+                m_syntax_error = true;
+                m_ss << __FILE__ << ":" << __LINE__ << " Error parsing input text. Error: " << error
+                     << " at offset " << (m_p - m_begin) << "\n";
+            }
+            return false;
+        }
+
+        // Opens an object or an array, false when the next value is something else
+        bool open(char bracket)
+        {
+            if (peek() != bracket) {
+                return false;
+            }
+            if (++m_depth > native_max_depth) {
+                return fail("document too deep");
+            }
+            ++m_p;
+            return true;
+        }
+
+        // First member of an object just opened, false when it is empty
+        bool first_key(native_key &key)
+        {
+            if (peek() == '}') {
+                close();
+                return false;
+            }
+            return read_key(key);
+        }
+
+        // Member after the last one read, false once the object is closed
+        bool next_key(native_key &key)
+        {
+            char c = peek();
+            if (c == ',') {
+                ++m_p;
+                return read_key(key);
+            }
+            if (c == '}') {
+                close();
+                return false;
+            }
+            return fail("missing comma or '}' after an object member");
+        }
+
+        // First element of an array just opened, false when it is empty
+        bool first_element()
+        {
+            if (peek() == ']') {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        // Element after the last one read, false once the array is closed
+        bool next_element()
+        {
+            char c = peek();
+            if (c == ',') {
+                ++m_p;
+                return true;
+            }
+            if (c == ']') {
+                close();
+                return false;
+            }
+            return fail("missing comma or ']' after an array element");
+        }
+
+        bool read_bool(bool &out)
+        {
+            char c = peek();
+            if (c == 't') {
+                out = true;
+                return literal("true");
+            }
+            if (c == 'f') {
+                out = false;
+                return literal("false");
+            }
+            return false;
+        }
+
+        bool read_int(int &out)
+        {
+            native_number n;
+            if (!number(n) || n.type != native_number::int_value || n.i < INT_MIN || n.i > INT_MAX) {
+                return false;
+            }
+            out = static_cast<int>(n.i);
+            m_p = n.end;
+            return true;
+        }
+
+        bool read_int64(long long int &out)
+        {
+            native_number n;
+            if (!number(n) || n.type != native_number::int_value) {
+                return false;
+            }
+            out = n.i;
+            m_p = n.end;
+            return true;
+        }
+
+        // Only numbers with a fraction, an exponent or too big for 64 bits are doubles
+        bool read_double(double &out)
+        {
+            native_number n;
+            if (!number(n) || n.type != native_number::double_value || !to_double(n, out)) {
+                return false;
+            }
+            m_p = n.end;
+            return true;
+        }
+
+        // Skips one value, it is checked as the rest of the text
+        bool skip()
+        {
+            switch (peek()) {
+                case '{':
+                    if (!open('{')) {
+                        return false;
+                    }
+                    if (peek() == '}') {
+                        close();
+                        return true;
+                    }
+                    for (;;) {
+                        if (peek() != '"') {
+                            return fail("missing name of an object member");
+                        }
+                        if (!skip_string()) {
+                            return false;
+                        }
+                        if (peek() != ':') {
+                            return fail("missing colon after an object member name");
+                        }
+                        ++m_p;
+                        if (!skip()) {
+                            return false;
+                        }
+                        char c = peek();
+                        if (c == '}') {
+                            close();
+                            return true;
+                        }
+                        if (c != ',') {
+                            return fail("missing comma or '}' after an object member");
+                        }
+                        ++m_p;
+                    }
+                case '[':
+                    if (!open('[')) {
+                        return false;
+                    }
+                    if (peek() == ']') {
+                        close();
+                        return true;
+                    }
+                    for (;;) {
+                        if (!skip()) {
+                            return false;
+                        }
+                        char c = peek();
+                        if (c == ']') {
+                            close();
+                            return true;
+                        }
+                        if (c != ',') {
+                            return fail("missing comma or ']' after an array element");
+                        }
+                        ++m_p;
+                    }
+                case '"':
+                    return skip_string();
+                case 't':
+                    return literal("true");
+                case 'f':
+                    return literal("false");
+                case 'n':
+                    return literal("null");
+                default: {
+                    native_number n;
+                    if (!number(n)) {
+                        return fail("invalid value");
+                    }
+                    m_p = n.end;
+                    return true;
+                }
+            }
+        }
+
+        // Checks a string without decoding it, the text is not modified
+        bool check_string()
+        {
+            return peek() == '"' && skip_string();
+        }
+
+        // Reads a string as a name, it points into the text when it has no escapes and into
+        // the buffer of the reader when they are decoded
+        bool read_name(native_key &name)
+        {
+            if (peek() != '"') {
+                return false;
+            }
+            const char *start = ++m_p;
+            const char *p = start;
+            while (!native_string_stop(at(p))) {
+                ++p;
+            }
+            m_p = p;
+            if (at(p) == '"') {
+                name.str = start;
+                name.len = static_cast<std::size_t>(p - start);
+                ++m_p;
+                return true;
+            }
+            m_key.assign(start, p);
+            if (!decode(m_key)) {
+                return false;
+            }
+            name.str = m_key.data();
+            name.len = m_key.size();
+            return true;
+        }
+
+        // Skips what is left of a value whose read failed, so the read goes on after it.
+        // start is where the value begins and level the depth it was found at
+        bool recover(const char *start, int level)
+        {
+            if (m_syntax_error) {
+                return false;
+            }
+            if (m_depth == level) {
+                // The value was not opened or it was closed before the error
+                return m_p == start ? skip() : true;
+            }
+            while (m_depth > level) {
+                char c = peek();
+                if (c == '}' || c == ']') {
+                    close();
+                } else if (c == ',' || c == ':') {
+                    ++m_p;
+                } else if (!skip()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Moves to a value found before, the position returned is restored once it is read
+        native_position seek(const char *value)
+        {
+            native_position position = {m_p, m_depth};
+            m_p = value;
+            return position;
+        }
+
+        void restore(const native_position &position)
+        {
+            m_p = position.p;
+            m_depth = position.depth;
+        }
+
+        // Only white space can follow the root
+        bool finish()
+        {
+            if (peek() != '\0' || m_p != m_end) {
+                return fail("the root is not the only value of the text");
+            }
+            return true;
+        }
+
+)umison";
+
+  /**
+   * Strings of the native engine read into std::string, the escapes are decoded in
+   * a copy as the text can't be modified
+   * */
+  static const char *native_string_code = R"umison(        bool read_string(std::string &out)
+        {
+            if (peek() != '"') {
+                return false;
+            }
+            const char *start = ++m_p;
+            const char *p = start;
+            while (!native_string_stop(at(p))) {
+                ++p;
+            }
+            m_p = p;
+            out.assign(start, p);
+            if (at(p) == '"') {
+                ++m_p;
+                return true;
+            }
+            return decode(out);
+        }
+
+)umison";
+
+  /**
+   * Strings of the native engine read into std::string_view, the text is writable in
+   * this mode so the escapes are decoded in place
+   * */
+  static const char *native_string_view_code = R"umison(        // The text of a string as it is in the json, its escapes are checked but not decoded so
+        // the text is not modified
+        bool read_string_raw(std::string_view &out)
+        {
+            const char *start = value() + 1;
+            if (!check_string()) {
+                return false;
+            }
+            out = std::string_view(start, static_cast<std::size_t>(m_p - 1 - start));
+            return true;
+        }
+
+        bool read_string(std::string_view &out)
+        {
+            if (peek() != '"') {
+                return false;
+            }
+            char *start = const_cast<char *>(++m_p);
+            const char *p = start;
+            while (!native_string_stop(at(p))) {
+                ++p;
+            }
+            m_p = p;
+            char *end = const_cast<char *>(p);
+            while (at(m_p) != '"') {
+                if (at(m_p) != '\\') {
+                    return fail(m_p == m_end ? "missing quotation mark" : "invalid char in string");
+                }
+                // The decoded chars are never longer than the escape
+                std::size_t len = unescape(end);
+                if (len == 0) {
+                    return false;
+                }
+                end += len;
+                const char *run = m_p;
+                p = run;
+                while (!native_string_stop(at(p))) {
+                    ++p;
+                }
+                m_p = p;
+                std::memmove(end, run, static_cast<std::size_t>(p - run));
+                end += p - run;
+            }
+            ++m_p;
+            out = std::string_view(start, static_cast<std::size_t>(end - start));
+            return true;
+        }
+
+)umison";
+
+  /**
+   * End of the reader of the native engine
+   * */
+  static const char *native_reader_end_code = R"umison(    protected:
+        // The char at p, the end of the text reads as a '\0' so the reader never goes past it
+        char at(const char *p) const
+        {
+            return p != m_end ? *p : '\0';
+        }
+
+        void close()
+        {
+            ++m_p;
+            --m_depth;
+        }
+
+        bool literal(const char *word)
+        {
+            const char *p = m_p;
+            for (; *word != '\0'; ++word, ++p) {
+                if (at(p) != *word) {
+                    return fail("invalid value");
+                }
+            }
+            m_p = p;
+            return true;
+        }
+
+        bool read_key(native_key &key)
+        {
+            if (peek() != '"') {
+                return fail("missing name of an object member");
+            }
+            if (!read_name(key)) {
+                return false;
+            }
+            if (peek() != ':') {
+                return fail("missing colon after an object member name");
+            }
+            ++m_p;
+            return true;
+        }
+
+        // Appends the rest of a string with escapes, the reader is on the char that stopped the copy
+        bool decode(std::string &out)
+        {
+            for (;;) {
+                if (at(m_p) == '"') {
+                    ++m_p;
+                    return true;
+                }
+                if (at(m_p) != '\\') {
+                    return fail(m_p == m_end ? "missing quotation mark" : "invalid char in string");
+                }
+                char buffer[4];
+                std::size_t len = unescape(buffer);
+                if (len == 0) {
+                    return false;
+                }
+                out.append(buffer, len);
+                const char *start = m_p;
+                const char *p = start;
+                while (!native_string_stop(at(p))) {
+                    ++p;
+                }
+                m_p = p;
+                out.append(start, p);
+            }
+        }
+
+        bool skip_string()
+        {
+            ++m_p;
+            for (;;) {
+                const char *p = m_p;
+                while (!native_string_stop(at(p))) {
+                    ++p;
+                }
+                m_p = p;
+                if (at(p) == '"') {
+                    ++m_p;
+                    return true;
+                }
+                if (at(p) != '\\') {
+                    return fail(p == m_end ? "missing quotation mark" : "invalid char in string");
+                }
+                char buffer[4];
+                if (unescape(buffer) == 0) {
+                    return false;
+                }
+            }
+        }
+
+        bool hex(unsigned int &code)
+        {
+            code = 0;
+            for (int i = 0; i < 4; ++i, ++m_p) {
+                char c = at(m_p);
+                code <<= 4;
+                if (c >= '0' && c <= '9') {
+                    code |= static_cast<unsigned int>(c - '0');
+                } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+                    code |= static_cast<unsigned int>((c | 0x20) - 'a' + 10);
+                } else {
+                    return fail("invalid unicode escape");
+                }
+            }
+            return true;
+        }
+
+        // Decodes the escape the reader is on into UTF-8, returns its length or 0 on error
+        std::size_t unescape(char *out)
+        {
+            char c = at(m_p + 1);
+            m_p += 2;
+            switch (c) {
+                case '"':
+                case '\\':
+                case '/':
+                    out[0] = c;
+                    return 1;
+                case 'b':
+                    out[0] = '\b';
+                    return 1;
+                case 'f':
+                    out[0] = '\f';
+                    return 1;
+                case 'n':
+                    out[0] = '\n';
+                    return 1;
+                case 'r':
+                    out[0] = '\r';
+                    return 1;
+                case 't':
+                    out[0] = '\t';
+                    return 1;
+                case 'u':
+                    break;
+                default:
+                    m_p -= 2;
+                    fail("invalid escape in string");
+                    return 0;
+            }
+            unsigned int code;
+            if (!hex(code)) {
+                return 0;
+            }
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                unsigned int low;
+                if (at(m_p) != '\\' || at(m_p + 1) != 'u') {
+                    fail("invalid unicode surrogate");
+                    return 0;
+                }
+                m_p += 2;
+                if (!hex(low)) {
+                    return 0;
+                }
+                if (low < 0xDC00 || low > 0xDFFF) {
+                    fail("invalid unicode surrogate");
+                    return 0;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            if (code < 0x80) {
+                out[0] = static_cast<char>(code);
+                return 1;
+            }
+            if (code < 0x800) {
+                out[0] = static_cast<char>(0xC0 | (code >> 6));
+                out[1] = static_cast<char>(0x80 | (code & 0x3F));
+                return 2;
+            }
+            if (code < 0x10000) {
+                out[0] = static_cast<char>(0xE0 | (code >> 12));
+                out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out[2] = static_cast<char>(0x80 | (code & 0x3F));
+                return 3;
+            }
+            out[0] = static_cast<char>(0xF0 | (code >> 18));
+            out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out[3] = static_cast<char>(0x80 | (code & 0x3F));
+            return 4;
+        }
+
+        // Scans the number the reader is on without consuming it, false when there is none
+        bool number(native_number &n)
+        {
+            const char *p = m_p;
+            if (at(p) != '-' && !native_digit(at(p))) {
+                peek();
+                p = m_p;
+                if (at(p) != '-' && !native_digit(at(p))) {
+                    return false;
+                }
+            }
+            bool minus = at(p) == '-';
+            if (minus) {
+                ++p;
+            }
+            if (!native_digit(at(p))) {
+                return fail("invalid value");
+            }
+            unsigned long long int u = 0;
+            bool is_double = false;
+            if (at(p) == '0') {
+                ++p;
+            } else {
+                for (; native_digit(at(p)); ++p) {
+                    unsigned int digit = static_cast<unsigned int>(at(p) - '0');
+                    if (u > (ULLONG_MAX - digit) / 10) {
+                        is_double = true;
+                    }
+                    u = u * 10 + digit;
+                }
+            }
+            if (at(p) == '.') {
+                ++p;
+                if (!native_digit(at(p))) {
+                    return fail("missing fraction of a number");
+                }
+                while (native_digit(at(p))) {
+                    ++p;
+                }
+                is_double = true;
+            }
+            if (at(p) == 'e' || at(p) == 'E') {
+                ++p;
+                if (at(p) == '+' || at(p) == '-') {
+                    ++p;
+                }
+                if (!native_digit(at(p))) {
+                    return fail("missing exponent of a number");
+                }
+                while (native_digit(at(p))) {
+                    ++p;
+                }
+                is_double = true;
+            }
+            n.end = p;
+            if (is_double) {
+                n.type = native_number::double_value;
+            } else if (minus) {
+                if (u > 9223372036854775808ULL) {
+                    n.type = native_number::double_value;
+                } else {
+                    n.type = native_number::int_value;
+                    n.i = static_cast<long long int>(0 - u);
+                }
+            } else if (u <= static_cast<unsigned long long int>(LLONG_MAX)) {
+                n.type = native_number::int_value;
+                n.i = static_cast<long long int>(u);
+            } else {
+                n.type = native_number::uint_value;
+            }
+            return true;
+        }
+
+        // Value of a double, the numbers with up to 15 digits and a power of ten up to 22 are
+        // exact with one operation, the rest are given to strtod as the number is valid for it
+        bool to_double(const native_number &n, double &out)
+        {
+            static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            const char *p = m_p;
+            bool minus = at(p) == '-';
+            if (minus) {
+                ++p;
+            }
+            unsigned long long int mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            for (; native_digit(at(p)); ++p) {
+                mantissa = mantissa * 10 + static_cast<unsigned int>(at(p) - '0');
+                digits += mantissa != 0;
+            }
+            if (at(p) == '.') {
+                for (++p; native_digit(at(p)); ++p) {
+                    mantissa = mantissa * 10 + static_cast<unsigned int>(at(p) - '0');
+                    digits += mantissa != 0;
+                    --exponent;
+                }
+            }
+            if (at(p) == 'e' || at(p) == 'E') {
+                ++p;
+                bool negative = at(p) == '-';
+                if (at(p) == '+' || at(p) == '-') {
+                    ++p;
+                }
+                int value = 0;
+                for (; native_digit(at(p)); ++p) {
+                    if (value < 100000) {
+                        value = value * 10 + (at(p) - '0');
+                    }
+                }
+                exponent += negative ? -value : value;
+            }
+            if (digits <= 15 && exponent >= -22 && exponent <= 22) {
+                double value = static_cast<double>(mantissa);
+                value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+                out = minus ? -value : value;
+                return true;
+            }
+            // strtod reads up to the first char that is not part of the number, a number that ends
+            // the text is copied so it is followed by a '\0'
+            out = n.end != m_end ? std::strtod(m_p, nullptr) : std::strtod(std::string(m_p, n.end).c_str(), nullptr);
+            if (std::isinf(out)) {
+                return fail("number too big to be stored in double");
+            }
+            return true;
+        }
+
+        std::ostream &m_ss;
+        const char *m_p;
+        const char *m_begin;
+        const char *m_end;
+        int m_depth;
+        bool m_syntax_error;
+        std::string m_key;
+    };
+
+)umison";
+
+  /**
+   * Checks of validate, the values are read into locals or skipped once checked, so nothing
+   * is stored. They fail where the readers of the lists and the maps fail
+   * */
+  static const char *native_validate_code = R"umison(    // Checks one value without storing it
+    typedef bool (*native_validator)(native_reader &r);
+
+    bool _native_validate_bool(native_reader &r)
+    {
+        bool value;
+        return r.read_bool(value);
+    }
+
+    bool _native_validate_int(native_reader &r)
+    {
+        int value;
+        return r.read_int(value);
+    }
+
+    bool _native_validate_int64(native_reader &r)
+    {
+        long long int value;
+        return r.read_int64(value);
+    }
+
+    bool _native_validate_double(native_reader &r)
+    {
+        double value;
+        return r.read_double(value);
+    }
+
+    bool _native_validate_string(native_reader &r)
+    {
+        return r.check_string();
+    }
+
+    bool _native_validate_list(native_reader &r, native_validator element)
+    {
+        if (!r.open('[')) {
+            r.out() << __FILE__ << ":" << __LINE__ << "Error data is not an array\n";
+            return false;
+        }
+        for (bool more = r.first_element(); more; more = r.next_element()) {
+            if (!element(r)) {
+                r.out() << __FILE__ << ":" << __LINE__ << " Error wrong element in an array\n";
+                return false;
+            }
+        }
+        return !r.failed();
+    }
+
+    bool _native_validate_map(native_reader &r, native_validator value)
+    {
+        if (!r.open('{')) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Element is not an object\n";
+            return false;
+        }
+        native_key key;
+        for (bool more = r.first_key(key); more; more = r.next_key(key)) {
+            if (!value(r)) {
+                r.out() << __FILE__ << ":" << __LINE__ << "Error wrong value in a map\n";
+                return false;
+            }
+        }
+        return !r.failed();
+    }
+
+    // The read drops the elements of a map of classes that can't be read and goes on
+    bool _native_validate_map_element(native_reader &r, native_validator value)
+    {
+        const char *start = r.value();
+        const int depth = r.depth();
+        if (!value(r)) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Error wrong object in a map\n";
+            return r.recover(start, depth);
+        }
+        return true;
+    }
+
+    // The values of a map of classes are objects or arrays of objects and the rest is ignored,
+    // only objects when objects is set
+    bool _native_validate_map_classes(native_reader &r, native_validator value, bool objects)
+    {
+        if (!r.open('{')) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Element is not an object\n";
+            return false;
+        }
+        native_key key;
+        for (bool more = r.first_key(key); more; more = r.next_key(key)) {
+            char c = r.peek();
+            if (c == '{') {
+                if (!_native_validate_map_element(r, value)) {
+                    return false;
+                }
+            } else if (objects) {
+                r.out() << __FILE__ << ":" << __LINE__ << " Error map value is not Object\n";
+                return false;
+            } else if (c == '[') {
+                if (!r.open('[')) {
+                    return false;
+                }
+                for (bool element = r.first_element(); element; element = r.next_element()) {
+                    if (!_native_validate_map_element(r, value)) {
+                        return false;
+                    }
+                }
+                if (r.failed()) {
+                    return false;
+                }
+            } else if (!r.skip()) {
+                return false;
+            }
+        }
+        return !r.failed();
+    }
+
+)umison";
+
+  /**
+   * Decoding of the members of the lazy views. The objects are walked only up to the member
+   * asked for, the values passed by are followed by their strings and brackets without being
+   * checked and the '\0' after the text stops every walk. The values asked for are read by the
+   * native reader, a value that can't be read is left with its default value.
+   * */
+  static const char *native_view_code = R"umison(    // Stream dropping the errors of the lazy views
+    inline std::ostream &native_view_errors()
+    {
+        static thread_local std::ostream errors(nullptr);
+        return errors;
+    }
+
+    inline const char *native_view_space(const char *p)
+    {
+        while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') {
+            ++p;
+        }
+        return p;
+    }
+
+    // Position after the string whose quote is at p
+    inline const char *native_view_string(const char *p)
+    {
+        for (++p;; p += 2) {
+            p += std::strcspn(p, "\"\\");
+            if (*p != '\\' || p[1] == '\0') {
+                return *p == '"' ? p + 1 : p;
+            }
+        }
+    }
+
+    // Position after the value at p, nothing but the strings and the brackets is looked at
+    inline const char *native_view_skip(const char *p)
+    {
+        int depth = 0;
+        do {
+            p += std::strcspn(p, depth == 0 ? "\"{}[], \n\r\t" : "\"{}[]");
+            switch (*p) {
+                case '"':
+                    p = native_view_string(p);
+                    break;
+                case '{':
+                case '[':
+                    ++depth;
+                    ++p;
+                    break;
+                case '}':
+                case ']':
+                    if (depth == 0) {
+                        return p;
+                    }
+                    --depth;
+                    ++p;
+                    break;
+                default:
+                    return p;
+            }
+        } while (depth > 0);
+        return p;
+    }
+
+    // Walks the member of an object after p, its value is kept in members when lookup knows its
+    // name and it is the first one with that name. Returns the colon of the member, the value is
+    // skipped by the next call so the member asked for is not walked twice, nullptr once the
+    // object is over
+    inline const char *native_view_next(const char *p, const char *end, int (*lookup)(const char *, std::size_t),
+                                        const char **members)
+    {
+        p = native_view_space(p);
+        if (*p == ':') {
+            p = native_view_space(native_view_skip(native_view_space(p + 1)));
+        }
+        if (*p == ',') {
+            p = native_view_space(p + 1);
+        }
+        if (*p != '"') {
+            return nullptr;
+        }
+        const char *name = p;
+        p = native_view_string(p);
+        if (p[-1] != '"' || p - name < 2) {
+            return nullptr;
+        }
+        int field;
+        if (std::memchr(name + 1, '\\', p - name - 2) == nullptr) {
+            field = lookup(name + 1, p - name - 2);
+        } else {
+            native_reader r(name, end, native_view_errors());
+            std::string decoded;
+            field = r.read_string(decoded) ? lookup(decoded.c_str(), decoded.size()) : -1;
+        }
+        p = native_view_space(p);
+        if (*p != ':') {
+            return nullptr;
+        }
+        if (field >= 0 && members[field] == nullptr) {
+            members[field] = native_view_space(p + 1);
+        }
+        return p;
+    }
+
+    inline bool native_view_read(native_reader &r, bool &out)
+    {
+        return r.read_bool(out);
+    }
+
+    inline bool native_view_read(native_reader &r, int &out)
+    {
+        return r.read_int(out);
+    }
+
+    inline bool native_view_read(native_reader &r, long long int &out)
+    {
+        return r.read_int64(out);
+    }
+
+    inline bool native_view_read(native_reader &r, double &out)
+    {
+        return r.read_double(out);
+    }
+
+    inline bool native_view_read(native_reader &r, std::string &out)
+    {
+        return r.read_string(out);
+    }
+
+    template<typename T>
+    bool native_view_read(native_reader &r, std::vector<T> &out)
+    {
+        if (!r.open('[')) {
+            return false;
+        }
+        for (bool more = r.first_element(); more; more = r.next_element()) {
+            T value;
+            if (!native_view_read(r, value)) {
+                return false;
+            }
+            out.push_back(std::move(value));
+        }
+        return !r.failed();
+    }
+
+    // Every object of the array at p becomes a view, the rest is passed by
+    template<typename T>
+    void native_view_list(const std::shared_ptr<const std::string> &text, const char *p, std::vector<T> &out)
+    {
+        if (*p != '[') {
+            return;
+        }
+        p = native_view_space(p + 1);
+        while (*p != ']' && *p != '\0') {
+            if (*p == '{') {
+                out.emplace_back(text, p);
+            }
+            const char *next = native_view_space(native_view_skip(p));
+            if (next == p) {
+                return;
+            }
+            p = *next == ',' ? native_view_space(next + 1) : next;
+        }
+    }
+
+)umison";
+
+  /**
+   * Native output engine, the .cpp file parses the text with a recursive descent reader
+   * specialized for the template, no rapidjson include is needed
+   *
+   * Every class gets one function reading its object, the members are found with the
+   * perfect hash of the class and each one is read with the type it is declared with, so
+   * the numbers go straight to long long int, int or double. Unknown members are skipped.
+   * Members under a condition are skipped too and read once the object has been closed,
+   * from the position they were found at.
+   * */
+  template<typename T1, typename T2>
+  class output_engine_native : public output_engine_rapid_json<T1, T2> {
+  public:
+    /**
+     * Constructor, internally will call the output_engine_rapid_json constructor
+     * */
+    output_engine_native(T1 &_H_streamer, T2 &_CPP_streamer)
+      : output_engine_rapid_json<T1, T2>(_H_streamer, _CPP_streamer) {
+    }
+
+    /**
+     * Releases the resources used by this engine
+     * */
+    virtual ~output_engine_native() {
+    }
+
+    /**
+     * The native engine has no custom interface, the .h doesn't include rapidjson
+     * */
+    virtual std::vector<std::string> additional_headers() const {
+      return std::vector<std::string>();
+    };
+
+    /**
+     * The native engine has no custom interface
+     * */
+    virtual std::vector<std::string> additional_methods() const {
+      return std::vector<std::string>();
+    }
+
+    /**
+     * The views are read with the native reader
+     * */
+    virtual bool lazy_views() const {
+      return true;
+    }
+  protected:
+    /**
+     * Element with its own parse function, a class or a json
+     * */
+    struct native_entity {
+      std::shared_ptr<umixmltypeclass> cls;
+      std::string prefix;
+      std::string type;
+      bool json;
+    };
+
+    /**
+     * Filter of a list of classes, the name of the parse function of its elements and the
+     * expression they are tested with
+     * */
+    struct native_filter {
+      std::string name;
+      std::string expression;
+    };
+
+    /**
+     * Method used to write the .cpp content to the cpp stream
+     *
+     * \param ff with the XML template already built
+     * */
+    virtual bool internal_write(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::vector<native_entity> entities;
+      for (auto &class_it: ff->getClassMap()) {
+        entities.push_back(native_entity{class_it.second, class_it.first, class_it.first, false});
+      }
+      for (auto &class_it: ff->getJsonArray()) {
+        entities.push_back(native_entity{class_it, class_it->name() + "__json", "umison::" + class_it->name(), true});
+      }
+      for (auto &entity: entities) {
+        auto &children = entity.cls->getChildren();
+        for (auto &child: children) {
+          if (child->isMap() && children.size() > 1) {
+            std::cerr << "Error: More than one element on the same level within a map\n";
+            exit(-1);
+          }
+        }
+      }
+
+      this->create_disclaimer();
+      create_includes();
+      // Create the internal namespace
+      streamer << "namespace __internal__umison" << output_engine<T1, T2>::m_additional_string << " {\n\n";
+      create_native_runtime();
+      create_native_forward_declarations(ff, entities);
+      this->create_index_builders(ff);
+      create_native_list_readers(ff);
+      create_native_map_readers(ff);
+      this->create_member_lookups(ff);
+      create_native_enum_readers(ff);
+      create_native_intern_reader(ff);
+      create_native_bounded_reader(ff);
+      create_native_validator_declarations(ff, entities);
+      create_native_filters(entities);
+      streamer << TABS << "// Data parsers\n";
+      for (auto &entity: entities) {
+        create_native_parse(entity);
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        create_native_variant_parse(variant, false);
+      }
+      create_native_streams(entities);
+      create_native_projections(ff, entities);
+      create_native_prefix_parsers(ff, entities);
+      create_native_validators(ff, entities);
+      if (ff->lazy_views()) {
+        streamer << native_view_code;
+        create_native_decoded_views(ff);
+      }
+      // Close the namespace
+      streamer << "}\n\n";
+      // Create the memory kept between reads
+      this->create_parser_context(std::vector<std::string>(), context_buffers());
+      this->create_index_finders(ff);
+      // Create the final parsers
+      streamer << "// Json parsers\n";
+      for (auto &entity: entities) {
+        if (!entity.json) {
+          continue;
+        }
+        this->create_default_method_read(entity.cls);
+        if (!output_engine<T1, T2>::m_string_view) {
+          create_native_read_data(entity, false, false);
+        }
+        streamer << "\n";
+        create_native_read_data(entity, true, false);
+        streamer << "\n";
+        create_native_read_data(entity, false, true);
+        streamer << "\n";
+        this->create_buffer_readers(entity.cls);
+        streamer << "\n";
+        create_native_validate(entity);
+        create_native_streaming_read_data(entity);
+        for (auto &projection: ff->getProjections()) {
+          if (projection->json() == entity.cls->name()) {
+            create_native_projection_read_data(entity, *projection);
+          }
+        }
+        if (entity.cls->read_prefix()) {
+          create_native_prefix_read_data(entity, nullptr);
+          for (auto &projection: ff->getProjections()) {
+            if (projection->json() == entity.cls->name()) {
+              create_native_prefix_read_data(entity, projection.get());
+            }
+          }
+        }
+      }
+      if (ff->lazy_views()) {
+        create_native_views(entities);
+      }
+      return true;
+    }
+
+    /**
+     * Create the include of the files in the .cpp file
+     * */
+    void create_includes() {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      if (!output_engine<T1, T2>::m_h_name.empty()) {
+        streamer << "#include \"" << output_engine<T1, T2>::m_h_name << "\"\n";
+      }
+      streamer << "#include <inttypes.h>\n"
+      << "#include <climits>\n"
+      << "#include <cmath>\n"
+      << "#include <cstddef>\n"
+      << "#include <cstdio>\n"
+      << "#include <cstdlib>\n"
+      << "#include <cstring>\n"
+      << "#include <iostream>\n"
+      << "#include <map>\n"
+      << "#include <memory>\n"
+      << "#include <sstream>\n"
+      << "#include <string>\n"
+      << "#include <tuple>\n"
+      << "#include <utility>\n"
+      << "#include <vector>\n";
+      writer_printer<T2>::print_includes(streamer);
+      streamer << "\n";
+    }
+
+    /**
+     * Class of the reader given to the parsers
+     * */
+    virtual std::string reader_class() const {
+      return "native_reader";
+    }
+
+    /**
+     * Type and name of the vectors kept by a parser_context between reads
+     * */
+    virtual std::vector<std::pair<std::string, std::string>> context_buffers() const {
+      std::vector<std::pair<std::string, std::string>> buffers;
+      if (output_engine<T1, T2>::m_string_view) {
+        buffers.emplace_back("char", "text");
+      }
+      return buffers;
+    }
+
+    /**
+     * Create the reader used by the parsers
+     * */
+    virtual void create_native_runtime() {
+      output_engine<T1, T2>::m_cpp_streamer << native_runtime_code
+      << (output_engine<T1, T2>::m_string_view ? native_string_view_code : native_string_code)
+      << native_reader_end_code;
+    }
+
+    /**
+     * C++ type of the values stored for a refclass/value attribute
+     * */
+    std::string native_value_type(const std::string &refclass) const {
+      type_to_cpp tcpp(output_engine<T1, T2>::m_string_view);
+      std::string retval = tcpp.get_type(refclass);
+      if (retval.empty()) {
+        retval = "__internal__umison" + output_engine<T1, T2>::m_additional_string + "::" + refclass;
+      }
+      return retval;
+    }
+
+    /**
+     * Method of the reader used for each basic type
+     * */
+    static std::string native_read(const std::string &refclass) {
+      if (refclass == UMI_XMLTAGS_BOOLEAN) {
+        return "read_bool";
+      } else if (refclass == UMI_XMLTAGS_INTEGER32) {
+        return "read_int";
+      } else if (refclass == UMI_XMLTAGS_INTEGER) {
+        return "read_int64";
+      } else if (refclass == UMI_XMLTAGS_FLOAT) {
+        return "read_double";
+      }
+      return "read_string";
+    }
+
+    /**
+     * Basic types supported on lists and maps
+     * */
+    static std::vector<std::string> native_basic_types() {
+      return std::vector<std::string>{UMI_XMLTAGS_INTEGER32, UMI_XMLTAGS_INTEGER, UMI_XMLTAGS_FLOAT,
+                                      UMI_XMLTAGS_BOOLEAN, UMI_XMLTAGS_STRING};
+    }
+
+    /**
+     * The entity is only a map, it is read by the map readers
+     * */
+    static bool is_map_entity(const native_entity &entity) {
+      auto &children = entity.cls->getChildren();
+      return children.size() == 1 && children[0]->isMap();
+    }
+
+    /**
+     * Create the forward declaration of the parse functions of the classes
+     * */
+    void create_native_forward_declarations(std::shared_ptr<umi::umixml> &ff,
+                                            const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      streamer << TABS << "// Forward declaration of parse functions\n";
+      for (auto &entity: entities) {
+        if (!entity.json) {
+          streamer << TABS << "bool " << entity.prefix << "__native_parse(" << reader_class() << " &r, " << entity.type
+          << " &inout);\n";
+        }
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << TABS << "bool " << variant->name() << "__native_parse(" << reader_class() << " &r, "
+        << variant->name() << " &inout);\n";
+      }
+      streamer << "\n";
+    }
+
+    /**
+     * Call reading the class of a case of a variant into object
+     * */
+    virtual std::string native_case_parse(const std::string &refclass, const std::string &object) const {
+      return refclass + "__native_parse(r, " + object + ")";
+    }
+
+    /**
+     * Create the parse function of one variant, or its validator. The object is walked up to
+     * its tag, the value is compared as written in the text, and read again from the start by
+     * the parser of the class of the case, so the tag first costs one member
+     * */
+    void create_native_variant_parse(const std::shared_ptr<umixmlvariant> &variant, bool validate) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      const std::string &name(variant->name());
+      const std::string &tag(variant->tag());
+      if (validate) {
+        streamer << def_indentation << "bool " << name << "__native_validate(native_reader &r)\n";
+      } else {
+        streamer << def_indentation << "bool " << name << "__native_parse(" << reader_class() << " &r, " << name
+        << " &inout)\n";
+      }
+      streamer << def_indentation << "{\n"
+      << def_1p_indentation << "if (r.peek() != '{') {\n"
+      << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << name
+      << " is not an object\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "native_position start = {r.value(), r.depth()};\n"
+      << def_1p_indentation << "const char *tag = nullptr;\n"
+      << def_1p_indentation << "if (!r.open('{')) {\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "native_key key;\n"
+      << def_1p_indentation << "for (bool more = r.first_key(key); more; more = r.next_key(key)) {\n"
+      << def_2p_indentation << "if (key.len == " << tag.size() << " && std::memcmp(key.str, \"" << tag << "\", "
+      << tag.size() << ") == 0 && r.peek() == '\"') {\n"
+      << def_3p_indentation << "tag = r.value();\n"
+      << def_3p_indentation << "break;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "if (!r.skip()) {\n"
+      << def_3p_indentation << "return false;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (tag == nullptr) {\n"
+      << def_2p_indentation << "if (!r.failed()) {\n"
+      << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << name
+      << " is missing its tag " << tag << "\\n\";\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "r.restore(start);\n";
+      for (auto &variant_case: variant->cases()) {
+        streamer << def_1p_indentation << "if (std::strncmp(tag, \"\\\"" << variant_case.value << "\\\"\", "
+        << variant_case.value.size() + 2 << ") == 0) {\n"
+        << def_2p_indentation << "return "
+        << (validate ? variant_case.refclass + "__native_validate(r)"
+                     : native_case_parse(variant_case.refclass, "inout.mutable_" + variant_case.refclass + "()"))
+        << ";\n"
+        << def_1p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << name
+      << " has an unknown " << tag << "\\n\";\n"
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the readers of the lazy views for the variants and the enums, they are decoded whole
+     * */
+    void create_native_decoded_views(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << TABS << "inline bool native_view_read(native_reader &r, " << variant->name() << " &out)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return " << variant->name() << "__native_parse(r, out);\n"
+        << TABS << "}\n\n";
+      }
+      for (auto &enum_node: ff->getEnumArray()) {
+        streamer << TABS << "inline bool native_view_read(native_reader &r, " << enum_node->name() << " &out)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return " << enum_node->name() << "__native_read(r, out);\n"
+        << TABS << "}\n\n";
+      }
+      if (ff->interned()) {
+        streamer << TABS << "inline bool native_view_read(native_reader &r, umison_interned &out)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return native_read_interned(r, out);\n"
+        << TABS << "}\n\n";
+      }
+      if (ff->bounded()) {
+        streamer << TABS << "template<std::size_t N>\n"
+        << TABS << "inline bool native_view_read(native_reader &r, umison_inline_string<N> &out)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return native_read_bounded(r, out);\n"
+        << TABS << "}\n\n";
+      }
+    }
+
+    /**
+     * Create the reader of the interned strings, the text is looked up in the intern pool as
+     * it is in the json, only the strings with escapes are decoded first
+     * */
+    void create_native_intern_reader(std::shared_ptr<umi::umixml> &ff) {
+      if (!ff->interned()) {
+        return;
+      }
+      output_engine<T1, T2>::m_cpp_streamer << TABS << "template<typename Reader>\n"
+      << TABS << "inline bool native_read_interned(Reader &r, umison_interned &value)\n"
+      << TABS << "{\n"
+      << TABS << TABS << "native_key text;\n"
+      << TABS << TABS << "if (!r.read_name(text)) {\n"
+      << TABS << TABS << TABS << "return false;\n"
+      << TABS << TABS << "}\n"
+      << TABS << TABS << "value = umison_intern(text.str, text.len);\n"
+      << TABS << TABS << "return true;\n"
+      << TABS << "}\n\n";
+    }
+
+    /**
+     * Create the reader of the strings with a maximum length, the text is copied into the
+     * object as it is in the json and the longer ones are rejected. Validate reads them into
+     * a local to check their length
+     * */
+    void create_native_bounded_reader(std::shared_ptr<umi::umixml> &ff) {
+      if (!ff->bounded()) {
+        return;
+      }
+      output_engine<T1, T2>::m_cpp_streamer << TABS << "template<typename Reader, std::size_t N>\n"
+      << TABS << "inline bool native_read_bounded(Reader &r, umison_inline_string<N> &value)\n"
+      << TABS << "{\n"
+      << TABS << TABS << "native_key text;\n"
+      << TABS << TABS << "return r.read_name(text) && value.assign(text.str, text.len);\n"
+      << TABS << "}\n\n"
+      << TABS << "template<std::size_t N, typename Reader>\n"
+      << TABS << "inline bool native_validate_bounded(Reader &r)\n"
+      << TABS << "{\n"
+      << TABS << TABS << "umison_inline_string<N> value;\n"
+      << TABS << TABS << "return native_read_bounded(r, value);\n"
+      << TABS << "}\n\n";
+    }
+
+    /**
+     * Create the readers of the enums, the value is read as a name and looked up, the reader
+     * is a template as the parsers of each engine use their own
+     * */
+    void create_native_enum_readers(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      for (auto &enum_node: ff->getEnumArray()) {
+        const std::string &name = enum_node->name();
+        streamer << TABS << "template<typename Reader>\n"
+        << TABS << "inline bool " << name << "__native_read(Reader &r, " << name << " &value)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "native_key name;\n"
+        << TABS << TABS << "return r.read_name(name) && " << name << "__enum(name.str, name.len, value);\n"
+        << TABS << "}\n\n"
+        << TABS << "inline bool " << name << "__native_validate(native_reader &r)\n"
+        << TABS << "{\n"
+        << TABS << TABS << name << " value;\n"
+        << TABS << TABS << "return " << name << "__native_read(r, value);\n"
+        << TABS << "}\n\n";
+      }
+    }
+
+    /**
+     * Writes the start of a list reader, opens the array and walks its elements
+     * */
+    void _native_list_start(T2 &streamer, const std::string &space, const std::string &function,
+                            const std::string &type, int level, const std::string &parameters = "",
+                            const std::string &before = "") {
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      std::string def_2p_indentation(def_1p_indentation + space);
+      streamer << def_indentation << "bool " << function << "(" << reader_class() << " &r, std::vector<" << type
+      << "> &str" << parameters << ")\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "if (!r.open('[')) {\n"
+      << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \"Error data is not an array\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << before
+      << def_1p_indentation << "for (bool more = r.first_element(); more; more = r.next_element()) {\n";
+    }
+
+    /**
+     * Writes the end of a list reader
+     * */
+    void _native_list_end(T2 &streamer, const std::string &space, int level, const std::string &after = "") {
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      streamer << def_1p_indentation << "}\n"
+      << after
+      << def_1p_indentation << "return !r.failed();\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the readers of the lists of basic types and classes
+     * */
+    void create_native_list_readers(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      std::string def_3p_indentation(build_indentation(TABS, 3));
+      streamer << TABS << "// Json type array readers implementation\n";
+      for (auto &basic: native_basic_types()) {
+        std::string type(native_value_type(basic));
+        _native_list_start(streamer, TABS, "_native_read_list", type, 1);
+        if (basic == UMI_XMLTAGS_STRING) {
+          streamer << def_2p_indentation << "str.emplace_back();\n"
+          << def_2p_indentation << "if (!r.read_string(str.back())) {\n";
+        } else {
+          streamer << def_2p_indentation << type << " value;\n"
+          << def_2p_indentation << "if (!r." << native_read(basic) << "(value)) {\n";
+        }
+        streamer << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \"Error data is not an "
+        << internal_to_rapidjson(basic) << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n";
+        if (basic != UMI_XMLTAGS_STRING) {
+          streamer << def_2p_indentation << "str.push_back(value);\n";
+        }
+        _native_list_end(streamer, TABS, 1);
+      }
+      for (auto &class_it: ff->getClassMap()) {
+        create_native_class_list_reader(class_it.first, nullptr);
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        create_native_class_list_reader(variant->name(), nullptr);
+      }
+      streamer << "\n";
+    }
+
+    /**
+     * Create the reader of the lists of one class, projection gives the members read of the elements
+     * */
+    void create_native_class_list_reader(const std::string &class_name, const umixmlprojection *projection) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      std::string def_3p_indentation(build_indentation(TABS, 3));
+      _native_list_start(streamer, TABS, "_native_read_list" + (projection != nullptr ? "__" + projection->name() : ""),
+                         native_value_type(class_name), 1);
+      streamer << def_2p_indentation << "str.emplace_back();\n"
+      << def_2p_indentation << "if (!" << native_parse_name(class_name, projection) << "(r, str.back())) {\n"
+      << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+      << class_name << "\\n\";\n"
+      << def_3p_indentation << "return false;\n"
+      << def_2p_indentation << "}\n";
+      _native_list_end(streamer, TABS, 1);
+    }
+
+    /**
+     * Name of the reader of a list with a filter or an index, owner is the class or json of the list
+     * */
+    static std::string native_filter_list(const std::string &owner, const std::shared_ptr<umixmltype> &element) {
+      return "_native_read_list__" + owner + "__" + element->name();
+    }
+
+    /**
+     * Tells if a list is read by a reader of its own, the lists with a filter or an index
+     * */
+    static bool native_own_list(const std::shared_ptr<umixmltype> &element) {
+      return element->isList() && (!element->filter().empty() || !element->index().empty());
+    }
+
+    /**
+     * Create the readers of the lists with a filter or an index and the parsers of the elements
+     * of the filtered ones. The members the filter and the conditions don't use that allocate,
+     * strings, classes, lists and maps, are kept aside and only read once the filter accepts the
+     * element. The elements kept are added to the index as soon as they are read
+     * */
+    void create_native_filters(const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string def_2p_indentation(build_indentation(TABS, 3));
+      std::string def_3p_indentation(build_indentation(TABS, 4));
+      std::vector<std::pair<std::string, std::shared_ptr<umixmltype>>> lists;
+      for (auto &entity: entities) {
+        for (auto &child: entity.cls->getChildren()) {
+          if (native_own_list(child)) {
+            lists.emplace_back(entity.cls->name(), child);
+          }
+        }
+      }
+      if (lists.empty()) {
+        return;
+      }
+      streamer << TABS << "// Lists with a filter or an index\n";
+      for (auto &list: lists) {
+        std::string function(native_filter_list(list.first, list.second));
+        if (!list.second->filter().empty()) {
+          streamer << TABS << "bool " << function << "__native_parse(" << reader_class() << " &r, "
+          << list.second->refclass() << " &inout, bool &accepted);\n";
+        }
+        streamer << TABS << "bool " << function << "(" << reader_class() << " &r, std::vector<" << list.second->refclass()
+        << "> &str" << (list.second->index().empty() ? "" : ", umison_index &index") << ");\n";
+      }
+      streamer << "\n";
+      for (auto &list: lists) {
+        auto &element = list.second;
+        std::string function(native_filter_list(list.first, element));
+        bool filtered = !element->filter().empty();
+        bool indexed = !element->index().empty();
+        if (indexed) {
+          _native_list_start(streamer, TABS, function, element->refclass(), 1, ", umison_index &index",
+                             def_1p_indentation + "// The index covers the list only when it was empty before, "
+                             + "otherwise find builds it again\n"
+                             + def_1p_indentation + "const std::size_t first = str.size();\n"
+                             + def_1p_indentation + "index.clear();\n");
+        } else {
+          _native_list_start(streamer, TABS, function, element->refclass(), 1);
+        }
+        streamer << def_2p_indentation << "str.emplace_back();\n";
+        if (filtered) {
+          streamer << def_2p_indentation << "bool accepted = true;\n"
+          << def_2p_indentation << "if (!" << function << "__native_parse(r, str.back(), accepted)) {\n";
+        } else {
+          streamer << def_2p_indentation << "if (!" << native_parse_name(element->refclass(), nullptr)
+          << "(r, str.back())) {\n";
+        }
+        streamer << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << element->refclass() << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n";
+        if (filtered) {
+          streamer << def_2p_indentation << "if (!accepted) {\n"
+          << def_3p_indentation << "str.pop_back();\n"
+          << (indexed ? def_3p_indentation + "continue;\n" : "")
+          << def_2p_indentation << "}\n";
+        }
+        if (indexed) {
+          streamer << def_2p_indentation << this->index_insert_name(element) << "(str, str.size() - 1, index);\n";
+          _native_list_end(streamer, TABS, 1,
+                           def_1p_indentation + "if (first == 0) {\n"
+                           + def_2p_indentation + "index.valid = true;\n"
+                           + def_1p_indentation + "}\n");
+        } else {
+          _native_list_end(streamer, TABS, 1);
+        }
+        if (!filtered) {
+          continue;
+        }
+        for (auto &entity: entities) {
+          if (!entity.json && entity.prefix == element->refclass()) {
+            native_filter filter{function + "__native_parse", element->filter()};
+            create_native_parse(entity, nullptr, false, &filter);
+          }
+        }
+      }
+    }
+
+    /**
+     * Create the parsers of the projections, the classes they read partially get a parse function
+     * and a list reader of their own, named after the projection
+     * */
+    virtual void create_native_projections(std::shared_ptr<umi::umixml> &ff, const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      for (auto &projection: ff->getProjections()) {
+        streamer << TABS << "// Parsers of the projection " << projection->name() << "\n";
+        for (auto &entity: entities) {
+          if (!entity.json && projection->partial(entity.cls->name())) {
+            streamer << TABS << "bool " << native_parse_name(entity.prefix, projection.get()) << "(" << reader_class()
+            << " &r, " << entity.type << " &inout);\n";
+          }
+        }
+        streamer << "\n";
+        for (auto &entity: entities) {
+          if (!entity.json && projection->partial(entity.cls->name())) {
+            create_native_class_list_reader(entity.cls->name(), projection.get());
+          }
+        }
+        for (auto &entity: entities) {
+          if (entity.json ? entity.cls->name() == projection->json() : projection->partial(entity.cls->name())) {
+            create_native_parse(entity, projection.get());
+          }
+        }
+      }
+    }
+
+    /**
+     * Create the parsers of read_data_prefix, the ones of the jsons that have it and of their
+     * projections
+     * */
+    virtual void create_native_prefix_parsers(std::shared_ptr<umi::umixml> &ff,
+                                              const std::vector<native_entity> &entities) {
+      for (auto &entity: entities) {
+        if (!entity.json || !entity.cls->read_prefix()) {
+          continue;
+        }
+        output_engine<T1, T2>::m_cpp_streamer << TABS << "// Parsers of read_data_prefix of " << entity.cls->name()
+        << "\n";
+        create_native_parse(entity, nullptr, true);
+        for (auto &projection: ff->getProjections()) {
+          if (projection->json() == entity.cls->name()) {
+            create_native_parse(entity, projection.get(), true);
+          }
+        }
+      }
+    }
+
+    /**
+     * Create the read_data_prefix methods of one json, or read_data_<projection>_prefix, they
+     * return once the parser stops and only check the end of the text when it did not
+     * */
+    void create_native_prefix_read_data(const native_entity &entity, const umixmlprojection *projection) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      std::string name("read_data_" + (projection != nullptr ? projection->name() + "_" : std::string()) + "prefix");
+      std::string method("umison::" + entity.cls->name() + "::" + name);
+      std::string text(output_engine<T1, T2>::m_string_view ? "&(*_buffer)[0]" : "input_text.c_str()");
+      streamer << "std::size_t " << method << "(const std::string &input_text, bool &validated)\n"
+      << "{\n"
+      << def_1p_indentation << "return this->" << name << "(input_text, validated, std::cerr);\n"
+      << "}\n\n"
+      << "std::size_t " << method << "(const std::string &input_text, bool &validated, std::ostream &ss)\n"
+      << "{\n"
+      << def_1p_indentation << "validated = false;\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        // The strings point into a copy of the text kept by the object, as read_data does
+        streamer << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+        << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "*this = " << entity.cls->name() << "();\n";
+      }
+      create_native_reader(text, "input_text.size()", false);
+      streamer << def_1p_indentation << "bool _stopped = false;\n"
+      << def_1p_indentation << "if (!__internal__umison" << output_engine<T1, T2>::m_additional_string << "::"
+      << native_parse_name(entity.prefix, projection, true) << "(_reader, *this, _stopped)) {\n"
+      << def_2p_indentation << "return 0;\n"
+      << def_1p_indentation << "}\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        streamer << def_1p_indentation << "umison_buffer = _buffer;\n";
+      }
+      streamer << def_1p_indentation << "if (_stopped) {\n"
+      << def_2p_indentation << "return static_cast<std::size_t>(_reader.value() - " << text << ");\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (!_reader.finish()) {\n"
+      << def_2p_indentation << "return 0;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "validated = true;\n"
+      << def_1p_indentation << "return input_text.size();\n"
+      << "}\n\n";
+    }
+
+    /**
+     * Create the read_data_<projection> methods of one json, they read as read_data does with the
+     * parser of the projection
+     * */
+    void create_native_projection_read_data(const native_entity &entity, const umixmlprojection &projection) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      std::string method("umison::" + entity.cls->name() + "::read_data_" + projection.name());
+      std::string parse("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::"
+                        + native_parse_name(entity.prefix, &projection) + "(_reader, *this) && _reader.finish()");
+      streamer << "bool " << method << "(const std::string &input_text)\n"
+      << "{\n"
+      << def_1p_indentation << "return this->read_data_" << projection.name() << "(input_text, std::cerr);\n"
+      << "}\n\n"
+      << "bool " << method << "(const std::string &input_text, std::ostream &ss)\n"
+      << "{\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        // The strings point into a copy of the text kept by the object, as read_data does
+        streamer << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+        << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "*this = " << entity.cls->name() << "();\n";
+        create_native_reader("&(*_buffer)[0]", "input_text.size()", false);
+        streamer << def_1p_indentation << "if (!(" << parse << ")) {\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "umison_buffer = _buffer;\n"
+        << def_1p_indentation << "return true;\n";
+      } else {
+        create_native_reader("input_text.c_str()", "input_text.size()", false);
+        streamer << def_1p_indentation << "return " << parse << ";\n";
+      }
+      streamer << "}\n\n";
+    }
+
+    /**
+     * Writes the start of a map reader, opens the object and walks its members
+     * */
+    void _native_map_start(T2 &streamer, const std::string &space, const std::string &function,
+                           const std::string &type, int level) {
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      std::string def_2p_indentation(def_1p_indentation + space);
+      streamer << def_indentation << "bool " << function << "(" << reader_class() << " &r, std::multimap<std::string, " << type
+      << "> &str)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "if (!r.open('{')) {\n"
+      << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Element is not an object\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "native_key key;\n"
+      << def_1p_indentation << "for (bool more = r.first_key(key); more; more = r.next_key(key)) {\n";
+    }
+
+    /**
+     * Create the readers of the maps of basic types and classes. The elements of the maps
+     * of classes that can't be read are dropped and the read goes on, an optional map of
+     * classes only accepts objects as values
+     * */
+    void create_native_map_readers(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string def_2p_indentation(build_indentation(TABS, 3));
+      std::string def_3p_indentation(build_indentation(TABS, 4));
+      std::string def_4p_indentation(build_indentation(TABS, 5));
+      streamer << TABS << "// Json type map readers implementation\n";
+      for (auto &basic: native_basic_types()) {
+        std::string type(native_value_type(basic));
+        _native_map_start(streamer, TABS, "_native_read_map", type, 1);
+        streamer << def_2p_indentation << "auto it = str.emplace(std::piecewise_construct, std::forward_as_tuple(key.str, key.len), "
+        << "std::forward_as_tuple());\n"
+        << def_2p_indentation << "if (!r." << native_read(basic) << "(it->second)) {\n"
+        << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \"Error map value is not a "
+        << internal_to_rapidjson(basic) << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n";
+        _native_list_end(streamer, TABS, 1);
+      }
+      for (auto &class_it: ff->getClassMap()) {
+        std::string type(native_value_type(class_it.first));
+        streamer << def_indentation << "bool _native_map_element(" << reader_class() << " &r, std::multimap<std::string, " << type
+        << "> &str, const std::string &key)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "const char *start = r.value();\n"
+        << def_1p_indentation << "const int depth = r.depth();\n"
+        << def_1p_indentation << "auto it = str.emplace(std::piecewise_construct, std::forward_as_tuple(key), "
+        << "std::forward_as_tuple());\n"
+        << def_1p_indentation << "if (!" << class_it.first << "__native_parse(r, it->second)) {\n"
+        << def_2p_indentation << "str.erase(it);\n"
+        << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << class_it.first << "\\n\";\n"
+        << def_2p_indentation << "return r.recover(start, depth);\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+        // The values of the map are objects or arrays of objects, the rest is ignored
+        _native_map_start(streamer, TABS, "_native_read_map", type, 1);
+        streamer << def_2p_indentation << "char c = r.peek();\n"
+        << def_2p_indentation << "if (c == '{') {\n"
+        << def_3p_indentation << "if (!_native_map_element(r, str, std::string(key.str, key.len))) {\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n"
+        << def_2p_indentation << "} else if (c == '[') {\n"
+        << def_3p_indentation << "std::string name(key.str, key.len);\n"
+        << def_3p_indentation << "if (!r.open('[')) {\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "for (bool element = r.first_element(); element; element = r.next_element()) {\n"
+        << def_4p_indentation << "if (!_native_map_element(r, str, name)) {\n"
+        << def_4p_indentation << TABS << "return false;\n"
+        << def_4p_indentation << "}\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "if (r.failed()) {\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n"
+        << def_2p_indentation << "} else if (!r.skip()) {\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n";
+        _native_list_end(streamer, TABS, 1);
+        _native_map_start(streamer, TABS, "_native_read_map_object", type, 1);
+        streamer << def_2p_indentation << "if (r.peek() != '{') {\n"
+        << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error map value is not Object\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "if (!_native_map_element(r, str, std::string(key.str, key.len))) {\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n";
+        _native_list_end(streamer, TABS, 1);
+      }
+      streamer << "\n";
+    }
+
+    /**
+     * Reads one member with the type it is declared with
+     *
+     * \param on_fail statements run before returning on an error
+     * \param projection the classes it reads partially are read with their projected parsers
+     * \param raw on string_view mode the strings are not decoded, the text is left as it was
+     * */
+    void _native_member(T2 &streamer, const std::string &space, const std::string &class_name,
+                        const std::shared_ptr<umixmltype> &element, const std::string &on_fail, int level,
+                        const umixmlprojection *projection, bool raw = false) {
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      std::string wrong_type("r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " + class_name
+                             + " is wrong type " + element->name() + "\\n\";\n");
+      if (element->isList() || element->isRefClass()) {
+        streamer << def_indentation << "if (r.peek() != '" << (element->isList() ? "[" : "{") << "') {\n"
+        << def_1p_indentation << wrong_type << on_fail
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+        if (projection != nullptr && !projection->partial(element->refclass())) {
+          projection = nullptr;
+        }
+        if (native_own_list(element)) {
+          // The filter may use any member of the elements and the index needs its key, so they
+          // are read whole
+          streamer << def_indentation << "if (!" << native_filter_list(class_name, element)
+          << "(r, inout.mutable_" << element->name() << "()"
+          << (element->index().empty() ? "" : ", inout.mutable_" + element->index_name() + "()") << ")) {\n"
+          << def_1p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading list\\n\";\n";
+        } else if (element->isList()) {
+          streamer << def_indentation << "if (!_native_read_list" << (projection != nullptr ? "__" + projection->name() : "")
+          << "(r, inout.mutable_" << element->name() << "())) {\n"
+          << def_1p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading list\\n\";\n";
+        } else {
+          streamer << def_indentation << "if (!" << native_parse_name(element->refclass(), projection)
+          << "(r, inout.mutable_" << element->name() << "())) {\n"
+          << def_1p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading refclass\\n\";\n";
+        }
+        streamer << on_fail
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+      } else {
+        std::string read;
+        if (element->isBoolean()) {
+          read = native_read(UMI_XMLTAGS_BOOLEAN);
+        } else if (element->isInteger32()) {
+          read = native_read(UMI_XMLTAGS_INTEGER32);
+        } else if (element->isInteger()) {
+          read = native_read(UMI_XMLTAGS_INTEGER);
+        } else if (element->isFloat()) {
+          read = native_read(UMI_XMLTAGS_FLOAT);
+        } else if (element->intern()) {
+          read = "native_read_interned";
+        } else if (element->bounded()) {
+          read = "native_read_bounded";
+        } else if (element->isString()) {
+          read = native_read(UMI_XMLTAGS_STRING) + (raw && output_engine<T1, T2>::m_string_view ? "_raw" : "");
+        } else if (element->isEnum()) {
+          read = element->enum_type() + "__native_read";
+        } else {
+          std::cerr << "Invalid element: " << element->name() << "\n";
+          exit(-1);
+        }
+        // The enums, the interned and the inline strings are read by a function, the rest by the reader
+        bool function = element->isEnum() || element->intern() || element->bounded();
+        streamer << def_indentation << "if (!" << (function ? read + "(r, " : "r." + read + "(")
+        << "inout.mutable_" << element->name() << "())) {\n"
+        << def_1p_indentation << wrong_type << on_fail
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+      }
+      if (element->optional()) {
+        streamer << def_indentation << "inout.mutable_" << element->optional_name() << "() = true;\n";
+      }
+    }
+
+    /**
+     * Validator of the values of a refclass/value attribute, a basic type or a class
+     * */
+    static std::string native_validator(const std::string &refclass) {
+      if (type_to_cpp().get_type(refclass).empty()) {
+        return refclass + "__native_validate";
+      }
+      return "_native_validate_" + native_read(refclass).substr(5);
+    }
+
+    /**
+     * Checks one member for validate. The basic members a condition uses are read into inout so
+     * the condition can be evaluated, the rest are only checked
+     *
+     * \param on_fail statements run before returning on an error
+     * */
+    void _native_validate_member(T2 &streamer, const std::string &space, const native_entity &entity,
+                                 const std::shared_ptr<umixmltype> &element, const std::string &on_fail, int level) {
+      if (!element->isList() && !element->isRefClass() && this->conditioned(entity.cls, element)) {
+        _native_member(streamer, space, entity.cls->name(), element, on_fail, level, nullptr, true);
+        return;
+      }
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      std::string error("r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " + entity.cls->name()
+                        + " is wrong type " + element->name() + "\\n\";\n");
+      std::string check;
+      if (element->isList() || element->isRefClass()) {
+        streamer << def_indentation << "if (r.peek() != '" << (element->isList() ? "[" : "{") << "') {\n"
+        << def_1p_indentation << error << on_fail
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+        if (element->isList()) {
+          check = "_native_validate_list(r, " + native_validator(element->refclass()) + ")";
+          error = "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading list\\n\";\n";
+        } else {
+          check = native_validator(element->refclass()) + "(r)";
+          error = "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading refclass\\n\";\n";
+        }
+      } else if (element->isBoolean()) {
+        check = native_validator(UMI_XMLTAGS_BOOLEAN) + "(r)";
+      } else if (element->isInteger32()) {
+        check = native_validator(UMI_XMLTAGS_INTEGER32) + "(r)";
+      } else if (element->isInteger()) {
+        check = native_validator(UMI_XMLTAGS_INTEGER) + "(r)";
+      } else if (element->isFloat()) {
+        check = native_validator(UMI_XMLTAGS_FLOAT) + "(r)";
+      } else if (element->isEnum()) {
+        check = element->enum_type() + "__native_validate(r)";
+      } else if (element->bounded()) {
+        check = "native_validate_bounded<" + std::to_string(element->maxlen()) + ">(r)";
+      } else {
+        check = native_validator(UMI_XMLTAGS_STRING) + "(r)";
+      }
+      streamer << def_indentation << "if (!" << check << ") {\n"
+      << def_1p_indentation << error << on_fail
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n";
+    }
+
+    /**
+     * Reads one member of an entity in a parse function written out member by member
+     * */
+    virtual void _native_field(T2 &streamer, const native_entity &entity, size_t index, const std::string &on_fail,
+                               int level) {
+      _native_member(streamer, TABS, entity.cls->name(), entity.cls->getChildren()[index], on_fail, level, nullptr);
+    }
+
+    /**
+     * Reads one member for read_data_streaming, the streamed lists go to their callbacks
+     *
+     * \param on_fail statements run before returning on an error
+     * */
+    void _native_streaming_member(T2 &streamer, const native_entity &entity, size_t index, const std::string &on_fail,
+                                  int level) {
+      auto &element = entity.cls->getChildren()[index];
+      if (!element->streaming()) {
+        _native_field(streamer, entity, index, on_fail, level);
+        return;
+      }
+      std::string def_indentation(build_indentation(TABS, level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      streamer << def_indentation << "if (r.peek() != '[') {\n"
+      << def_1p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << entity.cls->name()
+      << " is wrong type " << element->name() << "\\n\";\n" << on_fail
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n"
+      << def_indentation << "if (!" << native_stream_list(entity.cls->name(), element) << "(r, on_" << element->name()
+      << ")) {\n"
+      << def_1p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading list\\n\";\n" << on_fail
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n";
+      if (element->optional()) {
+        streamer << def_indentation << "inout.mutable_" << element->optional_name() << "() = true;\n";
+      }
+    }
+
+    /**
+     * Name of the parse function of a class or a json, read whole when projection is nullptr,
+     * stop for the one of read_data_prefix
+     * */
+    static std::string native_parse_name(const std::string &prefix, const umixmlprojection *projection,
+                                         bool stop = false) {
+      return prefix + (projection != nullptr ? "__" + projection->name() : std::string())
+             + (stop ? "__prefix" : "") + "__native_parse";
+    }
+
+    /**
+     * Members of an entity read by a projection, all of them when projection is nullptr
+     * */
+    static std::vector<bool> native_selected(const native_entity &entity, const umixmlprojection *projection) {
+      if (projection == nullptr) {
+        return std::vector<bool>(entity.cls->getChildren().size(), true);
+      }
+      return entity.json ? projection->json_fields() : projection->class_fields().at(entity.cls->name());
+    }
+
+    /**
+     * Mask of the members read_data_prefix waits for, 64 members per word: the mandatory ones,
+     * or all the selected ones with a projection. A condition may test any member, so all of
+     * them are waited for when there is one. It is empty when there is none to wait for
+     * */
+    static std::vector<unsigned long long> native_wanted(const native_entity &entity,
+                                                         const umixmlprojection *projection) {
+      auto &elements = entity.cls->getChildren();
+      std::vector<bool> selected(native_selected(entity, projection));
+      std::vector<unsigned long long> wanted(std::max<size_t>((elements.size() + 63) / 64, 1), 0);
+      bool all = projection != nullptr;
+      for (size_t i = 0; i < elements.size(); ++i) {
+        all = all || (selected[i] && !elements[i]->condition().empty());
+      }
+      bool any = false;
+      for (size_t i = 0; i < elements.size(); ++i) {
+        if (selected[i] && (all || !elements[i]->optional())) {
+          wanted[i / 64] |= 1ULL << (i % 64);
+          any = true;
+        }
+      }
+      return any ? wanted : std::vector<unsigned long long>();
+    }
+
+    /**
+     * Create the parse function of one class or json. With a projection only the members it
+     * selects are read and checked, the rest are skipped like the unknown ones. With stop the
+     * object is left, setting stopped, once the members it waits for have been found. With a
+     * filter the members kept aside are only read when it accepts the object, accepted is
+     * cleared and they are only checked otherwise. With validate it is the validator of
+     * validate, the members are checked and inout is a local only holding the ones the
+     * conditions use. With streaming it is the parser of read_data_streaming, the elements of
+     * the streamed lists go to their callbacks
+     * */
+    void create_native_parse(const native_entity &entity, const umixmlprojection *projection = nullptr,
+                             bool stop = false, const native_filter *filter = nullptr, bool validate = false,
+                             bool streaming = false) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string def_4p_indentation(def_3p_indentation + TABS);
+      auto &elements = entity.cls->getChildren();
+      std::vector<bool> selected(native_selected(entity, projection));
+      std::vector<unsigned long long> wanted(stop && !is_map_entity(entity) ? native_wanted(entity, projection)
+                                                                           : std::vector<unsigned long long>());
+      std::string rejected;
+      if (filter != nullptr) {
+        rejected = def_1p_indentation + "if (!(inout." + filter->expression + ")) {\n"
+                   + def_2p_indentation + "accepted = false;\n"
+                   + def_2p_indentation + "return true;\n"
+                   + def_1p_indentation + "}\n";
+      }
+      if (validate) {
+        streamer << def_indentation << "bool " << entity.prefix << "__native_validate(native_reader &r)\n"
+        << def_indentation << "{\n";
+        bool conditions = false;
+        for (auto &element: elements) {
+          conditions = conditions || !element->condition().empty();
+        }
+        if (conditions) {
+          streamer << def_1p_indentation << entity.type << " inout;\n";
+        }
+      } else if (streaming) {
+        streamer << def_indentation << "bool " << entity.prefix << "__streaming__native_parse(" << reader_class()
+        << " &r, " << entity.type << " &inout"
+        << entity.cls->streaming_parameters(output_engine<T1, T2>::m_additional_string) << ")\n"
+        << def_indentation << "{\n";
+      } else {
+        streamer << def_indentation << "bool "
+        << (filter != nullptr ? filter->name : native_parse_name(entity.prefix, projection, stop)) << "("
+        << reader_class() << " &r, " << entity.type << " &inout" << (stop ? ", bool &" : "")
+        << (wanted.empty() ? "" : "stopped") << (filter != nullptr ? ", bool &accepted" : "") << ")\n"
+        << def_indentation << "{\n";
+      }
+      if (is_map_entity(entity)) {
+        create_native_map_member(elements[0], validate);
+        streamer << rejected
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+        return;
+      }
+      size_t words = std::max<size_t>((elements.size() + 63) / 64, 1);
+      std::vector<int> deferred(elements.size(), -1);
+      int deferred_count = 0;
+      std::vector<unsigned long long> required(words, 0);
+      std::vector<bool> late(native_late(entity, filter));
+      for (size_t i = 0; i < elements.size(); ++i) {
+        if (!selected[i]) {
+          continue;
+        } else if (!elements[i]->condition().empty() || late[i]) {
+          deferred[i] = deferred_count++;
+        }
+        if (elements[i]->condition().empty() && !elements[i]->optional()) {
+          required[i / 64] |= 1ULL << (i % 64);
+        }
+      }
+      streamer << def_1p_indentation << "if (!r.open('{')) {\n"
+      << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Element is not an object\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "unsigned long long int seen[" << words << "] = {};\n";
+      if (deferred_count > 0) {
+        streamer << def_1p_indentation << "const char *deferred[" << deferred_count << "] = {};\n";
+      }
+      streamer << def_1p_indentation << "native_key key;\n"
+      << def_1p_indentation << "for (bool more = r.first_key(key); more; more = r.next_key(key)) {\n"
+      << def_2p_indentation << "const int field = " << entity.prefix << "__field(key.str, key.len);\n"
+      << def_2p_indentation << "if (field < 0 || (seen[field / 64] & (1ULL << (field % 64)))) {\n"
+      << def_3p_indentation << "if (!r.skip()) {\n"
+      << def_4p_indentation << "return false;\n"
+      << def_3p_indentation << "}\n"
+      << def_3p_indentation << "continue;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "seen[field / 64] |= 1ULL << (field % 64);\n"
+      << def_2p_indentation << "switch (field) {\n";
+      for (size_t i = 0; i < elements.size(); ++i) {
+        if (!selected[i]) {
+          continue;
+        }
+        streamer << def_3p_indentation << "case " << i << ":\n";
+        if (deferred[i] >= 0) {
+          streamer << def_4p_indentation << "deferred[" << deferred[i] << "] = r.value();\n"
+          << def_4p_indentation << "if (!r.skip()) {\n"
+          << def_4p_indentation << TABS << "return false;\n"
+          << def_4p_indentation << "}\n";
+        } else if (validate) {
+          _native_validate_member(streamer, TABS, entity, elements[i], "", 5);
+        } else if (streaming) {
+          _native_streaming_member(streamer, entity, i, "", 5);
+        } else {
+          _native_member(streamer, TABS, entity.cls->name(), elements[i], "", 5, projection);
+        }
+        streamer << def_4p_indentation << "break;\n";
+      }
+      streamer << def_3p_indentation << "default:\n";
+      if (projection != nullptr) {
+        streamer << def_4p_indentation << "if (!r.skip()) {\n"
+        << def_4p_indentation << TABS << "return false;\n"
+        << def_4p_indentation << "}\n";
+      }
+      streamer << def_4p_indentation << "break;\n"
+      << def_2p_indentation << "}\n";
+      if (!wanted.empty()) {
+        // The end of the object is read as read_data does, the text is then validated
+        streamer << def_2p_indentation << "if (r.peek() != '}'";
+        for (size_t word = 0; word < wanted.size(); ++word) {
+          std::ostringstream mask;
+          mask << "0x" << std::hex << wanted[word] << "ULL";
+          streamer << " && (seen[" << word << "] & " << mask.str() << ") == " << mask.str();
+        }
+        streamer << ") {\n"
+        << def_3p_indentation << "stopped = true;\n"
+        << def_3p_indentation << "break;\n"
+        << def_2p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (r.failed()) {\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      // Mandatory members, one mask per word and the detail only on failure
+      for (size_t word = 0; word < words; ++word) {
+        if (required[word] == 0) {
+          continue;
+        }
+        std::ostringstream mask;
+        mask << "0x" << std::hex << required[word] << "ULL";
+        streamer << def_1p_indentation << "if ((seen[" << word << "] & " << mask.str() << ") != " << mask.str()
+        << ") {\n";
+        for (size_t i = word * 64; i < elements.size() && i < (word + 1) * 64; ++i) {
+          if (!(required[word] & (1ULL << (i % 64)))) {
+            continue;
+          }
+          streamer << def_2p_indentation << "if (!(seen[" << word << "] & (1ULL << " << i % 64 << "))) {\n"
+          << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+          << entity.cls->name() << " is missing mandatory entry or entity is not an object" << elements[i]->name()
+          << "\\n\";\n"
+          << def_3p_indentation << "return false;\n"
+          << def_2p_indentation << "}\n";
+        }
+        streamer << def_1p_indentation << "}\n";
+      }
+      // Conditional members, read from where they were found
+      std::string actualCondition;
+      for (size_t i = 0; i < elements.size(); ++i) {
+        auto &element = elements[i];
+        if (deferred[i] < 0 || late[i]) {
+          continue;
+        }
+        if (actualCondition != element->condition()) {
+          if (!actualCondition.empty()) {
+            streamer << def_1p_indentation << "}\n";
+          }
+          actualCondition = element->condition();
+          streamer << def_1p_indentation << "if (inout." << actualCondition << ") {\n";
+        }
+        std::string value("deferred[" + std::to_string(deferred[i]) + "]");
+        if (element->optional()) {
+          streamer << def_2p_indentation << "if (" << value << " != nullptr) {\n";
+        } else {
+          streamer << def_2p_indentation << "if (" << value << " == nullptr) {\n"
+          << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+          << entity.cls->name() << " is missing mandatory entry or entity is not an object" << element->name()
+          << "\\n\";\n"
+          << def_3p_indentation << "return false;\n"
+          << def_2p_indentation << "}\n"
+          << def_2p_indentation << "{\n";
+        }
+        streamer << def_3p_indentation << "const native_position resume = r.seek(" << value << ");\n";
+        if (validate) {
+          _native_validate_member(streamer, TABS, entity, element, def_4p_indentation + "r.restore(resume);\n", 3);
+        } else if (streaming) {
+          _native_streaming_member(streamer, entity, i, def_4p_indentation + "r.restore(resume);\n", 3);
+        } else {
+          _native_member(streamer, TABS, entity.cls->name(), element, def_4p_indentation + "r.restore(resume);\n",
+                         3, projection);
+        }
+        streamer << def_3p_indentation << "r.restore(resume);\n"
+        << def_2p_indentation << "}\n";
+      }
+      if (!actualCondition.empty()) {
+        streamer << def_1p_indentation << "}\n";
+      }
+      // Members kept aside by the filter, the mandatory ones have been found. When it rejects the
+      // object they are only checked, as validate does, so the same texts are accepted
+      if (filter != nullptr) {
+        streamer << def_1p_indentation << "if (!(inout." << filter->expression << ")) {\n";
+        for (size_t i = 0; i < elements.size(); ++i) {
+          if (!late[i] || deferred[i] < 0) {
+            continue;
+          }
+          std::string value("deferred[" + std::to_string(deferred[i]) + "]");
+          streamer << def_2p_indentation << "if (" << value << " != nullptr) {\n"
+          << def_3p_indentation << "const native_position resume = r.seek(" << value << ");\n";
+          _native_validate_member(streamer, TABS, entity, elements[i], def_4p_indentation + "r.restore(resume);\n", 4);
+          streamer << def_3p_indentation << "r.restore(resume);\n"
+          << def_2p_indentation << "}\n";
+        }
+        streamer << def_2p_indentation << "accepted = false;\n"
+        << def_2p_indentation << "return true;\n"
+        << def_1p_indentation << "}\n";
+      }
+      for (size_t i = 0; i < elements.size(); ++i) {
+        if (!late[i] || deferred[i] < 0) {
+          continue;
+        }
+        std::string value("deferred[" + std::to_string(deferred[i]) + "]");
+        streamer << def_1p_indentation << "if (" << value << " != nullptr) {\n"
+        << def_2p_indentation << "const native_position resume = r.seek(" << value << ");\n";
+        _native_member(streamer, TABS, entity.cls->name(), elements[i], def_3p_indentation + "r.restore(resume);\n",
+                       3, projection);
+        streamer << def_2p_indentation << "r.restore(resume);\n"
+        << def_1p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Members of an entity a filter keeps aside, the ones allocating memory that neither the
+     * filter nor the conditions use. None without a filter
+     * */
+    static std::vector<bool> native_late(const native_entity &entity, const native_filter *filter) {
+      auto &elements = entity.cls->getChildren();
+      std::vector<bool> late(elements.size(), false);
+      if (filter == nullptr) {
+        return late;
+      }
+      for (size_t i = 0; i < elements.size(); ++i) {
+        auto &element = elements[i];
+        late[i] = element->condition().empty()
+                  && !output_engine_rapid_json<T1, T2>::expression_uses(filter->expression, element)
+                  && !output_engine_rapid_json<T1, T2>::conditioned(entity.cls, element)
+                  && (element->isString() || element->isList() || element->isRefClass() || element->isMap());
+      }
+      return late;
+    }
+
+    /**
+     * Reads the map of a class made only of one map, only checks it with validate
+     * */
+    void create_native_map_member(const std::shared_ptr<umixmltype> &element, bool validate = false) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string def_2p_indentation(build_indentation(TABS, 3));
+      // The values of an optional map of classes must all be objects
+      bool classes = type_to_cpp().get_type(element->refclass()).empty();
+      bool objects = element->optional() && classes;
+      std::string call;
+      if (!validate) {
+        call = "_native_read_map" + std::string(objects ? "_object" : "") + "(r, inout.mutable_" + element->name()
+               + "())";
+      } else if (classes) {
+        call = "_native_validate_map_classes(r, " + native_validator(element->refclass()) + ", "
+               + (objects ? "true" : "false") + ")";
+      } else {
+        call = "_native_validate_map(r, " + native_validator(element->refclass()) + ")";
+      }
+      if (!element->condition().empty()) {
+        streamer << def_1p_indentation << "if (!(inout." << element->condition() << ")) {\n"
+        << def_2p_indentation << "return r.skip();\n"
+        << def_1p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "if (!" << call << ") {\n"
+      << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error reading map\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      if (element->optional() && !validate) {
+        streamer << def_1p_indentation << "inout.mutable_" << element->optional_name() << "() = true;\n";
+      }
+    }
+
+    /**
+     * Create the checks of validate and the declarations of the validators, the parsers of the
+     * lists with a filter check with them the members of the elements it rejects
+     * */
+    void create_native_validator_declarations(std::shared_ptr<umi::umixml> &ff,
+                                              const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      streamer << native_validate_code
+      << TABS << "// Validators of the classes and the jsons\n";
+      for (auto &entity: entities) {
+        streamer << TABS << "bool " << entity.prefix << "__native_validate(native_reader &r);\n";
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << TABS << "bool " << variant->name() << "__native_validate(native_reader &r);\n";
+      }
+      streamer << "\n";
+    }
+
+    /**
+     * Create the validators of validate, one per class and json, with the checks of their parse
+     * functions. They read with native_reader whatever the engine, so nothing is allocated
+     * */
+    void create_native_validators(std::shared_ptr<umi::umixml> &ff, const std::vector<native_entity> &entities) {
+      for (auto &entity: entities) {
+        create_native_parse(entity, nullptr, false, nullptr, true);
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        create_native_variant_parse(variant, true);
+      }
+    }
+
+    /**
+     * Create validate of one json, the text is checked by the validators without being stored
+     * */
+    void create_native_validate(const native_entity &entity) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      streamer << def_indentation << "bool umison::" << entity.cls->name()
+      << "::validate(const char *text, std::size_t len, std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << ns << "native_reader _reader(text, text + len, ss);\n"
+      << def_1p_indentation << "return " << ns << entity.prefix << "__native_validate(_reader) && _reader.finish();\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Name of the reader of a streamed list, owner is the json of the list
+     * */
+    static std::string native_stream_list(const std::string &owner, const std::shared_ptr<umixmltype> &element) {
+      return "_native_stream_list__" + owner + "__" + element->name();
+    }
+
+    /**
+     * Call reading one element of a streamed list into element, accepted is cleared when the
+     * filter of the list rejects it
+     * */
+    virtual std::string native_stream_element(const std::string &owner, const std::shared_ptr<umixmltype> &element) const {
+      if (!element->filter().empty()) {
+        return native_filter_list(owner, element) + "__native_parse(r, element, accepted)";
+      }
+      return native_parse_name(element->refclass(), nullptr) + "(r, element)";
+    }
+
+    /**
+     * Create the readers of the streamed lists and the parsers of read_data_streaming. The
+     * elements are read one at a time into the same object, handed to the callback and cleared
+     * before the next one, so the memory of the list doesn't grow with it
+     * */
+    void create_native_streams(const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string def_2p_indentation(build_indentation(TABS, 3));
+      std::string def_3p_indentation(build_indentation(TABS, 4));
+      for (auto &entity: entities) {
+        if (!entity.json || entity.cls->streaming_arguments().empty()) {
+          continue;
+        }
+        streamer << TABS << "// Parsers of read_data_streaming of " << entity.cls->name() << "\n";
+        for (auto &element: entity.cls->getChildren()) {
+          if (!element->streaming()) {
+            continue;
+          }
+          bool filtered = !element->filter().empty();
+          streamer << TABS << "bool " << native_stream_list(entity.cls->name(), element) << "(" << reader_class()
+          << " &r, const std::function<void(const " << element->refclass() << " &)> &callback)\n"
+          << TABS << "{\n"
+          << def_1p_indentation << "if (!r.open('[')) {\n"
+          << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \"Error data is not an array\\n\";\n"
+          << def_2p_indentation << "return false;\n"
+          << def_1p_indentation << "}\n"
+          << def_1p_indentation << element->refclass() << " element;\n"
+          << def_1p_indentation << "for (bool more = r.first_element(); more; more = r.next_element()) {\n";
+          if (filtered) {
+            streamer << def_2p_indentation << "bool accepted = true;\n";
+          }
+          streamer << def_2p_indentation << "if (!" << native_stream_element(entity.cls->name(), element) << ") {\n"
+          << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+          << element->refclass() << "\\n\";\n"
+          << def_3p_indentation << "return false;\n"
+          << def_2p_indentation << "}\n";
+          if (filtered) {
+            streamer << def_2p_indentation << "if (accepted) {\n"
+            << def_3p_indentation << "callback(element);\n"
+            << def_2p_indentation << "}\n";
+          } else {
+            streamer << def_2p_indentation << "callback(element);\n";
+          }
+          streamer << def_2p_indentation << "element = " << element->refclass() << "();\n"
+          << def_1p_indentation << "}\n"
+          << def_1p_indentation << "return !r.failed();\n"
+          << TABS << "}\n\n";
+        }
+        create_native_parse(entity, nullptr, false, nullptr, false, true);
+      }
+    }
+
+    /**
+     * Create read_data_streaming of one json. On string_view mode the text is copied into a
+     * buffer kept by the object, as read_data does
+     * */
+    void create_native_streaming_read_data(const native_entity &entity) {
+      if (entity.cls->streaming_arguments().empty()) {
+        return;
+      }
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      std::string parse(ns + entity.prefix + "__streaming__native_parse(_reader, *this"
+                        + entity.cls->streaming_arguments() + ") && _reader.finish()");
+      streamer << def_indentation << "bool umison::" << entity.cls->name()
+      << "::read_data_streaming(const std::string &input_text"
+      << entity.cls->streaming_parameters(output_engine<T1, T2>::m_additional_string) << ", std::ostream &ss)\n"
+      << def_indentation << "{\n";
+      if (!output_engine<T1, T2>::m_string_view) {
+        create_native_reader("input_text.c_str()", "input_text.size()", false);
+        streamer << def_1p_indentation << "return " << parse << ";\n"
+        << def_indentation << "}\n\n";
+        return;
+      }
+      streamer << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+      << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+      << def_1p_indentation << "*this = " << entity.cls->name() << "();\n";
+      create_native_reader("&(*_buffer)[0]", "input_text.size()", false);
+      streamer << def_1p_indentation << "if (!(" << parse << ")) {\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "umison_buffer = _buffer;\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the read_data methods of one json
+     *
+     * \param insitu true to create read_data_insitu
+     * \param context true to create the reader using the memory of a parser_context
+     * */
+    void create_native_read_data(const native_entity &entity, bool insitu, bool context) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      if (context) {
+        this->create_context_prologue(entity.cls);
+        if (output_engine<T1, T2>::m_string_view) {
+          create_native_reader("&_context.text[0]", "input_text.size()", true);
+        } else {
+          create_native_reader("input_text.c_str()", "input_text.size()", true);
+        }
+      } else if (insitu) {
+        this->create_insitu_prologue(entity.cls);
+        create_native_reader("buffer", "len", false);
+      } else {
+        streamer << def_indentation << "bool umison::" << entity.cls->name()
+        << "::read_data(const std::string &input_text, std::ostream &ss)\n"
+        << def_indentation << "{\n";
+        create_native_reader("input_text.c_str()", "input_text.size()", false);
+      }
+      streamer << def_1p_indentation << "return " << ns << entity.prefix << "__native_parse(_reader, *this) && "
+      << "_reader.finish();\n"
+      << def_indentation << "}\n";
+    }
+
+    /**
+     * Creates _reader, the reader of the text of a read_data method
+     *
+     * \param text expression with the first char of the text
+     * \param len expression with the length of the text
+     * \param context true when the read has the memory of a parser_context
+     * */
+    virtual void create_native_reader(const std::string &text, const std::string &len, bool /*context*/) {
+      output_engine<T1, T2>::m_cpp_streamer << TABS << "__internal__umison" << output_engine<T1, T2>::m_additional_string
+      << "::native_reader _reader(" << text << ", " << text << " + " << len << ", ss);\n";
+    }
+
+    /**
+     * Call reading the object of an entity from _reader into out
+     * */
+    virtual std::string native_parse_call(const native_entity &entity, const std::string &out) const {
+      return entity.prefix + "__native_parse(_reader, " + out + ")";
+    }
+
+    /**
+     * Create the methods of the lazy views of the classes and the jsons
+     * */
+    void create_native_views(const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      streamer << "// Lazy views\n";
+      for (auto &entity: entities) {
+        std::string type(entity.json ? entity.type : ns + entity.type);
+        std::string view(type + "_view");
+        std::string name(entity.cls->name() + "_view");
+        auto &elements = entity.cls->getChildren();
+        std::string members;
+        for (auto &element: elements) {
+          members += std::string(",\n") + TABS + umixmltype::attribute_prepocess(element->name()) + "()";
+        }
+        streamer << view << "::" << name << "() : umison_object(nullptr), umison_scan(nullptr), umison_members(),\n"
+        << TABS << "umison_decoded()" << members << "\n"
+        << "{\n"
+        << "}\n\n"
+        << view << "::" << name << "(std::shared_ptr<const std::string> text, const char *object) :\n"
+        << TABS << "umison_text(std::move(text)), umison_object(object), umison_scan(nullptr), umison_members(),\n"
+        << TABS << "umison_decoded()" << members << "\n"
+        << "{\n";
+        if (is_map_entity(entity)) {
+          streamer << TABS << "umison_members[0] = object;\n";
+        } else {
+          streamer << TABS << "if (object != nullptr && *object == '{') {\n"
+          << TABS << TABS << "umison_scan = object + 1;\n"
+          << TABS << "}\n";
+        }
+        streamer << "}\n\n";
+        if (entity.json) {
+          create_native_view_read_data(view, name, ns);
+        }
+        create_native_view_materialize(entity, type, view, ns);
+        create_native_view_member(entity, view, ns);
+        for (size_t i = 0; i < elements.size(); ++i) {
+          create_native_view_getter(entity, view, ns, elements[i], i);
+        }
+      }
+    }
+
+    /**
+     * Create the read_data methods of the view of a json, only the start of the object is checked
+     * */
+    void create_native_view_read_data(const std::string &view, const std::string &name, const std::string &ns) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      streamer << "bool " << view << "::read_data(std::string input_text)\n"
+      << "{\n"
+      << def_1p_indentation << "return this->read_data(std::move(input_text), std::cerr);\n"
+      << "}\n\n"
+      << "bool " << view << "::read_data(std::string input_text, std::ostream &ss)\n"
+      << "{\n"
+      << def_1p_indentation
+      << "std::shared_ptr<const std::string> text(std::make_shared<const std::string>(std::move(input_text)));\n"
+      << def_1p_indentation << "const char *object = " << ns << "native_view_space(text->c_str());\n"
+      << def_1p_indentation << "if (*object != '{') {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Element is not an object\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "*this = " << name << "(std::move(text), object);\n"
+      << def_1p_indentation << "return true;\n"
+      << "}\n\n";
+    }
+
+    /**
+     * Create the materialize methods of a view, the object is read by the parser of the engine
+     * */
+    void create_native_view_materialize(const native_entity &entity, const std::string &type,
+                                        const std::string &view, const std::string &ns) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      streamer << "bool " << view << "::materialize(" << type << " &out) const\n"
+      << "{\n"
+      << def_1p_indentation << "return this->materialize(out, std::cerr);\n"
+      << "}\n\n"
+      << "bool " << view << "::materialize(" << type << " &out, std::ostream &ss) const\n"
+      << "{\n"
+      << def_1p_indentation << "if (!umison_text) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error the view has no text\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << ns
+      << "native_reader _reader(umison_object, umison_text->c_str() + umison_text->size(), ss);\n"
+      << def_1p_indentation << "return " << ns << native_parse_call(entity, "out")
+      << (entity.json ? " && _reader.finish()" : "") << ";\n"
+      << "}\n\n";
+    }
+
+    /**
+     * Create the lookup of the members of a view, the object is walked up to the member
+     * */
+    void create_native_view_member(const native_entity &entity, const std::string &view, const std::string &ns) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      streamer << "const char *" << view << "::umison_member(int index) const\n"
+      << "{\n";
+      // The map is the whole object, the constructor already has its position
+      if (!is_map_entity(entity)) {
+        streamer << def_1p_indentation << "while (umison_members[index] == nullptr && umison_scan != nullptr) {\n"
+        << def_2p_indentation << "umison_scan = " << ns << "native_view_next(umison_scan, umison_text->c_str() + "
+        << "umison_text->size(), " << ns << entity.prefix << "__field, umison_members);\n"
+        << def_1p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "return umison_members[index];\n"
+      << "}\n\n";
+    }
+
+    /**
+     * Create the getters of one member of a view, the member is decoded on the first call
+     * */
+    void create_native_view_getter(const native_entity &entity, const std::string &view, const std::string &ns,
+                                   const std::shared_ptr<umixmltype> &element, size_t index) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      std::string def_3p_indentation(build_indentation(TABS, 3));
+      std::string type(file_printer<T1>::view_type(element, output_engine<T1, T2>::m_additional_string));
+      std::string attribute(umixmltype::attribute_prepocess(element->name()));
+      std::string bit("(1ULL << " + std::to_string(index % 64) + ")");
+      std::string decoded("umison_decoded[" + std::to_string(index / 64) + "]");
+      // The variants are decoded whole as the basic types
+      bool basic = element->variant() || !type_to_cpp().get_type(element->refclass()).empty();
+      streamer << "const " << type << " &" << view << "::get_" << element->name() << "() const\n"
+      << "{\n"
+      << def_1p_indentation << "const char *value = nullptr;\n"
+      << def_1p_indentation << "if (!(" << decoded << " & " << bit << ")) {\n"
+      << def_2p_indentation << decoded << " |= " << bit << ";\n"
+      << def_2p_indentation << "value = umison_member(" << index << ");\n";
+      if (!element->condition().empty()) {
+        streamer << def_2p_indentation << "if (!(this->" << element->condition() << ")) {\n"
+        << def_3p_indentation << "value = nullptr;\n"
+        << def_2p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (value != nullptr) {\n";
+      if (element->isMap()) {
+        // The map is the only member, it is read with the parser of its class
+        streamer << def_2p_indentation << (entity.json ? entity.type : ns + entity.type) << " _object;\n"
+        << def_2p_indentation << ns << "native_reader _reader(value, umison_text->c_str() + umison_text->size(), "
+        << ns << "native_view_errors());\n"
+        << def_2p_indentation << "if (" << ns << native_parse_call(entity, "_object") << ") {\n"
+        << def_3p_indentation << attribute << " = std::move(_object.mutable_" << element->name() << "());\n"
+        << def_2p_indentation << "}\n";
+      } else if (element->isRefClass() && !basic) {
+        streamer << def_2p_indentation << "if (*value == '{') {\n"
+        << def_3p_indentation << attribute << " = " << type << "(umison_text, value);\n"
+        << def_2p_indentation << "}\n";
+      } else if (element->isList() && !basic) {
+        streamer << def_2p_indentation << ns << "native_view_list(umison_text, value, " << attribute << ");\n";
+      } else {
+        streamer << def_2p_indentation << ns << "native_reader r(value, umison_text->c_str() + umison_text->size(), "
+        << ns << "native_view_errors());\n"
+        << def_2p_indentation << type << " decoded{};\n"
+        << def_2p_indentation << "if (" << ns << "native_view_read(r, decoded)) {\n"
+        << def_3p_indentation << attribute << " = std::move(decoded);\n"
+        << def_2p_indentation << "}\n";
+      }
+      streamer << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return " << attribute << ";\n"
+      << "}\n\n";
+      if (element->optional()) {
+        streamer << "bool " << view << "::get_" << element->optional_name() << "() const\n"
+        << "{\n"
+        << def_1p_indentation << "return umison_member(" << index << ") != nullptr;\n"
+        << "}\n\n";
+      }
+    }
+  };
+}
+
+#endif
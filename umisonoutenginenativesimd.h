@@ -0,0 +1,678 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONOUTENGINENATIVESIMD_H
+#define UMISON_UMISONOUTENGINENATIVESIMD_H
+
+#include "umisonoutenginenative.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace umi {
+  /**
+   * First stage of the native-simd engine, finds the structural chars of the text 64 bytes
+   * at a time. The bytes are classified with AVX2 or SSE2, chosen when the program starts
+   * from the features of the CPU, or byte by byte on other targets. The masks of the block
+   * give the strings, from the quotes that are not escaped, and the index keeps the position
+   * of the {}[]:, outside the strings, of the quotes and of the first char of each number
+   * and literal.
+   * */
+  static const char *native_index_code = R"umison(#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define UMISON_INDEX_X86
+#endif
+
+    // Chars of one block of 64 bytes, bit i is the byte i
+    struct native_block {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t structural;
+        uint64_t whitespace;
+        uint64_t control;
+    };
+
+    typedef void (*native_classify)(const char *block, native_block &masks);
+
+    inline void native_classify_scalar(const char *block, native_block &masks)
+    {
+        masks = native_block();
+        for (int i = 0; i < 64; ++i) {
+            unsigned char c = static_cast<unsigned char>(block[i]);
+            uint64_t bit = 1ULL << i;
+            if (c == '"') {
+                masks.quote |= bit;
+            } else if (c == '\\') {
+                masks.backslash |= bit;
+            } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') {
+                masks.structural |= bit;
+            } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                masks.whitespace |= bit;
+            }
+            if (c < 0x20) {
+                masks.control |= bit;
+            }
+        }
+    }
+
+#if defined(UMISON_INDEX_X86)
+    inline void native_classify_sse2(const char *block, native_block &masks)
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        // '[' and ']' are '{' and '}' without the bit 0x20
+        const __m128i lower = _mm_set1_epi8(0x20);
+        const __m128i open = _mm_set1_epi8('{');
+        const __m128i close = _mm_set1_epi8('}');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i line = _mm_set1_epi8('\n');
+        const __m128i carriage = _mm_set1_epi8('\r');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        masks = native_block();
+        for (int i = 0; i < 64; i += 16) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+            __m128i folded = _mm_or_si128(chars, lower);
+            __m128i structural = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(chars, colon), _mm_cmpeq_epi8(chars, comma)));
+            __m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(chars, line), _mm_cmpeq_epi8(chars, carriage)));
+            masks.quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, quote)))) << i;
+            masks.backslash |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, backslash)))) << i;
+            masks.structural |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(structural))) << i;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(whitespace))) << i;
+            masks.control |= static_cast<uint64_t>(static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chars, control), chars)))) << i;
+        }
+    }
+
+    __attribute__((target("avx2"))) inline void native_classify_avx2(const char *block, native_block &masks)
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i lower = _mm256_set1_epi8(0x20);
+        const __m256i open = _mm256_set1_epi8('{');
+        const __m256i close = _mm256_set1_epi8('}');
+        const __m256i colon = _mm256_set1_epi8(':');
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i line = _mm256_set1_epi8('\n');
+        const __m256i carriage = _mm256_set1_epi8('\r');
+        const __m256i control = _mm256_set1_epi8(0x1F);
+        masks = native_block();
+        for (int i = 0; i < 64; i += 32) {
+            __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i));
+            __m256i folded = _mm256_or_si256(chars, lower);
+            __m256i structural = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, colon), _mm256_cmpeq_epi8(chars, comma)));
+            __m256i whitespace = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, space), _mm256_cmpeq_epi8(chars, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, line), _mm256_cmpeq_epi8(chars, carriage)));
+            masks.quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, quote)))) << i;
+            masks.backslash |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, backslash)))) << i;
+            masks.structural |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(structural))) << i;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(whitespace))) << i;
+            masks.control |= static_cast<uint64_t>(static_cast<unsigned>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(chars, control), chars)))) << i;
+        }
+    }
+#endif
+
+    // Classifier of the CPU running the program
+    inline native_classify native_default_classify()
+    {
+#if defined(UMISON_INDEX_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return native_classify_avx2;
+        }
+        return native_classify_sse2;
+#else
+        return native_classify_scalar;
+#endif
+    }
+
+    // Chars escaped by a backslash, carry tells if the first char of the block is escaped and
+    // is set for the next block. The sequences of backslashes that start on an odd bit are
+    // moved to an even one with the add, so every other bit after a sequence is escaped
+    inline uint64_t native_escaped(uint64_t backslash, uint64_t &carry)
+    {
+        if (backslash == 0) {
+            uint64_t escaped = carry;
+            carry = 0;
+            return escaped;
+        }
+        const uint64_t even_bits = 0x5555555555555555ULL;
+        backslash &= ~carry;
+        uint64_t follows_escape = (backslash << 1) | carry;
+        uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+        uint64_t even_starts = odd_starts + backslash;
+        carry = even_starts < backslash ? 1 : 0;
+        return (even_bits ^ (even_starts << 1)) & follows_escape;
+    }
+
+    inline int native_ctz(uint64_t bits)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#else
+        int n = 0;
+        for (; (bits & 1) == 0; bits >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    // Bit i is the xor of the bits up to i, the bytes from an opening quote to the closing one
+    inline uint64_t native_prefix_xor(uint64_t bits)
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    // Builds the index of the text, it ends with the position of the '\0' after the text
+    inline bool native_build_index(const char *text, std::size_t len, std::vector<uint32_t> &index, std::ostream &ss,
+                                   native_classify classify = nullptr)
+    {
+        static const native_classify cpu_classify = native_default_classify();
+        if (classify == nullptr) {
+            classify = cpu_classify;
+        }
+        if (len >= 0xFFFFFFFFu) {
+            ss << __FILE__ << ":" << __LINE__ << " Error text too big to be indexed\n";
+            return false;
+        }
+        if (index.size() < 1024) {
+            index.resize(1024);
+        }
+        std::size_t count = 0;
+        uint64_t escaped_carry = 0;
+        uint64_t string_carry = 0;
+        // The text starts as if a white space was before it
+        uint64_t boundary_carry = 1;
+        native_block masks;
+        char last[64];
+        for (std::size_t base = 0; base < len; base += 64) {
+            const char *block = text + base;
+            if (len - base < 64) {
+                std::memset(last, ' ', sizeof(last));
+                std::memcpy(last, block, len - base);
+                block = last;
+            }
+            classify(block, masks);
+            uint64_t quote = masks.quote & ~native_escaped(masks.backslash, escaped_carry);
+            // From the opening quote to the char before the closing one
+            uint64_t in_string = native_prefix_xor(quote) ^ string_carry;
+            string_carry = 0 - (in_string >> 63);
+            if (masks.control & in_string) {
+                std::size_t offset = base + static_cast<std::size_t>(native_ctz(masks.control & in_string));
+                ss << __FILE__ << ":" << __LINE__ << " Error parsing input text. Error: invalid char in string at offset "
+                   << offset << "\n";
+                return false;
+            }
+            // Numbers and literals start after a structural char, a white space or a closing quote
+            uint64_t boundary = masks.structural | masks.whitespace | quote;
+            uint64_t scalar = ~(boundary | in_string);
+            uint64_t tokens = (masks.structural & ~in_string) | quote | (scalar & ((boundary << 1) | boundary_carry));
+            boundary_carry = boundary >> 63;
+            if (count + 64 > index.size()) {
+                index.resize(index.size() * 2);
+            }
+            uint32_t *out = &index[count];
+            while (tokens != 0) {
+                *out++ = static_cast<uint32_t>(base + static_cast<std::size_t>(native_ctz(tokens)));
+                tokens &= tokens - 1;
+            }
+            count = static_cast<std::size_t>(out - &index[0]);
+        }
+        if (string_carry != 0) {
+            ss << __FILE__ << ":" << __LINE__ << " Error parsing input text. Error: missing quotation mark at offset "
+               << len << "\n";
+            return false;
+        }
+        index[count] = static_cast<uint32_t>(len);
+        index.resize(count + 1);
+        return true;
+    }
+
+    // Reader walking the index of the text, it keeps the reader position on the current token
+    // so the numbers, literals and escapes are read by native_reader
+    class native_index_reader : public native_reader {
+    public:
+        native_index_reader(const char *text, const char *text_end, const uint32_t *index, std::size_t count,
+                            std::ostream &ss) :
+            native_reader(text, text_end, ss), m_index(index), m_count(count), m_token(0)
+        {
+            m_p = m_begin + m_index[0];
+        }
+
+        char peek() const
+        {
+            return *m_p;
+        }
+
+        const char *value() const
+        {
+            return m_p;
+        }
+
+        bool open(char bracket)
+        {
+            if (*m_p != bracket) {
+                return false;
+            }
+            if (++m_depth > native_max_depth) {
+                return fail("document too deep");
+            }
+            step(1);
+            return true;
+        }
+
+        bool first_key(native_key &key)
+        {
+            if (*m_p == '}') {
+                close();
+                return false;
+            }
+            return read_key(key);
+        }
+
+        bool next_key(native_key &key)
+        {
+            char c = *m_p;
+            if (c == ',') {
+                step(1);
+                return read_key(key);
+            }
+            if (c == '}') {
+                close();
+                return false;
+            }
+            return fail("missing comma or '}' after an object member");
+        }
+
+        bool first_element()
+        {
+            if (*m_p == ']') {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        bool next_element()
+        {
+            char c = *m_p;
+            if (c == ',') {
+                step(1);
+                return true;
+            }
+            if (c == ']') {
+                close();
+                return false;
+            }
+            return fail("missing comma or ']' after an array element");
+        }
+
+        bool read_bool(bool &out)
+        {
+            return native_reader::read_bool(out) && scalar_end();
+        }
+
+        bool read_int(int &out)
+        {
+            return native_reader::read_int(out) && scalar_end();
+        }
+
+        bool read_int64(long long int &out)
+        {
+            return native_reader::read_int64(out) && scalar_end();
+        }
+
+        bool read_double(double &out)
+        {
+            return native_reader::read_double(out) && scalar_end();
+        }
+
+        // The strings without escapes are taken from the text between the two quotes
+        template<typename String>
+        bool read_string(String &out)
+        {
+            if (*m_p != '"') {
+                return false;
+            }
+            const char *start = m_p + 1;
+            const char *end = m_begin + m_index[m_token + 1];
+            if (*end != '"') {
+                return fail("missing quotation mark");
+            }
+            if (std::memchr(start, '\\', static_cast<std::size_t>(end - start)) == nullptr) {
+                out = String(start, static_cast<std::size_t>(end - start));
+            } else if (!native_reader::read_string(out)) {
+                return false;
+            }
+            step(2);
+            return true;
+        }
+
+        // The names without escapes point between the two quotes
+        bool read_name(native_key &name)
+        {
+            if (*m_p != '"') {
+                return false;
+            }
+            const char *start = m_p + 1;
+            const char *end = m_begin + m_index[m_token + 1];
+            if (*end != '"') {
+                return fail("missing quotation mark");
+            }
+            const char *escape = static_cast<const char *>(std::memchr(start, '\\', static_cast<std::size_t>(end - start)));
+            if (escape == nullptr) {
+                name.str = start;
+                name.len = static_cast<std::size_t>(end - start);
+            } else {
+                m_key.assign(start, escape);
+                m_p = escape;
+                if (!decode(m_key)) {
+                    return false;
+                }
+                name.str = m_key.data();
+                name.len = m_key.size();
+            }
+            step(2);
+            return true;
+        }
+
+        bool skip()
+        {
+            switch (*m_p) {
+                case '{': {
+                    if (!open('{')) {
+                        return false;
+                    }
+                    if (*m_p == '}') {
+                        close();
+                        return true;
+                    }
+                    native_key key;
+                    for (;;) {
+                        if (!read_key(key) || !skip()) {
+                            return false;
+                        }
+                        char c = *m_p;
+                        if (c == '}') {
+                            close();
+                            return true;
+                        }
+                        if (c != ',') {
+                            return fail("missing comma or '}' after an object member");
+                        }
+                        step(1);
+                    }
+                }
+                case '[':
+                    if (!open('[')) {
+                        return false;
+                    }
+                    if (*m_p == ']') {
+                        close();
+                        return true;
+                    }
+                    for (;;) {
+                        if (!skip()) {
+                            return false;
+                        }
+                        char c = *m_p;
+                        if (c == ']') {
+                            close();
+                            return true;
+                        }
+                        if (c != ',') {
+                            return fail("missing comma or ']' after an array element");
+                        }
+                        step(1);
+                    }
+                case '"': {
+                    const char *start = m_p + 1;
+                    const char *end = m_begin + m_index[m_token + 1];
+                    if (*end != '"') {
+                        return fail("missing quotation mark");
+                    }
+                    if (std::memchr(start, '\\', static_cast<std::size_t>(end - start)) != nullptr && !skip_string()) {
+                        return false;
+                    }
+                    step(2);
+                    return true;
+                }
+                case 't':
+                    return literal("true") && scalar_end();
+                case 'f':
+                    return literal("false") && scalar_end();
+                case 'n':
+                    return literal("null") && scalar_end();
+                default: {
+                    native_number n;
+                    if (!number(n)) {
+                        return fail("invalid value");
+                    }
+                    m_p = n.end;
+                    return scalar_end();
+                }
+            }
+        }
+
+        bool recover(const char *start, int level)
+        {
+            if (m_syntax_error) {
+                return false;
+            }
+            if (m_depth == level) {
+                return m_p == start ? skip() : true;
+            }
+            while (m_depth > level) {
+                char c = *m_p;
+                if (c == '}' || c == ']') {
+                    close();
+                } else if (c == ',' || c == ':') {
+                    step(1);
+                } else if (!skip()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        native_position seek(const char *value)
+        {
+            native_position position = {m_p, m_depth};
+            find(value);
+            return position;
+        }
+
+        void restore(const native_position &position)
+        {
+            find(position.p);
+            m_depth = position.depth;
+        }
+
+        bool finish()
+        {
+            if (m_token != m_count) {
+                return fail("the root is not the only value of the text");
+            }
+            return true;
+        }
+
+    private:
+        void step(std::size_t tokens)
+        {
+            m_token += tokens;
+            m_p = m_begin + m_index[m_token];
+        }
+
+        void close()
+        {
+            step(1);
+            --m_depth;
+        }
+
+        // A number or a literal must be followed by a white space or by the next token
+        bool scalar_end()
+        {
+            const char *next = m_begin + m_index[m_token + 1];
+            if (m_p != next && *m_p != ' ' && *m_p != '\n' && *m_p != '\r' && *m_p != '\t') {
+                return fail("invalid value");
+            }
+            step(1);
+            return true;
+        }
+
+        bool read_key(native_key &key)
+        {
+            if (*m_p != '"') {
+                return fail("missing name of an object member");
+            }
+            if (!read_name(key)) {
+                return false;
+            }
+            if (*m_p != ':') {
+                return fail("missing colon after an object member name");
+            }
+            step(1);
+            return true;
+        }
+
+        // Moves to the token at text
+        void find(const char *text)
+        {
+            uint32_t position = static_cast<uint32_t>(text - m_begin);
+            std::size_t low = 0;
+            std::size_t high = m_count;
+            while (low < high) {
+                std::size_t middle = low + (high - low) / 2;
+                if (m_index[middle] < position) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            m_token = low;
+            m_p = m_begin + m_index[m_token];
+        }
+
+        const uint32_t *m_index;
+        std::size_t m_count;
+        std::size_t m_token;
+    };
+
+)umison";
+
+  /**
+   * Native output engine reading the text in two stages. The first one builds the index of
+   * the structural chars of the text with SIMD, the second one is the parser of the native
+   * engine walking the index instead of the chars, so white space and the contents of the
+   * strings are not scanned again.
+   * */
+  template<typename T1, typename T2>
+  class output_engine_native_simd : public output_engine_native<T1, T2> {
+  public:
+    /**
+     * Constructor, internally will call the output_engine_native constructor
+     * */
+    output_engine_native_simd(T1 &_H_streamer, T2 &_CPP_streamer)
+      : output_engine_native<T1, T2>(_H_streamer, _CPP_streamer) {
+    }
+
+    /**
+     * Releases the resources used by this engine
+     * */
+    virtual ~output_engine_native_simd() {
+    }
+
+    /**
+     * The parsers read an index of the whole text, not the objects of the views
+     * */
+    virtual bool lazy_views() const {
+      return false;
+    }
+
+  protected:
+    /**
+     * The parsers walk the index
+     * */
+    virtual std::string reader_class() const {
+      return "native_index_reader";
+    }
+
+    /**
+     * A parser_context keeps the index between reads
+     * */
+    virtual std::vector<std::pair<std::string, std::string>> context_buffers() const {
+      std::vector<std::pair<std::string, std::string>> buffers(output_engine_native<T1, T2>::context_buffers());
+      buffers.emplace_back("uint32_t", "index");
+      return buffers;
+    }
+
+    /**
+     * Create the native reader and the index reader built on it
+     * */
+    virtual void create_native_runtime() {
+      output_engine_native<T1, T2>::create_native_runtime();
+      output_engine<T1, T2>::m_cpp_streamer << native_index_code;
+    }
+
+    /**
+     * Creates the index of the text and _reader walking it
+     * */
+    virtual void create_native_reader(const std::string &text, const std::string &len, bool context) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      if (context) {
+        streamer << def_1p_indentation << "std::vector<uint32_t> &_index = _context.index;\n";
+      } else {
+        streamer << def_1p_indentation << "std::vector<uint32_t> _index;\n";
+      }
+      streamer << def_1p_indentation << "if (!" << ns << "native_build_index(" << text << ", " << len
+      << ", _index, ss)) {\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << ns << "native_index_reader _reader(" << text << ", " << text << " + " << len
+      << ", _index.data(), _index.size() - 1, ss);\n";
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,1231 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONOUTENGINENATIVETABLE_H
+#define UMISON_UMISONOUTENGINENATIVETABLE_H
+
+#include "umisonoutenginenative.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Descriptors of the classes and the interpreter walking them. Every member is described by
+   * its offset in the object, the offset of its optional flag and its kind, the members that are
+   * classes, lists of classes or maps of classes point to the table of that class. The
+   * interpreter is the only code reading objects, the generated code left per class is its
+   * member lookup, its conditions and the functions adding an element to its lists and maps.
+   * */
+  static const char *native_table_code = R"umison(    // Kind of the value of a member, of the elements of a list and of the values of a map
+    enum native_kind : unsigned char {
+        kind_bool, kind_int, kind_int64, kind_double, kind_string, kind_class, kind_list, kind_map, kind_enum
+    };
+
+    // Names of the basic kinds used by the errors
+    static const char *const native_kind_names[] = {"Bool", "Int", "Int64", "Double", "String"};
+
+    // Offset of the optional flag of the members that have none
+    const std::size_t native_no_flag = ~static_cast<std::size_t>(0);
+
+    struct native_table;
+
+    // Condition of a member, it is evaluated on the object once the object has been closed
+    typedef bool (*native_condition)(void *object);
+
+    // Descriptor of one member
+    struct native_field {
+        const char *name;
+        std::size_t offset;
+        std::size_t optional_offset;
+        // Table of the class of the member, of its elements or of its values
+        const native_table *child;
+        native_condition condition;
+        native_kind kind;
+        // Kind of the elements of a list or of the values of a map
+        native_kind element;
+        bool required;
+        // Slot keeping the position of a member with a condition
+        int deferred;
+        // Reader of a list with an index, it adds the elements to the index while it reads them.
+        // The readers of an enum, an interned or an inline string are given the value instead of the object
+        bool (*read)(native_reader &r, void *object);
+        // Checker of a member kept aside by a filter, it is checked without being stored when the
+        // filter rejects the object
+        bool (*check)(native_reader &r);
+    };
+
+    // Descriptor of one class, the fields are in the order given by lookup
+    struct native_table {
+        const char *name;
+        const native_field *fields;
+        int count;
+        int (*lookup)(const char *str, std::size_t len);
+        // Mask of the members without a condition that must be found, 64 members per word
+        const unsigned long long int *required;
+        // The class is made only of one map
+        bool map;
+        // Set when the class is the element of a list or the value of a map
+        void *(*append)(void *list);
+        bool (*map_element)(native_reader &r, void *map, const std::string &key, const native_table &table);
+        // Filter of the elements of a list, the members with a slot and no condition are only read
+        // when it accepts the object, drop removes the last element of the list otherwise
+        native_condition filter;
+        void (*drop)(void *list);
+        // Parser of a variant, it reads the object in place of the fields
+        bool (*parse)(native_reader &r, void *object);
+    };
+
+    bool native_table_parse(native_reader &r, void *object, const native_table &table,
+                            const unsigned long long int *wanted = nullptr, bool *stopped = nullptr,
+                            bool *accepted = nullptr);
+
+    // Adds one element to a list of T and returns it
+    template<typename T>
+    void *native_append(void *list)
+    {
+        std::vector<T> &str = *static_cast<std::vector<T> *>(list);
+        str.emplace_back();
+        return &str.back();
+    }
+
+    // Removes the last element of a list of T
+    template<typename T>
+    void native_drop(void *list)
+    {
+        static_cast<std::vector<T> *>(list)->pop_back();
+    }
+
+    // Reads one object into a map of T, the element is dropped when it can't be read
+    template<typename T>
+    bool native_map_element(native_reader &r, void *map, const std::string &key, const native_table &table)
+    {
+        std::multimap<std::string, T> &str = *static_cast<std::multimap<std::string, T> *>(map);
+        const char *start = r.value();
+        const int depth = r.depth();
+        auto it = str.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+        if (!native_table_parse(r, &it->second, table)) {
+            str.erase(it);
+            r.out() << __FILE__ << ":" << __LINE__ << " Error data is not an " << table.name << "\n";
+            return r.recover(start, depth);
+        }
+        return true;
+    }
+
+    // Reads one value of a basic kind
+    bool native_read_basic(native_reader &r, void *value, native_kind kind)
+    {
+        switch (kind) {
+            case kind_bool:
+                return r.read_bool(*static_cast<bool *>(value));
+            case kind_int:
+                return r.read_int(*static_cast<int *>(value));
+            case kind_int64:
+                return r.read_int64(*static_cast<long long int *>(value));
+            case kind_double:
+                return r.read_double(*static_cast<double *>(value));
+            default:
+                return r.read_string(*static_cast<native_string *>(value));
+        }
+    }
+
+    template<typename T>
+    bool native_push_basic(native_reader &r, void *list, native_kind kind)
+    {
+        T value;
+        if (!native_read_basic(r, &value, kind)) {
+            return false;
+        }
+        static_cast<std::vector<T> *>(list)->push_back(value);
+        return true;
+    }
+
+    bool native_read_list(native_reader &r, void *list, const native_field &field)
+    {
+        if (!r.open('[')) {
+            r.out() << __FILE__ << ":" << __LINE__ << "Error data is not an array\n";
+            return false;
+        }
+        for (bool more = r.first_element(); more; more = r.next_element()) {
+            bool read = false;
+            switch (field.element) {
+                case kind_bool:
+                    read = native_push_basic<bool>(r, list, kind_bool);
+                    break;
+                case kind_int:
+                    read = native_push_basic<int>(r, list, kind_int);
+                    break;
+                case kind_int64:
+                    read = native_push_basic<long long int>(r, list, kind_int64);
+                    break;
+                case kind_double:
+                    read = native_push_basic<double>(r, list, kind_double);
+                    break;
+                case kind_string: {
+                    std::vector<native_string> &str = *static_cast<std::vector<native_string> *>(list);
+                    str.emplace_back();
+                    read = r.read_string(str.back());
+                    break;
+                }
+                default: {
+                    bool accepted = true;
+                    if (!native_table_parse(r, field.child->append(list), *field.child, nullptr, nullptr, &accepted)) {
+                        r.out() << __FILE__ << ":" << __LINE__ << " Error data is not an " << field.child->name << "\n";
+                        return false;
+                    }
+                    if (!accepted) {
+                        field.child->drop(list);
+                    }
+                    continue;
+                }
+            }
+            if (!read) {
+                r.out() << __FILE__ << ":" << __LINE__ << "Error data is not an " << native_kind_names[field.element]
+                        << "\n";
+                return false;
+            }
+        }
+        return !r.failed();
+    }
+
+    template<typename T>
+    bool native_insert_basic(native_reader &r, void *map, const native_key &key, native_kind kind)
+    {
+        std::multimap<std::string, T> &str = *static_cast<std::multimap<std::string, T> *>(map);
+        auto it = str.emplace(std::piecewise_construct, std::forward_as_tuple(key.str, key.len), std::forward_as_tuple());
+        return native_read_basic(r, &it->second, kind);
+    }
+
+    // The values of a map of classes are objects or arrays of objects and the rest is skipped,
+    // when objects is set they can only be objects
+    bool native_map_value(native_reader &r, void *map, const native_key &key, const native_table &table, bool objects)
+    {
+        char c = r.peek();
+        if (c == '{') {
+            return table.map_element(r, map, std::string(key.str, key.len), table);
+        }
+        if (objects) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Error map value is not Object\n";
+            return false;
+        }
+        if (c != '[') {
+            return r.skip();
+        }
+        std::string name(key.str, key.len);
+        if (!r.open('[')) {
+            return false;
+        }
+        for (bool element = r.first_element(); element; element = r.next_element()) {
+            if (!table.map_element(r, map, name, table)) {
+                return false;
+            }
+        }
+        return !r.failed();
+    }
+
+    bool native_read_map(native_reader &r, void *map, const native_field &field, bool objects)
+    {
+        if (!r.open('{')) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Element is not an object\n";
+            return false;
+        }
+        native_key key;
+        for (bool more = r.first_key(key); more; more = r.next_key(key)) {
+            bool read = false;
+            switch (field.element) {
+                case kind_bool:
+                    read = native_insert_basic<bool>(r, map, key, kind_bool);
+                    break;
+                case kind_int:
+                    read = native_insert_basic<int>(r, map, key, kind_int);
+                    break;
+                case kind_int64:
+                    read = native_insert_basic<long long int>(r, map, key, kind_int64);
+                    break;
+                case kind_double:
+                    read = native_insert_basic<double>(r, map, key, kind_double);
+                    break;
+                case kind_string:
+                    read = native_insert_basic<native_string>(r, map, key, kind_string);
+                    break;
+                default:
+                    if (!native_map_value(r, map, key, *field.child, objects)) {
+                        return false;
+                    }
+                    continue;
+            }
+            if (!read) {
+                r.out() << __FILE__ << ":" << __LINE__ << "Error map value is not a "
+                        << native_kind_names[field.element] << "\n";
+                return false;
+            }
+        }
+        return !r.failed();
+    }
+
+    // Reads one member with the kind it is declared with
+    bool native_read_field(native_reader &r, char *object, const native_field &field, const native_table &table)
+    {
+        void *value = object + field.offset;
+        if (field.kind == kind_list || field.kind == kind_class) {
+            if (r.peek() != (field.kind == kind_list ? '[' : '{')) {
+                r.out() << __FILE__ << ":" << __LINE__ << " Error entity: " << table.name << " is wrong type "
+                        << field.name << "\n";
+                return false;
+            }
+            if (field.read != nullptr) {
+                if (!field.read(r, object)) {
+                    r.out() << __FILE__ << ":" << __LINE__ << " Error reading list\n";
+                    return false;
+                }
+            } else if (field.kind == kind_list) {
+                if (!native_read_list(r, value, field)) {
+                    r.out() << __FILE__ << ":" << __LINE__ << " Error reading list\n";
+                    return false;
+                }
+            } else if (!native_table_parse(r, value, *field.child)) {
+                r.out() << __FILE__ << ":" << __LINE__ << " Error reading refclass\n";
+                return false;
+            }
+        } else if (field.read != nullptr ? !field.read(r, value) : !native_read_basic(r, value, field.kind)) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Error entity: " << table.name << " is wrong type "
+                    << field.name << "\n";
+            return false;
+        }
+        if (field.optional_offset != native_no_flag) {
+            *reinterpret_cast<bool *>(object + field.optional_offset) = true;
+        }
+        return true;
+    }
+
+    bool native_missing(native_reader &r, const native_table &table, const native_field &field)
+    {
+        r.out() << __FILE__ << ":" << __LINE__ << " Error entity: " << table.name
+                << " is missing mandatory entry or entity is not an object" << field.name << "\n";
+        return false;
+    }
+
+    // Reads one object described by table. Unknown and repeated members are skipped, the members
+    // with a condition are skipped too and read once the object has been closed, from the position
+    // they were found at. With wanted the object is left, setting stopped, once all the members in
+    // that mask have been found. accepted is cleared when the filter of the table rejects the object
+    bool native_table_parse(native_reader &r, void *object, const native_table &table,
+                            const unsigned long long int *wanted, bool *stopped, bool *accepted)
+    {
+        if (table.parse != nullptr) {
+            return table.parse(r, object);
+        }
+        char *base = static_cast<char *>(object);
+        if (table.map) {
+            const native_field &field = table.fields[0];
+            if (field.condition != nullptr && !field.condition(object)) {
+                return r.skip();
+            }
+            // The values of an optional map of classes must all be objects
+            if (!native_read_map(r, base + field.offset, field,
+                                 field.child != nullptr && field.optional_offset != native_no_flag)) {
+                r.out() << __FILE__ << ":" << __LINE__ << " Error reading map\n";
+                return false;
+            }
+            if (field.optional_offset != native_no_flag) {
+                *reinterpret_cast<bool *>(base + field.optional_offset) = true;
+            }
+            if (table.filter != nullptr && !table.filter(object)) {
+                *accepted = false;
+            }
+            return true;
+        }
+        if (!r.open('{')) {
+            r.out() << __FILE__ << ":" << __LINE__ << " Element is not an object\n";
+            return false;
+        }
+        unsigned long long int seen[native_seen_words] = {};
+        const char *deferred[native_max_deferred];
+        native_key key;
+        for (bool more = r.first_key(key); more; more = r.next_key(key)) {
+            const int index = table.lookup(key.str, key.len);
+            if (index < 0 || (seen[index / 64] & (1ULL << (index % 64)))) {
+                if (!r.skip()) {
+                    return false;
+                }
+                continue;
+            }
+            seen[index / 64] |= 1ULL << (index % 64);
+            const native_field &field = table.fields[index];
+            if (field.deferred >= 0) {
+                deferred[field.deferred] = r.value();
+                if (!r.skip()) {
+                    return false;
+                }
+            } else if (!native_read_field(r, base, field, table)) {
+                return false;
+            }
+            if (wanted != nullptr) {
+                int word = 0;
+                while (word * 64 < table.count && (seen[word] & wanted[word]) == wanted[word]) {
+                    ++word;
+                }
+                // The end of the object is read as usual, the text is then validated
+                if (word * 64 >= table.count && r.peek() != '}') {
+                    *stopped = true;
+                    break;
+                }
+            }
+        }
+        if (r.failed()) {
+            return false;
+        }
+        // Mandatory members, one mask per word and the detail only on failure
+        for (int word = 0; word * 64 < table.count; ++word) {
+            if ((seen[word] & table.required[word]) == table.required[word]) {
+                continue;
+            }
+            for (int i = word * 64; i < table.count; ++i) {
+                if ((table.required[word] & ~seen[word]) & (1ULL << (i % 64))) {
+                    return native_missing(r, table, table.fields[i]);
+                }
+            }
+        }
+        // Members with a condition, the consecutive ones with the same condition share its result
+        native_condition condition = nullptr;
+        bool active = false;
+        for (int i = 0; i < table.count; ++i) {
+            const native_field &field = table.fields[i];
+            if (field.condition == nullptr) {
+                continue;
+            }
+            if (field.condition != condition) {
+                condition = field.condition;
+                active = condition(object);
+            }
+            if (!active) {
+                continue;
+            }
+            if (!(seen[i / 64] & (1ULL << (i % 64)))) {
+                if (field.required) {
+                    return native_missing(r, table, field);
+                }
+                continue;
+            }
+            const native_position resume = r.seek(deferred[field.deferred]);
+            const bool read = native_read_field(r, base, field, table);
+            r.restore(resume);
+            if (!read) {
+                return false;
+            }
+        }
+        if (table.filter == nullptr) {
+            return true;
+        }
+        if (!table.filter(object)) {
+            // The members kept aside are only checked, as validate does
+            for (int i = 0; i < table.count; ++i) {
+                const native_field &field = table.fields[i];
+                if (field.check == nullptr || !(seen[i / 64] & (1ULL << (i % 64)))) {
+                    continue;
+                }
+                const native_position resume = r.seek(deferred[field.deferred]);
+                const bool checked = field.check(r);
+                r.restore(resume);
+                if (!checked) {
+                    return false;
+                }
+            }
+            *accepted = false;
+            return true;
+        }
+        // Members kept aside by the filter, the mandatory ones have been found
+        for (int i = 0; i < table.count; ++i) {
+            const native_field &field = table.fields[i];
+            if (field.condition != nullptr || field.deferred < 0 || !(seen[i / 64] & (1ULL << (i % 64)))) {
+                continue;
+            }
+            const native_position resume = r.seek(deferred[field.deferred]);
+            const bool read = native_read_field(r, base, field, table);
+            r.restore(resume);
+            if (!read) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+)umison";
+
+  /**
+   * Native output engine driven by tables, the .cpp describes every class with a constexpr
+   * array of its members and one interpreter reads all of them with the native reader. The
+   * parse code doesn't grow with the number of members, so the generated code is smaller and
+   * the same loop stays hot in the instruction cache for every class.
+   * */
+  template<typename T1, typename T2>
+  class output_engine_native_table : public output_engine_native<T1, T2> {
+  public:
+    /**
+     * Constructor, internally will call the output_engine_native constructor
+     * */
+    output_engine_native_table(T1 &_H_streamer, T2 &_CPP_streamer)
+      : output_engine_native<T1, T2>(_H_streamer, _CPP_streamer) {
+    }
+
+    /**
+     * Releases the resources used by this engine
+     * */
+    virtual ~output_engine_native_table() {
+    }
+
+    /**
+     * umison_fields gives the tables the offsets of the attributes
+     * */
+    virtual std::vector<std::string> additional_friends() const {
+      return std::vector<std::string>{"umison_fields"};
+    }
+
+  protected:
+    typedef typename output_engine_native<T1, T2>::native_entity native_entity;
+    typedef typename output_engine_native<T1, T2>::native_filter native_filter;
+    typedef typename output_engine_native<T1, T2>::index_list index_list;
+
+    /**
+     * Method used to write the .cpp content to the cpp stream
+     *
+     * \param ff with the XML template already built
+     * */
+    virtual bool internal_write(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::vector<native_entity> entities;
+      for (auto &class_it: ff->getClassMap()) {
+        entities.push_back(native_entity{class_it.second, class_it.first, class_it.first, false});
+      }
+      for (auto &class_it: ff->getJsonArray()) {
+        entities.push_back(native_entity{class_it, class_it->name() + "__json", "umison::" + class_it->name(), true});
+      }
+      std::set<std::string> &listed = m_listed;
+      std::set<std::string> &mapped = m_mapped;
+      size_t words = 1;
+      int deferred = 1;
+      for (auto &entity: entities) {
+        auto &children = entity.cls->getChildren();
+        int count = 0;
+        for (auto &child: children) {
+          if (child->isMap() && children.size() > 1) {
+            std::cerr << "Error: More than one element on the same level within a map\n";
+            exit(-1);
+          }
+          if (type_to_cpp().get_type(child->refclass()).empty()) {
+            if (child->isList()) {
+              listed.insert(child->refclass());
+            } else if (child->isMap()) {
+              mapped.insert(child->refclass());
+            }
+          }
+          if (!child->condition().empty()) {
+            ++count;
+          }
+        }
+        words = std::max<size_t>(words, (children.size() + 63) / 64);
+        deferred = std::max(deferred, count);
+      }
+      // The lists with a filter read their elements with a table of their own
+      std::vector<std::pair<native_entity, native_filter>> filters;
+      for (auto &entity: entities) {
+        for (auto &child: entity.cls->getChildren()) {
+          if (!child->isList() || child->filter().empty()) {
+            continue;
+          }
+          for (auto &element: entities) {
+            if (!element.json && element.prefix == child->refclass()) {
+              native_filter filter{native_filter_table(entity.cls->name(), child), child->filter()};
+              std::vector<bool> late(this->native_late(element, &filter));
+              int count = static_cast<int>(std::count(late.begin(), late.end(), true));
+              for (auto &member: element.cls->getChildren()) {
+                count += member->condition().empty() ? 0 : 1;
+              }
+              deferred = std::max(deferred, count);
+              filters.emplace_back(element, filter);
+            }
+          }
+        }
+      }
+
+      this->create_disclaimer();
+      this->create_includes();
+      create_native_fields(entities, true);
+      // Create the internal namespace
+      streamer << "namespace __internal__umison" << output_engine<T1, T2>::m_additional_string << " {\n\n";
+      this->create_native_runtime();
+      streamer << TABS << "typedef " << this->native_value_type(UMI_XMLTAGS_STRING) << " native_string;\n"
+      << TABS << "const int native_seen_words = " << words << ";\n"
+      << TABS << "const int native_max_deferred = " << deferred << ";\n\n"
+      << native_table_code;
+      this->create_index_builders(ff);
+      create_native_fields(entities, false);
+      this->create_member_lookups(ff);
+      this->create_native_enum_readers(ff);
+      this->create_native_intern_reader(ff);
+      if (ff->interned()) {
+        streamer << TABS << "bool native_table_read_interned(native_reader &r, void *value)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return native_read_interned(r, *static_cast<umison_interned *>(value));\n"
+        << TABS << "}\n\n";
+      }
+      this->create_native_bounded_reader(ff);
+      if (ff->bounded()) {
+        streamer << TABS << "template<std::size_t N>\n"
+        << TABS << "bool native_table_read_bounded(native_reader &r, void *value)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return native_read_bounded(r, *static_cast<umison_inline_string<N> *>(value));\n"
+        << TABS << "}\n\n";
+      }
+      for (auto &enum_node: ff->getEnumArray()) {
+        streamer << TABS << "bool " << enum_node->name() << "__table_read(native_reader &r, void *value)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return " << enum_node->name() << "__native_read(r, *static_cast<" << enum_node->name()
+        << " *>(value));\n"
+        << TABS << "}\n\n";
+      }
+      streamer << TABS << "// Member conditions\n";
+      for (auto &entity: entities) {
+        create_native_conditions(entity);
+      }
+      for (auto &filter: filters) {
+        streamer << TABS << "bool " << filter.second.name << "__accept(void *object)\n"
+        << TABS << "{\n"
+        << TABS << TABS << filter.first.type << " &inout = *static_cast<" << filter.first.type << " *>(object);\n"
+        << TABS << TABS << "return (inout." << filter.second.expression << ");\n"
+        << TABS << "}\n\n";
+        std::vector<bool> late(this->native_late(filter.first, &filter.second));
+        for (size_t i = 0; i < late.size(); ++i) {
+          if (late[i]) {
+            streamer << TABS << "bool " << native_filter_check(filter.second, filter.first.cls->getChildren()[i])
+            << "(native_reader &r);\n";
+          }
+        }
+      }
+      auto indexed(this->index_lists(ff));
+      if (!indexed.empty()) {
+        streamer << TABS << "// Readers of the lists with an index\n";
+        for (auto &list: indexed) {
+          streamer << TABS << "bool " << this->native_filter_list(list.owner->name(), list.element)
+          << "(native_reader &r, void *object);\n";
+        }
+      }
+      streamer << "\n" << TABS << "// Class tables\n";
+      for (auto &entity: entities) {
+        streamer << TABS << "extern const native_table " << entity.prefix << "__table;\n";
+      }
+      for (auto &filter: filters) {
+        streamer << TABS << "extern const native_table " << filter.second.name << "__table;\n";
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << TABS << "extern const native_table " << variant->name() << "__table;\n";
+      }
+      streamer << "\n";
+      for (auto &entity: entities) {
+        create_native_table(entity, listed.count(entity.prefix) > 0, mapped.count(entity.prefix) > 0);
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        create_native_variant_table(variant);
+      }
+      for (auto &filter: filters) {
+        create_native_table(filter.first, true, false, nullptr, &filter.second);
+      }
+      for (auto &list: indexed) {
+        create_native_index_reader(list);
+      }
+      streamer << TABS << "// Data parsers\n";
+      for (auto &entity: entities) {
+        if (entity.json) {
+          streamer << TABS << "bool " << entity.prefix << "__native_parse(native_reader &r, " << entity.type
+          << " &inout)\n"
+          << TABS << "{\n"
+          << TABS << TABS << "return native_table_parse(r, &inout, " << entity.prefix << "__table);\n"
+          << TABS << "}\n\n";
+        }
+      }
+      this->create_native_streams(entities);
+      create_native_projections(ff, entities);
+      create_native_prefix_parsers(ff, entities);
+      this->create_native_validator_declarations(ff, entities);
+      this->create_native_validators(ff, entities);
+      create_native_filter_checks(filters);
+      if (ff->lazy_views()) {
+        streamer << native_view_code;
+        this->create_native_decoded_views(ff);
+      }
+      // Close the namespace
+      streamer << "}\n\n";
+      // Create the memory kept between reads
+      this->create_parser_context(std::vector<std::string>(), this->context_buffers());
+      this->create_index_finders(ff);
+      // Create the final parsers
+      streamer << "// Json parsers\n";
+      for (auto &entity: entities) {
+        if (!entity.json) {
+          continue;
+        }
+        this->create_default_method_read(entity.cls);
+        if (!output_engine<T1, T2>::m_string_view) {
+          this->create_native_read_data(entity, false, false);
+        }
+        streamer << "\n";
+        this->create_native_read_data(entity, true, false);
+        streamer << "\n";
+        this->create_native_read_data(entity, false, true);
+        streamer << "\n";
+        this->create_buffer_readers(entity.cls);
+        streamer << "\n";
+        this->create_native_validate(entity);
+        this->create_native_streaming_read_data(entity);
+        for (auto &projection: ff->getProjections()) {
+          if (projection->json() == entity.cls->name()) {
+            this->create_native_projection_read_data(entity, *projection);
+          }
+        }
+        if (entity.cls->read_prefix()) {
+          this->create_native_prefix_read_data(entity, nullptr);
+          for (auto &projection: ff->getProjections()) {
+            if (projection->json() == entity.cls->name()) {
+              this->create_native_prefix_read_data(entity, projection.get());
+            }
+          }
+        }
+      }
+      if (ff->lazy_views()) {
+        this->create_native_views(entities);
+      }
+      return true;
+    }
+
+    /**
+     * The members are read by the interpreter from the table of the entity
+     * */
+    virtual void _native_field(T2 &streamer, const native_entity &entity, size_t index, const std::string &on_fail,
+                               int level) {
+      std::string def_indentation(build_indentation(TABS, level));
+      streamer << def_indentation << "if (!native_read_field(r, reinterpret_cast<char *>(&inout), " << entity.prefix
+      << "__fields[" << index << "], " << entity.prefix << "__table)) {\n"
+      << on_fail
+      << def_indentation << TABS << "return false;\n"
+      << def_indentation << "}\n";
+    }
+
+    /**
+     * The elements of the streamed lists are read by the interpreter, with the table of the
+     * filter of the list when it has one
+     * */
+    virtual std::string native_stream_element(const std::string &owner, const std::shared_ptr<umixmltype> &element) const {
+      if (!element->filter().empty()) {
+        return "native_table_parse(r, &element, " + native_filter_table(owner, element)
+               + "__table, nullptr, nullptr, &accepted)";
+      }
+      return "native_table_parse(r, &element, " + element->refclass() + "__table)";
+    }
+
+    /**
+     * The classes are read by the interpreter from their tables
+     * */
+    virtual std::string native_parse_call(const native_entity &entity, const std::string &out) const {
+      if (entity.json) {
+        return output_engine_native<T1, T2>::native_parse_call(entity, out);
+      }
+      return "native_table_parse(_reader, &" + out + ", __internal__umison" + output_engine<T1, T2>::m_additional_string
+             + "::" + entity.prefix + "__table)";
+    }
+
+    /**
+     * The projections are tables of their own, the members they don't select are skipped as the
+     * unknown ones by the lookup and none of them is required
+     * */
+    virtual void create_native_projections(std::shared_ptr<umi::umixml> &ff, const std::vector<native_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      for (auto &projection: ff->getProjections()) {
+        streamer << TABS << "// Tables of the projection " << projection->name() << "\n";
+        for (auto &entity: entities) {
+          if (!entity.json && projection->partial(entity.cls->name())) {
+            streamer << TABS << "extern const native_table " << entity.prefix << "__" << projection->name()
+            << "__table;\n";
+          }
+        }
+        streamer << "\n";
+        for (auto &entity: entities) {
+          if (entity.json ? entity.cls->name() != projection->json() : !projection->partial(entity.cls->name())) {
+            continue;
+          }
+          if (!this->is_map_entity(entity)) {
+            create_native_projection_lookup(entity, *projection);
+          }
+          create_native_table(entity, m_listed.count(entity.prefix) > 0, m_mapped.count(entity.prefix) > 0,
+                              projection.get());
+          if (entity.json) {
+            streamer << TABS << "bool " << this->native_parse_name(entity.prefix, projection.get())
+            << "(native_reader &r, " << entity.type << " &inout)\n"
+            << TABS << "{\n"
+            << TABS << TABS << "return native_table_parse(r, &inout, " << entity.prefix << "__"
+            << projection->name() << "__table);\n"
+            << TABS << "}\n\n";
+          }
+        }
+      }
+    }
+
+    /**
+     * The parsers of read_data_prefix give the interpreter the mask of the members to wait for
+     * */
+    virtual void create_native_prefix_parsers(std::shared_ptr<umi::umixml> &ff,
+                                              const std::vector<native_entity> &entities) {
+      for (auto &entity: entities) {
+        if (!entity.json || !entity.cls->read_prefix()) {
+          continue;
+        }
+        output_engine<T1, T2>::m_cpp_streamer << TABS << "// Parsers of read_data_prefix of " << entity.cls->name()
+        << "\n";
+        create_native_prefix_parser(entity, nullptr);
+        for (auto &projection: ff->getProjections()) {
+          if (projection->json() == entity.cls->name()) {
+            create_native_prefix_parser(entity, projection.get());
+          }
+        }
+      }
+    }
+
+    /**
+     * Create the parser of read_data_prefix of a json, or of one of its projections
+     * */
+    void create_native_prefix_parser(const native_entity &entity, const umixmlprojection *projection) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string table(entity.prefix + (projection != nullptr ? "__" + projection->name() : "") + "__table");
+      std::string name(this->native_parse_name(entity.prefix, projection, true));
+      std::vector<unsigned long long> wanted;
+      if (!this->is_map_entity(entity)) {
+        wanted = this->native_wanted(entity, projection);
+      }
+      if (!wanted.empty()) {
+        std::string mask_name(name.substr(0, name.size() - std::string("native_parse").size()) + "wanted");
+        streamer << TABS << "constexpr unsigned long long int " << mask_name << "[] = {";
+        for (size_t word = 0; word < wanted.size(); ++word) {
+          std::ostringstream mask;
+          mask << "0x" << std::hex << wanted[word] << "ULL";
+          streamer << (word > 0 ? ", " : "") << mask.str();
+        }
+        streamer << "};\n"
+        << TABS << "bool " << name << "(native_reader &r, " << entity.type << " &inout, bool &stopped)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return native_table_parse(r, &inout, " << table << ", " << mask_name << ", &stopped);\n"
+        << TABS << "}\n\n";
+      } else {
+        streamer << TABS << "bool " << name << "(native_reader &r, " << entity.type << " &inout, bool &)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "return native_table_parse(r, &inout, " << table << ");\n"
+        << TABS << "}\n\n";
+      }
+    }
+
+    /**
+     * Name of the table reading the elements of a list with a filter, owner is the class or json
+     * of the list
+     * */
+    static std::string native_filter_table(const std::string &owner, const std::shared_ptr<umixmltype> &element) {
+      return owner + "__" + element->name() + "__filter";
+    }
+
+    /**
+     * Name of the checker of a member a filter keeps aside, used when the filter rejects the object
+     * */
+    static std::string native_filter_check(const native_filter &filter, const std::shared_ptr<umixmltype> &member) {
+      return filter.name + "__" + member->name() + "__native_check";
+    }
+
+    /**
+     * Create the lookup of an entity in a projection, it only finds the members selected
+     * */
+    void create_native_projection_lookup(const native_entity &entity, const umixmlprojection &projection) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string prefix(entity.prefix + "__" + projection.name());
+      std::vector<bool> selected(this->native_selected(entity, &projection));
+      streamer << TABS << "constexpr unsigned long long int " << prefix << "__selected[] = {";
+      for (size_t word = 0; word * 64 < std::max<size_t>(selected.size(), 1); ++word) {
+        unsigned long long int mask = 0;
+        for (size_t i = word * 64; i < selected.size() && i < (word + 1) * 64; ++i) {
+          if (selected[i]) {
+            mask |= 1ULL << (i % 64);
+          }
+        }
+        std::ostringstream hex_mask;
+        hex_mask << "0x" << std::hex << mask << "ULL";
+        streamer << (word > 0 ? ", " : "") << hex_mask.str();
+      }
+      streamer << "};\n"
+      << TABS << "int " << prefix << "__field(const char *str, std::size_t len)\n"
+      << TABS << "{\n"
+      << TABS << TABS << "const int index = " << entity.prefix << "__field(str, len);\n"
+      << TABS << TABS << "return index >= 0 && (" << prefix << "__selected[index / 64] & (1ULL << (index % 64))) ? "
+      << "index : -1;\n"
+      << TABS << "}\n";
+    }
+
+    /**
+     * Name of the offset of one attribute in umison_fields
+     * */
+    static std::string native_offset(const native_entity &entity, const std::string &attribute) {
+      return (entity.json ? "umison::" : "") + std::string("umison_fields::") + entity.cls->name() + "__" + attribute;
+    }
+
+    /**
+     * Create umison_fields with the offsets of the attributes, of the jsons in the namespace
+     * umison or of the classes in the internal one. The classes with maps aren't standard
+     * layout, offsetof works on them as they have no virtual bases
+     * */
+    void create_native_fields(const std::vector<native_entity> &entities, bool json) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(json ? "" : TABS);
+      std::string def_1p_indentation(def_indentation + TABS);
+      streamer << "#if defined(__GNUC__)\n"
+      << "#pragma GCC diagnostic push\n"
+      << "#pragma GCC diagnostic ignored \"-Winvalid-offsetof\"\n"
+      << "#endif\n";
+      if (json) {
+        streamer << "namespace umison {\n\n";
+      }
+      streamer << def_indentation << "// Offsets of the attributes used by the tables\n"
+      << def_indentation << "struct umison_fields {\n";
+      for (auto &entity: entities) {
+        if (entity.json != json) {
+          continue;
+        }
+        std::string name(entity.cls->name());
+        for (auto &element: entity.cls->getChildren()) {
+          std::string attribute(umixmltype::attribute_prepocess(element->name()));
+          streamer << def_1p_indentation << "static constexpr std::size_t " << name << "__" << attribute
+          << " = offsetof(" << name << ", " << attribute << ");\n";
+          if (element->optional()) {
+            streamer << def_1p_indentation << "static constexpr std::size_t " << name << "__"
+            << element->optional_name() << " = offsetof(" << name << ", " << element->optional_name() << ");\n";
+          }
+        }
+      }
+      streamer << def_indentation << "};\n\n";
+      if (json) {
+        streamer << "}\n\n";
+      }
+      streamer << "#if defined(__GNUC__)\n"
+      << "#pragma GCC diagnostic pop\n"
+      << "#endif\n\n";
+    }
+
+    /**
+     * Kind of a basic type or of a class
+     * */
+    static std::string native_kind(const std::string &refclass) {
+      if (refclass == UMI_XMLTAGS_BOOLEAN) {
+        return "kind_bool";
+      } else if (refclass == UMI_XMLTAGS_INTEGER32) {
+        return "kind_int";
+      } else if (refclass == UMI_XMLTAGS_INTEGER) {
+        return "kind_int64";
+      } else if (refclass == UMI_XMLTAGS_FLOAT) {
+        return "kind_double";
+      } else if (refclass == UMI_XMLTAGS_STRING) {
+        return "kind_string";
+      }
+      return "kind_class";
+    }
+
+    /**
+     * Kind of a member
+     * */
+    static std::string native_member_kind(const std::shared_ptr<umixmltype> &element) {
+      if (element->isList()) {
+        return "kind_list";
+      } else if (element->isMap()) {
+        return "kind_map";
+      } else if (element->isRefClass()) {
+        return "kind_class";
+      } else if (element->isBoolean()) {
+        return native_kind(UMI_XMLTAGS_BOOLEAN);
+      } else if (element->isInteger32()) {
+        return native_kind(UMI_XMLTAGS_INTEGER32);
+      } else if (element->isInteger()) {
+        return native_kind(UMI_XMLTAGS_INTEGER);
+      } else if (element->isFloat()) {
+        return native_kind(UMI_XMLTAGS_FLOAT);
+      } else if (element->isString()) {
+        return native_kind(UMI_XMLTAGS_STRING);
+      } else if (element->isEnum()) {
+        return "kind_enum";
+      }
+      std::cerr << "Invalid element: " << element->name() << "\n";
+      exit(-1);
+    }
+
+    /**
+     * Name of the function evaluating one condition of an entity
+     * */
+    static std::string native_condition(const native_entity &entity, const std::shared_ptr<umixmltype> &element) {
+      auto &elements = entity.cls->getChildren();
+      int index = 0;
+      for (auto &it: elements) {
+        if (it->condition() == element->condition()) {
+          break;
+        }
+        if (!it->condition().empty()) {
+          ++index;
+        }
+      }
+      return entity.prefix + "__condition_" + std::to_string(index);
+    }
+
+    /**
+     * Create the functions evaluating the conditions of one entity, one per condition
+     * */
+    void create_native_conditions(const native_entity &entity) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::set<std::string> created;
+      for (auto &element: entity.cls->getChildren()) {
+        if (element->condition().empty() || created.count(element->condition()) > 0) {
+          continue;
+        }
+        created.insert(element->condition());
+        streamer << TABS << "bool " << native_condition(entity, element) << "(void *object)\n"
+        << TABS << "{\n"
+        << TABS << TABS << entity.type << " &inout = *static_cast<" << entity.type << " *>(object);\n"
+        << TABS << TABS << "return (inout." << element->condition() << ");\n"
+        << TABS << "}\n\n";
+      }
+    }
+
+    /**
+     * Create the checkers of the members the filters keep aside, they use the validators of
+     * validate so nothing is stored
+     * */
+    void create_native_filter_checks(const std::vector<std::pair<native_entity, native_filter>> &filters) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      for (auto &filter: filters) {
+        auto &elements = filter.first.cls->getChildren();
+        std::vector<bool> late(this->native_late(filter.first, &filter.second));
+        for (size_t i = 0; i < elements.size(); ++i) {
+          if (!late[i]) {
+            continue;
+          }
+          streamer << TABS << "bool " << native_filter_check(filter.second, elements[i]) << "(native_reader &r)\n"
+          << TABS << "{\n";
+          this->_native_validate_member(streamer, TABS, filter.first, elements[i], "", 2);
+          streamer << TABS << TABS << "return true;\n"
+          << TABS << "}\n\n";
+        }
+      }
+    }
+
+    /**
+     * Create the table of one entity
+     *
+     * \param listed true when the entity is the element of a list
+     * \param mapped true when the entity is the value of a map
+     * \param projection the table only reads the members it selects, nullptr for all of them
+     * \param filter the table reads the elements of a list with that filter, its members kept aside
+     * get a slot
+     * */
+    void create_native_table(const native_entity &entity, bool listed, bool mapped,
+                             const umixmlprojection *projection = nullptr, const native_filter *filter = nullptr) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string prefix(entity.prefix + (projection != nullptr ? "__" + projection->name() : ""));
+      if (filter != nullptr) {
+        prefix = filter->name;
+      }
+      auto &elements = entity.cls->getChildren();
+      std::vector<bool> selected(this->native_selected(entity, projection));
+      std::vector<bool> late(this->native_late(entity, filter));
+      bool map = this->is_map_entity(entity);
+      size_t words = std::max<size_t>((elements.size() + 63) / 64, 1);
+      std::vector<unsigned long long> required(words, 0);
+      int deferred = 0;
+      if (!elements.empty()) {
+        streamer << TABS << "constexpr native_field " << prefix << "__fields[] = {\n";
+        for (size_t i = 0; i < elements.size(); ++i) {
+          auto &element = elements[i];
+          std::string element_kind(native_member_kind(element));
+          if (element->isList() || element->isMap()) {
+            element_kind = native_kind(element->refclass());
+          }
+          std::string child("nullptr");
+          std::string read("nullptr");
+          if (element->isList() && !element->filter().empty()) {
+            // The filter may use any member of the elements, so they are read whole
+            child = "&" + native_filter_table(entity.cls->name(), element) + "__table";
+          } else if (element->isList() && !element->index().empty()) {
+            // The index needs the key of the elements, so they are read whole
+            child = "&" + element->refclass() + "__table";
+          } else if (element->isRefClass() || ((element->isList() || element->isMap()) && element_kind == "kind_class")) {
+            child = "&" + element->refclass() + (projection != nullptr && projection->partial(element->refclass())
+                                                 ? "__" + projection->name() : "") + "__table";
+          }
+          if (!element->index().empty()) {
+            read = this->native_filter_list(entity.cls->name(), element);
+          } else if (element->isEnum()) {
+            read = element->enum_type() + "__table_read";
+          } else if (element->intern()) {
+            read = "native_table_read_interned";
+          } else if (element->bounded()) {
+            read = "native_table_read_bounded<" + std::to_string(element->maxlen()) + ">";
+          }
+          std::string condition("nullptr");
+          std::string slot("-1");
+          std::string check("nullptr");
+          if (!element->condition().empty()) {
+            condition = native_condition(entity, element);
+            slot = std::to_string(deferred++);
+          } else {
+            if (late[i]) {
+              slot = std::to_string(deferred++);
+              check = native_filter_check(*filter, element);
+            }
+            if (!element->optional() && selected[i]) {
+              required[i / 64] |= 1ULL << (i % 64);
+            }
+          }
+          streamer << def_1p_indentation << "{\"" << element->name() << "\", "
+          << native_offset(entity, umixmltype::attribute_prepocess(element->name())) << ", "
+          << (element->optional() ? native_offset(entity, element->optional_name()) : "native_no_flag") << ", "
+          << child << ", " << condition << ", " << native_member_kind(element) << ", " << element_kind << ", "
+          << (element->optional() || !selected[i] ? "false" : "true") << ", " << slot << ", "
+          << read << ", " << check << "},\n";
+        }
+        streamer << TABS << "};\n";
+      }
+      streamer << TABS << "constexpr unsigned long long int " << prefix << "__required[] = {";
+      for (size_t word = 0; word < words; ++word) {
+        std::ostringstream mask;
+        mask << "0x" << std::hex << required[word] << "ULL";
+        streamer << (word > 0 ? ", " : "") << mask.str();
+      }
+      streamer << "};\n"
+      << TABS << "constexpr native_table " << prefix << "__table = {\n"
+      << def_1p_indentation << "\"" << entity.cls->name() << "\", "
+      << (elements.empty() ? "nullptr" : prefix + "__fields") << ", " << elements.size() << ", "
+      << (map ? "nullptr" : (filter != nullptr ? entity.prefix : prefix) + "__field") << ", " << prefix << "__required, "
+      << (map ? "true" : "false") << ",\n"
+      << def_1p_indentation << (listed ? "native_append<" + entity.type + ">" : "nullptr") << ", "
+      << (mapped ? "native_map_element<" + entity.type + ">" : "nullptr") << ",\n"
+      << def_1p_indentation << (filter != nullptr ? prefix + "__accept" : "nullptr") << ", "
+      << (filter != nullptr ? "native_drop<" + entity.type + ">" : "nullptr") << ", nullptr\n"
+      << TABS << "};\n\n";
+    }
+
+    /**
+     * Create the table of one variant, its parser finds the tag and reads the object with the
+     * table of the class of the case
+     * */
+    void create_native_variant_table(const std::shared_ptr<umixmlvariant> &variant) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      const std::string &name(variant->name());
+      this->create_native_variant_parse(variant, false);
+      streamer << TABS << "bool " << name << "__table_parse(native_reader &r, void *object)\n"
+      << TABS << "{\n"
+      << def_1p_indentation << "return " << name << "__native_parse(r, *static_cast<" << name << " *>(object));\n"
+      << TABS << "}\n"
+      << TABS << "constexpr native_table " << name << "__table = {\n"
+      << def_1p_indentation << "\"" << name << "\", nullptr, 0, nullptr, nullptr, false,\n"
+      << def_1p_indentation << (m_listed.count(name) > 0 ? "native_append<" + name + ">" : "nullptr")
+      << ", nullptr,\n"
+      << def_1p_indentation << "nullptr, nullptr, " << name << "__table_parse\n"
+      << TABS << "};\n\n";
+    }
+
+    /**
+     * The classes of the cases of the variants are read by the interpreter from their tables
+     * */
+    virtual std::string native_case_parse(const std::string &refclass, const std::string &object) const {
+      return "native_table_parse(r, &" + object + ", " + refclass + "__table)";
+    }
+
+    /**
+     * Create the reader of a list with an index, the elements are parsed with the table of their
+     * class, or of the filter of the list, and added to the index as soon as they are kept
+     * */
+    void create_native_index_reader(const index_list &list) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string def_2p_indentation(build_indentation(TABS, 3));
+      std::string def_3p_indentation(build_indentation(TABS, 4));
+      auto &owner = list.owner;
+      auto &element = list.element;
+      std::string type((list.json ? "umison::" : "") + owner->name());
+      bool filtered = !element->filter().empty();
+      std::string table(filtered ? native_filter_table(owner->name(), element) : element->refclass());
+      streamer << TABS << "bool " << this->native_filter_list(owner->name(), element) << "(native_reader &r, void *object)\n"
+      << TABS << "{\n"
+      << def_1p_indentation << type << " &inout = *static_cast<" << type << " *>(object);\n"
+      << def_1p_indentation << "std::vector<" << element->refclass() << "> &str = inout.mutable_" << element->name()
+      << "();\n"
+      << def_1p_indentation << "umison_index &index = inout.mutable_" << element->index_name() << "();\n"
+      << def_1p_indentation << "if (!r.open('[')) {\n"
+      << def_2p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \"Error data is not an array\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "// The index covers the list only when it was empty before, otherwise find builds it again\n"
+      << def_1p_indentation << "const std::size_t first = str.size();\n"
+      << def_1p_indentation << "index.clear();\n"
+      << def_1p_indentation << "for (bool more = r.first_element(); more; more = r.next_element()) {\n"
+      << def_2p_indentation << "str.emplace_back();\n";
+      if (filtered) {
+        streamer << def_2p_indentation << "bool accepted = true;\n"
+        << def_2p_indentation << "if (!native_table_parse(r, &str.back(), " << table
+        << "__table, nullptr, nullptr, &accepted)) {\n";
+      } else {
+        streamer << def_2p_indentation << "if (!native_table_parse(r, &str.back(), " << table << "__table)) {\n";
+      }
+      streamer << def_3p_indentation << "r.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+      << element->refclass() << "\\n\";\n"
+      << def_3p_indentation << "return false;\n"
+      << def_2p_indentation << "}\n";
+      if (filtered) {
+        streamer << def_2p_indentation << "if (!accepted) {\n"
+        << def_3p_indentation << "str.pop_back();\n"
+        << def_3p_indentation << "continue;\n"
+        << def_2p_indentation << "}\n";
+      }
+      streamer << def_2p_indentation << this->index_insert_name(element) << "(str, str.size() - 1, index);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "if (first == 0) {\n"
+      << def_2p_indentation << "index.valid = true;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return !r.failed();\n"
+      << TABS << "}\n\n";
+    }
+
+    /**
+     * Classes that are the elements of a list or the values of a map
+     * */
+    std::set<std::string> m_listed;
+    std::set<std::string> m_mapped;
+  };
+}
+
+#endif
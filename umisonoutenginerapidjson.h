@@ -27,8 +27,15 @@
 #define UMISON_UMISONOUTENGINERAPIDJSON_H_H
 
 #include "umisonoutputengine.h"
+#include "umisonperfecthash.h"
+#include <algorithm>
+#include <set>
+#include <sstream>
 
 namespace umi {
+  template<typename T1, typename T2>
+  class output_engine_rapid_json_sax;
+
   static std::string build_indentation(const std::string &space, int level) {
     std::string retval;
     for (int i = 0; i < level; ++i) {
@@ -96,10 +103,16 @@ namespace umi {
 
       // Create forward data
       create_forward_declarations(ff);
+      // Create the indexes of the lists
+      create_index_builders(ff);
       // Create the array parsers
       create_array_readers(ff);
       // Create the map readers
       create_map_readers(ff);
+      // Create the lookup of the members
+      create_member_lookups(ff);
+      // Create the state machines of validate
+      create_validate_state_machines(ff);
       // Create the json parsers
       output_engine<T1, T2>::m_cpp_streamer << "// Data parsers\n";
       auto &dataR = ff->getClassMap();
@@ -107,20 +120,41 @@ namespace umi {
         create_single_reader(class_it.second, class_it.first, true, false);
         output_engine<T1, T2>::m_cpp_streamer << "\n";
       }
+      for (auto &variant: ff->getVariantArray()) {
+        create_variant_reader(variant);
+        output_engine<T1, T2>::m_cpp_streamer << "\n";
+      }
       // Close the namespace
       output_engine<T1, T2>::m_cpp_streamer << "}\n\n";
+      // Create the memory kept between reads
+      std::vector<std::pair<std::string, std::string>> buffers;
+      if (output_engine<T1, T2>::m_string_view) {
+        buffers.emplace_back("char", "text");
+      }
+      create_parser_context({"value_pool", "stack_pool"}, buffers);
+      create_index_finders(ff);
       // Create the final parsers
       output_engine<T1, T2>::m_cpp_streamer << "// Json parsers\n";
       auto &classes = ff->getJsonArray();
       for (auto &class_it: classes) {
         create_default_method_read(class_it);
-        create_single_reader(class_it, "", false, false);
+        if (!output_engine<T1, T2>::m_string_view) {
+          create_single_reader(class_it, "", false, false);
+        }
         if (output_engine<T1, T2>::m_additional_engine_information == "rapidjson") {
           create_single_reader(class_it, "", false, true);
         }
         output_engine<T1, T2>::m_cpp_streamer << "\n";
         create_single_reader(class_it, "", false, false, true);
         output_engine<T1, T2>::m_cpp_streamer << "\n";
+        create_single_reader(class_it, "", false, false, false, true);
+        output_engine<T1, T2>::m_cpp_streamer << "\n";
+        create_buffer_readers(class_it);
+        output_engine<T1, T2>::m_cpp_streamer << "\n";
+        create_whole_projection_readers(ff, class_it);
+        create_whole_prefix_readers(ff, class_it);
+        create_whole_validate(class_it);
+        create_whole_streaming_reader(class_it);
       }
       return true;
     }
@@ -142,11 +176,25 @@ namespace umi {
       }
       output_engine<T1, T2>::m_cpp_streamer << "#include \"rapidjson/rapidjson.h\"\n"
       << "#include \"rapidjson/document.h\"\n"
+      << "#include \"rapidjson/memorystream.h\"\n"
+      << "#include \"rapidjson/reader.h\"\n"
       << "#include <inttypes.h>\n"
+      << "#include <algorithm>\n"
+      << "#include <climits>\n"
       << "#include <iostream>\n"
+      << "#include <iterator>\n"
+      << "#include <cmath>\n"
+      << "#include <cstdio>\n"
       << "#include <cstdlib>\n"
+      << "#include <cstring>\n"
       << "#include <map>\n"
-      << "#include <vector>\n\n";
+      << "#include <sstream>\n"
+      << "#include <string>\n"
+      << "#include <tuple>\n"
+      << "#include <utility>\n"
+      << "#include <vector>\n";
+      writer_printer<T2>::print_includes(output_engine<T1, T2>::m_cpp_streamer);
+      output_engine<T1, T2>::m_cpp_streamer << "\n";
     }
 
     /**
@@ -176,7 +224,7 @@ namespace umi {
       << TABS << "template<typename T, typename Stream>\n"
       << TABS << "bool _read_list(std::vector<bool> &str, T &data, Stream &ss);\n"
       << TABS << "template<typename T, typename Stream>\n"
-      << TABS << "bool _read_list(std::vector<std::string> &str, T &data, Stream &ss);\n";
+      << TABS << "bool _read_list(std::vector<" << string_type() << "> &str, T &data, Stream &ss);\n";
     }
 
     /**
@@ -190,6 +238,12 @@ namespace umi {
         << output_engine<T1, T2>::m_additional_string << "::" << class_map_it.first <<
         "> &str, T &data, Stream &ss);\n";
       }
+      for (auto &&variant: ff->getVariantArray()) {
+        output_engine<T1, T2>::m_cpp_streamer << TABS << "template<typename T, typename Stream>\n"
+        << TABS << "bool _read_list(std::vector<__internal__umison"
+        << output_engine<T1, T2>::m_additional_string << "::" << variant->name() <<
+        "> &str, T &data, Stream &ss);\n";
+      }
     }
 
     /**
@@ -206,7 +260,7 @@ namespace umi {
       << TABS << "template<typename T, typename Stream>\n"
       << TABS << "bool _read_map(std::multimap<std::string, bool> &str, T &data, Stream &ss);\n"
       << TABS << "template<typename T, typename Stream>\n"
-      << TABS << "bool _read_map(std::multimap<std::string, std::string> &str, T &data, Stream &ss);\n";
+      << TABS << "bool _read_map(std::multimap<std::string, " << string_type() << "> &str, T &data, Stream &ss);\n";
     }
 
     /**
@@ -232,9 +286,72 @@ namespace umi {
         << TABS << "bool " << class_map_it.first << "__input_parse(" << class_map_it.first <<
         " &inout, T &rData, Stream &ss);\n";
       }
+      for (auto &&variant: ff->getVariantArray()) {
+        output_engine<T1, T2>::m_cpp_streamer << TABS << "template<typename T, typename Stream>\n"
+        << TABS << "bool " << variant->name() << "__input_parse(" << variant->name() <<
+        " &inout, T &rData, Stream &ss);\n";
+      }
     }
 
 
+    /**
+     * Creates the perfect hash lookups used to find the field of each member
+     * */
+    void create_member_lookups(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      streamer << TABS << "// Member lookups\n";
+      perfect_hash::print_runtime(streamer, TABS, 1);
+      create_enum_lookups(ff);
+      for (auto &class_it: ff->getClassMap()) {
+        create_member_lookup(class_it.second, class_it.first + "__field");
+      }
+      for (auto &class_it: ff->getJsonArray()) {
+        create_member_lookup(class_it, class_it->name() + "__json__field");
+      }
+    }
+
+    /**
+     * Creates the perfect hash lookup of the values of each enum, E__enum reads the text of
+     * a value as the enumerator, the unknown values are the fallback or fail
+     * */
+    void create_enum_lookups(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      for (auto &enum_node: ff->getEnumArray()) {
+        const std::string &name = enum_node->name();
+        perfect_hash(enum_node->enumerators()).print_lookup(streamer, name + "__enum_index", TABS, 1);
+        streamer << TABS << "inline bool " << name << "__enum(const char *str, std::size_t len, " << name
+        << " &value)\n"
+        << TABS << "{\n"
+        << TABS << TABS << "int index = " << name << "__enum_index(str, len);\n"
+        << TABS << TABS << "if (index < 0) {\n";
+        if (enum_node->fallback().empty()) {
+          streamer << TABS << TABS << TABS << "return false;\n";
+        } else {
+          streamer << TABS << TABS << TABS << "value = " << name << "::" << enum_node->fallback() << ";\n"
+          << TABS << TABS << TABS << "return true;\n";
+        }
+        streamer << TABS << TABS << "}\n"
+        << TABS << TABS << "value = static_cast<" << name << ">(index);\n"
+        << TABS << TABS << "return true;\n"
+        << TABS << "}\n\n";
+      }
+    }
+
+    /**
+     * Creates the perfect hash lookup of one class, classes made of one map don't need it
+     * */
+    void create_member_lookup(const std::shared_ptr<umixmltypeclass> &ff, const std::string &function) {
+      auto &elements = ff->getChildren();
+      if (elements.size() == 1 && elements[0]->isMap()) {
+        return;
+      }
+      std::vector<std::string> names;
+      for (auto &element: elements) {
+        names.push_back(element->name());
+      }
+      perfect_hash(names).print_lookup(output_engine<T1, T2>::m_cpp_streamer, function, TABS, 1);
+    }
+
     /**
      * Creates the different array readers
      * */
@@ -268,10 +385,15 @@ namespace umi {
       << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \"Error data is not an array\\n\";\n"
       << def_2p_indentation << "return false;\n"
       << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "str.reserve(str.size() + data.Size());\n"
       << def_1p_indentation << "for (rapidjson::SizeType i = 0; i < data.Size(); ++i) {\n"
-      << def_2p_indentation << "if (data[i].Is" << rapid_json_type << "()) {\n"
-      << def_3p_indentation << "str.push_back(data[i].Get" << rapid_json_type << "());\n"
-      << def_2p_indentation << "} else {\n"
+      << def_2p_indentation << "if (data[i].Is" << rapid_json_type << "()) {\n";
+      if (rapid_json_type == "String") {
+        streamer << def_3p_indentation << "str.emplace_back(data[i].GetString(), data[i].GetStringLength());\n";
+      } else {
+        streamer << def_3p_indentation << "str.emplace_back(data[i].Get" << rapid_json_type << "());\n";
+      }
+      streamer << def_2p_indentation << "} else {\n"
       << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \"Error data is not an " <<
       rapid_json_type << "\\n\";\n"
       << def_3p_indentation << "return false;\n"
@@ -302,9 +424,14 @@ namespace umi {
       rapid_json_type << "\\n\";\n"
       << def_3p_indentation << "return false;\n"
       << def_2p_indentation << "}\n"
-      << def_2p_indentation << "str.insert(std::make_pair(std::string(i->name.GetString()), (" << type <<
-      ")(i->value.Get" << rapid_json_type << "())));\n"
-      << def_1p_indentation << "}\n"
+      << def_2p_indentation << "str.emplace(std::piecewise_construct,\n"
+      << def_3p_indentation << "std::forward_as_tuple(i->name.GetString(), i->name.GetStringLength()),\n";
+      if (rapid_json_type == "String") {
+        streamer << def_3p_indentation << "std::forward_as_tuple(i->value.GetString(), i->value.GetStringLength()));\n";
+      } else {
+        streamer << def_3p_indentation << "std::forward_as_tuple(i->value.Get" << rapid_json_type << "()));\n";
+      }
+      streamer << def_1p_indentation << "}\n"
       << def_1p_indentation << "return true;\n"
       << def_indentation << "}\n\n";
     }
@@ -323,11 +450,10 @@ namespace umi {
       << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error data is not an array\\n\";\n"
       << def_2p_indentation << "return false;\n"
       << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "str.reserve(str.size() + data.Size());\n"
       << def_1p_indentation << "for (rapidjson::SizeType i = 0; i < data.Size(); ++i) {\n"
-      << def_2p_indentation << "__internal__umison" << additional_str << "::" << type << " local_" << type << ";\n"
-      << def_2p_indentation << "if (" << type << "__input_parse(local_" << type << ", data[i], ss)) {\n"
-      << def_3p_indentation << "str.push_back(local_" << type << ");\n"
-      << def_2p_indentation << "} else {\n"
+      << def_2p_indentation << "str.emplace_back();\n"
+      << def_2p_indentation << "if (!" << type << "__input_parse(str.back(), data[i], ss)) {\n"
       << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error data is not an " << type <<
       "\\n\";\n"
       << def_3p_indentation << "return false;\n"
@@ -359,7 +485,8 @@ namespace umi {
       << def_2p_indentation << "if (i->value.IsObject()) {\n"
       << def_3p_indentation << "__internal__umison" << additional_str << "::" << type << " local_" << type << ";\n"
       << def_3p_indentation << "if (" << type << "__input_parse(local_" << type << ", i->value, ss)) {\n"
-      << def_4p_indentation << "str.insert(std::make_pair(std::string(i->name.GetString()), local_" << type << "));\n"
+      << def_4p_indentation << "str.emplace(std::string(i->name.GetString(), i->name.GetStringLength()), std::move(local_"
+      << type << "));\n"
       << def_3p_indentation << "} else {\n"
       << def_4p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error data is not an " << type <<
       "\\n\";\n"
@@ -368,7 +495,8 @@ namespace umi {
       << def_3p_indentation << "for (rapidjson::SizeType j = 0; j < i->value.Size(); ++j){\n"
       << def_4p_indentation << "__internal__umison" << additional_str << "::" << type << " local_" << type << ";\n"
       << def_4p_indentation << "if (" << type << "__input_parse(local_" << type << ", i->value[j], ss)) {\n"
-      << def_5p_indentation << "str.insert(std::make_pair(std::string(i->name.GetString()), local_" << type << "));\n"
+      << def_5p_indentation << "str.emplace(std::string(i->name.GetString(), i->name.GetStringLength()), std::move(local_"
+      << type << "));\n"
       << def_4p_indentation << "} else {\n"
       << def_5p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error data is not an " << type <<
       "\\n\";\n"
@@ -388,7 +516,7 @@ namespace umi {
       _read_list((output_engine<T1, T2>::m_cpp_streamer), TABS, "long long int", "Int64", 1);
       _read_list((output_engine<T1, T2>::m_cpp_streamer), TABS, "double", "Double", 1);
       _read_list((output_engine<T1, T2>::m_cpp_streamer), TABS, "bool", "Bool", 1);
-      _read_list((output_engine<T1, T2>::m_cpp_streamer), TABS, "std::string", "String", 1);
+      _read_list((output_engine<T1, T2>::m_cpp_streamer), TABS, string_type(), "String", 1);
     }
 
     /**
@@ -399,7 +527,7 @@ namespace umi {
       _read_map((output_engine<T1, T2>::m_cpp_streamer), TABS, "long long int", "Int64", 1);
       _read_map((output_engine<T1, T2>::m_cpp_streamer), TABS, "double", "Double", 1);
       _read_map((output_engine<T1, T2>::m_cpp_streamer), TABS, "bool", "Bool", 1);
-      _read_map((output_engine<T1, T2>::m_cpp_streamer), TABS, "std::string", "String", 1);
+      _read_map((output_engine<T1, T2>::m_cpp_streamer), TABS, string_type(), "String", 1);
     }
 
     /**
@@ -412,6 +540,11 @@ namespace umi {
                          (output_engine<T1, T2>::m_additional_string),
                          class_map_it.first, 1);
       }
+      for (auto &&variant : ff->getVariantArray()) {
+        _read_list_class((output_engine<T1, T2>::m_cpp_streamer), TABS,
+                         (output_engine<T1, T2>::m_additional_string),
+                         variant->name(), 1);
+      }
     }
 
     /**
@@ -427,18 +560,6 @@ namespace umi {
     }
 
 
-    void _data_reader_single(T2 &streamer, const std::string &space, const std::string &type,
-                             const std::string &class_name, const std::string &rapid_json_type,
-                             const std::string &rdata, int level) {
-      std::string def_indentation(build_indentation(space, level));
-      std::string def_1p_indentation(def_indentation + space);
-      streamer << def_indentation << "if (!" << rdata << "[\"" << type << "\"].Is" << rapid_json_type << "()) {\n"
-      << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
-      << class_name << " is wrong type " << type << "\\n\";\n"
-      << def_1p_indentation << "return false;\n"
-      << def_indentation << "}\n";
-    }
-
     void _data_reader_single_map(T2 &streamer, const std::string &space, const std::string &rdata, int level) {
       std::string def_indentation(build_indentation(space, level));
       std::string def_1p_indentation(def_indentation + space);
@@ -454,41 +575,6 @@ namespace umi {
       << def_indentation << "}\n";
     }
 
-    void _data_reader_single_assign(T2 &streamer, const std::string &space, const std::string &type_name,
-                                    const std::string &rapid_json_type, const std::string &inout,
-                                    const std::string &rdata, int level) {
-      std::string def_indentation(build_indentation(space, level));
-      streamer << def_indentation << inout << "mutable_" << type_name << "() = " << rdata <<
-      "[\"" << type_name << "\"].Get"
-      << rapid_json_type << "();\n";
-    }
-
-    void _data_reader_list_assign(T2 &streamer, const std::string &space, const std::string &additional_string,
-                                  const std::string &type_name, const std::string &inout,
-                                  const std::string &rdata, int level) {
-      std::string def_indentation(build_indentation(space, level));
-      std::string def_1p_indentation(def_indentation + space);
-      streamer << def_indentation
-      << "if (!__internal__umison" << additional_string << "::_read_list(" << inout
-      << "mutable_" << type_name << "(), " << rdata
-      << "[\"" << type_name << "\"], ss)) {\n"
-      << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading list\\n\";\n"
-      << def_1p_indentation << "return false;\n"
-      << def_indentation << "}\n\n";
-    }
-
-    void _data_reader_refclass_assign(T2 &streamer, const std::string &space, const std::string &refclass,
-                                      const std::string &type_name, const std::string &inout,
-                                      const std::string &rdata, int level) {
-      std::string def_indentation(build_indentation(space, level));
-      std::string def_1p_indentation(def_indentation + space);
-      streamer << def_indentation << "if (!" << refclass << "__input_parse(" << inout
-      << "mutable_" << type_name << "(), " << rdata << "[\"" << type_name << "\"], ss)) {\n"
-      << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading refclass\\n\";\n"
-      << def_1p_indentation << "return false;\n"
-      << def_indentation << "}\n\n";
-    }
-
     void _data_reader_map_assign(T2 &streamer, const std::string &space, const std::string &additional_string,
                                  const std::string &type_name, const std::string &inout,
                                  const std::string &rdata, int level) {
@@ -502,17 +588,6 @@ namespace umi {
     }
 
 
-    void _data_reader_second_if_optional(T2 &streamer, const std::string &space,
-                                         const std::string &type_name, const std::string &rapid_json_type,
-                                         const std::string &rdata, int level) {
-      std::string def_indentation(build_indentation(space, level));
-      std::string def_1p_indentation(def_indentation + space);
-      streamer << def_indentation << "if (!" << rdata << "[\"" << type_name << "\"].Is" << rapid_json_type << "()) {\n"
-      << def_1p_indentation << "ss << \"Error wrong type\" << __LINE__ << \":\" << __FILE__ << \"\\n\";\n"
-      << def_1p_indentation << "return false;\n"
-      << def_indentation << "}\n";
-    }
-
     void _data_reader_second_if_optional_member(T2 &streamer, const std::string &space,
                                                 const std::string &/*type_name*/, const std::string &rapid_json_type,
                                                 const std::string &rdata, int level) {
@@ -537,46 +612,457 @@ namespace umi {
       << def_indentation << "}\n";
     }
 
-    void _data_reader_second_if_optional_list(T2 &streamer, const std::string &space,
-                                              const std::string &additional_string,
-                                              const std::string &type_name, const std::string &inout,
-                                              const std::string &rdata, int level) {
+    void _data_reader_second_if_optional_map(T2 &streamer, const std::string &space,
+                                             const std::string &additional_string,
+                                             const std::string &type_name, const std::string &inout,
+                                             const std::string &rdata, int level) {
       std::string def_indentation(build_indentation(space, level));
       std::string def_1p_indentation(def_indentation + space);
-      streamer << def_indentation << "if (!__internal__umison" << additional_string << "::_read_list(" << inout
-      << "mutable_" << type_name << "(), " << rdata << "[\"" << type_name << "\"], ss)) {\n"
-      << def_1p_indentation << "ss << \"Error reading array\\n\";\n"
-      << def_1p_indentation << "return false;\n"
+      std::string def_2p_indentation(def_1p_indentation + space);
+      streamer << def_indentation << "if (" << rdata << ".MemberCount() > 0) {\n"
+      << def_1p_indentation << "if (!__internal__umison" << additional_string << "::_read_map(" << inout
+      << "mutable_" << type_name << "(), " << rdata << ", ss)) {\n"
+      << def_2p_indentation << "ss << \"Error reading map\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
       << def_indentation << "}\n";
     }
 
-    void _data_reader_second_if_optional_refclass(T2 &streamer, const std::string &space, const std::string &refclass,
-                                                  const std::string &type_name, const std::string &inout,
-                                                  const std::string &rdata, int level) {
+    /**
+     * Reads the map of a class made only of one map
+     * */
+    void create_map_member_reader(const std::shared_ptr<umixmltype> &element, const std::string &inout_dot,
+                                  const std::string &rdata, int level) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      if (!element->condition().empty()) {
+        streamer << build_indentation(TABS, level) << "if (" << inout_dot << element->condition() << ") {\n";
+        ++level;
+      }
+      if (!element->optional()) {
+        _data_reader_single_map(streamer, TABS, rdata, level);
+        _data_reader_map_assign(streamer, TABS, output_engine<T1, T2>::m_additional_string,
+                                element->name(), inout_dot, rdata, level);
+      } else {
+        _data_reader_second_if_optional_member(streamer, TABS, element->name(),
+                                               internal_to_rapidjson(element->refclass()), rdata, level);
+        _data_reader_second_if_optional_map(streamer, TABS, output_engine<T1, T2>::m_additional_string,
+                                            element->name(), inout_dot, rdata, level);
+        streamer << "\n" << build_indentation(TABS, level) << inout_dot
+        << "mutable_" << element->optional_name() << "() = true;\n";
+      }
+      if (!element->condition().empty()) {
+        --level;
+        streamer << build_indentation(TABS, level) << "}\n";
+      }
+    }
+
+    /**
+     * Checks the type of one member and assigns it
+     *
+     * \param value expression with the rapidjson value of the member
+     * */
+    void _data_reader_member(T2 &streamer, const std::string &space, const std::string &class_name,
+                             const std::shared_ptr<umixmltype> &element, const std::string &value,
+                             const std::string &inout_dot, int level) {
       std::string def_indentation(build_indentation(space, level));
       std::string def_1p_indentation(def_indentation + space);
-      streamer << def_indentation << "if (!" << refclass << "__input_parse(" << inout
-      << "mutable_" << type_name << "(), " << rdata << "[\"" << type_name << "\"], ss)) {\n"
-      << def_1p_indentation << "ss << \"Error reading refclass\\n\";\n"
+      std::string base_element;
+      if (element->isBoolean()) {
+        base_element = "Bool";
+      } else if (element->isInteger32()) {
+        base_element = "Int";
+      } else if (element->isInteger()) {
+        base_element = "Int64";
+      } else if (element->isFloat()) {
+        base_element = "Double";
+      } else if (element->isString() || element->isEnum()) {
+        base_element = "String";
+      } else if (element->isList()) {
+        base_element = "Array";
+      } else if (element->isRefClass()) {
+        base_element = "Object";
+      } else {
+        std::cerr << "Invalid element: " << element->name() << "\n";
+        exit(-1);
+      }
+      streamer << def_indentation << "if (!" << value << ".Is" << base_element << "()) {\n"
+      << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+      << class_name << " is wrong type " << element->name() << "\\n\";\n"
       << def_1p_indentation << "return false;\n"
       << def_indentation << "}\n";
+      if (element->isList()) {
+        streamer << def_indentation << "if (!__internal__umison" << output_engine<T1, T2>::m_additional_string
+        << "::_read_list(" << inout_dot << "mutable_" << element->name() << "(), " << value << ", ss)) {\n"
+        << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading list\\n\";\n"
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+        _data_reader_filter(streamer, space, element, inout_dot, level);
+        _data_reader_index(streamer, space, element, inout_dot, level);
+      } else if (element->isRefClass()) {
+        streamer << def_indentation << "if (!" << element->refclass() << "__input_parse(" << inout_dot
+        << "mutable_" << element->name() << "(), " << value << ", ss)) {\n"
+        << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading refclass\\n\";\n"
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+      } else if (element->isEnum()) {
+        streamer << def_indentation << "if (!" << element->enum_type() << "__enum(" << value << ".GetString(), "
+        << value << ".GetStringLength(), " << inout_dot << "mutable_" << element->name() << "())) {\n"
+        << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+        << class_name << " is wrong type " << element->name() << "\\n\";\n"
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+      } else if (element->intern()) {
+        streamer << def_indentation << inout_dot << "mutable_" << element->name() << "() = umison_intern("
+        << value << ".GetString(), " << value << ".GetStringLength());\n";
+      } else if (element->bounded()) {
+        streamer << def_indentation << "if (!" << inout_dot << "mutable_" << element->name() << "().assign("
+        << value << ".GetString(), " << value << ".GetStringLength())) {\n"
+        << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+        << class_name << " is longer than " << element->maxlen() << " " << element->name() << "\\n\";\n"
+        << def_1p_indentation << "return false;\n"
+        << def_indentation << "}\n";
+      } else if (element->isString() && output_engine<T1, T2>::m_string_view) {
+        streamer << def_indentation << inout_dot << "mutable_" << element->name() << "() = std::string_view("
+        << value << ".GetString(), " << value << ".GetStringLength());\n";
+      } else if (element->isString()) {
+        streamer << def_indentation << inout_dot << "mutable_" << element->name() << "().assign("
+        << value << ".GetString(), " << value << ".GetStringLength());\n";
+      } else {
+        streamer << def_indentation << inout_dot << "mutable_" << element->name() << "() = " << value
+        << ".Get" << base_element << "();\n";
+      }
+      if (element->optional()) {
+        streamer << def_indentation << inout_dot << "mutable_" << element->optional_name() << "() = true;\n";
+      }
     }
 
-
-    void _data_reader_second_if_optional_map(T2 &streamer, const std::string &space,
-                                             const std::string &additional_string,
-                                             const std::string &type_name, const std::string &inout,
-                                             const std::string &rdata, int level) {
+    /**
+     * Drops the elements of a list its filter rejects, the elements have been read whole
+     * */
+    void _data_reader_filter(T2 &streamer, const std::string &space, const std::shared_ptr<umixmltype> &element,
+                             const std::string &inout_dot, int level) {
+      if (element->filter().empty()) {
+        return;
+      }
       std::string def_indentation(build_indentation(space, level));
       std::string def_1p_indentation(def_indentation + space);
       std::string def_2p_indentation(def_1p_indentation + space);
-      streamer << def_indentation << "if (" << rdata << ".MemberCount() > 0) {\n"
-      << def_1p_indentation << "if (!__internal__umison" << additional_string << "::_read_map(" << inout
-      << "mutable_" << type_name << "(), " << rdata << ", ss)) {\n"
-      << def_2p_indentation << "ss << \"Error reading map\\n\";\n"
-      << def_2p_indentation << "return false;\n"
+      std::string type("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::" + element->refclass());
+      streamer << def_indentation << "{\n"
+      << def_1p_indentation << "std::vector<" << type << "> &_list = " << inout_dot << "mutable_" << element->name()
+      << "();\n"
+      << def_1p_indentation << "_list.erase(std::remove_if(_list.begin(), _list.end(), [](const " << type
+      << " &inout) {\n"
+      << def_2p_indentation << "return !(inout." << element->filter() << ");\n"
+      << def_1p_indentation << "}), _list.end());\n"
+      << def_indentation << "}\n";
+    }
+
+    /**
+     * Tells if an expression of the template, a condition or a filter, uses a member, through
+     * its getter or its attribute
+     * */
+    static bool expression_uses(const std::string &expression, const std::shared_ptr<umixmltype> &element) {
+      std::set<std::string> names{element->name(), "get_" + element->name(),
+                                  umixmltype::attribute_prepocess(element->name())};
+      if (element->optional()) {
+        names.insert(element->optional_name());
+        names.insert("get_" + element->optional_name());
+      }
+      for (size_t i = 0; i < expression.size();) {
+        if (!isalpha(static_cast<unsigned char>(expression[i])) && expression[i] != '_') {
+          ++i;
+          continue;
+        }
+        size_t start = i;
+        while (i < expression.size() && (isalnum(static_cast<unsigned char>(expression[i])) || expression[i] == '_')) {
+          ++i;
+        }
+        if (names.count(expression.substr(start, i - start)) > 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * Tells if a condition of the members of a class uses a member
+     * */
+    static bool conditioned(const std::shared_ptr<umixmltypeclass> &cls, const std::shared_ptr<umixmltype> &element) {
+      for (auto &other: cls->getChildren()) {
+        if (expression_uses(other->condition(), element)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+     * Builds the index of a list once it has been read, the rejected elements already dropped
+     * */
+    void _data_reader_index(T2 &streamer, const std::string &space, const std::shared_ptr<umixmltype> &element,
+                            const std::string &inout_dot, int level) {
+      if (element->index().empty()) {
+        return;
+      }
+      streamer << build_indentation(space, level) << "__internal__umison" << output_engine<T1, T2>::m_additional_string
+      << "::" << index_build_name(element) << "(" << inout_dot << "get_" << element->name() << "(), " << inout_dot
+      << "mutable_" << element->index_name() << "());\n";
+    }
+
+    /**
+     * Name of the function adding one element of a list to its index
+     * */
+    static std::string index_insert_name(const std::shared_ptr<umixmltype> &element) {
+      return element->refclass() + "__index_insert__" + element->index();
+    }
+
+    /**
+     * Name of the function indexing a whole list
+     * */
+    static std::string index_build_name(const std::shared_ptr<umixmltype> &element) {
+      return element->refclass() + "__index__" + element->index();
+    }
+
+    /**
+     * Hash of the key of an index, the strings hash their text
+     * */
+    static std::string index_hash(const std::shared_ptr<umixmltype> &element, const std::string &key) {
+      if (element->index_type() == UMI_XMLTAGS_STRING) {
+        return "umison_index_hash(" + key + ".data(), " + key + ".size())";
+      }
+      return "umison_index_hash(" + key + ")";
+    }
+
+    /**
+     * List with an index, with the class or json it is a member of
+     * */
+    struct index_list {
+      std::shared_ptr<umixmltypeclass> owner;
+      std::shared_ptr<umixmltype> element;
+      bool json;
+    };
+
+    /**
+     * Lists with an index of the classes and the jsons
+     * */
+    static std::vector<index_list> index_lists(std::shared_ptr<umi::umixml> &ff) {
+      std::vector<index_list> lists;
+      for (auto &class_it: ff->getClassMap()) {
+        for (auto &child: class_it.second->getChildren()) {
+          if (!child->index().empty()) {
+            lists.push_back(index_list{class_it.second, child, false});
+          }
+        }
+      }
+      for (auto &json: ff->getJsonArray()) {
+        for (auto &child: json->getChildren()) {
+          if (!child->index().empty()) {
+            lists.push_back(index_list{json, child, true});
+          }
+        }
+      }
+      return lists;
+    }
+
+    /**
+     * Create the functions filling the indexes of the lists, one per class and key, within the
+     * internal namespace. The engines add the elements while they read the list or index it
+     * once it is read
+     * */
+    void create_index_builders(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      std::string def_2p_indentation(build_indentation(TABS, 3));
+      std::set<std::string> created;
+      for (auto &list: index_lists(ff)) {
+        auto &element = list.element;
+        if (!created.insert(index_build_name(element)).second) {
+          continue;
+        }
+        std::string type("std::vector<" + element->refclass() + ">");
+        streamer << TABS << "// Index of the lists of " << element->refclass() << " by " << element->index() << "\n"
+        << TABS << "inline void " << index_insert_name(element) << "(const " << type
+        << " &list, std::size_t position, umison_index &index)\n"
+        << TABS << "{\n"
+        << def_1p_indentation << "const auto &key = list[position].get_" << element->index() << "();\n"
+        << def_1p_indentation << "index.insert(static_cast<uint32_t>(position), " << index_hash(element, "key")
+        << ", [&list, &key](uint32_t other) {\n"
+        << def_2p_indentation << "return list[other].get_" << element->index() << "() == key;\n"
+        << def_1p_indentation << "});\n"
+        << TABS << "}\n\n"
+        << TABS << "void " << index_build_name(element) << "(const " << type << " &list, umison_index &index)\n"
+        << TABS << "{\n"
+        << def_1p_indentation << "index.clear();\n"
+        << def_1p_indentation << "index.reserve(list.size());\n"
+        << def_1p_indentation << "for (std::size_t i = 0; i < list.size(); ++i) {\n"
+        << def_2p_indentation << index_insert_name(element) << "(list, i, index);\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "index.valid = true;\n"
+        << TABS << "}\n\n";
+      }
+    }
+
+    /**
+     * Create the find methods of the indexes. The methods changing the list reset its index, the
+     * find of a non const object builds it again and the const one, which never writes, looks the
+     * list up element by element until then
+     * */
+    void create_index_finders(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string);
+      auto lists(index_lists(ff));
+      if (lists.empty()) {
+        return;
+      }
+      streamer << "// Lookups on the indexes of the lists\n";
+      for (auto &list: lists) {
+        auto &element = list.element;
+        std::string index(umixmltype::attribute_prepocess(element->index_name()));
+        std::string attribute(umixmltype::attribute_prepocess(element->name()));
+        std::string signature("const " + ns + "::" + element->refclass() + " *" + (list.json ? "umison" : ns) + "::"
+                              + list.owner->name() + "::find_" + element->index_name() + "(const "
+                              + type_to_cpp(output_engine<T1, T2>::m_string_view).get_type(element->index_type())
+                              + " &key)");
+        streamer << signature << "\n"
+        << "{\n"
+        << TABS << "if (!" << index << ".valid) {\n"
+        << TABS << TABS << ns << "::" << index_build_name(element) << "(" << attribute << ", " << index << ");\n"
+        << TABS << "}\n"
+        << TABS << "return static_cast<const " << list.owner->name() << " *>(this)->find_" << element->index_name()
+        << "(key);\n"
+        << "}\n\n"
+        << signature << " const\n"
+        << "{\n"
+        << TABS << "if (!" << index << ".valid) {\n"
+        << TABS << TABS << "for (auto &element : " << attribute << ") {\n"
+        << TABS << TABS << TABS << "if (element.get_" << element->index() << "() == key) {\n"
+        << TABS << TABS << TABS << TABS << "return &element;\n"
+        << TABS << TABS << TABS << "}\n"
+        << TABS << TABS << "}\n"
+        << TABS << TABS << "return nullptr;\n"
+        << TABS << "}\n"
+        << TABS << "uint32_t position = " << index << ".find(" << ns << "::" << index_hash(element, "key")
+        << ", [this, &key](uint32_t other) {\n"
+        << TABS << TABS << "return " << attribute << "[other].get_" << element->index() << "() == key;\n"
+        << TABS << "});\n"
+        << TABS << "return position == 0 ? nullptr : &" << attribute << "[position - 1];\n"
+        << "}\n\n";
+      }
+    }
+
+    /**
+     * Walks the members of the object once, each name is routed to its field with the
+     * perfect hash of the class. Members under a condition are kept aside and read once
+     * the rest of the object is in place, in the order of the template.
+     *
+     * \param lookup name of the perfect hash function of the class
+     * */
+    void create_member_dispatch(const std::shared_ptr<umixmltypeclass> &ff, const std::string &lookup,
+                                const std::string &inout_dot, const std::string &rdata, int level) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      auto &elements = ff->getChildren();
+      size_t words = (elements.size() + 63) / 64;
+      std::vector<int> deferred(elements.size(), -1);
+      int deferred_count = 0;
+      std::vector<unsigned long long> required(words, 0);
+      for (size_t i = 0; i < elements.size(); ++i) {
+        if (elements[i]->isMap()) {
+          std::cerr << "Error: More than one element on the same level within a map\n";
+          exit(-1);
+        }
+        if (!elements[i]->condition().empty()) {
+          deferred[i] = deferred_count++;
+        } else if (!elements[i]->optional()) {
+          required[i / 64] |= 1ULL << (i % 64);
+        }
+      }
+      streamer << def_indentation << "if (!" << rdata << ".IsObject()) {\n"
+      << def_1p_indentation << "ss << __FILE__ <<  \":\" << __LINE__ << \" Element is not an object\\n\";\n"
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n"
+      << def_indentation << "unsigned long long int seen[" << words << "] = {};\n";
+      if (deferred_count > 0) {
+        streamer << def_indentation << "const rapidjson::Value *deferred[" << deferred_count << "] = {};\n";
+      }
+      streamer << def_indentation << "for (rapidjson::Document::ConstMemberIterator i = " << rdata << ".MemberBegin();\n"
+      << def_1p_indentation << "i != " << rdata << ".MemberEnd();\n"
+      << def_1p_indentation << "++i) {\n"
+      << def_1p_indentation << "const int field = " << lookup << "(i->name.GetString(), i->name.GetStringLength());\n"
+      << def_1p_indentation << "if (field < 0 || (seen[field / 64] & (1ULL << (field % 64)))) {\n"
+      << def_2p_indentation << "continue;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "seen[field / 64] |= 1ULL << (field % 64);\n"
+      << def_1p_indentation << "switch (field) {\n";
+      for (size_t i = 0; i < elements.size(); ++i) {
+        streamer << def_2p_indentation << "case " << i << ":\n";
+        if (deferred[i] >= 0) {
+          streamer << def_3p_indentation << "deferred[" << deferred[i] << "] = &i->value;\n";
+        } else {
+          _data_reader_member(streamer, TABS, ff->name(), elements[i], "i->value", inout_dot, level + 3);
+        }
+        streamer << def_3p_indentation << "break;\n";
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "break;\n"
       << def_1p_indentation << "}\n"
       << def_indentation << "}\n";
+      // Mandatory members, one mask per word and the detail only on failure
+      for (size_t word = 0; word < words; ++word) {
+        if (required[word] == 0) {
+          continue;
+        }
+        std::ostringstream mask;
+        mask << "0x" << std::hex << required[word] << "ULL";
+        streamer << def_indentation << "if ((seen[" << word << "] & " << mask.str() << ") != " << mask.str() << ") {\n";
+        for (size_t i = word * 64; i < elements.size() && i < (word + 1) * 64; ++i) {
+          if (!(required[word] & (1ULL << (i % 64)))) {
+            continue;
+          }
+          streamer << def_1p_indentation << "if (!(seen[" << word << "] & (1ULL << " << i % 64 << "))) {\n"
+          << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+          << ff->name() << " is missing mandatory entry or entity is not an object" << elements[i]->name()
+          << "\\n\";\n"
+          << def_2p_indentation << "return false;\n"
+          << def_1p_indentation << "}\n";
+        }
+        streamer << def_indentation << "}\n";
+      }
+      // Conditional members
+      std::string actualCondition;
+      for (size_t i = 0; i < elements.size(); ++i) {
+        auto &element = elements[i];
+        if (deferred[i] < 0) {
+          continue;
+        }
+        if (actualCondition != element->condition()) {
+          if (!actualCondition.empty()) {
+            streamer << def_indentation << "}\n";
+          }
+          actualCondition = element->condition();
+          streamer << def_indentation << "if (" << inout_dot << actualCondition << ") {\n";
+        }
+        std::string value("deferred[" + std::to_string(deferred[i]) + "]");
+        if (element->optional()) {
+          streamer << def_1p_indentation << "if (" << value << " != nullptr) {\n";
+          _data_reader_member(streamer, TABS, ff->name(), element, "(*" + value + ")", inout_dot, level + 2);
+          streamer << def_1p_indentation << "}\n";
+        } else {
+          streamer << def_1p_indentation << "if (" << value << " == nullptr) {\n"
+          << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+          << ff->name() << " is missing mandatory entry or entity is not an object" << element->name() << "\\n\";\n"
+          << def_2p_indentation << "return false;\n"
+          << def_1p_indentation << "}\n";
+          _data_reader_member(streamer, TABS, ff->name(), element, "(*" + value + ")", inout_dot, level + 1);
+        }
+      }
+      if (!actualCondition.empty()) {
+        streamer << def_indentation << "}\n";
+      }
     }
 
     void create_default_additional_method(const std::shared_ptr<umixmltypeclass> &ff) {
@@ -601,15 +1087,458 @@ namespace umi {
       << def_indentation << "bool umison::" << ff->name() << "::read_data_from_file(const std::string &input)\n"
       << def_indentation << "{\n"
       << def_1p_indentation << "return this->read_data_from_file(input, std::cerr);\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "bool umison::" << ff->name() << "::read_data_insitu(char *buffer, std::size_t len)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return this->read_data_insitu(buffer, len, std::cerr);\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "bool umison::" << ff->name() << "::validate(const char *text, std::size_t len)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return validate(text, len, std::cerr);\n"
+      << def_indentation << "}\n\n";
+      if (!ff->streaming_arguments().empty()) {
+        output_engine<T1, T2>::m_cpp_streamer
+        << def_indentation << "bool umison::" << ff->name() << "::read_data_streaming(const std::string &input_text"
+        << ff->streaming_parameters(output_engine<T1, T2>::m_additional_string) << ")\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "return this->read_data_streaming(input_text" << ff->streaming_arguments()
+        << ", std::cerr);\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * C++ type of the strings
+     * */
+    std::string string_type() const {
+      return output_engine<T1, T2>::m_string_view ? "std::string_view" : "std::string";
+    }
+
+    /**
+     * Creates the memory kept by umison::parser_context between reads. Each pool is the first
+     * chunk of one rapidjson::MemoryPoolAllocator, so a read that fits in them doesn't allocate.
+     * The pools grow to the biggest read seen while the context stays under its high water mark.
+     *
+     * \param pools names of the pools used by the engine, empty when it doesn't use rapidjson
+     * \param buffers type and name of additional vectors reused between reads
+     * */
+    void create_parser_context(const std::vector<std::string> &pools,
+                               const std::vector<std::pair<std::string, std::string>> &buffers) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      streamer << "// Memory kept by a parser_context between reads\n"
+      << def_indentation << "struct umison::parser_context::impl {\n";
+      if (!pools.empty()) {
+        streamer << def_1p_indentation << "// Memory used as first chunk of one allocator\n"
+        << def_1p_indentation << "struct pool {\n"
+        << def_2p_indentation << "std::vector<char> buffer;\n"
+        << def_2p_indentation << "std::size_t wanted;\n"
+        << def_1p_indentation << "};\n\n"
+        << def_1p_indentation << "// Allocator working on one pool, the pool can't change while it is alive so the\n"
+        << def_1p_indentation << "// capacity it reached is applied on the next read\n"
+        << def_1p_indentation << "class allocator : public rapidjson::MemoryPoolAllocator<> {\n"
+        << def_1p_indentation << "public:\n"
+        << def_2p_indentation << "explicit allocator(pool &p) : rapidjson::MemoryPoolAllocator<>(&p.buffer[0], p.buffer.size()),\n"
+        << def_2p_indentation << "                              m_pool(p)\n"
+        << def_2p_indentation << "{\n"
+        << def_2p_indentation << "}\n\n"
+        << def_2p_indentation << "~allocator()\n"
+        << def_2p_indentation << "{\n"
+        << def_3p_indentation << "if (Capacity() > m_pool.wanted) {\n"
+        << def_3p_indentation << TABS << "m_pool.wanted = Capacity();\n"
+        << def_3p_indentation << "}\n"
+        << def_2p_indentation << "}\n\n"
+        << def_1p_indentation << "private:\n"
+        << def_2p_indentation << "pool &m_pool;\n"
+        << def_1p_indentation << "};\n\n";
+      }
+      streamer << def_1p_indentation << "explicit impl(std::size_t mark) : high_water_mark(mark)\n"
+      << def_1p_indentation << "{\n"
+      << def_2p_indentation << "shrink();\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "// Starts a read, the errors of the previous one are dropped\n"
+      << def_1p_indentation << "std::ostream &begin()\n"
+      << def_1p_indentation << "{\n";
+      for (auto &pool: pools) {
+        streamer << def_2p_indentation << "grow(" << pool << ");\n";
+      }
+      if (!buffers.empty()) {
+        streamer << def_2p_indentation << "if (capacity() > high_water_mark) {\n";
+        for (auto &buffer: buffers) {
+          streamer << def_3p_indentation << "std::vector<" << buffer.first << ">().swap(" << buffer.second << ");\n";
+        }
+        streamer << def_2p_indentation << "}\n";
+      }
+      streamer << def_2p_indentation << "errors.str(std::string());\n"
+      << def_2p_indentation << "errors.clear();\n"
+      << def_2p_indentation << "return errors;\n"
+      << def_1p_indentation << "}\n\n";
+      if (!pools.empty()) {
+        streamer << def_1p_indentation << "// Doubles the pool until the last read fits in it, unless it goes over the high water mark\n"
+        << def_1p_indentation << "void grow(pool &p)\n"
+        << def_1p_indentation << "{\n"
+        << def_2p_indentation << "if (p.wanted >= p.buffer.size()) {\n"
+        << def_3p_indentation << "std::size_t size = p.buffer.size();\n"
+        << def_3p_indentation << "while (size < p.wanted + chunk_headers) {\n"
+        << def_3p_indentation << TABS << "size *= 2;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "if (capacity() - p.buffer.size() + size <= high_water_mark) {\n"
+        << def_3p_indentation << TABS << "std::vector<char>(size).swap(p.buffer);\n"
+        << def_3p_indentation << "}\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "p.wanted = 0;\n"
+        << def_1p_indentation << "}\n\n";
+      }
+      streamer << def_1p_indentation << "std::size_t capacity() const\n"
+      << def_1p_indentation << "{\n"
+      << def_2p_indentation << "return ";
+      for (size_t i = 0; i < pools.size(); ++i) {
+        streamer << (i > 0 ? " + " : "") << pools[i] << ".buffer.size()";
+      }
+      for (size_t i = 0; i < buffers.size(); ++i) {
+        streamer << (i > 0 || !pools.empty() ? " +\n" + def_3p_indentation : "") << buffers[i].second
+        << ".capacity() * sizeof(" << buffers[i].first << ")";
+      }
+      if (pools.empty() && buffers.empty()) {
+        streamer << "0";
+      }
+      streamer << ";\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "void shrink()\n"
+      << def_1p_indentation << "{\n";
+      for (auto &pool: pools) {
+        streamer << def_2p_indentation << "std::vector<char>(initial_pool).swap(" << pool << ".buffer);\n"
+        << def_2p_indentation << pool << ".wanted = 0;\n";
+      }
+      for (auto &buffer: buffers) {
+        streamer << def_2p_indentation << "std::vector<" << buffer.first << ">().swap(" << buffer.second << ");\n";
+      }
+      streamer << def_1p_indentation << "}\n\n";
+      if (!pools.empty()) {
+        streamer << def_1p_indentation << "// Size of a pool on a new context\n"
+        << def_1p_indentation << "static const std::size_t initial_pool = 4096;\n"
+        << def_1p_indentation << "// Room left in a pool for the headers of the allocator chunks\n"
+        << def_1p_indentation << "static const std::size_t chunk_headers = 64;\n";
+      }
+      streamer << def_1p_indentation << "std::size_t high_water_mark;\n";
+      for (auto &pool: pools) {
+        streamer << def_1p_indentation << "pool " << pool << ";\n";
+      }
+      for (auto &buffer: buffers) {
+        streamer << def_1p_indentation << "std::vector<" << buffer.first << "> " << buffer.second << ";\n";
+      }
+      streamer << def_1p_indentation << "std::stringstream errors;\n"
+      << def_indentation << "};\n\n"
+      << def_indentation << "umison::parser_context::parser_context(std::size_t high_water_mark) :\n"
+      << def_1p_indentation << "m_impl(new impl(high_water_mark))\n"
+      << def_indentation << "{\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "umison::parser_context::~parser_context()\n"
+      << def_indentation << "{\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "std::string umison::parser_context::errors() const\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return m_impl->errors.str();\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "std::size_t umison::parser_context::capacity() const\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return m_impl->capacity();\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "void umison::parser_context::shrink()\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "m_impl->shrink();\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Creates the read_data_<projection> methods of one json, they read all of it with read_data.
+     * rapidjson builds the whole document, rapidjson-sax only uses them for the jsons that are a
+     * map, their projections select the only member
+     * */
+    void create_whole_projection_readers(std::shared_ptr<umi::umixml> &ff, const std::shared_ptr<umixmltypeclass> &json) {
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      for (auto &projection: ff->getProjections()) {
+        if (projection->json() != json->name()) {
+          continue;
+        }
+        std::string method("umison::" + json->name() + "::read_data_" + projection->name());
+        output_engine<T1, T2>::m_cpp_streamer
+        << def_indentation << "bool " << method << "(const std::string &input_text)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "return this->read_data(input_text, std::cerr);\n"
+        << def_indentation << "}\n\n"
+        << def_indentation << "bool " << method << "(const std::string &input_text, std::ostream &ss)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "return this->read_data(input_text, ss);\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Creates the read_data_prefix methods of one json, rapidjson can't stop inside the document
+     * so they read and validate all of it with read_data
+     * */
+    void create_whole_prefix_readers(std::shared_ptr<umi::umixml> &ff, const std::shared_ptr<umixmltypeclass> &json) {
+      if (!json->read_prefix()) {
+        return;
+      }
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::vector<std::string> names(1, "read_data_prefix");
+      for (auto &projection: ff->getProjections()) {
+        if (projection->json() == json->name()) {
+          names.push_back("read_data_" + projection->name() + "_prefix");
+        }
+      }
+      for (auto &name: names) {
+        std::string method("umison::" + json->name() + "::" + name);
+        output_engine<T1, T2>::m_cpp_streamer
+        << def_indentation << "std::size_t " << method << "(const std::string &input_text, bool &validated)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "return this->" << name << "(input_text, validated, std::cerr);\n"
+        << def_indentation << "}\n\n"
+        << def_indentation << "std::size_t " << method
+        << "(const std::string &input_text, bool &validated, std::ostream &ss)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "validated = this->read_data(input_text, ss);\n"
+        << def_1p_indentation << "return validated ? input_text.size() : 0;\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Creates read_data_streaming of one json, rapidjson builds the document of the whole text so
+     * the json is read with read_data and the elements of its streamed lists are handed over then
+     * */
+    void create_whole_streaming_reader(const std::shared_ptr<umixmltypeclass> &json) {
+      if (json->streaming_arguments().empty()) {
+        return;
+      }
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      streamer << def_indentation << "bool umison::" << json->name() << "::read_data_streaming(const std::string &input_text"
+      << json->streaming_parameters(output_engine<T1, T2>::m_additional_string) << ", std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "if (!this->read_data(input_text, ss)) {\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      for (auto &child: json->getChildren()) {
+        if (!child->streaming()) {
+          continue;
+        }
+        std::string attribute(umixmltype::attribute_prepocess(child->name()));
+        streamer << def_1p_indentation << "for (auto &element : " << attribute << ") {\n"
+        << def_2p_indentation << "on_" << child->name() << "(element);\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "decltype(" << attribute << ")().swap(" << attribute << ");\n";
+      }
+      streamer << def_1p_indentation << "return true;\n"
       << def_indentation << "}\n\n";
     }
 
+    /**
+     * Creates the state machines of the rapidjson-sax engine, validate reads the text with them
+     * so the document isn't built
+     * */
+    void create_validate_state_machines(std::shared_ptr<umi::umixml> &ff) {
+      output_engine_rapid_json_sax<T1, T2> sax(output_engine<T1, T2>::m_h_streamer,
+                                               output_engine<T1, T2>::m_cpp_streamer);
+      sax.additional_string(output_engine<T1, T2>::m_additional_string);
+      sax.m_string_view = output_engine<T1, T2>::m_string_view;
+      sax.create_sax_check(ff);
+    }
+
+    /**
+     * Creates validate of one json with the state machines of create_validate_state_machines, the
+     * handler doesn't keep the values so only the objects open at a time are held
+     * */
+    void create_whole_validate(const std::shared_ptr<umixmltypeclass> &json) {
+      output_engine_rapid_json_sax<T1, T2> sax(output_engine<T1, T2>::m_h_streamer,
+                                               output_engine<T1, T2>::m_cpp_streamer);
+      sax.additional_string(output_engine<T1, T2>::m_additional_string);
+      sax.m_string_view = output_engine<T1, T2>::m_string_view;
+      sax.create_sax_check_validate(json);
+    }
+
+    /**
+     * Creates the start of read_data(parser_context &, const std::string &), the memory of the
+     * read comes from the context. On string_view mode the text is copied into the context
+     * and parsed in place, so the strings point into it until its next read.
+     * */
+    void create_context_prologue(const std::shared_ptr<umixmltypeclass> &ff) {
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      output_engine<T1, T2>::m_cpp_streamer
+      << def_indentation << "bool umison::" << ff->name()
+      << "::read_data(parser_context &context, const std::string &input_text)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "parser_context::impl &_context = *context.m_impl;\n"
+      << def_1p_indentation << "std::ostream &ss = _context.begin();\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        output_engine<T1, T2>::m_cpp_streamer
+        << def_1p_indentation << "_context.text.assign(input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "*this = " << ff->name() << "();\n";
+      }
+    }
+
+    /**
+     * Creates the start of read_data_insitu, checks the buffer and on string_view mode
+     * clears the object so no view is left pointing to a previous buffer
+     * */
+    void create_insitu_prologue(const std::shared_ptr<umixmltypeclass> &ff) {
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      output_engine<T1, T2>::m_cpp_streamer
+      << def_indentation << "bool umison::" << ff->name()
+      << "::read_data_insitu(char *buffer, std::size_t len, std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "if (buffer == nullptr || buffer[len] != '\\0') {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error buffer is not null terminated.\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        output_engine<T1, T2>::m_cpp_streamer << def_1p_indentation << "*this = " << ff->name() << "();\n";
+      }
+    }
+
+    /**
+     * Creates read_data_from_file, and read_data from a string on string_view mode, both load
+     * the input into a buffer that is parsed in place with read_data_insitu. On string_view mode
+     * the buffer is kept by the object as its strings point into it.
+     * */
+    void create_buffer_readers(const std::shared_ptr<umixmltypeclass> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      bool view = output_engine<T1, T2>::m_string_view;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string def_4p_indentation(def_3p_indentation + TABS);
+      if (view) {
+        streamer << def_indentation << "bool umison::" << ff->name()
+        << "::read_data(const std::string &input_text, std::ostream &ss)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+        << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "if (!this->read_data_insitu(&(*_buffer)[0], input_text.size(), ss)) {\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "umison_buffer = _buffer;\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+      }
+      streamer << def_indentation << "bool umison::" << ff->name()
+      << "::read_data_from_file(const std::string &input, std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "if (input.empty()) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Filename is empty.\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "FILE *fi = fopen(input.c_str(), \"rb\");\n"
+      << def_1p_indentation << "if (fi == 0) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error file can't be opened.\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "fseek(fi, 0, SEEK_END);\n"
+      << def_1p_indentation << "long fi_size = ftell(fi);\n"
+      << def_1p_indentation << "fseek(fi, 0, SEEK_SET);\n"
+      << def_1p_indentation << "if (fi_size == 0) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error file is empty.\\n\";\n"
+      << def_2p_indentation << "fclose(fi);\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "long actual_pos = 0;\n";
+      if (view) {
+        streamer << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = "
+        << "std::make_shared<std::vector<char>>(fi_size + 1, static_cast<char>(0x00));\n"
+        << def_1p_indentation << "std::vector<char> &fi_content = *_buffer;\n";
+      } else {
+        streamer << def_1p_indentation << "std::vector<char> fi_content(fi_size + 1, static_cast<char>(0x00));\n";
+      }
+      streamer << def_1p_indentation << "while (actual_pos < fi_size) {\n"
+      << def_2p_indentation << "size_t ret_read = fread(&fi_content[actual_pos], 1, fi_size - actual_pos, fi);\n"
+      << def_2p_indentation << "if (ret_read != static_cast<size_t>(fi_size - actual_pos)) {\n"
+      << def_3p_indentation << "if (feof(fi)) {\n"
+      << def_4p_indentation << "break;\n"
+      << def_3p_indentation << "} else if (ferror(fi)) {\n"
+      << def_4p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading file.\\n\";\n"
+      << def_4p_indentation << "fclose(fi);\n"
+      << def_4p_indentation << "return false;\n"
+      << def_3p_indentation << "} else {\n"
+      << def_4p_indentation << "actual_pos += static_cast<long>(ret_read);\n"
+      << def_3p_indentation << "}\n"
+      << def_2p_indentation << "} else {\n"
+      << def_3p_indentation << "break;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "fclose(fi);\n";
+      if (view) {
+        streamer << def_1p_indentation << "if (!this->read_data_insitu(&fi_content[0], static_cast<std::size_t>(fi_size), ss)) {\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "umison_buffer = _buffer;\n"
+        << def_1p_indentation << "return true;\n";
+      } else {
+        streamer << def_1p_indentation << "return this->read_data_insitu(&fi_content[0], static_cast<std::size_t>(fi_size), ss);\n";
+      }
+      streamer << def_indentation << "}\n";
+    }
+
     /**
      * Method to create a reader based if we are a json reader or a input_parse reader. Creates one reader per element
      * being an element a class or data_parser
+     *
+     * \param insitu true to create read_data_insitu, parsing the buffer in place
+     * \param context true to create the read_data using the memory of a parser_context
      * */
+    /**
+     * Creates the parser of one variant, the tag picks the parser of the class of the case
+     * */
+    void create_variant_reader(const std::shared_ptr<umixmlvariant> &variant) {
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      const std::string &name(variant->name());
+      output_engine<T1, T2>::m_cpp_streamer
+      << def_indentation << "template<typename T, typename Stream>\n"
+      << def_indentation << "bool " << name << "__input_parse(" << name << " &inout, T &rdata, Stream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "if (!rdata.IsObject()) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: " << name
+      << " is not an object\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "auto tag = rdata.FindMember(\"" << variant->tag() << "\");\n"
+      << def_1p_indentation << "if (tag == rdata.MemberEnd() || !tag->value.IsString()) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: " << name
+      << " is missing its tag " << variant->tag() << "\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      for (auto &variant_case: variant->cases()) {
+        output_engine<T1, T2>::m_cpp_streamer
+        << def_1p_indentation << "if (tag->value.GetStringLength() == " << variant_case.value.size()
+        << " && std::memcmp(tag->value.GetString(), \"" << variant_case.value << "\", "
+        << variant_case.value.size() << ") == 0) {\n"
+        << def_2p_indentation << "return " << variant_case.refclass << "__input_parse(inout.mutable_"
+        << variant_case.refclass << "(), rdata, ss);\n"
+        << def_1p_indentation << "}\n";
+      }
+      output_engine<T1, T2>::m_cpp_streamer
+      << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: " << name
+      << " has an unknown " << variant->tag() << "\\n\";\n"
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n";
+    }
+
     void create_single_reader(const std::shared_ptr<umixmltypeclass> &ff, const std::string &name, bool data_reader,
-                              bool additional_reader, bool from_file = false) {
+                              bool additional_reader, bool insitu = false, bool context = false) {
       int actual_level = 1;
       std::string inout;
       std::string inout_dot;
@@ -626,8 +1555,6 @@ namespace umi {
       std::string def_indentation(build_indentation(TABS, actual_level));
       std::string def_1p_indentation(def_indentation + TABS);
       std::string def_2p_indentation(def_1p_indentation + TABS);
-      std::string def_3p_indentation(def_2p_indentation + TABS);
-      std::string def_4p_indentation(def_3p_indentation + TABS);
       // Proceed with the header of the reader
       if (data_reader) {
         output_engine<T1, T2>::m_cpp_streamer
@@ -637,7 +1564,27 @@ namespace umi {
         << def_indentation << "{\n";
       } else {
         if (!additional_reader) {
-          if (!from_file) {
+          if (context) {
+            create_context_prologue(ff);
+            output_engine<T1, T2>::m_cpp_streamer
+            << def_1p_indentation << "parser_context::impl::allocator _value_allocator(_context.value_pool);\n"
+            << def_1p_indentation << "parser_context::impl::allocator _stack_allocator(_context.stack_pool);\n"
+            << def_1p_indentation << "rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>,\n"
+            << def_2p_indentation << "rapidjson::MemoryPoolAllocator<>> " << rdata
+            << "(&_value_allocator, 1024, &_stack_allocator);\n";
+            if (output_engine<T1, T2>::m_string_view) {
+              output_engine<T1, T2>::m_cpp_streamer
+              << def_1p_indentation << "if (" << rdata << ".ParseInsitu(&_context.text[0]).HasParseError()) {\n";
+            } else {
+              output_engine<T1, T2>::m_cpp_streamer
+              << def_1p_indentation << "if (" << rdata << ".Parse(input_text.c_str()).HasParseError()) {\n";
+            }
+            output_engine<T1, T2>::m_cpp_streamer
+            << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+            << rdata << ".GetParseError() << \"\\n\";\n"
+            << def_2p_indentation << "return false;\n"
+            << def_1p_indentation << "}\n";
+          } else if (!insitu) {
             output_engine<T1, T2>::m_cpp_streamer
             << def_indentation << "bool umison::" << ff->name()
             << "::read_data(const std::string &input_text, std::ostream &ss)\n"
@@ -649,49 +1596,10 @@ namespace umi {
             << def_2p_indentation << "return false;\n"
             << def_1p_indentation << "}\n";
           } else {
+            create_insitu_prologue(ff);
             output_engine<T1, T2>::m_cpp_streamer
-            << def_indentation << "bool umison::" << ff->name()
-            << "::read_data_from_file(const std::string &input, std::ostream &ss)\n"
-            << def_indentation << "{\n"
-            << def_1p_indentation << "if (input.empty()) {\n"
-            << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Filename is empty.\\n\";\n"
-            << def_2p_indentation << "return false;\n"
-            << def_1p_indentation << "}\n"
-            << def_1p_indentation << "FILE *fi = fopen(input.c_str(), \"rb\");\n"
-            << def_1p_indentation << "if (fi == 0) {\n"
-            << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error file can't be opened.\\n\";\n"
-            << def_2p_indentation << "return false;\n"
-            << def_1p_indentation << "}\n"
-            << def_1p_indentation << "fseek(fi, 0, SEEK_END);\n"
-            << def_1p_indentation << "long fi_size = ftell(fi);\n"
-            << def_1p_indentation << "fseek(fi, 0, SEEK_SET);\n"
-            << def_1p_indentation << "if (fi_size == 0) {\n"
-            << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error file is empty.\\n\";\n"
-            << def_2p_indentation << "fclose(fi);\n"
-            << def_2p_indentation << "return false;\n"
-            << def_1p_indentation << "}\n"
-            << def_1p_indentation << "long actual_pos = 0;\n"
-            << def_1p_indentation << "std::vector<char> fi_content(fi_size, static_cast<char>(0x00));\n"
-            << def_1p_indentation << "while (actual_pos < fi_size) {\n"
-            << def_2p_indentation << "size_t ret_read = fread(&fi_content[actual_pos], 1, fi_size - actual_pos, fi);\n"
-            << def_2p_indentation << "if (ret_read != static_cast<size_t>(fi_size - actual_pos)) {\n"
-            << def_3p_indentation << "if (feof(fi)) {\n"
-            << def_4p_indentation << "break;\n"
-            << def_3p_indentation << "} else if (ferror(fi)) {\n"
-            << def_4p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading file.\\n\";\n"
-            << def_4p_indentation << "fclose(fi);\n"
-            << def_4p_indentation << "return false;\n"
-            << def_3p_indentation << "} else {\n"
-            << def_4p_indentation << "actual_pos += static_cast<long>(ret_read);\n"
-            << def_3p_indentation << "}\n"
-            << def_2p_indentation << "} else {\n"
-            << def_3p_indentation << "break;\n"
-            << def_2p_indentation << "}\n"
-            << def_1p_indentation << "}\n"
-            << def_1p_indentation << "fclose(fi);\n"
-            << def_1p_indentation << "std::string input_text(fi_content.begin(), fi_content.end());\n"
             << def_1p_indentation << "rapidjson::Document " << rdata << ";\n"
-            << def_1p_indentation << "if (" << rdata << ".Parse(input_text.c_str()).HasParseError()) {\n"
+            << def_1p_indentation << "if (" << rdata << ".ParseInsitu(buffer).HasParseError()) {\n"
             << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
             << rdata << ".GetParseError() << \"\\n\";\n"
             << def_2p_indentation << "return false;\n"
@@ -704,190 +1612,16 @@ namespace umi {
           << def_indentation << "{\n";
         }
       }
-      bool printedIsObject = false;
-#define STATUS_CONDITION_INITIAL 0
-#define STATUS_CONDITION_IN_CONDITION 1
-      int status_condition = STATUS_CONDITION_INITIAL;
-      std::string actualCondition;
       auto &elements = ff->getChildren();
-      ++actual_level;
-      for (auto &single_element : elements) {
-        bool openCondition = true;
-        // Check the condition and open conditional if necessary
-        if (actualCondition == single_element->condition() && !actualCondition.empty()) {
-          // We keep the same condition and it is not empty dont open it
-          openCondition = false;
-        }
-        // if we are in one condition and the option is different
-        // close the previous one
-        if (status_condition == STATUS_CONDITION_IN_CONDITION && actualCondition != single_element->condition()) {
-          --actual_level;
-          output_engine<T1, T2>::m_cpp_streamer
-          << def_1p_indentation << "}\n";
-          status_condition = STATUS_CONDITION_INITIAL;
-        }
-        if (!single_element->condition().empty() && openCondition && status_condition == STATUS_CONDITION_INITIAL) {
-          status_condition = STATUS_CONDITION_IN_CONDITION;
-          actualCondition = single_element->condition();
-          output_engine<T1, T2>::m_cpp_streamer
-          << def_1p_indentation << "if (" << inout_dot << single_element->condition() << ") {\n";
-          // Increase indentation
-          ++actual_level;
-        }
-        // Check if the element is optional
-        if (single_element->optional()) {
-          if (!single_element->isMap()) {
-            if (!printedIsObject) {
-              output_engine<T1, T2>::m_cpp_streamer
-              << build_indentation(TABS, actual_level) << "if (!" << rdata << ".IsObject()) {\n"
-              << build_indentation(TABS, actual_level + 1) <<
-              "ss << __FILE__ <<  \":\" << __LINE__ << \" Element is not an object\\n\";\n"
-              << build_indentation(TABS, actual_level + 1) << "return false;\n"
-              << build_indentation(TABS, actual_level) << "}\n";
-              printedIsObject = true;
-            }
-            output_engine<T1, T2>::m_cpp_streamer
-            << build_indentation(TABS, actual_level) << "if (" << rdata << ".HasMember(\""
-            << single_element->name() << "\")) {\n";
-            ++actual_level;
-          }
-        }
-        // Check if the object checking has been already printed
-        // So we avoid problems checking the rest of elements
-        if (!single_element->isMap()) {
-          if (!printedIsObject) {
-            output_engine<T1, T2>::m_cpp_streamer
-            << build_indentation(TABS, actual_level) << "if (!" << rdata << ".IsObject()) {\n"
-            << build_indentation(TABS, actual_level + 1) <<
-            "ss << __FILE__ <<  \":\" << __LINE__ << \" Element is not an object\\n\";\n"
-            << build_indentation(TABS, actual_level + 1) << "return false;\n"
-            << build_indentation(TABS, actual_level) << "}\n";
-            printedIsObject = true;
-          }
-          // Get if the type is valid
-          if (!single_element->optional()) {
-            output_engine<T1, T2>::m_cpp_streamer
-            << build_indentation(TABS, actual_level) << "if (!" << rdata << ".HasMember(\"" << single_element->name()
-            << "\")) {\n"
-            << build_indentation(TABS, actual_level + 1) <<
-            "ss << __FILE__ << \":\" << __LINE__ << \" Error entity: "
-            << name << " is missing mandatory entry or entity is not an object" << single_element->name()
-            << "\\n\";\n"
-            << build_indentation(TABS, actual_level + 1) << "return false;\n"
-            << build_indentation(TABS, actual_level) << "}\n";
-          }
-        }
-        // Create the if depending on the optionality of the elements 2º IF
-        if (single_element->isMap()) {
-          if (elements.size() > 1) {
-            std::cerr << "Error: More than one element on the same level within a map\n";
-            exit(-1);
-          }
-          if (!single_element->optional()) {
-            _data_reader_single_map((output_engine<T1, T2>::m_cpp_streamer), TABS, rdata, actual_level);
-          } else {
-            _data_reader_second_if_optional_member((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                                   single_element->name(),
-                                                   internal_to_rapidjson(single_element->refclass()), rdata,
-                                                   actual_level);
-          }
-        } else {
-          std::string base_element;
-          if (single_element->isBoolean()) {
-            base_element = "Bool";
-          } else if (single_element->isInteger32()) {
-            base_element = "Int";
-          } else if (single_element->isInteger()) {
-            base_element = "Int64";
-          } else if (single_element->isFloat()) {
-            base_element = "Double";
-          } else if (single_element->isString()) {
-            base_element = "String";
-          } else if (single_element->isList()) {
-            base_element = "Array";
-          } else if (single_element->isRefClass()) {
-            base_element = "Object";
-          } else {
-            std::cerr << "Invalid element: " << single_element->name() << "\n";
-            exit(-1);
-          }
-          if (!single_element->optional()) {
-            _data_reader_single((output_engine<T1, T2>::m_cpp_streamer), TABS, single_element->name(),
-                                name, base_element, rdata, actual_level);
-          } else {
-            _data_reader_second_if_optional((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                            single_element->name(), base_element, rdata, actual_level);
-          }
-        }
-
-        // Last part is assignement of elements, 3º IF
-        if (single_element->isMap()) {
-          if (!single_element->optional()) {
-            _data_reader_map_assign((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                    (output_engine<T1, T2>::m_additional_string),
-                                    single_element->name(), inout_dot, rdata, actual_level);
-          } else {
-            _data_reader_second_if_optional_map((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                                (output_engine<T1, T2>::m_additional_string),
-                                                single_element->name(), inout_dot, rdata, actual_level);
-          }
-        } else if (single_element->isRefClass()) {
-          if (!single_element->optional()) {
-            _data_reader_refclass_assign((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                         single_element->refclass(), single_element->name(), inout_dot, rdata,
-                                         actual_level);
-          } else {
-            _data_reader_second_if_optional_refclass((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                                     single_element->refclass(),
-                                                     single_element->name(), inout_dot, rdata, actual_level);
-          }
-        } else if (single_element->isList()) {
-          if (!single_element->optional()) {
-            _data_reader_list_assign((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                     (output_engine<T1, T2>::m_additional_string),
-                                     single_element->name(), inout_dot, rdata, actual_level);
-          } else {
-            _data_reader_second_if_optional_list((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                                 (output_engine<T1, T2>::m_additional_string),
-                                                 single_element->name(), inout_dot, rdata, actual_level);
-          }
-        } else {
-          std::string base_element;
-          if (single_element->isBoolean()) {
-            base_element = "Bool";
-          } else if (single_element->isInteger()) {
-            base_element = "Int64";
-          } else if (single_element->isInteger32()) {
-            base_element = "Int";
-          } else if (single_element->isFloat()) {
-            base_element = "Double";
-          } else if (single_element->isString()) {
-            base_element = "String";
-          } else {
-            std::cerr << "Invalid element: " << single_element->name() << "\n";
-            exit(-1);
-          }
-          _data_reader_single_assign((output_engine<T1, T2>::m_cpp_streamer), TABS,
-                                     single_element->name(), base_element, inout_dot, rdata, actual_level);
+      if (elements.size() == 1 && elements[0]->isMap()) {
+        create_map_member_reader(elements[0], inout_dot, rdata, actual_level + 1);
+      } else if (!elements.empty()) {
+        std::string lookup(ff->name() + "__field");
+        if (!data_reader) {
+          lookup = "__internal__umison" + output_engine<T1, T2>::m_additional_string + "::" + ff->name() +
+                   "__json__field";
         }
-        // New Line
-        output_engine<T1, T2>::m_cpp_streamer << "\n";
-        // Close the if conditional
-        if (single_element->optional()) {
-          output_engine<T1, T2>::m_cpp_streamer
-          << build_indentation(TABS, actual_level) << inout_dot
-          << "mutable_" << single_element->optional_name() << "() = true;\n";
-          if (!single_element->isMap()) {
-            --actual_level;
-            output_engine<T1, T2>::m_cpp_streamer
-            << build_indentation(TABS, actual_level) << "}\n";
-          }
-        }
-      }
-      if (status_condition == STATUS_CONDITION_IN_CONDITION) {
-        --actual_level;
-        output_engine<T1, T2>::m_cpp_streamer
-        << def_1p_indentation << "}\n";
+        create_member_dispatch(ff, lookup, inout_dot, rdata, actual_level + 1);
       }
       output_engine<T1, T2>::m_cpp_streamer << def_1p_indentation << "return true;\n";
       // Close the method
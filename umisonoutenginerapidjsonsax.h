@@ -0,0 +1,1939 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONOUTENGINERAPIDJSONSAX_H
+#define UMISON_UMISONOUTENGINERAPIDJSONSAX_H
+
+#include "umisonoutenginerapidjson.h"
+#include "umisontypetocpp.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Runtime shared by every parser created with the sax engine, it is printed once
+   * in the internal namespace after the frame kinds.
+   *
+   * The handler keeps one frame per open json object/array and forwards every
+   * rapidjson::Reader event to the state machine of the frame on top.
+   * */
+  static const char *sax_runtime_code = R"umison(    // Scalar value received from the reader
+    struct sax_value {
+        enum value_type {
+            null_value, bool_value, int_value, uint_value, double_value, string_value
+        };
+        value_type type;
+        bool b;
+        long long int i;
+        unsigned long long int u;
+        double d;
+        const char *s;
+        rapidjson::SizeType len;
+
+        bool is_bool() const { return type == bool_value; }
+
+        bool is_int() const
+        {
+            return (type == int_value && i >= INT_MIN && i <= INT_MAX) || (type == uint_value && u <= INT_MAX);
+        }
+
+        bool is_int64() const
+        {
+            return type == int_value || (type == uint_value && u <= static_cast<unsigned long long int>(LLONG_MAX));
+        }
+
+        bool is_double() const { return type == double_value; }
+
+        bool is_string() const { return type == string_value; }
+
+        int get_int() const { return type == int_value ? static_cast<int>(i) : static_cast<int>(u); }
+
+        long long int get_int64() const { return type == int_value ? i : static_cast<long long int>(u); }
+    };
+
+    // State of one open json object or array
+    struct sax_frame {
+        int kind;
+        void *target;
+        // Callback of a streamed list, its elements are handed over and dropped once closed
+        const void *stream;
+        // Filter of a list, the elements it rejects are dropped as soon as they are closed
+        bool (*filter)(const void *element);
+        // The members a projection skips are read, the filters and the indexes may use any of them
+        bool whole;
+        int field;
+        int depth;
+        bool tolerant;
+        unsigned long long int seen[sax_field_words];
+        unsigned long long int failed[sax_field_words];
+        std::string key;
+    };
+
+    template<typename Handler>
+    bool sax_dispatch_key(Handler &h, sax_frame &f, const char *str, rapidjson::SizeType len);
+    template<typename Handler>
+    bool sax_dispatch_value(Handler &h, sax_frame &f, const sax_value &v);
+    template<typename Handler>
+    bool sax_dispatch_start(Handler &h, sax_frame &f, bool is_object);
+    template<typename Handler>
+    bool sax_dispatch_end(Handler &h, sax_frame &f);
+    template<typename Handler>
+    void sax_dispatch_discard(Handler &h, sax_frame &f);
+    template<typename Handler>
+    void sax_dispatch_element(Handler &h, sax_frame &f, int kind);
+
+    // rapidjson::Reader handler, the frame on top of the stack receives the events
+    template<typename Stream>
+    class sax_handler {
+    public:
+        // The frames are given by the caller so their memory can be reused between reads. Without
+        // keep the values are only checked, the elements of the lists and the maps are dropped once
+        // closed and the members stored are the ones the conditions use. streams holds the callbacks
+        // of the streamed lists of the root, in the order of its members. With wanted the read stops,
+        // closing the root, once the root has all the members of the mask. skipped gives the mask of
+        // the members a projection leaves out for each kind, they are marked as seen when the frame
+        // is opened so they are skipped as the unknown ones and not required
+        sax_handler(Stream &ss, int root_kind, void *root_target, std::vector<sax_frame> &frames, bool keep = true,
+                    const void *const *streams = nullptr, const unsigned long long int *wanted = nullptr,
+                    const unsigned long long int *(*skipped)(int kind) = nullptr) :
+            m_ss(ss), m_root_kind(root_kind), m_root_target(root_target), m_started(false), m_keep(keep),
+            m_stopped(false), m_streams(streams), m_wanted(wanted), m_skipped(skipped), m_frames(frames)
+        {
+            m_frames.clear();
+            m_frames.reserve(16);
+            m_root.kind = sax_kind_skip;
+            std::memset(m_root.seen, 0, sizeof(m_root.seen));
+            std::memset(m_root.failed, 0, sizeof(m_root.failed));
+        }
+
+        bool Null()
+        {
+            sax_value v;
+            v.type = sax_value::null_value;
+            return value(v);
+        }
+
+        bool Bool(bool b)
+        {
+            sax_value v;
+            v.type = sax_value::bool_value;
+            v.b = b;
+            return value(v);
+        }
+
+        bool Int(int i)
+        {
+            sax_value v;
+            v.type = sax_value::int_value;
+            v.i = i;
+            return value(v);
+        }
+
+        bool Uint(unsigned u)
+        {
+            sax_value v;
+            v.type = sax_value::uint_value;
+            v.u = u;
+            return value(v);
+        }
+
+        bool Int64(int64_t i)
+        {
+            sax_value v;
+            v.type = sax_value::int_value;
+            v.i = i;
+            return value(v);
+        }
+
+        bool Uint64(uint64_t u)
+        {
+            sax_value v;
+            v.type = sax_value::uint_value;
+            v.u = u;
+            return value(v);
+        }
+
+        bool Double(double d)
+        {
+            sax_value v;
+            v.type = sax_value::double_value;
+            v.d = d;
+            return value(v);
+        }
+
+        bool RawNumber(const char *, rapidjson::SizeType, bool)
+        {
+            return false;
+        }
+
+        bool String(const char *str, rapidjson::SizeType len, bool)
+        {
+            sax_value v;
+            v.type = sax_value::string_value;
+            v.s = str;
+            v.len = len;
+            return value(v);
+        }
+
+        bool StartObject()
+        {
+            return start(true);
+        }
+
+        bool Key(const char *str, rapidjson::SizeType len, bool)
+        {
+            sax_frame &f = m_frames.back();
+            if (f.kind == sax_kind_skip) {
+                return true;
+            }
+            return sax_dispatch_key(*this, f, str, len);
+        }
+
+        bool EndObject(rapidjson::SizeType)
+        {
+            return end();
+        }
+
+        bool StartArray()
+        {
+            return start(false);
+        }
+
+        bool EndArray(rapidjson::SizeType)
+        {
+            return end();
+        }
+
+        // Opens a new frame, the key is taken by value as it may live in the stack. With whole the
+        // frame and the ones opened inside it read every member
+        bool push(int kind, void *target, bool tolerant, std::string key = std::string(), const void *stream = nullptr,
+                  bool (*filter)(const void *element) = nullptr, bool whole = false)
+        {
+            whole = whole || (!m_frames.empty() && m_frames.back().whole);
+            m_frames.emplace_back();
+            sax_frame &f = m_frames.back();
+            f.kind = kind;
+            f.target = target;
+            f.stream = stream;
+            f.filter = filter;
+            f.whole = whole;
+            f.field = -1;
+            f.depth = 0;
+            f.tolerant = tolerant;
+            const unsigned long long int *skipped = m_skipped != nullptr && !whole ? m_skipped(kind) : nullptr;
+            if (skipped != nullptr) {
+                std::memcpy(f.seen, skipped, sizeof(f.seen));
+            } else {
+                std::memset(f.seen, 0, sizeof(f.seen));
+            }
+            std::memset(f.failed, 0, sizeof(f.failed));
+            f.key.swap(key);
+            return true;
+        }
+
+        // Ignores the next depth levels of the document
+        bool skip(int depth = 1)
+        {
+            push(sax_kind_skip, nullptr, false);
+            m_frames.back().depth = depth;
+            return true;
+        }
+
+        Stream &out()
+        {
+            return m_ss;
+        }
+
+        bool keeps() const
+        {
+            return m_keep;
+        }
+
+        // Callback of the streamed list index, nullptr when the lists are stored
+        const void *stream(int index) const
+        {
+            return m_streams != nullptr ? m_streams[index] : nullptr;
+        }
+
+        const sax_frame &root() const
+        {
+            return m_root;
+        }
+
+        // The read was stopped before the end of the root, the text left is not read
+        bool stopped() const
+        {
+            return m_stopped;
+        }
+
+    private:
+        bool value(const sax_value &v)
+        {
+            if (m_frames.empty()) {
+                m_ss << __FILE__ << ":" << __LINE__ << " Element is not an object\n";
+                return false;
+            }
+            sax_frame &f = m_frames.back();
+            if (f.kind == sax_kind_skip) {
+                return true;
+            }
+            return recover(sax_dispatch_value(*this, f, v), 0) && complete();
+        }
+
+        bool start(bool is_object)
+        {
+            if (m_frames.empty()) {
+                if (m_started || !is_object) {
+                    m_ss << __FILE__ << ":" << __LINE__ << " Element is not an object\n";
+                    return false;
+                }
+                m_started = true;
+                return push(m_root_kind, m_root_target, false);
+            }
+            sax_frame &f = m_frames.back();
+            if (f.kind == sax_kind_skip) {
+                ++f.depth;
+                return true;
+            }
+            return recover(sax_dispatch_start(*this, f, is_object), 1);
+        }
+
+        bool end()
+        {
+            sax_frame &f = m_frames.back();
+            if (f.kind == sax_kind_skip) {
+                if (--f.depth == 0) {
+                    m_frames.pop_back();
+                }
+                return true;
+            }
+            if (!sax_dispatch_end(*this, f)) {
+                return recover(false, -1);
+            }
+            if (m_frames.size() == 1) {
+                m_root = f;
+            } else if (!m_keep || m_frames[m_frames.size() - 2].stream != nullptr ||
+                       m_frames[m_frames.size() - 2].filter != nullptr) {
+                sax_dispatch_element(*this, m_frames[m_frames.size() - 2], f.kind);
+            }
+            m_frames.pop_back();
+            return complete();
+        }
+
+        // Closes the root and stops the read once it has the members wanted, the reader then
+        // ends with kParseErrorTermination
+        bool complete()
+        {
+            if (m_wanted == nullptr || m_frames.size() != 1) {
+                return true;
+            }
+            sax_frame &f = m_frames.back();
+            for (int i = 0; i < sax_field_words; ++i) {
+                if ((f.seen[i] & m_wanted[i]) != m_wanted[i]) {
+                    return true;
+                }
+            }
+            if (!sax_dispatch_end(*this, f)) {
+                return false;
+            }
+            m_root = f;
+            m_frames.pop_back();
+            m_stopped = true;
+            return false;
+        }
+
+        // On error drops the frames up to the closest tolerant one, its parent
+        // discards the element and the rest of it is skipped
+        bool recover(bool ok, int opened)
+        {
+            if (ok) {
+                return true;
+            }
+            std::size_t k = m_frames.size();
+            while (k > 0 && !m_frames[k - 1].tolerant) {
+                --k;
+            }
+            if (k == 0) {
+                return false;
+            }
+            --k;
+            int depth = static_cast<int>(m_frames.size() - k) + opened;
+            m_frames.erase(m_frames.begin() + k, m_frames.end());
+            sax_dispatch_discard(*this, m_frames.back());
+            if (depth > 0) {
+                return skip(depth);
+            }
+            return true;
+        }
+
+        Stream &m_ss;
+        int m_root_kind;
+        void *m_root_target;
+        bool m_started;
+        bool m_keep;
+        bool m_stopped;
+        const void *const *m_streams;
+        const unsigned long long int *m_wanted;
+        const unsigned long long int *(*m_skipped)(int kind);
+        sax_frame m_root;
+        std::vector<sax_frame> &m_frames;
+    };
+
+)umison";
+
+  /**
+   * rapid json sax output engine, the .cpp file fills the data structures straight
+   * from the rapidjson::Reader events so no rapidjson::Document is built
+   *
+   * Every class gets a state machine made of small functions (field lookup, scalar
+   * values, nested containers and the checks on close), conditions are evaluated once
+   * the object has been closed as the json may hold the fields in any order
+   * */
+  template<typename T1, typename T2>
+  class output_engine_rapid_json_sax : public output_engine_rapid_json<T1, T2> {
+  public:
+    /**
+     * Constructor, internally will call the output_engine_rapid_json constructor
+     * */
+    output_engine_rapid_json_sax(T1 &_H_streamer, T2 &_CPP_streamer)
+      : output_engine_rapid_json<T1, T2>(_H_streamer, _CPP_streamer) {
+    }
+
+    /**
+     * Releases the resources used by this engine
+     * */
+    virtual ~output_engine_rapid_json_sax() {
+    }
+
+    /**
+     * Create the state machines on namespace sax_check of the internal namespace, the rapidjson
+     * engine validates with them so it doesn't build the document
+     *
+     * \param ff with the XML template already built
+     * */
+    void create_sax_check(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      streamer << TABS << "namespace sax_check {\n\n";
+      create_sax_state_machines(ff, sax_entities(ff));
+      streamer << TABS << "}\n\n";
+    }
+
+    /**
+     * Create validate of one json with the state machines of create_sax_check
+     * */
+    void create_sax_check_validate(const std::shared_ptr<umixmltypeclass> &json) {
+      create_sax_validate(sax_json_entity(json), "sax_check::");
+    }
+
+  protected:
+    /**
+     * Element with a state machine, a class or a json
+     * */
+    struct sax_entity {
+      std::shared_ptr<umixmltypeclass> cls;
+      std::string prefix;
+      std::string type;
+      std::string kind;
+      bool json;
+    };
+
+    /**
+     * Method used to write the .cpp content to the cpp stream
+     *
+     * \param ff with the XML template already built
+     * */
+    virtual bool internal_write(std::shared_ptr<umi::umixml> &ff) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::vector<sax_entity> entities(sax_entities(ff));
+
+      this->create_disclaimer();
+      create_includes();
+      // Create the internal namespace
+      streamer << "namespace __internal__umison" << output_engine<T1, T2>::m_additional_string << " {\n\n";
+      this->create_index_builders(ff);
+      perfect_hash::print_runtime(streamer, TABS, 1);
+      this->create_enum_lookups(ff);
+      create_sax_state_machines(ff, entities);
+      create_sax_projections(ff, entities);
+      // Close the namespace
+      streamer << "}\n\n";
+      // Create the memory kept between reads
+      std::vector<std::pair<std::string, std::string>> buffers;
+      buffers.emplace_back("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::sax_frame", "frames");
+      if (output_engine<T1, T2>::m_string_view) {
+        buffers.emplace_back("char", "text");
+      }
+      this->create_parser_context({"stack_pool"}, buffers);
+      this->create_index_finders(ff);
+      // Create the final parsers
+      streamer << "// Json parsers\n";
+      for (auto &entity: entities) {
+        if (!entity.json) {
+          continue;
+        }
+        this->create_default_method_read(entity.cls);
+        if (!output_engine<T1, T2>::m_string_view) {
+          create_sax_read_data(entity, false, false);
+        }
+        if (output_engine<T1, T2>::m_additional_engine_information == "rapidjson") {
+          this->create_default_additional_method(entity.cls);
+          create_sax_read_data(entity, false, true);
+        }
+        streamer << "\n";
+        create_sax_read_data(entity, true, false);
+        streamer << "\n";
+        create_sax_read_data(entity, false, false, true);
+        streamer << "\n";
+        this->create_buffer_readers(entity.cls);
+        streamer << "\n";
+        if (is_map_entity(entity)) {
+          this->create_whole_projection_readers(ff, entity.cls);
+          this->create_whole_prefix_readers(ff, entity.cls);
+        } else {
+          create_sax_prefix_reader(entity, nullptr);
+          for (auto &projection: ff->getProjections()) {
+            if (projection->json() == entity.cls->name()) {
+              create_sax_projection_reader(entity, *projection);
+              create_sax_prefix_reader(entity, projection.get());
+            }
+          }
+        }
+        create_sax_validate(entity);
+        create_sax_streaming_reader(entity);
+      }
+      return true;
+    }
+
+    /**
+     * Elements with a state machine, the classes and the jsons
+     * */
+    static std::vector<sax_entity> sax_entities(std::shared_ptr<umi::umixml> &ff) {
+      std::vector<sax_entity> entities;
+      for (auto &class_it: ff->getClassMap()) {
+        entities.push_back(sax_entity{class_it.second, class_it.first, class_it.first,
+                                      sax_kind(class_it.first, "class"), false});
+      }
+      for (auto &class_it: ff->getJsonArray()) {
+        entities.push_back(sax_json_entity(class_it));
+      }
+      for (auto &entity: entities) {
+        auto &children = entity.cls->getChildren();
+        for (auto &child: children) {
+          if (child->isMap() && children.size() > 1) {
+            std::cerr << "Error: More than one element on the same level within a map\n";
+            exit(-1);
+          }
+        }
+      }
+      return entities;
+    }
+
+    /**
+     * Element with the state machine of a json
+     * */
+    static sax_entity sax_json_entity(const std::shared_ptr<umixmltypeclass> &json) {
+      return sax_entity{json, json->name() + "__json", "umison::" + json->name(), sax_kind(json->name(), "json"), true};
+    }
+
+    /**
+     * Create the runtime, the state machines and the dispatchers, the index builders, the perfect hash
+     * runtime and the enum lookups must be on the same or an enclosing namespace
+     * */
+    void create_sax_state_machines(std::shared_ptr<umi::umixml> &ff, const std::vector<sax_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      create_sax_kinds(ff, entities);
+      create_sax_runtime(entities);
+      create_sax_forward_declarations(ff, entities);
+      create_sax_basic_readers();
+      create_sax_filters(entities);
+      streamer << TABS << "// State machines\n";
+      for (auto &entity: entities) {
+        create_sax_field(entity);
+        create_sax_push(entity);
+        if (!is_map_entity(entity)) {
+          create_sax_value(entity);
+          create_sax_start(entity);
+          create_sax_end(entity);
+        }
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        create_sax_variant_push(variant);
+      }
+      create_sax_dispatchers(ff, entities);
+    }
+
+    /**
+     * Create the include of the files in the .cpp file
+     * */
+    void create_includes() {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      if (!output_engine<T1, T2>::m_h_name.empty()) {
+        streamer << "#include \"" << output_engine<T1, T2>::m_h_name << "\"\n";
+      }
+      streamer << "#include \"rapidjson/rapidjson.h\"\n"
+      << "#include \"rapidjson/memorystream.h\"\n"
+      << "#include \"rapidjson/reader.h\"\n";
+      if (output_engine<T1, T2>::m_additional_engine_information == "rapidjson") {
+        streamer << "#include \"rapidjson/document.h\"\n";
+      }
+      streamer << "#include <inttypes.h>\n"
+      << "#include <algorithm>\n"
+      << "#include <climits>\n"
+      << "#include <cmath>\n"
+      << "#include <cstdio>\n"
+      << "#include <cstdlib>\n"
+      << "#include <cstring>\n"
+      << "#include <iostream>\n"
+      << "#include <iterator>\n"
+      << "#include <map>\n"
+      << "#include <sstream>\n"
+      << "#include <string>\n"
+      << "#include <vector>\n";
+      writer_printer<T2>::print_includes(streamer);
+      streamer << "\n";
+    }
+
+    /**
+     * Name of the frame kind for one element and role
+     * */
+    static std::string sax_kind(const std::string &name, const std::string &role) {
+      return "sax_kind_" + name + "__" + role;
+    }
+
+    /**
+     * Name of the frame kind used for a map element, optional maps of classes
+     * only accept objects as values
+     * */
+    static std::string sax_map_kind(const std::shared_ptr<umixmltype> &element) {
+      if (element->optional() && !sax_is_basic(element->refclass())) {
+        return sax_kind(element->refclass(), "map_object");
+      }
+      return sax_kind(element->refclass(), "map");
+    }
+
+    /**
+     * C++ type of the values stored for a refclass/value attribute
+     * */
+    std::string sax_value_type(const std::string &refclass) const {
+      type_to_cpp tcpp(output_engine<T1, T2>::m_string_view);
+      std::string retval = tcpp.get_type(refclass);
+      if (retval.empty()) {
+        retval = "__internal__umison" + output_engine<T1, T2>::m_additional_string + "::" + refclass;
+      }
+      return retval;
+    }
+
+    /**
+     * Returns true if the refclass/value attribute is one of the basic types
+     * */
+    static bool sax_is_basic(const std::string &refclass) {
+      type_to_cpp tcpp;
+      return !tcpp.get_type(refclass).empty();
+    }
+
+    /**
+     * Check done on the sax_value for each basic type
+     * */
+    static std::string sax_check(const std::string &refclass) {
+      if (refclass == UMI_XMLTAGS_BOOLEAN) {
+        return "is_bool()";
+      } else if (refclass == UMI_XMLTAGS_INTEGER32) {
+        return "is_int()";
+      } else if (refclass == UMI_XMLTAGS_INTEGER) {
+        return "is_int64()";
+      } else if (refclass == UMI_XMLTAGS_FLOAT) {
+        return "is_double()";
+      }
+      return "is_string()";
+    }
+
+    /**
+     * Expression used to get the value of the sax_value v for each basic type
+     * */
+    std::string sax_get(const std::string &refclass) const {
+      if (refclass == UMI_XMLTAGS_BOOLEAN) {
+        return "v.b";
+      } else if (refclass == UMI_XMLTAGS_INTEGER32) {
+        return "v.get_int()";
+      } else if (refclass == UMI_XMLTAGS_INTEGER) {
+        return "v.get_int64()";
+      } else if (refclass == UMI_XMLTAGS_FLOAT) {
+        return "v.d";
+      }
+      return this->string_type() + "(v.s, v.len)";
+    }
+
+    /**
+     * Basic type name of a scalar element
+     * */
+    static std::string sax_scalar_type(const std::shared_ptr<umixmltype> &element) {
+      if (element->isBoolean()) {
+        return UMI_XMLTAGS_BOOLEAN;
+      } else if (element->isInteger32()) {
+        return UMI_XMLTAGS_INTEGER32;
+      } else if (element->isInteger()) {
+        return UMI_XMLTAGS_INTEGER;
+      } else if (element->isFloat()) {
+        return UMI_XMLTAGS_FLOAT;
+      } else if (element->isString()) {
+        return UMI_XMLTAGS_STRING;
+      }
+      std::cerr << "Invalid element: " << element->name() << "\n";
+      exit(-1);
+    }
+
+    /**
+     * Expression testing the bit of one field
+     * */
+    static std::string sax_bit(const std::string &bits, size_t index) {
+      return "(" + bits + "[" + std::to_string(index / 64) + "] & (1ULL << " + std::to_string(index % 64) + "))";
+    }
+
+    /**
+     * Expression setting the bit of one field
+     * */
+    static std::string sax_set_bit(const std::string &bits, size_t index) {
+      return bits + "[" + std::to_string(index / 64) + "] |= 1ULL << " + std::to_string(index % 64) + ";";
+    }
+
+    /**
+     * The entity is only a map, its frames are the frames of the map
+     * */
+    static bool is_map_entity(const sax_entity &entity) {
+      auto &children = entity.cls->getChildren();
+      return children.size() == 1 && children[0]->isMap();
+    }
+
+    /**
+     * Create the enumeration with the kind of frames
+     * */
+    void create_sax_kinds(std::shared_ptr<umi::umixml> &ff, const std::vector<sax_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 1));
+      std::string def_2p_indentation(build_indentation(TABS, 2));
+      streamer << def_1p_indentation << "// Kind of elements a sax frame can hold\n"
+      << def_1p_indentation << "enum sax_kind {\n"
+      << def_2p_indentation << "sax_kind_skip";
+      for (auto &basic: sax_basic_types()) {
+        streamer << ",\n" << def_2p_indentation << sax_kind(basic, "list")
+        << ",\n" << def_2p_indentation << sax_kind(basic, "map");
+      }
+      for (auto &class_it: ff->getClassMap()) {
+        streamer << ",\n" << def_2p_indentation << sax_kind(class_it.first, "class")
+        << ",\n" << def_2p_indentation << sax_kind(class_it.first, "list")
+        << ",\n" << def_2p_indentation << sax_kind(class_it.first, "map")
+        << ",\n" << def_2p_indentation << sax_kind(class_it.first, "map_array")
+        << ",\n" << def_2p_indentation << sax_kind(class_it.first, "map_object");
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << ",\n" << def_2p_indentation << sax_kind(variant->name(), "variant")
+        << ",\n" << def_2p_indentation << sax_kind(variant->name(), "list");
+      }
+      for (auto &entity: entities) {
+        if (entity.json) {
+          streamer << ",\n" << def_2p_indentation << entity.kind;
+        }
+      }
+      streamer << "\n" << def_1p_indentation << "};\n\n";
+    }
+
+    /**
+     * Basic types supported on lists and maps
+     * */
+    static std::vector<std::string> sax_basic_types() {
+      return std::vector<std::string>{UMI_XMLTAGS_INTEGER32, UMI_XMLTAGS_INTEGER, UMI_XMLTAGS_FLOAT,
+                                      UMI_XMLTAGS_BOOLEAN, UMI_XMLTAGS_STRING};
+    }
+
+    /**
+     * Create the frames, the handler and the rest of common code
+     * */
+    void create_sax_runtime(const std::vector<sax_entity> &entities) {
+      size_t max_fields = 1;
+      for (auto &entity: entities) {
+        max_fields = std::max(max_fields, entity.cls->getChildren().size());
+      }
+      output_engine<T1, T2>::m_cpp_streamer
+      << TABS << "// Number of 64 bits words used to track the fields of the biggest class\n"
+      << TABS << "const int sax_field_words = " << (max_fields + 63) / 64 << ";\n\n"
+      << sax_runtime_code;
+    }
+
+    /**
+     * Create the forward declaration of the state machines
+     * */
+    void create_sax_forward_declarations(std::shared_ptr<umi::umixml> &ff, const std::vector<sax_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      streamer << TABS << "// Forward declaration of the state machines\n";
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << TABS << "template<typename Handler>\n"
+        << TABS << "bool " << variant->name() << "__sax_push(Handler &h, " << sax_value_type(variant->name())
+        << " &inout, bool tolerant);\n";
+      }
+      for (auto &entity: entities) {
+        if (!entity.json) {
+          streamer << TABS << "template<typename Handler>\n"
+          << TABS << "bool " << entity.prefix << "__sax_push(Handler &h, " << entity.type << " &inout, bool tolerant);\n";
+        }
+        if (!is_map_entity(entity)) {
+          streamer << TABS << "template<typename Handler>\n"
+          << TABS << "bool " << entity.prefix << "__sax_value(Handler &h, sax_frame &f, const sax_value &v);\n"
+          << TABS << "template<typename Handler>\n"
+          << TABS << "bool " << entity.prefix << "__sax_start(Handler &h, sax_frame &f, bool is_object);\n"
+          << TABS << "template<typename Handler>\n"
+          << TABS << "bool " << entity.prefix << "__sax_end(Handler &h, sax_frame &f);\n";
+        }
+      }
+      streamer << "\n";
+    }
+
+    /**
+     * Create the consumers of basic values inside lists and maps
+     * */
+    void create_sax_basic_readers() {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      streamer << def_indentation << "// Json type array and map values\n";
+      for (auto &basic: sax_basic_types()) {
+        std::string type(sax_value_type(basic));
+        std::string value(basic == UMI_XMLTAGS_STRING ? "v.s, v.len" : sax_get(basic));
+        streamer << def_indentation << "template<typename Handler>\n"
+        << def_indentation << "bool _sax_list_value(Handler &h, std::vector<" << type << "> &str, const sax_value &v)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "if (!v." << sax_check(basic) << ") {\n"
+        << def_2p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \"Error data is not an "
+        << internal_to_rapidjson(basic) << "\\n\";\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "if (h.keeps()) {\n"
+        << def_2p_indentation << "str.emplace_back(" << value << ");\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n"
+        << def_indentation << "template<typename Handler>\n"
+        << def_indentation << "bool _sax_map_value(Handler &h, std::multimap<std::string, " << type
+        << "> &str, const std::string &key, const sax_value &v)\n"
+        << def_indentation << "{\n"
+        << def_1p_indentation << "if (!v." << sax_check(basic) << ") {\n"
+        << def_2p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \"Error map value is not a "
+        << internal_to_rapidjson(basic) << "\\n\";\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "if (h.keeps()) {\n"
+        << def_2p_indentation << "str.emplace(key, " << sax_get(basic) << ");\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Create the perfect hash lookup from json key to field index
+     * */
+    void create_sax_field(const sax_entity &entity) {
+      if (is_map_entity(entity)) {
+        return;
+      }
+      std::vector<std::string> names;
+      for (auto &element: entity.cls->getChildren()) {
+        names.push_back(element->name());
+      }
+      perfect_hash(names).print_lookup(output_engine<T1, T2>::m_cpp_streamer, entity.prefix + "__field", TABS, 1);
+    }
+
+    /**
+     * Create the method used to open the frame of one class
+     * */
+    void create_sax_push(const sax_entity &entity) {
+      if (entity.json) {
+        return;
+      }
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool " << entity.prefix << "__sax_push(Handler &h, " << entity.type
+      << " &inout, bool tolerant)\n"
+      << def_indentation << "{\n";
+      if (is_map_entity(entity)) {
+        auto &element = entity.cls->getChildren()[0];
+        if (element->optional()) {
+          streamer << def_1p_indentation << "inout.mutable_" << element->optional_name() << "() = true;\n";
+        }
+        streamer << def_1p_indentation << "return h.push(" << sax_map_kind(element)
+        << ", &inout.mutable_" << element->name() << "(), tolerant);\n";
+      } else {
+        streamer << def_1p_indentation << "return h.push(" << entity.kind << ", &inout, tolerant);\n";
+      }
+      streamer << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the method used to open the frame of one variant, the frame becomes the frame of
+     * the class of the case once its tag is read
+     * */
+    void create_sax_variant_push(const std::shared_ptr<umixmlvariant> &variant) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool " << variant->name() << "__sax_push(Handler &h, "
+      << sax_value_type(variant->name()) << " &inout, bool tolerant)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return h.push(" << sax_kind(variant->name(), "variant") << ", &inout, tolerant);\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Writes the error of a field with the wrong type, fields under a condition
+     * keep the error until the condition is evaluated
+     * */
+    void _sax_wrong_type(T2 &streamer, const std::string &space, const sax_entity &entity, size_t index,
+                         bool skip, int level) {
+      std::string def_indentation(build_indentation(space, level));
+      auto &element = entity.cls->getChildren()[index];
+      if (element->condition().empty()) {
+        streamer << def_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+        << entity.cls->name() << " is wrong type " << element->name() << "\\n\";\n"
+        << def_indentation << "return false;\n";
+      } else {
+        streamer << def_indentation << sax_set_bit("f.failed", index) << "\n"
+        << def_indentation << (skip ? "return h.skip();\n" : "return true;\n");
+      }
+    }
+
+    /**
+     * Marks the field as read, sets the optional flag
+     * */
+    void _sax_mark(T2 &streamer, const std::string &space, const std::shared_ptr<umixmltype> &element,
+                   size_t index, int level) {
+      std::string def_indentation(build_indentation(space, level));
+      streamer << def_indentation << sax_set_bit("f.seen", index) << "\n";
+      if (element->optional()) {
+        streamer << def_indentation << "inout.mutable_" << element->optional_name() << "() = true;\n";
+      }
+    }
+
+    /**
+     * Create the consumer of scalar values of one class
+     * */
+    void create_sax_value(const sax_entity &entity) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string def_4p_indentation(def_3p_indentation + TABS);
+      auto &children = entity.cls->getChildren();
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool " << entity.prefix << "__sax_value(Handler &h, sax_frame &f, const sax_value &v)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << entity.type << " &inout = *static_cast<" << entity.type << " *>(f.target);\n"
+      << def_1p_indentation << "(void) h;\n"
+      << def_1p_indentation << "(void) v;\n"
+      << def_1p_indentation << "(void) inout;\n"
+      << def_1p_indentation << "if (f.field < 0 || " << "(f.seen[f.field / 64] & (1ULL << (f.field % 64)))) {\n"
+      << def_2p_indentation << "return true;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "switch (f.field) {\n";
+      for (size_t i = 0; i < children.size(); ++i) {
+        auto &element = children[i];
+        streamer << def_2p_indentation << "case " << i << ":\n";
+        if (element->isList() || element->isRefClass()) {
+          _sax_wrong_type(streamer, TABS, entity, i, false, 3);
+          continue;
+        }
+        // The enums and the strings longer than their maximum are wrong as the other types
+        if (element->isEnum() || element->bounded()) {
+          if (element->isEnum()) {
+            streamer << def_3p_indentation << "if (!v.is_string() || !" << element->enum_type() << "__enum(v.s, v.len, "
+            << "inout.mutable_" << element->name() << "())) {\n";
+          } else {
+            streamer << def_3p_indentation << "if (!v.is_string() || !inout.mutable_" << element->name()
+            << "().assign(v.s, v.len)) {\n";
+          }
+          _sax_wrong_type(streamer, TABS, entity, i, false, 4);
+          streamer << def_3p_indentation << "}\n";
+          _sax_mark(streamer, TABS, element, i, 3);
+          streamer << def_3p_indentation << "return true;\n";
+          continue;
+        }
+        std::string type(sax_scalar_type(element));
+        streamer << def_3p_indentation << "if (!v." << sax_check(type) << ") {\n";
+        _sax_wrong_type(streamer, TABS, entity, i, false, 4);
+        streamer << def_3p_indentation << "}\n";
+        std::string store("inout.mutable_" + element->name() + "()");
+        if (element->intern()) {
+          store += " = umison_intern(v.s, v.len);\n";
+        } else if (type == UMI_XMLTAGS_STRING && !output_engine<T1, T2>::m_string_view) {
+          store += ".assign(v.s, v.len);\n";
+        } else {
+          store += " = " + sax_get(type) + ";\n";
+        }
+        // validate only keeps the members the conditions use
+        if (this->conditioned(entity.cls, element)) {
+          streamer << def_3p_indentation << store;
+        } else {
+          streamer << def_3p_indentation << "if (h.keeps()) {\n"
+          << def_4p_indentation << store
+          << def_3p_indentation << "}\n";
+        }
+        _sax_mark(streamer, TABS, element, i, 3);
+        streamer << def_3p_indentation << "return true;\n";
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "return true;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the consumer of nested objects and arrays of one class
+     * */
+    void create_sax_start(const sax_entity &entity) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      auto &children = entity.cls->getChildren();
+      int streamed = 0;
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool " << entity.prefix << "__sax_start(Handler &h, sax_frame &f, bool is_object)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << entity.type << " &inout = *static_cast<" << entity.type << " *>(f.target);\n"
+      << def_1p_indentation << "(void) is_object;\n"
+      << def_1p_indentation << "(void) inout;\n"
+      << def_1p_indentation << "if (f.field < 0 || " << "(f.seen[f.field / 64] & (1ULL << (f.field % 64)))) {\n"
+      << def_2p_indentation << "return h.skip();\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "switch (f.field) {\n";
+      for (size_t i = 0; i < children.size(); ++i) {
+        auto &element = children[i];
+        bool tolerant = !element->condition().empty();
+        streamer << def_2p_indentation << "case " << i << ":\n";
+        if (element->isRefClass()) {
+          streamer << def_3p_indentation << "if (!is_object) {\n";
+          _sax_wrong_type(streamer, TABS, entity, i, true, 4);
+          streamer << def_3p_indentation << "}\n";
+          _sax_mark(streamer, TABS, element, i, 3);
+          streamer << def_3p_indentation << "return " << element->refclass() << "__sax_push(h, inout.mutable_"
+          << element->name() << "(), " << (tolerant ? "true" : "false") << ");\n";
+        } else if (element->isList()) {
+          streamer << def_3p_indentation << "if (is_object) {\n";
+          _sax_wrong_type(streamer, TABS, entity, i, true, 4);
+          streamer << def_3p_indentation << "}\n";
+          _sax_mark(streamer, TABS, element, i, 3);
+          streamer << def_3p_indentation << "return h.push(" << sax_kind(element->refclass(), "list")
+          << ", &inout.mutable_" << element->name() << "(), " << (tolerant ? "true" : "false");
+          // The elements of the lists with a filter or an index are read whole by the projections
+          bool whole = !element->filter().empty() || !element->index().empty();
+          if (entity.json && element->streaming()) {
+            streamer << ", std::string(), h.stream(" << streamed++ << ")";
+          } else if (whole) {
+            streamer << ", std::string(), nullptr";
+          }
+          if (whole) {
+            streamer << ", " << (element->filter().empty() ? "nullptr" : sax_filter(entity, element)) << ", true";
+          }
+          streamer << ");\n";
+        } else {
+          _sax_wrong_type(streamer, TABS, entity, i, true, 3);
+        }
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "return h.skip();\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Writes the error of a mandatory field not found in the object
+     * */
+    void _sax_missing(T2 &streamer, const std::string &space, const sax_entity &entity, const std::string &frame,
+                      const std::string &out, size_t index, int level, const std::string &failure = "false") {
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      streamer << def_indentation << "if (!" << sax_bit(frame + ".seen", index) << ") {\n"
+      << def_1p_indentation << out << " << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+      << entity.cls->name() << " is missing mandatory entry or entity is not an object"
+      << entity.cls->getChildren()[index]->name() << "\\n\";\n"
+      << def_1p_indentation << "return " << failure << ";\n"
+      << def_indentation << "}\n";
+    }
+
+    /**
+     * Writes the checks of mandatory and conditional fields once the object is closed
+     *
+     * \param inout_dot prefix used to reach the data on conditions and accessors
+     * \param frame name of the frame with the bits of the object
+     * \param conditional true to print the conditional fields, false for the rest
+     * \param failure value returned when a check fails
+     * */
+    void _sax_checks(T2 &streamer, const std::string &space, const sax_entity &entity, const std::string &inout_dot,
+                     const std::string &frame, const std::string &out, bool conditional, int level,
+                     const std::string &failure = "false") {
+      std::string def_indentation(build_indentation(space, level));
+      std::string def_1p_indentation(def_indentation + space);
+      std::string def_2p_indentation(def_1p_indentation + space);
+      auto &children = entity.cls->getChildren();
+      for (size_t i = 0; i < children.size(); ++i) {
+        auto &element = children[i];
+        if (element->condition().empty() == conditional) {
+          continue;
+        }
+        if (!conditional) {
+          if (!element->optional()) {
+            _sax_missing(streamer, space, entity, frame, out, i, level, failure);
+          }
+          continue;
+        }
+        streamer << def_indentation << "if (" << inout_dot << element->condition() << ") {\n";
+        if (!element->optional()) {
+          _sax_missing(streamer, space, entity, frame, out, i, level + 1, failure);
+        }
+        streamer << def_1p_indentation << "if (" << sax_bit(frame + ".failed", i) << ") {\n"
+        << def_2p_indentation << out << " << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+        << entity.cls->name() << " is wrong type " << element->name() << "\\n\";\n"
+        << def_2p_indentation << "return " << failure << ";\n"
+        << def_1p_indentation << "}\n"
+        << def_indentation << "} else {\n"
+        << def_1p_indentation << inout_dot << "mutable_" << element->name() << "() = {};\n";
+        if (element->optional()) {
+          streamer << def_1p_indentation << inout_dot << "mutable_" << element->optional_name() << "() = false;\n";
+        }
+        streamer << def_indentation << "}\n";
+      }
+    }
+
+    /**
+     * Name of the filter of a list of an entity
+     * */
+    static std::string sax_filter(const sax_entity &entity, const std::shared_ptr<umixmltype> &element) {
+      return entity.prefix + "__" + element->name() + "__sax_filter";
+    }
+
+    /**
+     * Create the filters of the lists, the frame of a list calls its filter on each element once
+     * the element is closed
+     * */
+    void create_sax_filters(const std::vector<sax_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_1p_indentation(build_indentation(TABS, 2));
+      bool first = true;
+      for (auto &entity: entities) {
+        for (auto &element: entity.cls->getChildren()) {
+          if (!element->isList() || element->filter().empty()) {
+            continue;
+          }
+          if (first) {
+            streamer << TABS << "// Filters of the lists\n";
+            first = false;
+          }
+          std::string type(sax_value_type(element->refclass()));
+          streamer << TABS << "bool " << sax_filter(entity, element) << "(const void *element)\n"
+          << TABS << "{\n"
+          << def_1p_indentation << "const " << type << " &inout = *static_cast<const " << type << " *>(element);\n"
+          << def_1p_indentation << "return (inout." << element->filter() << ");\n"
+          << TABS << "}\n\n";
+        }
+      }
+    }
+
+    /**
+     * Create the checks done when the object of one class is closed
+     * */
+    void create_sax_end(const sax_entity &entity) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool " << entity.prefix << "__sax_end(Handler &h, sax_frame &f)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << entity.type << " &inout = *static_cast<" << entity.type << " *>(f.target);\n"
+      << def_1p_indentation << "(void) h;\n"
+      << def_1p_indentation << "(void) inout;\n";
+      _sax_checks(streamer, TABS, entity, "inout.", "f", "h.out()", false, 1);
+      if (!entity.json) {
+        // Conditions on json members are evaluated by read_data
+        _sax_checks(streamer, TABS, entity, "inout.", "f", "h.out()", true, 1);
+      }
+      // The elements the filters reject have been dropped as they were closed, the lists with an
+      // index are indexed
+      for (auto &element: entity.cls->getChildren()) {
+        if (element->isList()) {
+          this->_data_reader_index(streamer, TABS, element, "inout.", 1);
+        }
+      }
+      streamer << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the dispatchers used by the handler to reach the state machine
+     * of the frame on top
+     * */
+    void create_sax_dispatchers(std::shared_ptr<umi::umixml> &ff, const std::vector<sax_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string def_4p_indentation(def_3p_indentation + TABS);
+
+      streamer << def_indentation << "// Dispatchers\n"
+      << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool sax_dispatch_key(Handler &h, sax_frame &f, const char *str, rapidjson::SizeType len)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "(void) h;\n"
+      << def_1p_indentation << "switch (f.kind) {\n";
+      for (auto &entity: entities) {
+        if (!is_map_entity(entity)) {
+          streamer << def_2p_indentation << "case " << entity.kind << ":\n"
+          << def_3p_indentation << "f.field = " << entity.prefix << "__field(str, len);\n"
+          << def_3p_indentation << "return true;\n";
+        }
+      }
+      // The tag of a variant is field 0, any other member read before it is field 1
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << def_2p_indentation << "case " << sax_kind(variant->name(), "variant") << ":\n"
+        << def_3p_indentation << "f.field = len == " << variant->tag().size() << " && std::memcmp(str, \""
+        << variant->tag() << "\", " << variant->tag().size() << ") == 0 ? 0 : 1;\n"
+        << def_3p_indentation << "return true;\n";
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "f.key.assign(str, len);\n"
+      << def_3p_indentation << "return true;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+
+      // Scalar values
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool sax_dispatch_value(Handler &h, sax_frame &f, const sax_value &v)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "switch (f.kind) {\n";
+      for (auto &basic: sax_basic_types()) {
+        std::string type(sax_value_type(basic));
+        streamer << def_2p_indentation << "case " << sax_kind(basic, "list") << ":\n"
+        << def_3p_indentation << "return _sax_list_value(h, *static_cast<std::vector<" << type
+        << "> *>(f.target), v);\n"
+        << def_2p_indentation << "case " << sax_kind(basic, "map") << ":\n"
+        << def_3p_indentation << "return _sax_map_value(h, *static_cast<std::multimap<std::string, " << type
+        << "> *>(f.target), f.key, v);\n";
+      }
+      for (auto &class_it: ff->getClassMap()) {
+        streamer << def_2p_indentation << "case " << sax_kind(class_it.first, "list") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << class_it.first << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_array") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << class_it.first << "\\n\";\n"
+        << def_3p_indentation << "return true;\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_object") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error map value is not Object\\n\";\n"
+        << def_3p_indentation << "return false;\n";
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        std::string type(sax_value_type(variant->name()));
+        streamer << def_2p_indentation << "case " << sax_kind(variant->name(), "list") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << variant->name() << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "case " << sax_kind(variant->name(), "variant") << ": {\n"
+        << def_3p_indentation << type << " &inout = *static_cast<" << type << " *>(f.target);\n"
+        << def_3p_indentation << "if (f.field != 0 || !v.is_string()) {\n"
+        << def_4p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << variant->name()
+        << " needs its tag " << variant->tag() << " as a string before the other members\\n\";\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n";
+        for (auto &variant_case: variant->cases()) {
+          streamer << def_3p_indentation << "if (v.len == " << variant_case.value.size() << " && std::memcmp(v.s, \""
+          << variant_case.value << "\", " << variant_case.value.size() << ") == 0) {\n"
+          << def_4p_indentation << "f.kind = " << sax_kind(variant_case.refclass, "class") << ";\n"
+          << def_4p_indentation << "f.target = &inout.mutable_" << variant_case.refclass << "();\n"
+          << def_4p_indentation << "f.field = -1;\n"
+          << def_4p_indentation << "return true;\n"
+          << def_3p_indentation << "}\n";
+        }
+        streamer << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: "
+        << variant->name() << " has an unknown " << variant->tag() << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "}\n";
+      }
+      for (auto &entity: entities) {
+        if (!is_map_entity(entity)) {
+          streamer << def_2p_indentation << "case " << entity.kind << ":\n"
+          << def_3p_indentation << "return " << entity.prefix << "__sax_value(h, f, v);\n";
+        }
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "return true;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+
+      // Nested objects and arrays
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool sax_dispatch_start(Handler &h, sax_frame &f, bool is_object)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "switch (f.kind) {\n";
+      for (auto &basic: sax_basic_types()) {
+        streamer << def_2p_indentation << "case " << sax_kind(basic, "list") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \"Error data is not an "
+        << internal_to_rapidjson(basic) << "\\n\";\n"
+        << def_3p_indentation << "return false;\n"
+        << def_2p_indentation << "case " << sax_kind(basic, "map") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \"Error map value is not a "
+        << internal_to_rapidjson(basic) << "\\n\";\n"
+        << def_3p_indentation << "return false;\n";
+      }
+      for (auto &class_it: ff->getClassMap()) {
+        std::string type(sax_value_type(class_it.first));
+        streamer << def_2p_indentation << "case " << sax_kind(class_it.first, "list") << ": {\n"
+        << def_3p_indentation << "if (!is_object) {\n"
+        << def_4p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << class_it.first << "\\n\";\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "std::vector<" << type << "> &str = *static_cast<std::vector<" << type
+        << "> *>(f.target);\n"
+        << def_3p_indentation << "str.emplace_back();\n"
+        << def_3p_indentation << "return " << class_it.first << "__sax_push(h, str.back(), false);\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map") << ": {\n"
+        << def_3p_indentation << "if (!is_object) {\n"
+        << def_4p_indentation << "return h.push(" << sax_kind(class_it.first, "map_array")
+        << ", f.target, false, f.key);\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "std::multimap<std::string, " << type << "> &str = "
+        << "*static_cast<std::multimap<std::string, " << type << "> *>(f.target);\n"
+        << def_3p_indentation << "return " << class_it.first << "__sax_push(h, str.emplace(f.key, " << type
+        << "())->second, true);\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_array") << ": {\n"
+        << def_3p_indentation << "if (!is_object) {\n"
+        << def_4p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << class_it.first << "\\n\";\n"
+        << def_4p_indentation << "return h.skip();\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "std::multimap<std::string, " << type << "> &str = "
+        << "*static_cast<std::multimap<std::string, " << type << "> *>(f.target);\n"
+        << def_3p_indentation << "return " << class_it.first << "__sax_push(h, str.emplace(f.key, " << type
+        << "())->second, true);\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_object") << ": {\n"
+        << def_3p_indentation << "if (!is_object) {\n"
+        << def_4p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error map value is not Object\\n\";\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "std::multimap<std::string, " << type << "> &str = "
+        << "*static_cast<std::multimap<std::string, " << type << "> *>(f.target);\n"
+        << def_3p_indentation << "return " << class_it.first << "__sax_push(h, str.emplace(f.key, " << type
+        << "())->second, true);\n"
+        << def_2p_indentation << "}\n";
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        std::string type(sax_value_type(variant->name()));
+        streamer << def_2p_indentation << "case " << sax_kind(variant->name(), "list") << ": {\n"
+        << def_3p_indentation << "if (!is_object) {\n"
+        << def_4p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << variant->name() << "\\n\";\n"
+        << def_4p_indentation << "return false;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "std::vector<" << type << "> &str = *static_cast<std::vector<" << type
+        << "> *>(f.target);\n"
+        << def_3p_indentation << "str.emplace_back();\n"
+        << def_3p_indentation << "return " << variant->name() << "__sax_push(h, str.back(), false);\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "case " << sax_kind(variant->name(), "variant") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << variant->name()
+        << " needs its tag " << variant->tag() << " as a string before the other members\\n\";\n"
+        << def_3p_indentation << "return false;\n";
+      }
+      for (auto &entity: entities) {
+        if (!is_map_entity(entity)) {
+          streamer << def_2p_indentation << "case " << entity.kind << ":\n"
+          << def_3p_indentation << "return " << entity.prefix << "__sax_start(h, f, is_object);\n";
+        }
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "return h.skip();\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+
+      // Closed objects
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "bool sax_dispatch_end(Handler &h, sax_frame &f)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "switch (f.kind) {\n";
+      for (auto &entity: entities) {
+        if (!is_map_entity(entity)) {
+          streamer << def_2p_indentation << "case " << entity.kind << ":\n"
+          << def_3p_indentation << "return " << entity.prefix << "__sax_end(h, f);\n";
+        }
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << def_2p_indentation << "case " << sax_kind(variant->name(), "variant") << ":\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error entity: " << variant->name()
+        << " is missing its tag " << variant->tag() << "\\n\";\n"
+        << def_3p_indentation << "return false;\n";
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "(void) h;\n"
+      << def_3p_indentation << "return true;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+
+      // Elements dropped by a tolerant frame
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "void sax_dispatch_discard(Handler &h, sax_frame &f)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "(void) h;\n"
+      << def_1p_indentation << "switch (f.kind) {\n";
+      for (auto &class_it: ff->getClassMap()) {
+        std::string type(sax_value_type(class_it.first));
+        streamer << def_2p_indentation << "case " << sax_kind(class_it.first, "map") << ":\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_array") << ":\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_object") << ": {\n"
+        << def_3p_indentation << "std::multimap<std::string, " << type << "> &str = "
+        << "*static_cast<std::multimap<std::string, " << type << "> *>(f.target);\n"
+        << def_3p_indentation << "h.out() << __FILE__ << \":\" << __LINE__ << \" Error data is not an "
+        << class_it.first << "\\n\";\n"
+        << def_3p_indentation << "str.erase(std::prev(str.upper_bound(f.key)));\n"
+        << def_3p_indentation << "return;\n"
+        << def_2p_indentation << "}\n";
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "f.failed[f.field / 64] |= 1ULL << (f.field % 64);\n"
+      << def_3p_indentation << "return;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+
+      // Elements closed in a streamed or filtered list or in a list or a map that doesn't keep them,
+      // kind is the one of the closed frame
+      streamer << def_indentation << "template<typename Handler>\n"
+      << def_indentation << "void sax_dispatch_element(Handler &h, sax_frame &f, int kind)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "(void) h;\n"
+      << def_1p_indentation << "(void) kind;\n"
+      << def_1p_indentation << "switch (f.kind) {\n";
+      for (auto &class_it: ff->getClassMap()) {
+        std::string type(sax_value_type(class_it.first));
+        streamer << def_2p_indentation << "case " << sax_kind(class_it.first, "list") << ": {\n"
+        << def_3p_indentation << "std::vector<" << type << "> &str = *static_cast<std::vector<" << type
+        << "> *>(f.target);\n"
+        << def_3p_indentation << "if (h.keeps() && f.filter != nullptr && !f.filter(&str.back())) {\n"
+        << def_4p_indentation << "str.pop_back();\n"
+        << def_4p_indentation << "return;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "if (f.stream != nullptr) {\n"
+        << def_4p_indentation << "(*static_cast<const std::function<void(const " << type << " &)> *>(f.stream))"
+        << "(str.back());\n"
+        << def_3p_indentation << "} else if (h.keeps()) {\n"
+        << def_4p_indentation << "return;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "str.pop_back();\n"
+        << def_3p_indentation << "return;\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map") << ":\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_array") << ":\n"
+        << def_2p_indentation << "case " << sax_kind(class_it.first, "map_object") << ": {\n"
+        << def_3p_indentation << "// The elements of an array in a map are dropped one by one\n"
+        << def_3p_indentation << "if (kind == " << sax_kind(class_it.first, "map_array") << ") {\n"
+        << def_4p_indentation << "return;\n"
+        << def_3p_indentation << "}\n"
+        << def_3p_indentation << "std::multimap<std::string, " << type << "> &str = "
+        << "*static_cast<std::multimap<std::string, " << type << "> *>(f.target);\n"
+        << def_3p_indentation << "str.erase(std::prev(str.upper_bound(f.key)));\n"
+        << def_3p_indentation << "return;\n"
+        << def_2p_indentation << "}\n";
+      }
+      for (auto &variant: ff->getVariantArray()) {
+        streamer << def_2p_indentation << "case " << sax_kind(variant->name(), "list") << ":\n"
+        << def_3p_indentation << "static_cast<std::vector<" << sax_value_type(variant->name())
+        << "> *>(f.target)->pop_back();\n"
+        << def_3p_indentation << "return;\n";
+      }
+      streamer << def_2p_indentation << "default:\n"
+      << def_3p_indentation << "return;\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Members of an entity read by a projection, all of them when projection is nullptr
+     * */
+    static std::vector<bool> sax_selected(const sax_entity &entity, const umixmlprojection *projection) {
+      if (projection == nullptr) {
+        return std::vector<bool>(entity.cls->getChildren().size(), true);
+      }
+      return entity.json ? projection->json_fields() : projection->class_fields().at(entity.cls->name());
+    }
+
+    /**
+     * Mask of the members read_data_prefix waits for, 64 members per word: the mandatory ones,
+     * or all the selected ones with a projection. A condition may test any member, so all of
+     * them are waited for when there is one. It is empty when there is none to wait for
+     * */
+    static std::vector<unsigned long long> sax_wanted(const sax_entity &entity, const umixmlprojection *projection) {
+      auto &elements = entity.cls->getChildren();
+      std::vector<bool> selected(sax_selected(entity, projection));
+      std::vector<unsigned long long> wanted(std::max<size_t>((elements.size() + 63) / 64, 1), 0);
+      bool all = projection != nullptr;
+      for (size_t i = 0; i < elements.size(); ++i) {
+        all = all || (selected[i] && !elements[i]->condition().empty());
+      }
+      bool any = false;
+      for (size_t i = 0; i < elements.size(); ++i) {
+        if (selected[i] && (all || !elements[i]->optional())) {
+          wanted[i / 64] |= 1ULL << (i % 64);
+          any = true;
+        }
+      }
+      return any ? wanted : std::vector<unsigned long long>();
+    }
+
+    /**
+     * Writes a mask of 64 members per word as the initializer of an array
+     * */
+    static std::string sax_mask(const std::vector<unsigned long long> &mask) {
+      std::ostringstream retval;
+      for (size_t word = 0; word < mask.size(); ++word) {
+        retval << (word == 0 ? "" : ", ") << "0x" << std::hex << mask[word] << "ULL";
+      }
+      return retval.str();
+    }
+
+    /**
+     * Name of the function giving the members a projection skips
+     * */
+    static std::string sax_skipped(const umixmlprojection &projection) {
+      return projection.name() + "__sax_skipped";
+    }
+
+    /**
+     * Create the functions giving the mask of the members each projection skips for the kind of
+     * a frame, its json and the classes it reads partially. The rest of the kinds read everything
+     * */
+    void create_sax_projections(std::shared_ptr<umi::umixml> &ff, const std::vector<sax_entity> &entities) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 1));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      for (auto &projection: ff->getProjections()) {
+        std::vector<const sax_entity *> partial;
+        for (auto &entity: entities) {
+          if (!is_map_entity(entity) && (entity.json ? entity.cls->name() == projection->json()
+                                                     : projection->partial(entity.cls->name()))) {
+            partial.push_back(&entity);
+          }
+        }
+        streamer << def_indentation << "// Members skipped by the projection " << projection->name() << "\n"
+        << def_indentation << "const unsigned long long int *" << sax_skipped(*projection) << "(int kind)\n"
+        << def_indentation << "{\n";
+        for (auto entity: partial) {
+          std::vector<bool> selected(sax_selected(*entity, projection.get()));
+          std::vector<unsigned long long> skipped(std::max<size_t>((selected.size() + 63) / 64, 1), 0);
+          for (size_t i = 0; i < selected.size(); ++i) {
+            if (!selected[i]) {
+              skipped[i / 64] |= 1ULL << (i % 64);
+            }
+          }
+          streamer << def_1p_indentation << "static const unsigned long long int " << entity->kind
+          << "__skipped[sax_field_words] = {" << sax_mask(skipped) << "};\n";
+        }
+        streamer << def_1p_indentation << "switch (kind) {\n";
+        for (auto entity: partial) {
+          streamer << def_2p_indentation << "case " << entity->kind << ":\n"
+          << def_2p_indentation << TABS << "return " << entity->kind << "__skipped;\n";
+        }
+        streamer << def_2p_indentation << "default:\n"
+        << def_2p_indentation << TABS << "return nullptr;\n"
+        << def_1p_indentation << "}\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Create the read_data_<projection> methods of one json, they read as read_data does with the
+     * members the projection leaves out marked as seen, so they are skipped as the unknown ones
+     * */
+    void create_sax_projection_reader(const sax_entity &entity, const umixmlprojection &projection) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      std::string name(entity.cls->name());
+      std::string method("umison::" + name + "::read_data_" + projection.name());
+      streamer << def_indentation << "bool " << method << "(const std::string &input_text)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return this->read_data_" << projection.name() << "(input_text, std::cerr);\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "bool " << method << "(const std::string &input_text, std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "*this = " << name << "();\n"
+      << def_1p_indentation << "std::vector<" << ns << "sax_frame> _frames;\n"
+      << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns << entity.kind
+      << ", this, _frames, true, nullptr, nullptr, " << ns << sax_skipped(projection) << ");\n"
+      << def_1p_indentation << "rapidjson::Reader _reader;\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        // The strings point into a copy of the text kept by the object, as read_data does
+        streamer << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+        << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "rapidjson::InsituStringStream _stream(&(*_buffer)[0]);\n"
+        << def_1p_indentation << "if (_reader.Parse<rapidjson::kParseInsituFlag>(_stream, _handler).IsError()) {\n";
+      } else {
+        streamer << def_1p_indentation << "rapidjson::StringStream _stream(input_text.c_str());\n"
+        << def_1p_indentation << "if (_reader.Parse(_stream, _handler).IsError()) {\n";
+      }
+      streamer << def_2p_indentation << "if (_reader.GetParseErrorCode() != rapidjson::kParseErrorTermination) {\n"
+      << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+      << "_reader.GetParseErrorCode() << \"\\n\";\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        streamer << def_1p_indentation << "umison_buffer = _buffer;\n";
+      }
+      bool has_conditions = false;
+      for (auto &element: entity.cls->getChildren()) {
+        has_conditions = has_conditions || !element->condition().empty();
+      }
+      if (has_conditions) {
+        streamer << def_1p_indentation << "const " << ns << "sax_frame &_root = _handler.root();\n";
+        _sax_checks(streamer, TABS, entity, "", "_root", "ss", true, 1);
+      }
+      streamer << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create read_data_prefix of one json, or read_data_<projection>_prefix, the handler closes the
+     * root and stops the reader once the members it waits for have been read. The size read is then
+     * the position of the reader, the end of the object is only read when it is what follows
+     * */
+    void create_sax_prefix_reader(const sax_entity &entity, const umixmlprojection *projection) {
+      if (!entity.cls->read_prefix() || is_map_entity(entity)) {
+        return;
+      }
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      std::string name(entity.cls->name());
+      std::string prefix("read_data_" + (projection != nullptr ? projection->name() + "_" : std::string()) + "prefix");
+      std::string method("umison::" + name + "::" + prefix);
+      std::vector<unsigned long long> wanted(sax_wanted(entity, projection));
+      streamer << def_indentation << "std::size_t " << method << "(const std::string &input_text, bool &validated)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "return this->" << prefix << "(input_text, validated, std::cerr);\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "std::size_t " << method
+      << "(const std::string &input_text, bool &validated, std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "validated = false;\n";
+      if (!wanted.empty()) {
+        streamer << def_1p_indentation << "static const unsigned long long int _wanted[" << ns
+        << "sax_field_words] = {" << sax_mask(wanted) << "};\n";
+      }
+      streamer << def_1p_indentation << "std::vector<" << ns << "sax_frame> _frames;\n"
+      << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns << entity.kind
+      << ", this, _frames, true, nullptr, " << (wanted.empty() ? "nullptr" : "_wanted");
+      if (projection != nullptr) {
+        streamer << ", " << ns << sax_skipped(*projection);
+      }
+      streamer << ");\n"
+      << def_1p_indentation << "rapidjson::Reader _reader;\n";
+      // The members a projection skips keep their default value
+      if (output_engine<T1, T2>::m_string_view || projection != nullptr) {
+        streamer << def_1p_indentation << "*this = " << name << "();\n";
+      }
+      if (output_engine<T1, T2>::m_string_view) {
+        // The strings point into a copy of the text kept by the object, as read_data does
+        streamer << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+        << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "rapidjson::InsituStringStream _stream(&(*_buffer)[0]);\n"
+        << def_1p_indentation << "if (_reader.Parse<rapidjson::kParseInsituFlag>(_stream, _handler).IsError() && "
+        << "!_handler.stopped()) {\n";
+      } else {
+        streamer << def_1p_indentation << "rapidjson::StringStream _stream(input_text.c_str());\n"
+        << def_1p_indentation << "if (_reader.Parse(_stream, _handler).IsError() && !_handler.stopped()) {\n";
+      }
+      streamer << def_2p_indentation << "if (_reader.GetParseErrorCode() != rapidjson::kParseErrorTermination) {\n"
+      << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+      << "_reader.GetParseErrorCode() << \"\\n\";\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return 0;\n"
+      << def_1p_indentation << "}\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        streamer << def_1p_indentation << "umison_buffer = _buffer;\n";
+      }
+      bool has_conditions = false;
+      for (auto &element: entity.cls->getChildren()) {
+        has_conditions = has_conditions || !element->condition().empty();
+      }
+      if (has_conditions) {
+        streamer << def_1p_indentation << "const " << ns << "sax_frame &_root = _handler.root();\n";
+        _sax_checks(streamer, TABS, entity, "", "_root", "ss", true, 1, "0");
+      }
+      streamer << def_1p_indentation << "if (!_handler.stopped()) {\n"
+      << def_2p_indentation << "validated = true;\n"
+      << def_2p_indentation << "return input_text.size();\n"
+      << def_1p_indentation << "}\n"
+      // The offset of a termination is the start of a number, the stream is already past the value
+      << def_1p_indentation << "std::size_t _next = input_text.find_first_not_of(\" \\n\\r\\t\", _stream.Tell());\n"
+      << def_1p_indentation << "if (_next == std::string::npos || input_text[_next] != '}') {\n"
+      << def_2p_indentation << "return _next != std::string::npos ? _next : input_text.size();\n"
+      << def_1p_indentation << "}\n"
+      // The end of the object follows, the text is then validated as read_data does
+      << def_1p_indentation << "if (input_text.find_first_not_of(\" \\n\\r\\t\", _next + 1) != std::string::npos) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+      << "rapidjson::kParseErrorDocumentRootNotSingular << \"\\n\";\n"
+      << def_2p_indentation << "return 0;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "validated = true;\n"
+      << def_1p_indentation << "return input_text.size();\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create validate of one json, the handler doesn't keep the values so only the objects
+     * open at a time are held, with the members their conditions use
+     *
+     * \param scope namespace of the state machines inside the internal namespace
+     * */
+    void create_sax_validate(const sax_entity &entity, const std::string &scope = std::string()) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::" + scope);
+      std::string name(entity.cls->name());
+      streamer << def_indentation << "bool umison::" << name
+      << "::validate(const char *text, std::size_t len, std::ostream &ss)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << name << " _json;\n"
+      << def_1p_indentation << "std::vector<" << ns << "sax_frame> _frames;\n";
+      if (is_map_entity(entity)) {
+        streamer << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns
+        << sax_map_kind(entity.cls->getChildren()[0]) << ", &_json.mutable_" << entity.cls->getChildren()[0]->name()
+        << "(), _frames, false);\n";
+      } else {
+        streamer << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns
+        << entity.kind << ", &_json, _frames, false);\n";
+      }
+      streamer << def_1p_indentation << "rapidjson::Reader _reader;\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        // The strings the conditions use point into a copy of the text
+        streamer << def_1p_indentation << "std::vector<char> _buffer(text, text + len);\n"
+        << def_1p_indentation << "_buffer.push_back('\\0');\n"
+        << def_1p_indentation << "rapidjson::InsituStringStream _stream(&_buffer[0]);\n"
+        << def_1p_indentation << "if (_reader.Parse<rapidjson::kParseInsituFlag>(_stream, _handler).IsError()) {\n";
+      } else {
+        streamer << def_1p_indentation << "rapidjson::MemoryStream _stream(text, len);\n"
+        << def_1p_indentation << "if (_reader.Parse(_stream, _handler).IsError()) {\n";
+      }
+      streamer << def_2p_indentation << "if (_reader.GetParseErrorCode() != rapidjson::kParseErrorTermination) {\n"
+      << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+      << "_reader.GetParseErrorCode() << \"\\n\";\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      bool has_conditions = false;
+      for (auto &element: entity.cls->getChildren()) {
+        has_conditions = has_conditions || !element->condition().empty();
+      }
+      if (has_conditions && !is_map_entity(entity)) {
+        streamer << def_1p_indentation << "const " << ns << "sax_frame &_root = _handler.root();\n";
+        _sax_checks(streamer, TABS, entity, "_json.", "_root", "ss", true, 1);
+      }
+      streamer << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create read_data_streaming of one json, the frames of the streamed lists hand each element to
+     * their callback once it is closed and drop it. The filter of a list drops the elements it
+     * rejects before, so its callback only gets the ones it accepts
+     * */
+    void create_sax_streaming_reader(const sax_entity &entity) {
+      if (entity.cls->streaming_arguments().empty()) {
+        return;
+      }
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      std::string name(entity.cls->name());
+      streamer << def_indentation << "bool umison::" << name << "::read_data_streaming(const std::string &input_text"
+      << entity.cls->streaming_parameters(output_engine<T1, T2>::m_additional_string) << ", std::ostream &ss)\n"
+      << def_indentation << "{\n";
+      std::string streams;
+      for (auto &element: entity.cls->getChildren()) {
+        if (!element->streaming()) {
+          continue;
+        }
+        streams += (streams.empty() ? "&on_" : ", &on_") + element->name();
+      }
+      streamer << def_1p_indentation << "const void *_streams[] = {" << streams << "};\n"
+      << def_1p_indentation << "std::vector<" << ns << "sax_frame> _frames;\n"
+      << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns << entity.kind
+      << ", this, _frames, true, _streams);\n"
+      << def_1p_indentation << "rapidjson::Reader _reader;\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        // The strings point into a copy of the text kept by the object, as read_data does
+        streamer << def_1p_indentation << "*this = " << name << "();\n"
+        << def_1p_indentation << "std::shared_ptr<std::vector<char>> _buffer = std::make_shared<std::vector<char>>(\n"
+        << def_2p_indentation << "input_text.c_str(), input_text.c_str() + input_text.size() + 1);\n"
+        << def_1p_indentation << "rapidjson::InsituStringStream _stream(&(*_buffer)[0]);\n"
+        << def_1p_indentation << "if (_reader.Parse<rapidjson::kParseInsituFlag>(_stream, _handler).IsError()) {\n";
+      } else {
+        streamer << def_1p_indentation << "rapidjson::StringStream _stream(input_text.c_str());\n"
+        << def_1p_indentation << "if (_reader.Parse(_stream, _handler).IsError()) {\n";
+      }
+      streamer << def_2p_indentation << "if (_reader.GetParseErrorCode() != rapidjson::kParseErrorTermination) {\n"
+      << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+      << "_reader.GetParseErrorCode() << \"\\n\";\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n";
+      if (output_engine<T1, T2>::m_string_view) {
+        streamer << def_1p_indentation << "umison_buffer = _buffer;\n";
+      }
+      bool has_conditions = false;
+      for (auto &element: entity.cls->getChildren()) {
+        has_conditions = has_conditions || !element->condition().empty();
+      }
+      if (has_conditions) {
+        streamer << def_1p_indentation << "const " << ns << "sax_frame &_root = _handler.root();\n";
+        _sax_checks(streamer, TABS, entity, "", "_root", "ss", true, 1);
+      }
+      streamer << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Create the read_data methods of one json
+     *
+     * \param insitu true to create read_data_insitu
+     * \param additional_reader true to create the reader of a rapidjson::Document
+     * \param context true to create the reader using the memory of a parser_context
+     * */
+    void create_sax_read_data(const sax_entity &entity, bool insitu, bool additional_reader, bool context = false) {
+      T2 &streamer = output_engine<T1, T2>::m_cpp_streamer;
+      std::string def_indentation(build_indentation(TABS, 0));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string ns("__internal__umison" + output_engine<T1, T2>::m_additional_string + "::");
+      std::string name(entity.cls->name());
+      if (additional_reader) {
+        streamer << def_indentation << "bool umison::" << name
+        << "::read_data(const rapidjson::Document &_document, std::ostream &ss)\n"
+        << def_indentation << "{\n";
+      } else if (context) {
+        this->create_context_prologue(entity.cls);
+      } else if (insitu) {
+        this->create_insitu_prologue(entity.cls);
+      } else {
+        streamer << def_indentation << "bool umison::" << name
+        << "::read_data(const std::string &input_text, std::ostream &ss)\n"
+        << def_indentation << "{\n";
+      }
+      // Handler pointing to the root
+      std::string frames("_context.frames");
+      if (!context) {
+        frames = "_frames";
+        streamer << def_1p_indentation << "std::vector<" << ns << "sax_frame> _frames;\n";
+      }
+      if (is_map_entity(entity)) {
+        auto &element = entity.cls->getChildren()[0];
+        if (element->optional()) {
+          streamer << def_1p_indentation << "mutable_" << element->optional_name() << "() = true;\n";
+        }
+        streamer << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns
+        << sax_map_kind(element) << ", &mutable_" << element->name() << "(), " << frames << ");\n";
+      } else {
+        streamer << def_1p_indentation << ns << "sax_handler<std::ostream> _handler(ss, " << ns
+        << entity.kind << ", this, " << frames << ");\n";
+      }
+      if (additional_reader) {
+        streamer << def_1p_indentation << "if (!_document.Accept(_handler)) {\n"
+        << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error reading document\\n\";\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n";
+      } else {
+        if (context) {
+          streamer << def_1p_indentation << "parser_context::impl::allocator _stack_allocator(_context.stack_pool);\n"
+          << def_1p_indentation << "rapidjson::GenericReader<rapidjson::UTF8<>, rapidjson::UTF8<>, "
+          << "rapidjson::MemoryPoolAllocator<>> _reader(&_stack_allocator);\n";
+        } else {
+          streamer << def_1p_indentation << "rapidjson::Reader _reader;\n";
+        }
+        if (context && output_engine<T1, T2>::m_string_view) {
+          streamer << def_1p_indentation << "rapidjson::InsituStringStream _stream(&_context.text[0]);\n"
+          << def_1p_indentation << "if (_reader.Parse<rapidjson::kParseInsituFlag>(_stream, _handler).IsError()) {\n";
+        } else if (insitu) {
+          streamer << def_1p_indentation << "rapidjson::InsituStringStream _stream(buffer);\n"
+          << def_1p_indentation << "if (_reader.Parse<rapidjson::kParseInsituFlag>(_stream, _handler).IsError()) {\n";
+        } else {
+          streamer << def_1p_indentation << "rapidjson::StringStream _stream(input_text.c_str());\n"
+          << def_1p_indentation << "if (_reader.Parse(_stream, _handler).IsError()) {\n";
+        }
+        streamer
+        << def_2p_indentation << "if (_reader.GetParseErrorCode() != rapidjson::kParseErrorTermination) {\n"
+        << def_3p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error parsing input text. Error: \" << "
+        << "_reader.GetParseErrorCode() << \"\\n\";\n"
+        << def_2p_indentation << "}\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n";
+      }
+      // Conditions of the members are evaluated in our scope
+      bool has_conditions = false;
+      for (auto &element: entity.cls->getChildren()) {
+        has_conditions = has_conditions || !element->condition().empty();
+      }
+      if (has_conditions && !is_map_entity(entity)) {
+        streamer << def_1p_indentation << "const " << ns << "sax_frame &_root = _handler.root();\n";
+        _sax_checks(streamer, TABS, entity, "", "_root", "ss", true, 1);
+      }
+      streamer << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n";
+    }
+  };
+}
+
+#endif
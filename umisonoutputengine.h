@@ -27,6 +27,7 @@
 #define UMISON_UMISONOUTPUTENGINE_H
 
 #include "umisonfileprinter.h"
+#include "umisonwriter.h"
 #include "umixml.h"
 #include "umixmltags.h"
 #include <cstdlib>
@@ -79,11 +80,16 @@ namespace umi {
      * */
     bool write(std::shared_ptr<umi::umixml> &ff) {
       bool retval = false;
+      m_string_view = ff->string_view();
+      if (ff->lazy_views() && (!lazy_views() || m_string_view)) {
+        std::cerr << "Error: The lazy views need the native or native-table engine and std::string strings\n";
+        exit(-1);
+      }
       file_printer<T1> printer;
-      printer.print(ff, m_h_streamer, additional_headers(), additional_methods());
+      printer.print(ff, m_h_streamer, additional_headers(), additional_methods(), additional_friends());
       retval = this->internal_write(ff);
-      printer.print_write_data_common_string(ff, m_cpp_streamer);
-      printer.print_write_data_on_string(ff, m_cpp_streamer);
+      writer_printer<T2> writer(m_additional_string);
+      writer.print(ff, m_cpp_streamer);
       return retval;
     };
 
@@ -129,6 +135,21 @@ namespace umi {
       return std::vector<std::string>();
     }
 
+    /**
+     * Gets the list of engine structs declared friends of every struct, they are
+     * defined in the same namespace as the struct by the .cpp
+     * */
+    virtual std::vector<std::string> additional_friends() const {
+      return std::vector<std::string>();
+    }
+
+    /**
+     * The engine creates the lazy views declared on the .h
+     * */
+    virtual bool lazy_views() const {
+      return false;
+    }
+
   protected:
     /**
      * Basic constructor, it is used to store the references of the input streams
@@ -168,6 +189,10 @@ namespace umi {
      * Create additional engine information on the .h
      * */
     std::string m_additional_engine_information;
+    /**
+     * Strings are std::string_view on the parsed buffer
+     * */
+    bool m_string_view = false;
   };
 }
 
@@ -28,5 +28,9 @@
 
 #include "umisonoutputengine.h"
 #include "umisonoutenginerapidjson.h"
+#include "umisonoutenginerapidjsonsax.h"
+#include "umisonoutenginenative.h"
+#include "umisonoutenginenativesimd.h"
+#include "umisonoutenginenativetable.h"
 
 #endif
@@ -0,0 +1,180 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONPERFECTHASH_H
+#define UMISON_UMISONPERFECTHASH_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Perfect hash over the member names of one class. The generator looks for a seed
+   * that sends every name to a different slot, so the generated code finds the field
+   * of a json member with one hash and one memcmp.
+   *
+   * The hash is printed in the .cpp with print_runtime and must match hash()
+   * */
+  class perfect_hash {
+  public:
+    /**
+     * Builds the table for the given names
+     * */
+    explicit perfect_hash(const std::vector<std::string> &names) : m_names(names), m_seed(0), m_size(1) {
+      build();
+    }
+
+    /**
+     * FNV-1a with a seed and a final mix of the high bits into the low ones
+     * */
+    static uint32_t hash(const char *str, size_t len, uint32_t seed) {
+      uint32_t h = 2166136261u ^ seed;
+      for (size_t i = 0; i < len; ++i) {
+        h ^= static_cast<unsigned char>(str[i]);
+        h *= 16777619u;
+      }
+      return h ^ (h >> 16);
+    }
+
+    /**
+     * Prints the slot type and the hash function, once per .cpp
+     * */
+    template<typename streamer>
+    static void print_runtime(streamer &out, const std::string &space, int level) {
+      std::string def_indentation;
+      for (int i = 0; i < level; ++i) {
+        def_indentation += space;
+      }
+      std::string def_1p_indentation(def_indentation + space);
+      std::string def_2p_indentation(def_1p_indentation + space);
+      out << def_indentation << "// Slot of the perfect hash tables used to find the fields\n"
+      << def_indentation << "struct umison_hash_slot {\n"
+      << def_1p_indentation << "const char *name;\n"
+      << def_1p_indentation << "std::size_t len;\n"
+      << def_1p_indentation << "int field;\n"
+      << def_indentation << "};\n\n"
+      << def_indentation << "inline uint32_t umison_hash(const char *str, std::size_t len, uint32_t seed)\n"
+      << def_indentation << "{\n"
+      << def_1p_indentation << "uint32_t h = 2166136261u ^ seed;\n"
+      << def_1p_indentation << "for (std::size_t i = 0; i < len; ++i) {\n"
+      << def_2p_indentation << "h ^= static_cast<unsigned char>(str[i]);\n"
+      << def_2p_indentation << "h *= 16777619u;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return h ^ (h >> 16);\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints the lookup function, returns the index of the name or -1
+     *
+     * \param function name of the function to print
+     * */
+    template<typename streamer>
+    void print_lookup(streamer &out, const std::string &function, const std::string &space, int level) const {
+      std::string def_indentation;
+      for (int i = 0; i < level; ++i) {
+        def_indentation += space;
+      }
+      std::string def_1p_indentation(def_indentation + space);
+      std::string def_2p_indentation(def_1p_indentation + space);
+      out << def_indentation << "inline int " << function << "(const char *str, std::size_t len)\n"
+      << def_indentation << "{\n";
+      if (m_names.empty()) {
+        out << def_1p_indentation << "(void) str;\n"
+        << def_1p_indentation << "(void) len;\n"
+        << def_1p_indentation << "return -1;\n"
+        << def_indentation << "}\n\n";
+        return;
+      }
+      out << def_1p_indentation << "static const umison_hash_slot slots[" << m_size << "] = {\n";
+      for (size_t i = 0; i < m_size; ++i) {
+        out << def_2p_indentation;
+        if (m_slots[i] < 0) {
+          out << "{\"\", 0, -1}";
+        } else {
+          out << "{\"" << m_names[m_slots[i]] << "\", " << m_names[m_slots[i]].size() << ", " << m_slots[i] << "}";
+        }
+        out << (i + 1 < m_size ? ",\n" : "\n");
+      }
+      out << def_1p_indentation << "};\n"
+      << def_1p_indentation << "const umison_hash_slot &slot = slots[umison_hash(str, len, " << m_seed << "u) & "
+      << (m_size - 1) << "u];\n"
+      << def_1p_indentation << "if (slot.len != len || memcmp(slot.name, str, len) != 0) {\n"
+      << def_2p_indentation << "return -1;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return slot.field;\n"
+      << def_indentation << "}\n\n";
+    }
+
+  protected:
+    /**
+     * Looks for the seed, the table grows when no seed is found
+     * */
+    void build() {
+      for (size_t i = 1; i < m_names.size(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+          if (m_names[i] == m_names[j]) {
+            std::cerr << "Error: Duplicated element " << m_names[i] << "\n";
+            exit(-1);
+          }
+        }
+      }
+      while (m_size < m_names.size() * 2) {
+        m_size *= 2;
+      }
+      for (;;) {
+        for (uint32_t seed = 0; seed < 4096; ++seed) {
+          if (try_seed(seed)) {
+            m_seed = seed;
+            return;
+          }
+        }
+        m_size *= 2;
+      }
+    }
+
+    bool try_seed(uint32_t seed) {
+      m_slots.assign(m_size, -1);
+      for (size_t i = 0; i < m_names.size(); ++i) {
+        size_t slot = hash(m_names[i].c_str(), m_names[i].size(), seed) & (m_size - 1);
+        if (m_slots[slot] >= 0) {
+          return false;
+        }
+        m_slots[slot] = static_cast<int>(i);
+      }
+      return true;
+    }
+
+    std::vector<std::string> m_names;
+    uint32_t m_seed;
+    size_t m_size;
+    std::vector<int> m_slots;
+  };
+}
+
+#endif
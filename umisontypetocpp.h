@@ -36,8 +36,14 @@ namespace umi {
   public:
     /**
      * Constructor
+     *
+     * \param string_view true to use std::string_view for the strings
      * */
-    type_to_cpp() { }
+    explicit type_to_cpp(bool string_view = false) {
+      if (string_view) {
+        m_mapType["string"] = "std::string_view";
+      }
+    }
 
     /**
      * Destructor
@@ -0,0 +1,1096 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMISONWRITER_H
+#define UMISON_UMISONWRITER_H
+
+#include "umisonnumberformat.h"
+#include "umixml.h"
+#include "umixmltags.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Prints the writers of the .cpp, it is common to all the output engines.
+   *
+   * Every class gets its own __write_type with the quoted names of its members
+   * already built and a __serialized_size that walks the same members adding up the
+   * length of their json. The text goes through a umison_writer that keeps it in a fixed
+   * buffer and hands it in blocks to its output, the string of write_data_to_string or
+   * the memory of write_to. The values are written with overloads of __write_type so
+   * lists and maps of any type share the same code.
+   * */
+  template<typename streamer>
+  class writer_printer {
+  public:
+    /**
+     * Constructor
+     *
+     * \param additional_string appended to the internal namespace
+     * */
+    explicit writer_printer(const std::string &additional_string) : m_additional_string(additional_string) { }
+
+    /**
+     * Prints the writers and the sizes of all the classes and the output functions of
+     * the jsons
+     * */
+    void print(std::shared_ptr<umi::umixml> &ff, streamer &stream) {
+      stream << "namespace __internal__umison" << m_additional_string << " {\n\n";
+      print_runtime(stream, 1);
+      number_format::print_runtime(stream, TABS, 1);
+      print_basic_types(ff, stream, 1);
+      print_basic_sizes(ff, stream, 1);
+      print_enum_types(ff, stream, 1);
+      print_forward_declarations(ff, stream, 1);
+      print_containers(stream, 1);
+      print_container_sizes(stream, 1);
+      for (auto &element : ff->getClassMap()) {
+        print_class_size(element.second, stream, 1);
+        print_class_writer(element.second, stream, 1);
+      }
+      for (auto &variant : ff->getVariantArray()) {
+        print_variant_size(ff, variant, stream, 1);
+        print_variant_writer(ff, variant, stream, 1);
+      }
+      for (auto &json : ff->getJsonArray()) {
+        print_json_writer(json, stream, 1);
+      }
+      stream << "}\n\n";
+      print_serialize_scratch(stream);
+      for (auto &json : ff->getJsonArray()) {
+        print_json_functions(json, stream);
+      }
+    }
+
+    /**
+     * Prints the headers of the writers, the engines print them with their own
+     * */
+    static void print_includes(streamer &stream) {
+      stream << "#include <cerrno>\n"
+      << "#if defined(_WIN32)\n"
+      << "#include <io.h>\n"
+      << "#else\n"
+      << "#include <sys/uio.h>\n"
+      << "#include <unistd.h>\n"
+      << "#endif\n"
+      << "#if defined(__AVX2__) || defined(__SSE2__)\n"
+      << "#include <immintrin.h>\n"
+      << "#endif\n";
+    }
+
+  protected:
+    static std::string indentation(int level) {
+      std::string retval;
+      for (int i = 0; i < level; ++i) {
+        retval += TABS;
+      }
+      return retval;
+    }
+
+    /**
+     * Prints umison_writer, the buffered output used by all the writers, and its outputs
+     * */
+    void print_runtime(streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      std::string def_4p_indentation(def_3p_indentation + TABS);
+      stream << def_indentation << "// Length of the run at the start of data that needs no escaping in a json string,\n"
+      << def_indentation << "// eight bytes are checked at a time, a block with a byte to escape is checked again\n"
+      << def_indentation << "// byte by byte\n"
+      << def_indentation << "inline std::size_t umison_clean_run_scalar(const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "const uint64_t ones = 0x0101010101010101ull;\n"
+      << def_1p_indentation << "const uint64_t highs = 0x8080808080808080ull;\n"
+      << def_1p_indentation << "std::size_t i = 0;\n"
+      << def_1p_indentation << "for (; i + 8 <= len; i += 8) {\n"
+      << def_2p_indentation << "uint64_t block;\n"
+      << def_2p_indentation << "memcpy(&block, data + i, sizeof(block));\n"
+      << def_2p_indentation << "uint64_t quote = block ^ (ones * '\"');\n"
+      << def_2p_indentation << "uint64_t backslash = block ^ (ones * '\\\\');\n"
+      << def_2p_indentation << "uint64_t found = ((quote - ones) & ~quote) | ((backslash - ones) & ~backslash) | ((block - ones * 0x20) & ~block);\n"
+      << def_2p_indentation << "if (found & highs) {\n"
+      << def_3p_indentation << "break;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "for (; i < len; ++i) {\n"
+      << def_2p_indentation << "unsigned char c = static_cast<unsigned char>(data[i]);\n"
+      << def_2p_indentation << "if (c < 0x20 || c == '\"' || c == '\\\\') {\n"
+      << def_3p_indentation << "break;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return i;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << "#if defined(__AVX2__) || defined(__SSE2__)\n"
+      << def_indentation << "// Same as umison_clean_run_scalar checking 32 (AVX2) or 16 (SSE2) bytes at a time\n"
+      << def_indentation << "inline std::size_t umison_clean_run(const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "if (len < 16) {\n"
+      << def_2p_indentation << "return umison_clean_run_scalar(data, len);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "std::size_t i = 0;\n"
+      << "#if defined(__AVX2__)\n"
+      << def_1p_indentation << "const __m256i quote32 = _mm256_set1_epi8('\"');\n"
+      << def_1p_indentation << "const __m256i backslash32 = _mm256_set1_epi8('\\\\');\n"
+      << def_1p_indentation << "const __m256i control32 = _mm256_set1_epi8(0x1F);\n"
+      << def_1p_indentation << "for (; i + 32 <= len; i += 32) {\n"
+      << def_2p_indentation << "__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));\n"
+      << def_2p_indentation << "__m256i found = _mm256_or_si256(\n"
+      << def_3p_indentation << "_mm256_or_si256(_mm256_cmpeq_epi8(block, quote32), _mm256_cmpeq_epi8(block, backslash32)),\n"
+      << def_3p_indentation << "_mm256_cmpeq_epi8(_mm256_min_epu8(block, control32), block));\n"
+      << def_2p_indentation << "unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(found));\n"
+      << def_2p_indentation << "if (mask != 0) {\n"
+      << def_3p_indentation << "return i + static_cast<std::size_t>(__builtin_ctz(mask));\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << "#endif\n"
+      << def_1p_indentation << "const __m128i quote = _mm_set1_epi8('\"');\n"
+      << def_1p_indentation << "const __m128i backslash = _mm_set1_epi8('\\\\');\n"
+      << def_1p_indentation << "const __m128i control = _mm_set1_epi8(0x1F);\n"
+      << def_1p_indentation << "for (; i + 16 <= len; i += 16) {\n"
+      << def_2p_indentation << "__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));\n"
+      << def_2p_indentation << "__m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),\n"
+      << def_4p_indentation << "                     _mm_cmpeq_epi8(_mm_min_epu8(block, control), block));\n"
+      << def_2p_indentation << "unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(found));\n"
+      << def_2p_indentation << "if (mask != 0) {\n"
+      << def_3p_indentation << "return i + static_cast<std::size_t>(__builtin_ctz(mask));\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return i + umison_clean_run_scalar(data + i, len - i);\n"
+      << def_indentation << "}\n"
+      << "#else\n"
+      << def_indentation << "inline std::size_t umison_clean_run(const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "return umison_clean_run_scalar(data, len);\n"
+      << def_indentation << "}\n"
+      << "#endif\n"
+      << "\n";
+      stream << def_indentation << "// Length of data written as a json string with its quotes\n"
+      << def_indentation << "inline std::size_t umison_escaped_size(const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "std::size_t size = len + 2;\n"
+      << def_1p_indentation << "std::size_t i = 0;\n"
+      << def_1p_indentation << "for (;;) {\n"
+      << def_2p_indentation << "i += umison_clean_run(data + i, len - i);\n"
+      << def_2p_indentation << "if (i == len) {\n"
+      << def_3p_indentation << "return size;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "switch (data[i++]) {\n"
+      << def_3p_indentation << "case '\"': case '\\\\': case '\\b': case '\\f': case '\\n': case '\\r': case '\\t':\n"
+      << def_4p_indentation << "size += 1;\n"
+      << def_4p_indentation << "break;\n"
+      << def_3p_indentation << "default:\n"
+      << def_4p_indentation << "size += 5;\n"
+      << def_4p_indentation << "break;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << "#if defined(__GNUC__)\n"
+      << "#define UMISON_NOINLINE __attribute__((noinline))\n"
+      << "#elif defined(_MSC_VER)\n"
+      << "#define UMISON_NOINLINE __declspec(noinline)\n"
+      << "#else\n"
+      << "#define UMISON_NOINLINE\n"
+      << "#endif\n"
+      << "\n"
+      << def_indentation << "// Receives the text of the writers in blocks, returns false when it can't take more\n"
+      << def_indentation << "typedef bool (*umison_output)(void *context, const char *data, std::size_t len);\n"
+      << "\n"
+      << def_indentation << "// Runs of the strings that need no escaping and are at least this long are given to the\n"
+      << def_indentation << "// reference output of the writer, the shorter ones are cheaper to copy\n"
+      << def_indentation << "static const std::size_t umison_reference_run = 64;\n"
+      << "\n"
+      << def_indentation << "// Output of the writers, the text is kept in a fixed buffer and handed to output in\n"
+      << def_indentation << "// blocks when the buffer is full and on flush. When there is a reference output the long\n"
+      << def_indentation << "// runs of the strings are handed to it as they are, they stay in the written object.\n"
+      << def_indentation << "// Once an output fails nothing else is given to them\n"
+      << def_indentation << "class umison_writer {\n"
+      << def_indentation << "public:\n"
+      << def_1p_indentation << "umison_writer(umison_output output, void *context, umison_output reference = nullptr)\n"
+      << def_2p_indentation << ": m_output(output), m_reference(reference), m_context(context), m_failed(false), m_size(0) {}\n\n"
+      << def_1p_indentation << "umison_writer(const umison_writer &) = delete;\n"
+      << def_1p_indentation << "umison_writer &operator=(const umison_writer &) = delete;\n\n"
+      << def_1p_indentation << "inline void put(char c) {\n"
+      << def_2p_indentation << "if (m_size == sizeof(m_buffer)) {\n"
+      << def_3p_indentation << "flush();\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "m_buffer[m_size++] = c;\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "inline void write(const char *data, std::size_t len) {\n"
+      << def_2p_indentation << "// an empty string_view may have no data, memcpy can't be given nullptr\n"
+      << def_2p_indentation << "if (len == 0) {\n"
+      << def_3p_indentation << "return;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "if (len > sizeof(m_buffer) - m_size) {\n"
+      << def_3p_indentation << "flush();\n"
+      << def_3p_indentation << "if (len > sizeof(m_buffer)) {\n"
+      << def_4p_indentation << "if (!m_failed && !m_output(m_context, data, len)) {\n"
+      << def_4p_indentation << "    m_failed = true;\n"
+      << def_4p_indentation << "}\n"
+      << def_4p_indentation << "return;\n"
+      << def_3p_indentation << "}\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "memcpy(m_buffer + m_size, data, len);\n"
+      << def_2p_indentation << "m_size += len;\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "// room for len chars written in place, len must fit in the buffer\n"
+      << def_1p_indentation << "inline char *reserve(std::size_t len) {\n"
+      << def_2p_indentation << "if (len > sizeof(m_buffer) - m_size) {\n"
+      << def_3p_indentation << "flush();\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return m_buffer + m_size;\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "// keeps what was written in the room given by reserve up to end\n"
+      << def_1p_indentation << "inline void commit(const char *end) {\n"
+      << def_2p_indentation << "m_size = static_cast<std::size_t>(end - m_buffer);\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "// writes a json string, the runs that need no escaping are copied at once\n"
+      << def_1p_indentation << "void string(const char *data, std::size_t len) {\n"
+      << def_2p_indentation << "put('\"');\n"
+      << def_2p_indentation << "std::size_t i = 0;\n"
+      << def_2p_indentation << "for (;;) {\n"
+      << def_3p_indentation << "std::size_t run = umison_clean_run(data + i, len - i);\n"
+      << def_3p_indentation << "if (m_reference != nullptr && run >= umison_reference_run) {\n"
+      << def_4p_indentation << "reference(data + i, run);\n"
+      << def_3p_indentation << "} else {\n"
+      << def_4p_indentation << "write(data + i, run);\n"
+      << def_3p_indentation << "}\n"
+      << def_3p_indentation << "i += run;\n"
+      << def_3p_indentation << "if (i == len) {\n"
+      << def_4p_indentation << "break;\n"
+      << def_3p_indentation << "}\n"
+      << def_3p_indentation << "escape(static_cast<unsigned char>(data[i++]));\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "put('\"');\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "// writes the escape sequence of c\n"
+      << def_1p_indentation << "void escape(unsigned char c) {\n"
+      << def_2p_indentation << "static const char hex[] = \"0123456789abcdef\";\n"
+      << def_2p_indentation << "put('\\\\');\n"
+      << def_2p_indentation << "switch (c) {\n"
+      << def_3p_indentation << "case '\"': put('\"'); break;\n"
+      << def_3p_indentation << "case '\\\\': put('\\\\'); break;\n"
+      << def_3p_indentation << "case '\\b': put('b'); break;\n"
+      << def_3p_indentation << "case '\\f': put('f'); break;\n"
+      << def_3p_indentation << "case '\\n': put('n'); break;\n"
+      << def_3p_indentation << "case '\\r': put('r'); break;\n"
+      << def_3p_indentation << "case '\\t': put('t'); break;\n"
+      << def_3p_indentation << "default:\n"
+      << def_4p_indentation << "write(\"u00\", 3);\n"
+      << def_4p_indentation << "put(hex[c >> 4]);\n"
+      << def_4p_indentation << "put(hex[c & 0xf]);\n"
+      << def_4p_indentation << "break;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "// hands the buffer to output, returns false when the output failed. It is kept out\n"
+      << def_1p_indentation << "// of line so put and write stay small enough to be inlined\n"
+      << def_1p_indentation << "UMISON_NOINLINE bool flush() {\n"
+      << def_2p_indentation << "if (m_size > 0) {\n"
+      << def_3p_indentation << "if (!m_failed && !m_output(m_context, m_buffer, m_size)) {\n"
+      << def_4p_indentation << "m_failed = true;\n"
+      << def_3p_indentation << "}\n"
+      << def_3p_indentation << "m_size = 0;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return !m_failed;\n"
+      << def_1p_indentation << "}\n\n"
+      << def_indentation << "private:\n"
+      << def_1p_indentation << "// hands data to the reference output after the text before it\n"
+      << def_1p_indentation << "UMISON_NOINLINE void reference(const char *data, std::size_t len) {\n"
+      << def_2p_indentation << "flush();\n"
+      << def_2p_indentation << "if (!m_failed && !m_reference(m_context, data, len)) {\n"
+      << def_3p_indentation << "m_failed = true;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n\n"
+      << def_1p_indentation << "umison_output m_output;\n"
+      << def_1p_indentation << "umison_output m_reference;\n"
+      << def_1p_indentation << "void *m_context;\n"
+      << def_1p_indentation << "bool m_failed;\n"
+      << def_1p_indentation << "std::size_t m_size;\n"
+      << def_1p_indentation << "char m_buffer[4096];\n"
+      << def_indentation << "};\n\n"
+      << def_indentation << "// Output appending to the std::string given as context\n"
+      << def_indentation << "inline bool umison_string_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "static_cast<std::string *>(context)->append(data, len);\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Memory given by the caller, full is set when the text didn't fit\n"
+      << def_indentation << "struct umison_memory {\n"
+      << def_1p_indentation << "char *data;\n"
+      << def_1p_indentation << "std::size_t capacity;\n"
+      << def_1p_indentation << "std::size_t size;\n"
+      << def_1p_indentation << "bool full;\n"
+      << def_indentation << "};\n"
+      << "\n"
+      << def_indentation << "// Output copying to the umison_memory given as context\n"
+      << def_indentation << "inline bool umison_memory_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "umison_memory *memory = static_cast<umison_memory *>(context);\n"
+      << def_1p_indentation << "if (len > memory->capacity - memory->size) {\n"
+      << def_2p_indentation << "memory->full = true;\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "memcpy(memory->data + memory->size, data, len);\n"
+      << def_1p_indentation << "memory->size += len;\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Output writing to the file descriptor given as context\n"
+      << def_indentation << "inline bool umison_fd_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "int fd = *static_cast<int *>(context);\n"
+      << def_1p_indentation << "while (len > 0) {\n"
+      << "#if defined(_WIN32)\n"
+      << def_2p_indentation << "int written = _write(fd, data, static_cast<unsigned int>(len));\n"
+      << "#else\n"
+      << def_2p_indentation << "ssize_t written = ::write(fd, data, len);\n"
+      << "#endif\n"
+      << def_2p_indentation << "if (written < 0) {\n"
+      << def_3p_indentation << "if (errno == EINTR) {\n"
+      << def_4p_indentation << "continue;\n"
+      << def_3p_indentation << "}\n"
+      << def_3p_indentation << "return false;\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "data += written;\n"
+      << def_2p_indentation << "len -= static_cast<std::size_t>(written);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Output writing to the FILE given as context\n"
+      << def_indentation << "inline bool umison_file_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "return fwrite(data, 1, len, static_cast<FILE *>(context)) == len;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Output writing to the std::ostream given as context\n"
+      << def_indentation << "inline bool umison_stream_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "std::ostream *output = static_cast<std::ostream *>(context);\n"
+      << def_1p_indentation << "output->write(data, static_cast<std::streamsize>(len));\n"
+      << def_1p_indentation << "return !output->fail();\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Output calling the std::function given as context\n"
+      << def_indentation << "inline bool umison_callback_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "return (*static_cast<const std::function<bool(const char *, std::size_t)> *>(context))(data, len);\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << "#if !defined(_WIN32)\n"
+      << def_indentation << "// Pieces of a serialize_iov\n"
+      << def_indentation << "struct umison_iov {\n"
+      << def_1p_indentation << "std::vector<iovec> *iov;\n"
+      << def_1p_indentation << "umison::serialize_scratch *scratch;\n"
+      << def_indentation << "};\n"
+      << "\n"
+      << def_indentation << "// adds a piece, it is joined to the last one when it follows it in memory\n"
+      << def_indentation << "inline void umison_iov_add(std::vector<iovec> &iov, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "if (!iov.empty() && static_cast<const char *>(iov.back().iov_base) + iov.back().iov_len == data) {\n"
+      << def_2p_indentation << "iov.back().iov_len += len;\n"
+      << def_2p_indentation << "return;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "iovec piece;\n"
+      << def_1p_indentation << "piece.iov_base = const_cast<char *>(data);\n"
+      << def_1p_indentation << "piece.iov_len = len;\n"
+      << def_1p_indentation << "iov.push_back(piece);\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Output copying the text to the scratch of the umison_iov given as context\n"
+      << def_indentation << "inline bool umison_iov_output(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "umison_iov *iov = static_cast<umison_iov *>(context);\n"
+      << def_1p_indentation << "char *copy = iov->scratch->allocate(len);\n"
+      << def_1p_indentation << "memcpy(copy, data, len);\n"
+      << def_1p_indentation << "umison_iov_add(*iov->iov, copy, len);\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n"
+      << "\n"
+      << def_indentation << "// Reference output pointing to the runs of the strings from the umison_iov given as context\n"
+      << def_indentation << "inline bool umison_iov_reference(void *context, const char *data, std::size_t len) {\n"
+      << def_1p_indentation << "umison_iov_add(*static_cast<umison_iov *>(context)->iov, data, len);\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n"
+      << "#endif\n"
+      << "\n";
+    }
+
+    /**
+     * Prints the writers of the basic types, the doubles that are not finite have no
+     * json representation and are reported as an error
+     * */
+    void print_basic_types(std::shared_ptr<umi::umixml> &ff, streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      stream << def_indentation << "// Writing functions of the basic types\n"
+      << def_indentation << "inline bool __write_type(bool arr, umison_writer &out, std::ostream &) {\n"
+      << def_1p_indentation << "if (arr) {\n"
+      << def_2p_indentation << "out.write(\"true\", 4);\n"
+      << def_1p_indentation << "} else {\n"
+      << def_2p_indentation << "out.write(\"false\", 5);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline bool __write_type(int arr, umison_writer &out, std::ostream &) {\n"
+      << def_1p_indentation << "out.commit(umison_i64toa(arr, out.reserve(32)));\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline bool __write_type(long long int arr, umison_writer &out, std::ostream &) {\n"
+      << def_1p_indentation << "out.commit(umison_i64toa(arr, out.reserve(32)));\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline bool __write_type(double arr, umison_writer &out, std::ostream &ss) {\n"
+      << def_1p_indentation << "if (!std::isfinite(arr)) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error \" << arr << \" can not be written in json\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "out.commit(umison_dtoa(arr, out.reserve(32)));\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline bool __write_type(const std::string &arr, umison_writer &out, std::ostream &) {\n"
+      << def_1p_indentation << "out.string(arr.data(), arr.size());\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+      if (ff->string_view()) {
+        stream << def_indentation << "inline bool __write_type(std::string_view arr, umison_writer &out, std::ostream &) {\n"
+        << def_1p_indentation << "out.string(arr.data(), arr.size());\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+      }
+      if (ff->interned()) {
+        stream << def_indentation
+        << "inline bool __write_type(const umison_interned &arr, umison_writer &out, std::ostream &) {\n"
+        << def_1p_indentation << "out.string(arr.data(), arr.size());\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+      }
+      if (ff->bounded()) {
+        stream << def_indentation << "template<std::size_t N>\n"
+        << def_indentation
+        << "inline bool __write_type(const umison_inline_string<N> &arr, umison_writer &out, std::ostream &) {\n"
+        << def_1p_indentation << "out.string(arr.data(), arr.size());\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Prints the sizes of the basic types, the doubles are formatted to know their length
+     * */
+    void print_basic_sizes(std::shared_ptr<umi::umixml> &ff, streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      stream << def_indentation << "// Length of the json of the basic types\n"
+      << def_indentation << "inline std::size_t __serialized_size(bool arr) {\n"
+      << def_1p_indentation << "return arr ? 4 : 5;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline std::size_t __serialized_size(long long int arr) {\n"
+      << def_1p_indentation << "uint64_t magnitude = static_cast<uint64_t>(arr);\n"
+      << def_1p_indentation << "if (arr < 0) {\n"
+      << def_2p_indentation << "return static_cast<std::size_t>(umison_count_digits(0 - magnitude)) + 1;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return static_cast<std::size_t>(umison_count_digits(magnitude));\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline std::size_t __serialized_size(int arr) {\n"
+      << def_1p_indentation << "return __serialized_size(static_cast<long long int>(arr));\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "// the doubles that are not finite can't be written and have no length\n"
+      << def_indentation << "inline std::size_t __serialized_size(double arr) {\n"
+      << def_1p_indentation << "if (!std::isfinite(arr)) {\n"
+      << def_2p_indentation << "return 0;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "char buffer[32];\n"
+      << def_1p_indentation << "return static_cast<std::size_t>(umison_dtoa(arr, buffer) - buffer);\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "inline std::size_t __serialized_size(const std::string &arr) {\n"
+      << def_1p_indentation << "return umison_escaped_size(arr.data(), arr.size());\n"
+      << def_indentation << "}\n\n";
+      if (ff->string_view()) {
+        stream << def_indentation << "inline std::size_t __serialized_size(std::string_view arr) {\n"
+        << def_1p_indentation << "return umison_escaped_size(arr.data(), arr.size());\n"
+        << def_indentation << "}\n\n";
+      }
+      if (ff->interned()) {
+        stream << def_indentation << "inline std::size_t __serialized_size(const umison_interned &arr) {\n"
+        << def_1p_indentation << "return umison_escaped_size(arr.data(), arr.size());\n"
+        << def_indentation << "}\n\n";
+      }
+      if (ff->bounded()) {
+        stream << def_indentation << "template<std::size_t N>\n"
+        << def_indentation << "inline std::size_t __serialized_size(const umison_inline_string<N> &arr) {\n"
+        << def_1p_indentation << "return umison_escaped_size(arr.data(), arr.size());\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Prints the writer and the size of each enum, the values are written from a table with
+     * their quoted names, a value out of the enum can't be written and has no length
+     * */
+    void print_enum_types(std::shared_ptr<umi::umixml> &ff, streamer &stream, int level) {
+      auto &enums = ff->getEnumArray();
+      if (enums.empty()) {
+        return;
+      }
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      stream << def_indentation << "// Writing functions of the enums\n"
+      << def_indentation << "struct umison_enum_name {\n"
+      << def_1p_indentation << "const char *text;\n"
+      << def_1p_indentation << "std::size_t size;\n"
+      << def_indentation << "};\n\n";
+      for (auto &enum_node : enums) {
+        const std::string &name = enum_node->name();
+        auto enumerators = enum_node->enumerators();
+        stream << def_indentation << "static const umison_enum_name " << name << "__names[" << enumerators.size()
+        << "] = {\n";
+        for (std::size_t i = 0; i < enumerators.size(); ++i) {
+          stream << def_1p_indentation << "{\"\\\"" << enumerators[i] << "\\\"\", " << enumerators[i].size() + 2 << "}"
+          << (i + 1 < enumerators.size() ? ",\n" : "\n");
+        }
+        stream << def_indentation << "};\n\n"
+        << def_indentation << "inline bool __write_type(" << name << " arr, umison_writer &out, std::ostream &ss) {\n"
+        << def_1p_indentation << "std::size_t index = static_cast<std::size_t>(arr);\n"
+        << def_1p_indentation << "if (index >= " << enumerators.size() << ") {\n"
+        << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error \" << index << \" is not a value of "
+        << name << "\\n\";\n"
+        << def_2p_indentation << "return false;\n"
+        << def_1p_indentation << "}\n"
+        << def_1p_indentation << "out.write(" << name << "__names[index].text, " << name << "__names[index].size);\n"
+        << def_1p_indentation << "return true;\n"
+        << def_indentation << "}\n\n"
+        << def_indentation << "inline std::size_t __serialized_size(" << name << " arr) {\n"
+        << def_1p_indentation << "std::size_t index = static_cast<std::size_t>(arr);\n"
+        << def_1p_indentation << "return index < " << enumerators.size() << " ? " << name << "__names[index].size : 0;\n"
+        << def_indentation << "}\n\n";
+      }
+    }
+
+    /**
+     * Declares the writers of the containers and the classes so they can call each other
+     * */
+    void print_forward_declarations(std::shared_ptr<umi::umixml> &ff, streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      stream << def_indentation << "// Forward declaration of writing functions\n"
+      << def_indentation << "template<typename Type>\n"
+      << def_indentation << "bool __write_type(const std::vector<Type> &arr, umison_writer &out, std::ostream &ss);\n"
+      << def_indentation << "template<typename Type>\n"
+      << def_indentation
+      << "bool __write_type(const std::multimap<std::string, Type> &arr, umison_writer &out, std::ostream &ss);\n";
+      stream << def_indentation << "template<typename Type>\n"
+      << def_indentation << "std::size_t __serialized_size(const std::vector<Type> &arr);\n"
+      << def_indentation << "template<typename Type>\n"
+      << def_indentation << "std::size_t __serialized_size(const std::multimap<std::string, Type> &arr);\n";
+      for (auto &element : ff->getClassMap()) {
+        stream << def_indentation << "inline bool __write_type(const " << element.first
+        << " &arr, umison_writer &out, std::ostream &ss);\n"
+        << def_indentation << "inline std::size_t __serialized_size(const " << element.first << " &arr);\n";
+      }
+      for (auto &variant : ff->getVariantArray()) {
+        stream << def_indentation << "inline bool __write_type(const " << variant->name()
+        << " &arr, umison_writer &out, std::ostream &ss);\n"
+        << def_indentation << "inline std::size_t __serialized_size(const " << variant->name() << " &arr);\n";
+      }
+      stream << "\n";
+    }
+
+    /**
+     * Prints the writers of lists and maps
+     * */
+    void print_containers(streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      std::string def_3p_indentation(def_2p_indentation + TABS);
+      stream << def_indentation << "template<typename Type>\n"
+      << def_indentation << "bool __write_type(const std::vector<Type> &arr, umison_writer &out, std::ostream &ss) {\n"
+      << def_1p_indentation << "out.put('[');\n"
+      << def_1p_indentation << "for (std::size_t position = 0; position < arr.size(); ++position) {\n"
+      << def_2p_indentation << "if (position > 0) {\n"
+      << def_3p_indentation << "out.put(',');\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "if (!__write_type(arr[position], out, ss)) {\n"
+      << def_3p_indentation << "return false;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "out.put(']');\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "template<typename Type>\n"
+      << def_indentation
+      << "bool __write_type(const std::multimap<std::string, Type> &arr, umison_writer &out, std::ostream &ss) {\n"
+      << def_1p_indentation << "out.put('{');\n"
+      << def_1p_indentation << "for (auto it = arr.begin(); it != arr.end(); ++it) {\n"
+      << def_2p_indentation << "if (it != arr.begin()) {\n"
+      << def_3p_indentation << "out.put(',');\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "out.string(it->first.data(), it->first.size());\n"
+      << def_2p_indentation << "out.put(':');\n"
+      << def_2p_indentation << "if (!__write_type(it->second, out, ss)) {\n"
+      << def_3p_indentation << "return false;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "out.put('}');\n"
+      << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints the sizes of lists and maps, the separators are one char less than the elements
+     * */
+    void print_container_sizes(streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      stream << def_indentation << "template<typename Type>\n"
+      << def_indentation << "std::size_t __serialized_size(const std::vector<Type> &arr) {\n"
+      << def_1p_indentation << "std::size_t size = arr.empty() ? 2 : arr.size() + 1;\n"
+      << def_1p_indentation << "for (std::size_t position = 0; position < arr.size(); ++position) {\n"
+      << def_2p_indentation << "size += __serialized_size(arr[position]);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return size;\n"
+      << def_indentation << "}\n\n"
+      << def_indentation << "template<typename Type>\n"
+      << def_indentation << "std::size_t __serialized_size(const std::multimap<std::string, Type> &arr) {\n"
+      << def_1p_indentation << "std::size_t size = arr.empty() ? 2 : arr.size() + 1;\n"
+      << def_1p_indentation << "for (auto it = arr.begin(); it != arr.end(); ++it) {\n"
+      << def_2p_indentation << "size += umison_escaped_size(it->first.data(), it->first.size()) + 1 + __serialized_size(it->second);\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return size;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints the size of one class
+     * */
+    void print_class_size(const std::shared_ptr<umi::umixmltypeclass> &elem, streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      stream << def_indentation << "inline std::size_t __serialized_size(const " << elem->name() << " &arr) {\n";
+      print_size_members(elem, "arr.", "", stream, level + 1);
+      stream << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints the writer of one class
+     * */
+    void print_class_writer(const std::shared_ptr<umi::umixmltypeclass> &elem, streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      stream << def_indentation << "inline bool __write_type(const " << elem->name()
+      << " &arr, umison_writer &out, std::ostream &ss) {\n";
+      print_members(elem, "arr.", stream, level + 1);
+      stream << def_1p_indentation << "return true;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints the size of one variant, the size of the class of its case with the tag
+     * */
+    void print_variant_size(std::shared_ptr<umi::umixml> &ff, const std::shared_ptr<umi::umixmlvariant> &variant,
+                            streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      stream << def_indentation << "inline std::size_t __serialized_size(const " << variant->name() << " &arr) {\n"
+      << def_1p_indentation << "switch (arr.which()) {\n";
+      for (auto &variant_case : variant->cases()) {
+        stream << def_1p_indentation << "case " << variant->name() << "::umison_case::" << variant_case.refclass
+        << ": {\n"
+        << def_2p_indentation << "const " << variant_case.refclass << " &value = *arr.get_" << variant_case.refclass
+        << "();\n";
+        print_size_members(case_class(ff, variant_case), "value.", "", stream, level + 2,
+                           variant->tag().size() + variant_case.value.size() + 5);
+        stream << def_1p_indentation << "}\n";
+      }
+      stream << def_1p_indentation << "case " << variant->name() << "::umison_case::none:\n"
+      << def_2p_indentation << "break;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "// __write_type fails on it\n"
+      << def_1p_indentation << "return 0;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints the writer of one variant, the tag is written first and then the members of the
+     * class of its case
+     * */
+    void print_variant_writer(std::shared_ptr<umi::umixml> &ff, const std::shared_ptr<umi::umixmlvariant> &variant,
+                              streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      std::string def_2p_indentation(def_1p_indentation + TABS);
+      stream << def_indentation << "inline bool __write_type(const " << variant->name()
+      << " &arr, umison_writer &out, std::ostream &ss) {\n"
+      << def_1p_indentation << "switch (arr.which()) {\n";
+      for (auto &variant_case : variant->cases()) {
+        stream << def_1p_indentation << "case " << variant->name() << "::umison_case::" << variant_case.refclass
+        << ": {\n"
+        << def_2p_indentation << "const " << variant_case.refclass << " &value = *arr.get_" << variant_case.refclass
+        << "();\n";
+        print_members(case_class(ff, variant_case), "value.", stream, level + 2,
+                      "\\\"" + variant->tag() + "\\\":\\\"" + variant_case.value + "\\\"",
+                      variant->tag().size() + variant_case.value.size() + 5);
+        stream << def_2p_indentation << "return true;\n"
+        << def_1p_indentation << "}\n";
+      }
+      stream << def_1p_indentation << "case " << variant->name() << "::umison_case::none:\n"
+      << def_2p_indentation << "break;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error " << variant->name()
+      << " holds no case\\n\";\n"
+      << def_1p_indentation << "return false;\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Class of one case of a variant
+     * */
+    static std::shared_ptr<umi::umixmltypeclass> case_class(std::shared_ptr<umi::umixml> &ff,
+                                                           const umi::umixmlvariantcase &variant_case) {
+      for (auto &element : ff->getClassMap()) {
+        if (element.first == variant_case.refclass) {
+          return element.second;
+        }
+      }
+      return nullptr;
+    }
+
+    /**
+     * Prints the writer of one json, it is the only one that has the umison_writer so the
+     * writers of its members can be inlined with the writer kept in registers
+     * */
+    void print_json_writer(const std::shared_ptr<umi::umixmltypeclass> &json, streamer &stream, int level) {
+      std::string def_indentation(indentation(level));
+      std::string def_1p_indentation(def_indentation + TABS);
+      stream << def_indentation << "// writes json to output, false when a value can't be written or the output fails\n"
+      << def_indentation << "bool __write_json(const umison::" << json->name()
+      << " &json, umison_output output, void *context, std::ostream &ss,\n"
+      << def_indentation << "                  umison_output reference = nullptr) {\n"
+      << def_1p_indentation << "umison_writer out(output, context, reference);\n";
+      print_members(json, "json.", stream, level + 1);
+      stream << def_1p_indentation << "return out.flush();\n"
+      << def_indentation << "}\n\n";
+    }
+
+    /**
+     * Prints serialized_size, write_to and write_data_to_string of one json, on error the
+     * string is left as it was
+     * */
+    void print_json_functions(const std::shared_ptr<umi::umixmltypeclass> &json, streamer &stream) {
+      std::string def_1p_indentation(indentation(1));
+      std::string def_2p_indentation(indentation(2));
+      std::string ns("__internal__umison" + m_additional_string + "::");
+      stream << "std::size_t umison::" << json->name() << "::serialized_size() const {\n";
+      print_size_members(json, "", ns, stream, 1);
+      stream << "}\n\n"
+      << "std::size_t umison::" << json->name() << "::write_to(char *buffer, std::size_t capacity) const {\n"
+      << def_1p_indentation << "return write_to(buffer, capacity, std::cerr);\n"
+      << "}\n\n"
+      << "std::size_t umison::" << json->name()
+      << "::write_to(char *buffer, std::size_t capacity, std::ostream &ss) const {\n"
+      << def_1p_indentation << ns << "umison_memory memory = {buffer, capacity, 0, false};\n"
+      << def_1p_indentation << "if (!" << ns << "__write_json(*this, " << ns << "umison_memory_output, &memory, ss)) {\n"
+      << def_2p_indentation << "if (memory.full) {\n"
+      << def_2p_indentation << TABS
+      << "ss << __FILE__ << \":\" << __LINE__ << \" Error the json doesn't fit in \" << capacity << \" chars\\n\";\n"
+      << def_2p_indentation << "}\n"
+      << def_2p_indentation << "return 0;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return memory.size;\n"
+      << "}\n\n"
+      << "bool umison::" << json->name() << "::write_data_to_string(std::string &output) const {\n"
+      << def_1p_indentation << "return write_data_to_string(output, std::cerr);\n"
+      << "}\n\n"
+      << "bool umison::" << json->name()
+      << "::write_data_to_string(std::string &output, std::ostream &ss) const {\n"
+      << def_1p_indentation << "std::size_t start = output.size();\n"
+      << def_1p_indentation << "if (!" << ns << "__write_json(*this, " << ns << "umison_string_output, &output, ss)) {\n"
+      << def_2p_indentation << "output.resize(start);\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return true;\n"
+      << "}\n\n";
+      print_json_sink(json, "write_data_to_fd", "int fd", "fd", "&fd", "umison_fd_output", stream);
+      print_json_sink(json, "write_data_to_file", "FILE *file", "file", "file", "umison_file_output", stream);
+      print_json_sink(json, "write_data_to_stream", "std::ostream &output", "output", "&output",
+                      "umison_stream_output", stream);
+      print_json_sink(json, "write_data_to_callback", "const std::function<bool(const char *, std::size_t)> &output",
+                      "output", "const_cast<std::function<bool(const char *, std::size_t)> *>(&output)",
+                      "umison_callback_output", stream);
+      stream << "#if !defined(_WIN32)\n"
+      << "bool umison::" << json->name() << "::serialize_iov(std::vector<iovec> &iov, serialize_scratch &scratch) const {\n"
+      << def_1p_indentation << "return serialize_iov(iov, scratch, std::cerr);\n"
+      << "}\n\n"
+      << "bool umison::" << json->name()
+      << "::serialize_iov(std::vector<iovec> &iov, serialize_scratch &scratch, std::ostream &ss) const {\n"
+      << def_1p_indentation << "std::size_t start = iov.size();\n"
+      << def_1p_indentation << ns << "umison_iov pieces = {&iov, &scratch};\n"
+      << def_1p_indentation << "if (!" << ns << "__write_json(*this, " << ns << "umison_iov_output, &pieces, ss, " << ns
+      << "umison_iov_reference)) {\n"
+      << def_2p_indentation << "iov.resize(start);\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return true;\n"
+      << "}\n"
+      << "#endif\n\n";
+    }
+
+    /**
+     * Prints the functions of umison::serialize_scratch, the blocks are kept until the
+     * scratch is destroyed and taken again in order after clear
+     * */
+    void print_serialize_scratch(streamer &stream) {
+      std::string def_1p_indentation(indentation(1));
+      std::string def_2p_indentation(indentation(2));
+      std::string def_3p_indentation(indentation(3));
+      stream << "#if !defined(_WIN32)\n"
+      << "umison::serialize_scratch::serialize_scratch(std::size_t block_size) :\n"
+      << def_1p_indentation << "m_block(0), m_used(0), m_block_size(block_size) {}\n\n"
+      << "void umison::serialize_scratch::clear() {\n"
+      << def_1p_indentation << "m_block = 0;\n"
+      << def_1p_indentation << "m_used = 0;\n"
+      << "}\n\n"
+      << "char *umison::serialize_scratch::allocate(std::size_t len) {\n"
+      << def_1p_indentation << "for (; m_block < m_blocks.size(); ++m_block, m_used = 0) {\n"
+      << def_2p_indentation << "std::vector<char> &block = m_blocks[m_block];\n"
+      << def_2p_indentation << "if (len <= block.size() - m_used) {\n"
+      << def_3p_indentation << "m_used += len;\n"
+      << def_3p_indentation << "return block.data() + m_used - len;\n"
+      << def_2p_indentation << "}\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "m_blocks.emplace_back(len > m_block_size ? len : m_block_size);\n"
+      << def_1p_indentation << "m_used = len;\n"
+      << def_1p_indentation << "return m_blocks.back().data();\n"
+      << "}\n\n"
+      << "std::size_t umison::serialize_scratch::capacity() const {\n"
+      << def_1p_indentation << "std::size_t retval = 0;\n"
+      << def_1p_indentation << "for (auto &block : m_blocks) {\n"
+      << def_2p_indentation << "retval += block.size();\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return retval;\n"
+      << "}\n"
+      << "#endif\n\n";
+    }
+
+    /**
+     * Prints the two functions of one json that write to a sink, the one without an error
+     * stream reports on stderr
+     *
+     * \param parameter declaration of the sink parameter
+     * \param argument the sink parameter passed to the other function
+     * \param context the sink given to the output function
+     * \param output output function of the sink
+     * */
+    void print_json_sink(const std::shared_ptr<umi::umixmltypeclass> &json, const std::string &function,
+                         const std::string &parameter, const std::string &argument, const std::string &context,
+                         const std::string &output, streamer &stream) {
+      std::string def_1p_indentation(indentation(1));
+      std::string def_2p_indentation(indentation(2));
+      std::string ns("__internal__umison" + m_additional_string + "::");
+      stream << "bool umison::" << json->name() << "::" << function << "(" << parameter << ") const {\n"
+      << def_1p_indentation << "return " << function << "(" << argument << ", std::cerr);\n"
+      << "}\n\n"
+      << "bool umison::" << json->name() << "::" << function << "(" << parameter << ", std::ostream &ss) const {\n"
+      << def_1p_indentation << "if (!" << ns << "__write_json(*this, " << ns << output << ", " << context
+      << ", ss)) {\n"
+      << def_2p_indentation << "ss << __FILE__ << \":\" << __LINE__ << \" Error writing the json of " << json->name()
+      << "\\n\";\n"
+      << def_2p_indentation << "return false;\n"
+      << def_1p_indentation << "}\n"
+      << def_1p_indentation << "return true;\n"
+      << "}\n\n";
+    }
+
+    /**
+     * Prints the body of a size function, the length of the names and the separators of
+     * the members that are always written is added up here, the members that may be left
+     * out are added when they are written
+     *
+     * \param inout_dot prefix of the getters and the conditions
+     * \param ns namespace of the size functions
+     * \param opening_size size of the tag of a variant written before the members, 0 for none
+     * */
+    void print_size_members(const std::shared_ptr<umi::umixmltypeclass> &elem, const std::string &inout_dot,
+                            const std::string &ns, streamer &stream, int level, std::size_t opening_size = 0) {
+      std::string def_indentation(indentation(level));
+      auto &children = elem->getChildren();
+      if (children.size() == 1 && children[0]->isMap()) {
+        stream << def_indentation << "return " << ns << "__serialized_size(" << inout_dot << "get_"
+        << children[0]->name() << "());\n";
+        return;
+      }
+      if (children.empty()) {
+        stream << def_indentation << "return " << 2 + opening_size << ";\n";
+        return;
+      }
+      // The tag is one more member always written
+      std::size_t fixed_size = opening_size > 0 ? 2 + opening_size : 2;
+      std::size_t fixed_members = opening_size > 0 ? 1 : 0;
+      bool any_skipped = false;
+      for (auto &child : children) {
+        if (child->optional() || !child->condition().empty()) {
+          any_skipped = true;
+        } else {
+          fixed_size += child->name().size() + 3;
+          ++fixed_members;
+        }
+      }
+      if (any_skipped) {
+        stream << def_indentation << "std::size_t size = " << fixed_size << ";\n"
+        << def_indentation << "std::size_t members = " << fixed_members << ";\n";
+      } else {
+        stream << def_indentation << "std::size_t size = " << fixed_size + fixed_members - 1 << ";\n";
+      }
+      for (auto &child : children) {
+        std::string child_indentation(def_indentation);
+        if (!child->condition().empty()) {
+          stream << child_indentation << "if (" << inout_dot << child->condition() << ") {\n";
+          child_indentation += TABS;
+        }
+        if (child->optional()) {
+          stream << child_indentation << "if (" << inout_dot << "get_" << child->optional_name() << "()) {\n";
+          child_indentation += TABS;
+        }
+        if (child->optional() || !child->condition().empty()) {
+          stream << child_indentation << "size += " << child->name().size() + 3 << " + " << ns
+          << "__serialized_size(" << inout_dot << "get_" << child->name() << "());\n"
+          << child_indentation << "++members;\n";
+        } else {
+          stream << child_indentation << "size += " << ns << "__serialized_size(" << inout_dot << "get_"
+          << child->name() << "());\n";
+        }
+        if (child->optional()) {
+          child_indentation.resize(child_indentation.size() - std::string(TABS).size());
+          stream << child_indentation << "}\n";
+        }
+        if (!child->condition().empty()) {
+          child_indentation.resize(child_indentation.size() - std::string(TABS).size());
+          stream << child_indentation << "}\n";
+        }
+      }
+      if (!any_skipped) {
+        stream << def_indentation << "return size;\n";
+      } else if (fixed_members > 0) {
+        stream << def_indentation << "return size + members - 1;\n";
+      } else {
+        stream << def_indentation << "return members > 0 ? size + members - 1 : size;\n";
+      }
+    }
+
+    /**
+     * Prints the members of one object. The quoted names are written with the comma
+     * in front when a member is known to be before them, the optional members that are
+     * not set and the members whose condition is false are left out.
+     *
+     * \param inout_dot prefix of the getters and the conditions
+     * \param opening tag of a variant written first, escaped for the generated code, empty for none
+     * \param opening_size size of the tag written
+     * */
+    void print_members(const std::shared_ptr<umi::umixmltypeclass> &elem, const std::string &inout_dot,
+                       streamer &stream, int level, const std::string &opening = std::string(),
+                       std::size_t opening_size = 0) {
+      std::string def_indentation(indentation(level));
+      auto &children = elem->getChildren();
+      // A class made of one map is the map itself
+      if (children.size() == 1 && children[0]->isMap()) {
+        stream << def_indentation << "if (!__write_type(" << inout_dot << "get_" << children[0]->name()
+        << "(), out, ss)) {\n"
+        << def_indentation << TABS << "return false;\n"
+        << def_indentation << "}\n";
+        return;
+      }
+      if (children.empty()) {
+        stream << def_indentation << "out.write(\"{" << opening << "}\", " << opening_size + 2 << ");\n";
+        return;
+      }
+      // none: nothing written yet, maybe: the variable first tells, some: a member was written
+      enum { none, maybe, some } written = none;
+      if (!opening.empty()) {
+        stream << def_indentation << "out.write(\"{" << opening << "\", " << opening_size + 1 << ");\n";
+        written = some;
+      }
+      for (std::size_t i = 0; i < children.size(); ++i) {
+        auto &child = children[i];
+        bool skipped = child->optional() || !child->condition().empty();
+        bool last = i + 1 == children.size();
+        std::string child_indentation(def_indentation);
+        if (written == none && skipped) {
+          stream << def_indentation << "out.put('{');\n";
+          if (!last) {
+            stream << def_indentation << "bool first = true;\n";
+          }
+        }
+        if (!child->condition().empty()) {
+          stream << child_indentation << "if (" << inout_dot << child->condition() << ") {\n";
+          child_indentation += TABS;
+        }
+        if (child->optional()) {
+          stream << child_indentation << "if (" << inout_dot << "get_" << child->optional_name() << "()) {\n";
+          child_indentation += TABS;
+        }
+        std::string key("\\\"" + child->name() + "\\\":");
+        std::size_t key_size = child->name().size() + 3;
+        if (written == none && !skipped) {
+          stream << child_indentation << "out.write(\"{" << key << "\", " << key_size + 1 << ");\n";
+        } else if (written == none) {
+          stream << child_indentation << "out.write(\"" << key << "\", " << key_size << ");\n";
+        } else if (written == maybe) {
+          stream << child_indentation << "if (!first) {\n"
+          << child_indentation << TABS << "out.put(',');\n"
+          << child_indentation << "}\n"
+          << child_indentation << "out.write(\"" << key << "\", " << key_size << ");\n";
+        } else {
+          stream << child_indentation << "out.write(\"," << key << "\", " << key_size + 1 << ");\n";
+        }
+        stream << child_indentation << "if (!__write_type(" << inout_dot << "get_" << child->name()
+        << "(), out, ss)) {\n"
+        << child_indentation << TABS << "return false;\n"
+        << child_indentation << "}\n";
+        if (skipped && written != some && !last) {
+          stream << child_indentation << "first = false;\n";
+        }
+        if (child->optional()) {
+          child_indentation.resize(child_indentation.size() - std::string(TABS).size());
+          stream << child_indentation << "}\n";
+        }
+        if (!child->condition().empty()) {
+          child_indentation.resize(child_indentation.size() - std::string(TABS).size());
+          stream << child_indentation << "}\n";
+        }
+        if (!skipped) {
+          written = some;
+        } else if (written == none) {
+          written = maybe;
+        }
+      }
+      stream << def_indentation << "out.put('}');\n";
+    }
+
+    /**
+     * String appended to the internal namespace
+     * */
+    std::string m_additional_string;
+  };
+}
+
+#endif
@@ -26,11 +26,13 @@
 #include "umixml.h"
 #include "umixmltags.h"
 #include "umixmltypestring.h"
+#include <algorithm>
 #include <array>
 #include <boost/algorithm/string.hpp>
 #include <exception>
 #include <iostream>
 #include <pugixml.hpp>
+#include <stdexcept>
 
 namespace umi {
   /**
@@ -200,6 +202,17 @@ namespace umi {
             strncmp(UMI_XMLATTR_CONDITION, node_attribute->name(), strlen(UMI_XMLATTR_CONDITION)) ==
             0) {
             list_node->condition(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_FILTER, node_attribute->name(), strlen(UMI_XMLATTR_FILTER)) == 0) {
+            list_node->filter(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_INDEX, node_attribute->name(), strlen(UMI_XMLATTR_INDEX)) == 0) {
+            list_node->index(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_STREAMING, node_attribute->name(), strlen(UMI_XMLATTR_STREAMING)) == 0) {
+            try {
+              list_node->streaming(boolean_to_bool(node_attribute->value()));
+            } catch (std::exception &ex) {
+              std::cerr << "Wrong boolean value: " << node_attribute->value()
+              << ". Setting streaming to false.\n";
+            }
           } else if (strncmp(UMI_XMLATTR_REFCLASS, node_attribute->name(), strlen(UMI_XMLATTR_REFCLASS)) ==
                      0) {
             list_node->refclass(node_attribute->value());
@@ -341,6 +354,23 @@ namespace umi {
             strncmp(UMI_XMLATTR_CONDITION, node_attribute->name(), strlen(UMI_XMLATTR_CONDITION)) ==
             0) {
             string_node->condition(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_INTERN, node_attribute->name(), strlen(UMI_XMLATTR_INTERN)) == 0) {
+            try {
+              string_node->intern(boolean_to_bool(node_attribute->value()));
+            } catch (std::exception &ex) {
+              std::cerr << "Wrong boolean value: " << node_attribute->value()
+              << ". Setting intern to false.\n";
+            }
+          } else if (strncmp(UMI_XMLATTR_MAXLEN, node_attribute->name(), strlen(UMI_XMLATTR_MAXLEN)) == 0) {
+            try {
+              if (node_attribute->value()[0] == '-') {
+                throw std::invalid_argument("negative maxlen");
+              }
+              string_node->maxlen(std::stoul(node_attribute->value()));
+            } catch (std::exception &ex) {
+              std::cerr << "Wrong maxlen value: " << node_attribute->value()
+              << ". The string has no maximum length.\n";
+            }
           } else {
             std::cerr << "Unsupported attribute on node string: << " << node_attribute->name()
             << " ignoring it.\n";
@@ -354,6 +384,68 @@ namespace umi {
         if (string_node->optional() && string_node->optional_name().empty()) {
           string_node->optional_name(string_node->name() + "_umi_optional");
         }
+        if (string_node->bounded() && string_node->intern()) {
+          std::cerr << "String node " << string_node->name() << " with maxlen can't be interned, ignoring intern.\n";
+          string_node->intern(false);
+        }
+        retval = true;
+      }
+      return retval;
+    }
+
+    /**
+     * Reads on node from rapid xml and fills the enum stored in it, the values are separated
+     * by commas
+     * */
+    bool read_enum_node(std::shared_ptr<umixmltypeenum> &enum_node, pugi::xml_node &node) {
+      bool retval = false;
+      if (node == nullptr) {
+        std::cerr << "Trying to read a nullptr node. Expecting enum node.\n";
+      } else {
+        // Get attributes and fill them
+        pugi::xml_attribute_iterator node_attribute = node.attributes_begin();
+        while (node_attribute != node.attributes_end()) {
+          if (strncmp(UMI_XMLATTR_NAME, node_attribute->name(), strlen(UMI_XMLATTR_NAME)) == 0) {
+            enum_node->name(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_OPTIONAL_NAME, node_attribute->name(), strlen(UMI_XMLATTR_OPTIONAL_NAME)) ==
+                     0) {
+            enum_node->optional_name(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_OPTIONAL, node_attribute->name(), strlen(UMI_XMLATTR_OPTIONAL)) ==
+                     0) {
+            try {
+              enum_node->optional(boolean_to_bool(node_attribute->value()));
+            } catch (std::exception &ex) {
+              std::cerr << "Wrong boolean value: " << node_attribute->value()
+              << ". Setting optional to false.\n";
+            }
+          } else if (
+            strncmp(UMI_XMLATTR_CONDITION, node_attribute->name(), strlen(UMI_XMLATTR_CONDITION)) ==
+            0) {
+            enum_node->condition(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_VALUES, node_attribute->name(), strlen(UMI_XMLATTR_VALUES)) == 0) {
+            std::vector<std::string> values;
+            boost::algorithm::split(values, node_attribute->value(), boost::algorithm::is_any_of(","));
+            for (auto &value: values) {
+              boost::algorithm::trim(value);
+            }
+            enum_node->values(values);
+          } else if (strncmp(UMI_XMLATTR_FALLBACK, node_attribute->name(), strlen(UMI_XMLATTR_FALLBACK)) == 0) {
+            enum_node->fallback(boost::algorithm::trim_copy(std::string(node_attribute->value())));
+          } else if (strncmp(UMI_XMLATTR_TYPE, node_attribute->name(), strlen(UMI_XMLATTR_TYPE)) == 0) {
+            enum_node->type(node_attribute->value());
+          } else {
+            std::cerr << "Unsupported attribute on node enum: << " << node_attribute->name()
+            << " ignoring it.\n";
+          }
+          node_attribute++;
+        }
+        if (enum_node->name().empty()) {
+          std::cerr << "Enum node with empty name is not supported\n";
+          return retval;
+        }
+        if (enum_node->optional() && enum_node->optional_name().empty()) {
+          enum_node->optional_name(enum_node->name() + "_umi_optional");
+        }
         retval = true;
       }
       return retval;
@@ -479,6 +571,14 @@ namespace umi {
             strncmp(UMI_XMLATTR_CONDITION, node_attribute->name(), strlen(UMI_XMLATTR_CONDITION)) ==
             0) {
             class_node->condition(node_attribute->value());
+          } else if (strncmp(UMI_XMLATTR_READ_PREFIX, node_attribute->name(), strlen(UMI_XMLATTR_READ_PREFIX)) ==
+                     0) {
+            try {
+              class_node->read_prefix(boolean_to_bool(node_attribute->value()));
+            } catch (std::exception &ex) {
+              std::cerr << "Wrong boolean value: " << node_attribute->value()
+              << ". Setting read_prefix to false.\n";
+            }
           } else {
             std::cerr << "Unsupported attribute on node class: << " << node_attribute->name()
             << " ignoring it.\n";
@@ -517,6 +617,10 @@ namespace umi {
             auto ptr_bool = std::make_shared<umi::umixmltypeboolean>();
             read_boolean_node(ptr_bool, child_node);
             class_node->addChildren(std::dynamic_pointer_cast<umi::umixmltype>(ptr_bool));
+          } else if (strncmp(UMI_XMLTAGS_ENUM, child_node.name(), strlen(UMI_XMLTAGS_ENUM)) == 0) {
+            auto ptr_enum = std::make_shared<umi::umixmltypeenum>();
+            read_enum_node(ptr_enum, child_node);
+            class_node->addChildren(std::dynamic_pointer_cast<umi::umixmltype>(ptr_enum));
           } else if (strncmp(UMI_XMLTAGS_LIST, child_node.name(), strlen(UMI_XMLTAGS_LIST)) == 0) {
             auto ptr_list = std::make_shared<umi::umixmltypelist>();
             read_list_node(ptr_list, child_node);
@@ -538,6 +642,183 @@ namespace umi {
       }
       return retval;
     }
+
+    /**
+     * Reads one projection node, its name, its json and the path of each field node
+     * */
+    bool read_projection_node(std::shared_ptr<umixmlprojection> &projection_node, pugi::xml_node &node) {
+      pugi::xml_attribute_iterator node_attribute = node.attributes_begin();
+      while (node_attribute != node.attributes_end()) {
+        if (strncmp(UMI_XMLATTR_NAME, node_attribute->name(), strlen(UMI_XMLATTR_NAME)) == 0) {
+          projection_node->name(node_attribute->value());
+        } else if (strncmp(UMI_XMLATTR_JSON, node_attribute->name(), strlen(UMI_XMLATTR_JSON)) == 0) {
+          projection_node->json(node_attribute->value());
+        } else {
+          std::cerr << "Unsupported attribute on node projection: << " << node_attribute->name()
+          << " ignoring it.\n";
+        }
+        node_attribute++;
+      }
+      if (projection_node->name().empty() || projection_node->json().empty()) {
+        std::cerr << "Projection node without name or json is not supported\n";
+        return false;
+      }
+      pugi::xml_node child_node(node.first_child());
+      while (child_node) {
+        if (strncmp(UMI_XMLTAGS_FIELD, child_node.name(), strlen(UMI_XMLTAGS_FIELD)) == 0) {
+          pugi::xml_attribute_iterator field_attribute = child_node.attributes_begin();
+          while (field_attribute != child_node.attributes_end()) {
+            if (strncmp(UMI_XMLATTR_PATH, field_attribute->name(), strlen(UMI_XMLATTR_PATH)) == 0 &&
+                *field_attribute->value() != '\0') {
+              projection_node->add_path(field_attribute->value());
+            } else {
+              std::cerr << "Unsupported attribute on node field: << " << field_attribute->name()
+              << " ignoring it.\n";
+            }
+            field_attribute++;
+          }
+        } else {
+          std::cerr << "Unsupported node on node projection: << " << child_node.name() << " ignoring it.\n";
+        }
+        child_node = child_node.next_sibling();
+      }
+      return true;
+    }
+
+    /**
+     * Reads one variant node, its name, its tag and the value and class of each case node
+     * */
+    bool read_variant_node(std::shared_ptr<umixmlvariant> &variant_node, pugi::xml_node &node) {
+      pugi::xml_attribute_iterator node_attribute = node.attributes_begin();
+      while (node_attribute != node.attributes_end()) {
+        if (strncmp(UMI_XMLATTR_NAME, node_attribute->name(), strlen(UMI_XMLATTR_NAME)) == 0) {
+          variant_node->name(node_attribute->value());
+        } else if (strncmp(UMI_XMLATTR_TAG, node_attribute->name(), strlen(UMI_XMLATTR_TAG)) == 0) {
+          variant_node->tag(node_attribute->value());
+        } else {
+          std::cerr << "Unsupported attribute on node variant: << " << node_attribute->name()
+          << " ignoring it.\n";
+        }
+        node_attribute++;
+      }
+      if (variant_node->name().empty() || variant_node->tag().empty()) {
+        std::cerr << "Variant node without name or tag is not supported\n";
+        return false;
+      }
+      pugi::xml_node child_node(node.first_child());
+      while (child_node) {
+        if (strncmp(UMI_XMLTAGS_CASE, child_node.name(), strlen(UMI_XMLTAGS_CASE)) == 0) {
+          umixmlvariantcase variant_case;
+          pugi::xml_attribute_iterator case_attribute = child_node.attributes_begin();
+          while (case_attribute != child_node.attributes_end()) {
+            if (strncmp(UMI_XMLATTR_VALUE, case_attribute->name(), strlen(UMI_XMLATTR_VALUE)) == 0) {
+              variant_case.value = case_attribute->value();
+            } else if (strncmp(UMI_XMLATTR_REFCLASS, case_attribute->name(), strlen(UMI_XMLATTR_REFCLASS)) == 0) {
+              variant_case.refclass = case_attribute->value();
+            } else {
+              std::cerr << "Unsupported attribute on node case: << " << case_attribute->name()
+              << " ignoring it.\n";
+            }
+            case_attribute++;
+          }
+          if (variant_case.value.empty() || variant_case.refclass.empty()) {
+            std::cerr << "Case node without value or refclass on variant " << variant_node->name()
+            << " is not supported\n";
+            return false;
+          }
+          variant_node->add_case(variant_case);
+        } else {
+          std::cerr << "Unsupported node on node variant: << " << child_node.name() << " ignoring it.\n";
+        }
+        child_node = child_node.next_sibling();
+      }
+      if (variant_node->cases().empty()) {
+        std::cerr << "Variant node " << variant_node->name() << " without cases is not supported\n";
+        return false;
+      }
+      return true;
+    }
+
+    /**
+     * Checks the text is written as is inside a json string, without quotes, backslashes or
+     * control chars, the tag and the values of the variants are compared to the raw json
+     * */
+    bool is_plain_json_string(const std::string &value) {
+      for (char c: value) {
+        if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Checks the text is a C++ identifier, the enums and their values are generated as they are
+     * */
+    bool is_identifier(const std::string &value) {
+      if (value.empty() || std::isdigit(static_cast<unsigned char>(value[0]))) {
+        return false;
+      }
+      return std::all_of(value.begin(), value.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+      });
+    }
+
+    /**
+     * Selects the members named by the paths of the projection on the json and on the classes
+     * the paths go through, the lists of classes stand for their elements. Throws an exception
+     * when a path names a member that doesn't exist or goes through a member that is not a class
+     * */
+    void resolve_projection(umixmlprojection &projection, const std::shared_ptr<umixmltypeclass> &json,
+                            const std::vector<std::pair<std::string, std::shared_ptr<umixmltypeclass>>> &classes) {
+      std::unordered_set<std::string> whole;
+      projection.json_fields().assign(json->getChildren().size(), false);
+      for (auto &path: projection.paths()) {
+        std::vector<std::string> names;
+        boost::algorithm::split(names, path, boost::algorithm::is_any_of("."));
+        std::shared_ptr<umixmltypeclass> current(json);
+        std::vector<bool> *fields = &projection.json_fields();
+        for (size_t i = 0; i < names.size(); ++i) {
+          // name[] is the name of a list of classes
+          if (boost::algorithm::ends_with(names[i], "[]")) {
+            names[i].resize(names[i].size() - 2);
+          }
+          auto &children = current->getChildren();
+          auto child = std::find_if(children.begin(), children.end(),
+                                    [&names, i](const std::shared_ptr<umixmltype> &elem) {
+                                      return elem->name() == names[i];
+                                    });
+          if (child == children.end()) {
+            std::cerr << "Error projection " << projection.name() << ": " << names[i] << " is not a member of "
+            << current->name() << "\n";
+            throw std::runtime_error("Error wrong member on a projection.");
+          }
+          (*fields)[child - children.begin()] = true;
+          auto next = std::find_if(classes.begin(), classes.end(),
+                                   [&child](const std::pair<std::string, std::shared_ptr<umixmltypeclass>> &elem) {
+                                     return ((*child)->isRefClass() || (*child)->isList()) &&
+                                            elem.first == (*child)->refclass();
+                                   });
+          if (i + 1 == names.size()) {
+            if (next != classes.end()) {
+              whole.insert(next->first);
+            }
+            break;
+          }
+          if (next == classes.end()) {
+            std::cerr << "Error projection " << projection.name() << ": " << names[i]
+            << " is not a class or a list of classes\n";
+            throw std::runtime_error("Error wrong member on a projection.");
+          }
+          current = next->second;
+          fields = &projection.class_fields()[current->name()];
+          fields->resize(current->getChildren().size(), false);
+        }
+      }
+      for (auto &class_name: whole) {
+        projection.class_fields().erase(class_name);
+      }
+    }
   };
 }
 
@@ -549,6 +830,9 @@ umi::umixml::umixml(const std::string &content) {
     umi::umixml_helper umi_helper;
     std::vector<pugi::xml_node> json_nodes;
     std::vector<pugi::xml_node> class_nodes;
+    std::vector<pugi::xml_node> projection_nodes;
+    // Variant nodes with the number of class nodes declared before them
+    std::vector<std::pair<pugi::xml_node, size_t>> variant_nodes;
 
     pugi::xml_document local_document;
     pugi::xml_parse_result parse_result = local_document.load_string(content.c_str());
@@ -572,6 +856,10 @@ umi::umixml::umixml(const std::string &content) {
         json_nodes.push_back(node_iterator);
       } else if (strncmp(UMI_XMLTAGS_CLASS, node_iterator.name(), strlen(UMI_XMLTAGS_CLASS)) == 0) {
         class_nodes.push_back(node_iterator);
+      } else if (strncmp(UMI_XMLTAGS_PROJECTION, node_iterator.name(), strlen(UMI_XMLTAGS_PROJECTION)) == 0) {
+        projection_nodes.push_back(node_iterator);
+      } else if (strncmp(UMI_XMLTAGS_VARIANT, node_iterator.name(), strlen(UMI_XMLTAGS_VARIANT)) == 0) {
+        variant_nodes.push_back(std::make_pair(node_iterator, class_nodes.size()));
       } else {
         std::cerr << "Unknown node on umison level: " << node_iterator.name() << " Ignoring it.\n";
       }
@@ -583,14 +871,76 @@ umi::umixml::umixml(const std::string &content) {
     }
 
     std::cerr << "XML checking minimum requirements.\n";
-    // Build class list
+    // Build class list, class_positions keeps the number of classes built before each node
+    std::vector<size_t> class_positions;
     for (auto &class_it : class_nodes) {
+      class_positions.push_back(m_classMap.size());
       auto class_node = std::make_shared<umi::umixmltypeclass>();
       if (umi_helper.read_class_node(class_node, class_it)) {
         m_classMap.push_back(std::make_pair(std::string(class_node->name()), class_node));
       }
 
     }
+    class_positions.push_back(m_classMap.size());
+    // Build variant list, each case is a class declared before the variant
+    for (auto &variant_it : variant_nodes) {
+      auto variant_node = std::make_shared<umi::umixmlvariant>();
+      if (!umi_helper.read_variant_node(variant_node, variant_it.first)) {
+        throw std::runtime_error("Error wrong variant.");
+      }
+      variant_node->position(class_positions[variant_it.second]);
+      if (getVariant(variant_node->name()) || umi_helper.is_internal(variant_node->name()) ||
+          std::any_of(m_classMap.begin(), m_classMap.end(),
+                      [&variant_node](const std::pair<std::string, std::shared_ptr<umi::umixmltypeclass>> &elem) {
+                        return elem.first == variant_node->name();
+                      })) {
+        std::cerr << "Error variant " << variant_node->name() << " has the name of another class or variant"
+        << " Aborting execution.\n";
+        throw std::runtime_error("Error variant with the name of another class.");
+      }
+      if (!umi_helper.is_plain_json_string(variant_node->tag())) {
+        std::cerr << "Error variant " << variant_node->name() << " tag " << variant_node->tag()
+        << " has quotes, backslashes or control chars. Aborting execution.\n";
+        throw std::runtime_error("Error variant tag with quotes, backslashes or control chars.");
+      }
+      auto &cases = variant_node->cases();
+      for (auto case_it = cases.begin(); case_it != cases.end(); ++case_it) {
+        auto refclass = std::find_if(m_classMap.begin(), m_classMap.begin() + variant_node->position(),
+                                     [&case_it](const std::pair<std::string, std::shared_ptr<umi::umixmltypeclass>> &elem) {
+                                       return elem.first == case_it->refclass;
+                                     });
+        if (refclass == m_classMap.begin() + variant_node->position()) {
+          std::cerr << "Error variant " << variant_node->name() << " case " << case_it->value
+          << " refclass " << case_it->refclass << " is not a class declared before the variant."
+          << " Aborting execution.\n";
+          throw std::runtime_error("Error variant case that is not a class declared before it.");
+        }
+        auto &members = refclass->second->getChildren();
+        if ((members.size() == 1 && members[0]->isMap()) ||
+            std::any_of(members.begin(), members.end(),
+                        [&variant_node](const std::shared_ptr<umixmltype> &elem) {
+                          return elem->name() == variant_node->tag();
+                        })) {
+          std::cerr << "Error variant " << variant_node->name() << " case " << case_it->value
+          << " refclass " << case_it->refclass << " is a map or has a member named as the tag "
+          << variant_node->tag() << ". Aborting execution.\n";
+          throw std::runtime_error("Error variant case that is a map or has the tag.");
+        }
+        if (!umi_helper.is_plain_json_string(case_it->value)) {
+          std::cerr << "Error variant " << variant_node->name() << " case " << case_it->value
+          << " has quotes, backslashes or control chars. Aborting execution.\n";
+          throw std::runtime_error("Error variant case with quotes, backslashes or control chars.");
+        }
+        if (std::any_of(cases.begin(), case_it, [&case_it](const umixmlvariantcase &elem) {
+          return elem.value == case_it->value || elem.refclass == case_it->refclass;
+        })) {
+          std::cerr << "Error variant " << variant_node->name() << " case " << case_it->value
+          << " repeats the value or the refclass of another case. Aborting execution.\n";
+          throw std::runtime_error("Error variant case repeated.");
+        }
+      }
+      m_variantArray.push_back(variant_node);
+    }
     // Build json list
     for (auto &json_it : json_nodes) {
       auto json_node = std::make_shared<umi::umixmltypeclass>();
@@ -600,11 +950,115 @@ umi::umixml::umixml(const std::string &content) {
     }
     std::cerr << "Done.\nChecking references on Classes and Jsons.\n";
 
+    // Resolves the type of the member a list of classes is indexed by, it has to be a
+    // string or an integer of the referenced class
+    auto resolve_index = [this](const std::string &owner, const std::shared_ptr<umixmltype> &child) {
+      if (child->index().empty()) {
+        return;
+      }
+      auto refclass = std::find_if(m_classMap.begin(), m_classMap.end(),
+                                   [&child](const std::pair<std::string, std::shared_ptr<umi::umixmltypeclass>> &elem) {
+                                     return elem.first == child->refclass();
+                                   });
+      if (!child->isList() || refclass == m_classMap.end()) {
+        std::cerr << "Error index on an element that is not a list of classes on: " << owner
+        << " Element: " << child->name() << " Aborting execution.\n";
+        throw std::runtime_error("Error index on an element that is not a list of classes.");
+      }
+      for (auto &&member : refclass->second->getChildren()) {
+        if (member->name() != child->index()) {
+          continue;
+        }
+        if (member->isString()) {
+          child->index_type(UMI_XMLTAGS_STRING);
+        } else if (member->isInteger32()) {
+          child->index_type(UMI_XMLTAGS_INTEGER32);
+        } else if (member->isInteger()) {
+          child->index_type(UMI_XMLTAGS_INTEGER);
+        }
+      }
+      if (child->index_type().empty()) {
+        std::cerr << "Error index " << child->index() << " is not a string or integer member of: "
+        << child->refclass() << " on: " << owner << " Element: " << child->name() << " Aborting execution.\n";
+        throw std::runtime_error("Error index is not a string or integer member.");
+      }
+    };
+
+    // Resolves the refclass of the element to a variant, the class holding it has to be declared
+    // after the variant, position is the number of classes before it. The maps don't hold variants
+    // and the lists of variants are not filtered, indexed nor streamed
+    auto resolve_variant = [this](const std::string &owner, const std::shared_ptr<umixmltype> &child,
+                                  size_t position) {
+      auto variant = getVariant(child->refclass());
+      if (!variant) {
+        return false;
+      }
+      if (child->isMap() || position < variant->position()) {
+        std::cerr << "Error variant " << variant->name() << " on a map or on a class declared before it on: "
+        << owner << " Element: " << child->name() << " Aborting execution.\n";
+        throw std::runtime_error("Error variant on a map or on a class declared before it.");
+      }
+      if (!child->filter().empty() || !child->index().empty() || child->streaming()) {
+        std::cerr << "Error filter, index or streaming on a list of variants on: " << owner
+        << " Element: " << child->name() << " Aborting execution.\n";
+        throw std::runtime_error("Error filter, index or streaming on a list of variants.");
+      }
+      child->variant(true);
+      return true;
+    };
+
+    // Resolves the enum of an enum member, a new enum takes the values of the member and the
+    // next members naming it with type reuse them or repeat the same ones
+    auto resolve_enum = [this, &umi_helper](const std::string &owner, const std::shared_ptr<umixmltype> &child) {
+      auto enum_member = std::dynamic_pointer_cast<umixmltypeenum>(child);
+      std::string type = enum_member->type().empty() ? owner + "_" + child->name() : enum_member->type();
+      auto enum_node = getEnum(type);
+      if (!enum_node) {
+        if (enum_member->values().empty() || !umi_helper.is_identifier(type) || umi_helper.is_internal(type) ||
+            getVariant(type) ||
+            std::any_of(m_classMap.begin(), m_classMap.end(),
+                        [&type](const std::pair<std::string, std::shared_ptr<umi::umixmltypeclass>> &elem) {
+                          return elem.first == type;
+                        })) {
+          std::cerr << "Error enum " << type << " without values or with the name of another type on: " << owner
+          << " Element: " << child->name() << " Aborting execution.\n";
+          throw std::runtime_error("Error enum without values or with the name of another type.");
+        }
+        enum_node = std::make_shared<umi::umixmlenum>();
+        enum_node->name(type);
+        enum_node->values(enum_member->values());
+        enum_node->fallback(enum_member->fallback());
+        auto enumerators = enum_node->enumerators();
+        for (auto value = enumerators.begin(); value != enumerators.end(); ++value) {
+          if (!umi_helper.is_identifier(*value) || std::find(enumerators.begin(), value, *value) != value) {
+            std::cerr << "Error enum " << type << " value " << *value << " is not an identifier or is repeated on: "
+            << owner << " Element: " << child->name() << " Aborting execution.\n";
+            throw std::runtime_error("Error enum value that is not an identifier or is repeated.");
+          }
+        }
+        m_enumArray.push_back(enum_node);
+      } else if ((!enum_member->values().empty() && enum_member->values() != enum_node->values()) ||
+                 (!enum_member->fallback().empty() && enum_member->fallback() != enum_node->fallback())) {
+        std::cerr << "Error enum " << type << " with other values or fallback on: " << owner
+        << " Element: " << child->name() << " Aborting execution.\n";
+        throw std::runtime_error("Error enum with other values or fallback.");
+      }
+      child->enum_type(type);
+    };
+
     // Check any possible missing reference on the classes or jsons
     for (auto &&class_it : m_classMap) {
       // Check children refclass & list
       const std::vector<std::shared_ptr<umixmltype>> &children = class_it.second->getChildren();
+      size_t position = &class_it - &m_classMap.front();
       for (auto &&child : children) {
+        if (child->isEnum()) {
+          resolve_enum(class_it.first, child);
+          continue;
+        }
+        if (resolve_variant(class_it.first, child, position)) {
+          continue;
+        }
         if (child->isRefClass() || child->isList()) {
           std::array<std::string, 1> arr{{child->refclass()}};
           auto classFound = std::search(m_classMap.begin(), m_classMap.end(),
@@ -620,13 +1074,31 @@ umi::umixml::umixml(const std::string &content) {
             << " Refvalue: " << child->refclass() << " Aborting execution.\n";
             throw std::runtime_error("Error wrong class referenced on class.");
           }
+          if (!child->filter().empty() && umi_helper.is_internal(child->refclass())) {
+            std::cerr << "Error filter on a list of basic types on class: " << class_it.first
+            << " Element: " << child->name() << " Aborting execution.\n";
+            throw std::runtime_error("Error filter on a list of basic types.");
+          }
+        }
+        if (child->streaming()) {
+          std::cerr << "Error streaming on a list of class: " << class_it.first << " Element: " << child->name()
+          << ", only the lists of a json are streamed. Aborting execution.\n";
+          throw std::runtime_error("Error streaming on a list of a class.");
         }
+        resolve_index(class_it.first, child);
       }
     }
     for (auto &&class_it : m_jsonArray) {
       // Check children refclass & list
       const std::vector<std::shared_ptr<umixmltype>> &children = class_it->getChildren();
       for (auto &&child : children) {
+        if (child->isEnum()) {
+          resolve_enum(class_it->name(), child);
+          continue;
+        }
+        if (resolve_variant(class_it->name(), child, m_classMap.size())) {
+          continue;
+        }
         if (child->isRefClass() || child->isList()) {
           std::array<std::string, 1> arr{{child->refclass()}};
           auto classFound = std::search(m_classMap.begin(), m_classMap.end(),
@@ -640,9 +1112,39 @@ umi::umixml::umixml(const std::string &content) {
             << " Refvalue: " << child->refclass() << " Aborting execution.\n";
             throw std::runtime_error("Error wron class referenced within the json.");
           }
+          if (!child->filter().empty() && umi_helper.is_internal(child->refclass())) {
+            std::cerr << "Error filter on a list of basic types on json: " << class_it->name()
+            << " Element: " << child->name() << " Aborting execution.\n";
+            throw std::runtime_error("Error filter on a list of basic types.");
+          }
         }
+        if (child->streaming() && (!child->isList() || umi_helper.is_internal(child->refclass()) ||
+                                   !child->index().empty())) {
+          std::cerr << "Error streaming on an element that is not a list of classes without index on json: "
+          << class_it->name() << " Element: " << child->name() << " Aborting execution.\n";
+          throw std::runtime_error("Error streaming on an element that is not a list of classes without index.");
+        }
+        resolve_index(class_it->name(), child);
       }
     }
+    // Resolve the projections on their jsons
+    for (auto &projection_it : projection_nodes) {
+      auto projection_node = std::make_shared<umi::umixmlprojection>();
+      if (!umi_helper.read_projection_node(projection_node, projection_it)) {
+        continue;
+      }
+      auto json = std::find_if(m_jsonArray.begin(), m_jsonArray.end(),
+                               [&projection_node](const std::shared_ptr<umi::umixmltypeclass> &elem) {
+                                 return elem->name() == projection_node->json();
+                               });
+      if (json == m_jsonArray.end()) {
+        std::cerr << "Error wrong json referenced on projection: " << projection_node->name()
+        << " Refvalue: " << projection_node->json() << " Aborting execution.\n";
+        throw std::runtime_error("Error wrong json referenced on projection.");
+      }
+      umi_helper.resolve_projection(*projection_node, *json, m_classMap);
+      m_projections.push_back(projection_node);
+    }
     std::cerr << "Parsing complete.\nStarting to build output.\n";
   } catch (std::exception &ex) {
     std::cerr << "Error during the parsing: " << ex.what() << "\n";
@@ -652,3 +1154,60 @@ umi::umixml::umixml(const std::string &content) {
 
 umi::umixml::~umixml() {
 }
+
+std::shared_ptr<umi::umixmlvariant> umi::umixml::getVariant(const std::string &name) const {
+  auto variant = std::find_if(m_variantArray.begin(), m_variantArray.end(),
+                              [&name](const std::shared_ptr<umi::umixmlvariant> &elem) {
+                                return elem->name() == name;
+                              });
+  return variant == m_variantArray.end() ? nullptr : *variant;
+}
+
+std::shared_ptr<umi::umixmlenum> umi::umixml::getEnum(const std::string &name) const {
+  auto enum_node = std::find_if(m_enumArray.begin(), m_enumArray.end(),
+                                [&name](const std::shared_ptr<umi::umixmlenum> &elem) {
+                                  return elem->name() == name;
+                                });
+  return enum_node == m_enumArray.end() ? nullptr : *enum_node;
+}
+
+bool umi::umixml::has_member(bool (umixmltype::*check)() const) const {
+  auto member = [check](const std::shared_ptr<umixmltype> &child) {
+    return (child.get()->*check)();
+  };
+  for (auto &&class_it : m_classMap) {
+    auto &children = class_it.second->getChildren();
+    if (std::any_of(children.begin(), children.end(), member)) {
+      return true;
+    }
+  }
+  for (auto &&json_it : m_jsonArray) {
+    auto &children = json_it->getChildren();
+    if (std::any_of(children.begin(), children.end(), member)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool umi::umixml::interned() const {
+  return has_member(&umixmltype::intern);
+}
+
+bool umi::umixml::bounded() const {
+  return has_member(&umixmltype::bounded);
+}
+
+void umi::umixml::string_view(bool value) {
+  m_string_view = value;
+  for (auto &&class_it : m_classMap) {
+    for (auto &&child : class_it.second->getChildren()) {
+      child->string_view(value);
+    }
+  }
+  for (auto &&json_it : m_jsonArray) {
+    for (auto &&child : json_it->getChildren()) {
+      child->string_view(value);
+    }
+  }
+}
@@ -26,7 +26,10 @@
 #ifndef UMISON_UMIXML_H
 #define UMISON_UMIXML_H
 
+#include "umixmlenum.h"
+#include "umixmlprojection.h"
 #include "umixmltypes.h"
+#include "umixmlvariant.h"
 
 #include <vector>
 #include <unordered_map>
@@ -75,7 +78,80 @@ namespace umi {
       return m_jsonArray;
     }
 
+    /**
+     * Gets the projections of the jsons
+     * */
+    inline const std::vector<std::shared_ptr<umi::umixmlprojection>> &getProjections() const {
+      return m_projections;
+    }
+
+    /**
+     * Gets the variants, in the order they are declared
+     * */
+    inline const std::vector<std::shared_ptr<umi::umixmlvariant>> &getVariantArray() const {
+      return m_variantArray;
+    }
+
+    /**
+     * Gets the variant named name, nullptr when there is none
+     * */
+    std::shared_ptr<umi::umixmlvariant> getVariant(const std::string &name) const;
+
+    /**
+     * Gets the enums of the enum members, in the order they are first used
+     * */
+    inline const std::vector<std::shared_ptr<umi::umixmlenum>> &getEnumArray() const {
+      return m_enumArray;
+    }
+
+    /**
+     * Gets the enum named name, nullptr when there is none
+     * */
+    std::shared_ptr<umi::umixmlenum> getEnum(const std::string &name) const;
+
+    /**
+     * Gets if a string member of the classes or jsons is interned
+     * */
+    bool interned() const;
+
+    /**
+     * Gets if a string member of the classes or jsons has a maximum length
+     * */
+    bool bounded() const;
+
+    /**
+     * Gets if the strings are std::string_view on the parsed buffer
+     * */
+    inline bool string_view() const {
+      return m_string_view;
+    }
+
+    /**
+     * Makes every string of the classes and jsons a std::string_view
+     * pointing into the parsed buffer instead of an owned std::string
+     * */
+    void string_view(bool value);
+
+    /**
+     * Gets if the lazy views of the jsons are generated
+     * */
+    inline bool lazy_views() const {
+      return m_lazy_views;
+    }
+
+    /**
+     * Generates the lazy views of the jsons, umison::<json>_view
+     * */
+    inline void lazy_views(bool value) {
+      m_lazy_views = value;
+    }
+
   protected:
+    /**
+     * Gets if check is true on a member of the classes or jsons
+     * */
+    bool has_member(bool (umixmltype::*check)() const) const;
+
     /**
      * List of classes we will use in the creation of the json, we use a vector of pairs as we need to keep
      * the dependencies declared on the input template, anyway the intention is to use it as a map
@@ -85,6 +161,26 @@ namespace umi {
      * List of json documents we will output
      * */
     std::vector<std::shared_ptr<umi::umixmltypeclass>> m_jsonArray;
+    /**
+     * Projections of the jsons, each one reads a part of its json
+     * */
+    std::vector<std::shared_ptr<umi::umixmlprojection>> m_projections;
+    /**
+     * Variants the classes and jsons refer to, each one is one of several classes
+     * */
+    std::vector<std::shared_ptr<umi::umixmlvariant>> m_variantArray;
+    /**
+     * Enums the enum members hold
+     * */
+    std::vector<std::shared_ptr<umi::umixmlenum>> m_enumArray;
+    /**
+     * Strings are views on the parsed buffer
+     * */
+    bool m_string_view = false;
+    /**
+     * Lazy views of the jsons are generated
+     * */
+    bool m_lazy_views = false;
   };
 }
 
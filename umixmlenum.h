@@ -0,0 +1,92 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMIXMLENUM_H
+#define UMISON_UMIXMLENUM_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Enum, the fixed set of values of the string members that hold it. The generated enum class
+   * has one enumerator per value, in the order they are declared, and one more for the fallback
+   * when it is not one of them
+   * */
+  class umixmlenum {
+  public:
+    /**
+     * Name of the enum, the enum class generated
+     * */
+    inline const std::string &name() const {
+      return m_name;
+    }
+
+    inline void name(const std::string &value) {
+      m_name = value;
+    }
+
+    /**
+     * Values of the enum, in the order they are declared
+     * */
+    inline const std::vector<std::string> &values() const {
+      return m_values;
+    }
+
+    inline void values(const std::vector<std::string> &value) {
+      m_values = value;
+    }
+
+    /**
+     * Enumerator the unknown values are read as, empty when they are an error
+     * */
+    inline const std::string &fallback() const {
+      return m_fallback;
+    }
+
+    inline void fallback(const std::string &value) {
+      m_fallback = value;
+    }
+
+    /**
+     * Enumerators of the enum class, the values and the fallback when it is not one of them
+     * */
+    std::vector<std::string> enumerators() const {
+      std::vector<std::string> retval(m_values);
+      if (!m_fallback.empty() && std::find(retval.begin(), retval.end(), m_fallback) == retval.end()) {
+        retval.push_back(m_fallback);
+      }
+      return retval;
+    }
+
+  protected:
+    std::string m_name;
+    std::vector<std::string> m_values;
+    std::string m_fallback;
+  };
+}
+
+#endif
@@ -0,0 +1,112 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMIXMLPROJECTION_H
+#define UMISON_UMIXMLPROJECTION_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Projection of a json, the members read by its read_data_<name> methods. The paths are
+   * resolved by umixml into the members selected on the json and on every class reached
+   * through them, a class reached by a path ending on it is read whole
+   * */
+  class umixmlprojection {
+  public:
+    /**
+     * Name of the projection, the methods are read_data_<name>
+     * */
+    inline const std::string &name() const {
+      return m_name;
+    }
+
+    inline void name(const std::string &value) {
+      m_name = value;
+    }
+
+    /**
+     * Name of the json the projection reads
+     * */
+    inline const std::string &json() const {
+      return m_json;
+    }
+
+    inline void json(const std::string &value) {
+      m_json = value;
+    }
+
+    /**
+     * Paths of the members, the names separated by '.'
+     * */
+    inline const std::vector<std::string> &paths() const {
+      return m_paths;
+    }
+
+    inline void add_path(const std::string &value) {
+      m_paths.push_back(value);
+    }
+
+    /**
+     * Members of the json that are read, in the order of its children
+     * */
+    inline const std::vector<bool> &json_fields() const {
+      return m_json_fields;
+    }
+
+    inline std::vector<bool> &json_fields() {
+      return m_json_fields;
+    }
+
+    /**
+     * Members read of the classes only partially read, the classes missing are read whole
+     * */
+    inline const std::map<std::string, std::vector<bool>> &class_fields() const {
+      return m_class_fields;
+    }
+
+    inline std::map<std::string, std::vector<bool>> &class_fields() {
+      return m_class_fields;
+    }
+
+    /**
+     * The class is partially read by the projection
+     * */
+    inline bool partial(const std::string &class_name) const {
+      return m_class_fields.find(class_name) != m_class_fields.end();
+    }
+
+  protected:
+    std::string m_name;
+    std::string m_json;
+    std::vector<std::string> m_paths;
+    std::vector<bool> m_json_fields;
+    std::map<std::string, std::vector<bool>> m_class_fields;
+  };
+}
+
+#endif
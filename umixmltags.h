@@ -39,6 +39,11 @@
 #define UMI_XMLTAGS_REFCLASS "refclass"
 #define UMI_XMLTAGS_MAP "map"
 #define UMI_XMLTAGS_JSON "json"
+#define UMI_XMLTAGS_PROJECTION "projection"
+#define UMI_XMLTAGS_FIELD "field"
+#define UMI_XMLTAGS_VARIANT "variant"
+#define UMI_XMLTAGS_CASE "case"
+#define UMI_XMLTAGS_ENUM "enum"
 
 
 // Attributes used in the xml parsing process
@@ -49,6 +54,18 @@
 #define UMI_XMLATTR_REFCLASS "refclass"
 #define UMI_XMLATTR_CONDITION "condition"
 #define UMI_XMLATTR_VALUE "value"
+#define UMI_XMLATTR_JSON "json"
+#define UMI_XMLATTR_PATH "path"
+#define UMI_XMLATTR_READ_PREFIX "read_prefix"
+#define UMI_XMLATTR_FILTER "filter"
+#define UMI_XMLATTR_INDEX "index"
+#define UMI_XMLATTR_STREAMING "streaming"
+#define UMI_XMLATTR_TAG "tag"
+#define UMI_XMLATTR_VALUES "values"
+#define UMI_XMLATTR_FALLBACK "fallback"
+#define UMI_XMLATTR_TYPE "type"
+#define UMI_XMLATTR_INTERN "intern"
+#define UMI_XMLATTR_MAXLEN "maxlen"
 
 /**
  * Macro used to store the amount of space we want to use as tabulations
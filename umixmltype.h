@@ -29,6 +29,7 @@
 #include <string>
 #include <sstream>
 #include "umisonforwarddeclaration.h"
+#include "umisontypetocpp.h"
 
 
 namespace umi {
@@ -117,6 +118,13 @@ namespace umi {
       return false;
     }
 
+    /**
+     * Will inform if the type is an enum, a string with a fixed set of values
+     * */
+    virtual bool isEnum() const {
+      return false;
+    }
+
     /**
      * Gets Name we want to use in the json reading and the data structure
      * */
@@ -145,6 +153,126 @@ namespace umi {
       m_condition = cnd;
     }
 
+    /**
+     * Gets the filter of the elements of a list, the elements it is false on are dropped
+     * */
+    inline const std::string &filter() const {
+      return m_filter;
+    }
+
+    /**
+     * Sets the filter of the elements of a list
+     * */
+    inline void filter(const std::string &flt) {
+      m_filter = flt;
+    }
+
+    /**
+     * Gets the member of the elements of a list they are indexed by, empty for no index
+     * */
+    inline const std::string &index() const {
+      return m_index;
+    }
+
+    /**
+     * Sets the member of the elements of a list they are indexed by
+     * */
+    inline void index(const std::string &idx) {
+      m_index = idx;
+    }
+
+    /**
+     * Gets if the elements of a list are handed to a callback by read_data_streaming instead
+     * of being stored
+     * */
+    inline bool streaming() const {
+      return m_streaming;
+    }
+
+    /**
+     * Sets if the elements of a list are handed to a callback by read_data_streaming
+     * */
+    inline void streaming(bool value) {
+      m_streaming = value;
+    }
+
+    /**
+     * Gets if a string is kept once in the intern pool and the member holds a handle to it
+     * */
+    inline bool intern() const {
+      return m_intern;
+    }
+
+    /**
+     * Sets if a string is kept in the intern pool
+     * */
+    inline void intern(bool value) {
+      m_intern = value;
+    }
+
+    /**
+     * Gets the maximum length of a string kept inline in the object, 0 when it has none
+     * */
+    inline std::size_t maxlen() const {
+      return m_maxlen;
+    }
+
+    /**
+     * Sets the maximum length of a string
+     * */
+    inline void maxlen(std::size_t value) {
+      m_maxlen = value;
+    }
+
+    /**
+     * Gets if a string has a maximum length
+     * */
+    inline bool bounded() const {
+      return m_maxlen != 0;
+    }
+
+    /**
+     * Gets if refclass is a variant instead of a class
+     * */
+    inline bool variant() const {
+      return m_variant;
+    }
+
+    /**
+     * Sets if refclass is a variant
+     * */
+    inline void variant(bool value) {
+      m_variant = value;
+    }
+
+    /**
+     * Gets the basic type of the member the list is indexed by
+     * */
+    inline const std::string &index_type() const {
+      return m_index_type;
+    }
+
+    /**
+     * Sets the basic type of the member the list is indexed by
+     * */
+    inline void index_type(const std::string &type) {
+      m_index_type = type;
+    }
+
+    /**
+     * Gets the name of the enum an enum member holds
+     * */
+    inline const std::string &enum_type() const {
+      return m_enum_type;
+    }
+
+    /**
+     * Sets the name of the enum an enum member holds
+     * */
+    inline void enum_type(const std::string &type) {
+      m_enum_type = type;
+    }
+
     /**
      * Gets tje referenced class to be used(useful for arrays)
      * */
@@ -187,6 +315,20 @@ namespace umi {
       m_optional_name = val;
     }
 
+    /**
+     * Gets if the strings of this entry are views on the parsed buffer
+     * */
+    inline bool string_view() const {
+      return m_string_view;
+    }
+
+    /**
+     * Sets if the strings of this entry are views on the parsed buffer
+     * */
+    inline void string_view(bool value) {
+      m_string_view = value;
+    }
+
     /**
      * Returns the type we want to use in the header, it will
      * append the new line
@@ -239,6 +381,27 @@ namespace umi {
       return std::string();
     }
 
+    /**
+     * Returns the set method taking the value by rvalue reference, only for the
+     * types where moving is cheaper than copying
+     * */
+    virtual std::string move_setter_method(const std::string &, bool, const std::string &indentation,
+                                           int basic_indentation) {
+      (void) indentation;
+      (void) basic_indentation;
+      return std::string();
+    }
+
+    /**
+     * Returns the method constructing one element of a container in place
+     * */
+    virtual std::string emplace_method(const std::string &, bool, const std::string &indentation,
+                                       int basic_indentation) {
+      (void) indentation;
+      (void) basic_indentation;
+      return std::string();
+    }
+
     /**
      * Returns the get method
      * */
@@ -335,19 +498,146 @@ namespace umi {
     }
 
     /**
-     * Returns the write method into a string
+     * Name of the index of a list, the list name and the member it is indexed by
      * */
-    virtual std::string write_to_string(
-        const std::string &,
-        bool ,
-        const std::string &,
-        int,
-        const std::string &,
-        int,
-        const std::string &) {
-      return std::string();
+    std::string index_name() const {
+      return m_name + "_by_" + m_index;
     }
+
+    /**
+     * Returns the declaration of the index of a list, empty when it has none
+     * */
+    std::string index_header_type(const std::string &additiona_text, const std::string &indentation,
+                                  int basic_indentation) const {
+      if (m_index.empty()) {
+        return "";
+      }
+      std::string retval;
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "__internal__umison" + additiona_text + "::umison_index " + attribute_prepocess(index_name())
+                + ";\n";
+      return retval;
+    }
+
+    /**
+     * Returns the find method of the index of a list and the mutable method of the index
+     * the engines fill while reading, empty when it has none
+     * */
+    std::string index_methods(const std::string &additiona_text, const std::string &indentation,
+                              int basic_indentation) const {
+      if (m_index.empty()) {
+        return "";
+      }
+      umi::type_to_cpp tcpp(m_string_view);
+      std::string def_indentation;
+      for (int i = 0; i < basic_indentation; ++i) {
+        def_indentation += indentation;
+      }
+      std::string find("const __internal__umison" + additiona_text + "::" + m_refclass + " *find_" + index_name()
+                       + "(const " + tcpp.get_type(m_index_type) + " &key)");
+      return def_indentation + "// element whose " + m_index + " is key, the first one if several are, nullptr if none.\n"
+             + def_indentation + "// The index is built again once the list was changed, the const find looks the list\n"
+             + def_indentation + "// up element by element until then\n"
+             + def_indentation + find + ";\n"
+             + def_indentation + find + " const;\n"
+             + def_indentation + "inline __internal__umison" + additiona_text + "::umison_index &mutable_"
+             + index_name() + "() {\n"
+             + def_indentation + indentation + "return " + attribute_prepocess(index_name()) + ";\n"
+             + def_indentation + "}\n";
+    }
+
   protected:
+    /**
+     * Returns the statement resetting the index of a list the method changes, empty when it has none
+     * */
+    std::string index_reset(const std::string &indentation, int basic_indentation) const {
+      if (m_index.empty()) {
+        return "";
+      }
+      std::string retval;
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      return retval + attribute_prepocess(index_name()) + ".invalidate();\n";
+    }
+
+    /**
+     * Builds the set method moving a value of cpp_type
+     * */
+    std::string move_setter(const std::string &cpp_type, bool append_new_line, const std::string &indentation,
+                            int basic_indentation) const {
+      std::string retval;
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "inline void set_";
+      retval += m_name;
+      retval += "(";
+      retval += cpp_type;
+      retval += " &&val) noexcept {\n";
+      retval += index_reset(indentation, basic_indentation + 1);
+      for (int i = 0; i < basic_indentation + 1; ++i) {
+        retval += indentation;
+      }
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      retval += " = std::move(val);\n";
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "}";
+      if (append_new_line) {
+        retval += "\n";
+      }
+      return retval;
+    }
+
+    /**
+     * Builds the method constructing one element of the container in place with
+     * the container method insert_method, it returns insert_result
+     * */
+    std::string emplace(const std::string &result_type, const std::string &insert_method,
+                        const std::string &insert_result, bool append_new_line, const std::string &indentation,
+                        int basic_indentation) const {
+      std::string base;
+      for (int i = 0; i < basic_indentation; ++i) {
+        base += indentation;
+      }
+      std::string retval;
+      retval += base;
+      retval += "template<typename... Args>\n";
+      retval += base;
+      retval += "inline ";
+      retval += result_type;
+      retval += " emplace_";
+      retval += m_name;
+      retval += "(Args &&... args) {\n";
+      retval += index_reset(indentation, basic_indentation + 1);
+      retval += base;
+      retval += indentation;
+      if (insert_result.empty()) {
+        retval += "return ";
+      }
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      retval += ".";
+      retval += insert_method;
+      retval += "(std::forward<Args>(args)...);\n";
+      if (!insert_result.empty()) {
+        retval += base;
+        retval += indentation;
+        retval += "return ";
+        retval += umi::umixmltype::attribute_prepocess(m_name);
+        retval += insert_result;
+        retval += ";\n";
+      }
+      retval += base;
+      retval += "}";
+      if (append_new_line) {
+        retval += "\n";
+      }
+      return retval;
+    }
 
     /**
      * Name of the element in the output structure and json to be read
@@ -357,6 +647,35 @@ namespace umi {
      * Condition to be used in the parsing of this element
      * */
     std::string m_condition;
+    /**
+     * Filter of the elements of a list of classes
+     * */
+    std::string m_filter;
+    /**
+     * Member of the elements of a list they are indexed by and its basic type
+     * */
+    std::string m_index;
+    std::string m_index_type;
+    /**
+     * The elements of the list are handed to a callback by read_data_streaming
+     * */
+    bool m_streaming = false;
+    /**
+     * The string is a handle into the intern pool
+     * */
+    bool m_intern = false;
+    /**
+     * Maximum length of the string, 0 when it is unbounded
+     * */
+    std::size_t m_maxlen = 0;
+    /**
+     * The refclass is a variant
+     * */
+    bool m_variant = false;
+    /**
+     * Enum held by an enum member
+     * */
+    std::string m_enum_type;
     /**
      * Referenced class to be used in this element
      * */
@@ -369,6 +688,10 @@ namespace umi {
      * Name for the optional element
      * */
     std::string m_optional_name;
+    /**
+     * Strings are std::string_view instead of std::string
+     * */
+    bool m_string_view = false;
   };
 }
 
@@ -59,6 +59,44 @@ namespace umi {
       return true;
     }
 
+    /**
+     * The json gets read_data_prefix, the read stops once its required members have been read
+     * */
+    inline bool read_prefix() const {
+      return m_read_prefix;
+    }
+
+    inline void read_prefix(bool value) {
+      m_read_prefix = value;
+    }
+
+    /**
+     * Parameters of read_data_streaming after the text, the callback of each list streamed
+     * */
+    std::string streaming_parameters(const std::string &additiona_text) const {
+      std::string retval;
+      for (auto &child: m_children) {
+        if (child->streaming()) {
+          retval += ", const std::function<void(const __internal__umison" + additiona_text + "::" + child->refclass()
+                    + " &)> &on_" + child->name();
+        }
+      }
+      return retval;
+    }
+
+    /**
+     * Arguments passing the callbacks of read_data_streaming, empty when no list is streamed
+     * */
+    std::string streaming_arguments() const {
+      std::string retval;
+      for (auto &child: m_children) {
+        if (child->streaming()) {
+          retval += ", on_" + child->name();
+        }
+      }
+      return retval;
+    }
+
     /**
      * Adds one children to the list
      * */
@@ -117,19 +155,16 @@ namespace umi {
       (void) basic_indentation;
       return std::string();
     }
-
-    /**
-     * Returns the write method into a string
-     * */
-    std::string write_to_string(const std::string &, bool , const std::string &, int ) {
-      return std::string();
-    }
   protected:
     /**
      * Array of children are included within the class. It is a vector as we
      * want to keep the order
      * */
     std::vector<std::shared_ptr<umixmltype>> m_children;
+    /**
+     * read_data_prefix is generated
+     * */
+    bool m_read_prefix = false;
   };
 }
 
@@ -0,0 +1,244 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMIXMLTYPEENUM_H
+#define UMISON_UMIXMLTYPEENUM_H
+
+#include "umixmltype.h"
+#include <vector>
+
+namespace umi {
+  /**
+   * Enum type of the xml template, a string of the json read as one of a fixed set of values.
+   * The values are given on the member or on another member of the same enum, type names the
+   * enum and defaults to the owner and the member names
+   * */
+  class umixmltypeenum : public umixmltype {
+  public:
+    /**
+     * Constructor
+     * */
+    umixmltypeenum() : umixmltype() {
+    }
+
+    /**
+     * Destructor
+     * */
+    virtual ~umixmltypeenum() {
+    }
+
+    /**
+     * It is an enum
+     * */
+    virtual bool isEnum() const final {
+      return true;
+    }
+
+    /**
+     * Values given on the member, empty when they are given on another member
+     * */
+    inline const std::vector<std::string> &values() const {
+      return m_values;
+    }
+
+    inline void values(const std::vector<std::string> &value) {
+      m_values = value;
+    }
+
+    /**
+     * Fallback given on the member
+     * */
+    inline const std::string &fallback() const {
+      return m_fallback;
+    }
+
+    inline void fallback(const std::string &value) {
+      m_fallback = value;
+    }
+
+    /**
+     * Name of the enum given with the type attribute
+     * */
+    inline const std::string &type() const {
+      return m_type;
+    }
+
+    inline void type(const std::string &value) {
+      m_type = value;
+    }
+
+    /**
+     * C++ type of the enum
+     * */
+    std::string cpp_type(const std::string &additional_text) const {
+      return "__internal__umison" + additional_text + "::" + m_enum_type;
+    }
+
+    /**
+     * Returns the type we want to use in the header, it will
+     * append the new line
+     * */
+    virtual std::string header_type(const std::string &additional_text, bool append_new_line = true) {
+      std::string retval = cpp_type(additional_text);
+      retval += " ";
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      if (append_new_line) {
+        retval += ";\n";
+      } else {
+        retval += ";";
+      }
+      return retval;
+    }
+
+    /**
+     * Returns the optional header we want to use
+     * */
+    virtual std::string optional_name_type(const std::string &, bool append_new_line = true) {
+      std::string retval;
+      if (m_optional && !m_optional_name.empty()) {
+        retval = "bool ";
+        retval += m_optional_name;
+        if (append_new_line) {
+          retval += ";\n";
+        } else {
+          retval += ";";
+        }
+      }
+      return retval;
+    }
+
+    /**
+     * Returns the initialization element in the constructor, the first value
+     * */
+    virtual std::string constructor_initializer() {
+      std::string retval;
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      retval += "()";
+      if (m_optional && !m_optional_name.empty()) {
+        retval += ", ";
+        retval += m_optional_name;
+        retval += "(false)";
+      }
+      return retval;
+    }
+
+    /**
+     * Returns the get method
+     * */
+    virtual std::string getter_method(const std::string &additional_text, bool append_new_line,
+                                      const std::string &indentation, int basic_indentation) {
+      std::string retval;
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "inline ";
+      retval += cpp_type(additional_text);
+      retval += " get_";
+      retval += m_name;
+      retval += "() const {\n";
+      for (int i = 0; i < basic_indentation + 1; ++i) {
+        retval += indentation;
+      }
+      retval += "return ";
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      retval += ";\n";
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "}";
+      if (append_new_line) {
+        retval += "\n";
+      }
+      return retval;
+    }
+
+    /**
+     * Returns the set method
+     * */
+    virtual std::string setter_method(const std::string &additional_text, bool append_new_line,
+                                      const std::string &indentation, int basic_indentation) {
+      std::string retval;
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "inline ";
+      retval += "void set_";
+      retval += m_name;
+      retval += "(";
+      retval += cpp_type(additional_text);
+      retval += " val) {\n";
+      for (int i = 0; i < basic_indentation + 1; ++i) {
+        retval += indentation;
+      }
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      retval += " = val;\n";
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "}";
+      if (append_new_line) {
+        retval += "\n";
+      }
+      return retval;
+    }
+
+    /**
+     * Returns the mutable method
+     * */
+    virtual std::string mutable_method(const std::string &additional_text, bool append_new_line,
+                                       const std::string &indentation, int basic_indentation) {
+      std::string retval;
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "inline ";
+      retval += cpp_type(additional_text);
+      retval += "& mutable_";
+      retval += m_name;
+      retval += "() {\n";
+      for (int i = 0; i < basic_indentation + 1; ++i) {
+        retval += indentation;
+      }
+      retval += "return ";
+      retval += umi::umixmltype::attribute_prepocess(m_name);
+      retval += ";\n";
+      for (int i = 0; i < basic_indentation; ++i) {
+        retval += indentation;
+      }
+      retval += "}";
+      if (append_new_line) {
+        retval += "\n";
+      }
+      return retval;
+    }
+
+  protected:
+    std::vector<std::string> m_values;
+    std::string m_fallback;
+    std::string m_type;
+  };
+}
+
+#endif
@@ -61,7 +61,7 @@ namespace umi {
      * append the new line
      * */
     virtual std::string header_type(const std::string &additiona_text, bool append_new_line = true) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval = "std::vector<";
       std::string cpp_type = tcpp.get_type(m_refclass);
       if (cpp_type.empty()) {
@@ -122,7 +122,7 @@ namespace umi {
     virtual std::string getter_method(const std::string &additiona_text, bool append_new_line,
                                       const std::string &indentation,
                                       int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -164,7 +164,7 @@ namespace umi {
     virtual std::string setter_method(const std::string &additiona_text, bool append_new_line,
                                       const std::string &indentation,
                                       int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -184,6 +184,7 @@ namespace umi {
         retval += cpp_type;
       }
       retval += "> &val) {\n";
+      retval += index_reset(indentation, basic_indentation + 1);
       for (int i = 0; i < basic_indentation + 1; ++i) {
         retval += indentation;
       }
@@ -199,13 +200,42 @@ namespace umi {
       return retval;
     }
 
+    /**
+     * Returns the set method moving the list
+     * */
+    virtual std::string move_setter_method(const std::string &additiona_text, bool append_new_line,
+                                           const std::string &indentation,
+                                           int basic_indentation) {
+      umi::type_to_cpp tcpp(m_string_view);
+      std::string cpp_type = tcpp.get_type(m_refclass);
+      if (cpp_type.empty()) {
+        cpp_type = "__internal__umison" + additiona_text + "::" + m_refclass;
+      }
+      return move_setter("std::vector<" + cpp_type + ">", append_new_line, indentation, basic_indentation);
+    }
+
+    /**
+     * Returns the method appending one element built in place, it returns the element
+     * */
+    virtual std::string emplace_method(const std::string &additiona_text, bool append_new_line,
+                                       const std::string &indentation,
+                                       int basic_indentation) {
+      umi::type_to_cpp tcpp(m_string_view);
+      std::string cpp_type = tcpp.get_type(m_refclass);
+      if (cpp_type.empty()) {
+        cpp_type = "__internal__umison" + additiona_text + "::" + m_refclass;
+      }
+      return emplace("std::vector<" + cpp_type + ">::reference", "emplace_back", ".back()", append_new_line, indentation,
+                     basic_indentation);
+    }
+
     /**
      * Returns the mutable method
      * */
     virtual std::string mutable_method(const std::string &additiona_text, bool append_new_line,
                                        const std::string &indentation,
                                        int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -225,6 +255,7 @@ namespace umi {
       retval += ">& mutable_";
       retval += m_name;
       retval += "() {\n";
+      retval += index_reset(indentation, basic_indentation + 1);
       for (int i = 0; i < basic_indentation + 1; ++i) {
         retval += indentation;
       }
@@ -240,102 +271,6 @@ namespace umi {
       }
       return retval;
     }
-    /**
-     * Returns the write method into a string
-     * */
-    std::string write_to_string(const std::string &input_string, bool append_new_line, const std::string &indentation,
-                                int basic_indentation, const std::string &aux_array, int size_array,
-                                const std::string &out_error) {
-      umi::type_to_cpp tcpp;
-      std::string cpp_type = tcpp.get_type(m_refclass);
-      std::stringstream retval;
-      std::string base_indentation;
-      std::string base_indentation_1p;
-      std::string base_indentation_2p;
-      std::string base_indentation_3p;
-      std::string quoted_name;
-      for (int i = 0; i < basic_indentation; ++i) {
-        base_indentation += indentation;
-      }
-      base_indentation_1p += base_indentation + indentation;
-      base_indentation_2p += base_indentation_1p + indentation;
-      base_indentation_3p += base_indentation_2p + indentation;
-      quoted_name = "\\\"";
-      quoted_name += m_name;
-      quoted_name += "\\\"";
-
-      retval << base_indentation << "{\n"
-             << base_indentation_1p << input_string << " += \"" << quoted_name << ": [\";\n";
-
-      if (cpp_type.empty()) {
-        retval << base_indentation_1p << "std::size_t position;\n"
-               << base_indentation_1p << "for (position = 0; position < "
-               << umi::umixmltype::attribute_prepocess(m_name) << ".size(); ++position) {\n"
-               << base_indentation_2p << "if (position > 0) { " << input_string << " += \",\"; }\n"
-               << base_indentation_2p << input_string << " += \"{\";\n"
-               << base_indentation_2p << input_string << " += \"}\";\n";
-        retval << base_indentation_1p << "}\n";
-      } else {
-        retval << base_indentation_1p << "std::size_t position;\n"
-               << base_indentation_1p << "for (position = 0; position < "
-                                      << umi::umixmltype::attribute_prepocess(m_name) << ".size(); ++position) {\n"
-               << base_indentation_2p << "if (position > 0) { " << input_string << " += \",\"; }\n";
-        if (cpp_type == "std::string") {
-          retval << base_indentation_2p << input_string << " += \"\\\"\";\n"
-                 << base_indentation_2p << input_string << " += " << umi::umixmltype::attribute_prepocess(m_name)
-                 << "[position];\n"
-                 << base_indentation_2p << input_string << " += \"\\\"\";\n";
-        } else {
-          if (cpp_type == "long long int") {
-            retval << base_indentation_2p << "memset(" << aux_array << ", 0, " << size_array << ");\n"
-                   << base_indentation_2p << "int aux_retval = snprintf(" << aux_array
-                   << ", sizeof(" << aux_array << ") - 1, \"%\"PRId64\"\", "
-                   << umi::umixmltype::attribute_prepocess(m_name) << "[position]);\n"
-                   << base_indentation_2p << "if (aux_retval < 0) {\n"
-                   << base_indentation_3p << out_error << " << \"Error in line \" << __LINE__;\n"
-                   << base_indentation_3p << "return false;\n"
-                   << base_indentation_2p << "}\n"
-                   << base_indentation_2p << input_string << " += " << aux_array << ";\n";
-          } else if (cpp_type == "int") {
-            retval << base_indentation_2p << "memset(" << aux_array << ", 0, " << size_array << ");\n"
-                   << base_indentation_2p << "int aux_retval = snprintf(" << aux_array
-                   << ", sizeof(" << aux_array << ") - 1, \"%d\", "
-                   << umi::umixmltype::attribute_prepocess(m_name) << "[position]);\n"
-                   << base_indentation_2p << "if (aux_retval < 0) {\n"
-                   << base_indentation_3p << out_error << " << \"Error in line \" << __LINE__;\n"
-                   << base_indentation_3p << "return false;\n"
-                   << base_indentation_2p << "}\n"
-                   << base_indentation_2p << input_string << " += " << aux_array << ";\n";
-          } else if (cpp_type == "double") {
-            retval << base_indentation_2p << "memset(" << aux_array << ", 0, " << size_array << ");\n"
-                   << base_indentation_2p << "int aux_retval = snprintf(" << aux_array
-                   << ", sizeof(" << aux_array << ") - 1, \"%f\", "
-                   << umi::umixmltype::attribute_prepocess(m_name) << "[position]);\n"
-                   << base_indentation_2p << "if (aux_retval < 0) {\n"
-                   << base_indentation_3p << out_error << " << \"Error in line \" << __LINE__;\n"
-                   << base_indentation_3p << "return false;\n"
-                   << base_indentation_2p << "}\n"
-                   << base_indentation_2p << input_string << " += " << aux_array << ";\n";
-          } else if (cpp_type == "bool") {
-            retval << base_indentation_2p << "if ("
-                      << umi::umixmltype::attribute_prepocess(m_name) << "[position]) {\n"
-                   << base_indentation_3p << input_string << " += \"true\";\n"
-                   << base_indentation_2p << "} else {\n"
-                   << base_indentation_3p << input_string << " += \"false\";\n"
-                   << base_indentation_2p << "}\n";
-          }
-        }
-        retval << base_indentation_1p << "}\n";
-      }
-
-      retval << base_indentation_1p << input_string << " += \"]\";\n";
-      retval << base_indentation << "}\n";
-
-      if (append_new_line) {
-        retval << "\n";
-      }
-      return retval.str();
-    }
   };
 }
 
@@ -61,7 +61,7 @@ namespace umi {
      * append the new line
      * */
     virtual std::string header_type(const std::string &additiona_text, bool append_new_line = true) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval = "std::multimap<std::string,";
       std::string cpp_type = tcpp.get_type(m_refclass);
       if (cpp_type.empty()) {
@@ -120,7 +120,7 @@ namespace umi {
     virtual std::string getter_method(const std::string &additiona_text, bool append_new_line,
                                       const std::string &indentation,
                                       int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -162,7 +162,7 @@ namespace umi {
     virtual std::string setter_method(const std::string &additiona_text, bool append_new_line,
                                       const std::string &indentation,
                                       int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -197,13 +197,42 @@ namespace umi {
       return retval;
     }
 
+    /**
+     * Returns the set method moving the map
+     * */
+    virtual std::string move_setter_method(const std::string &additiona_text, bool append_new_line,
+                                           const std::string &indentation,
+                                           int basic_indentation) {
+      umi::type_to_cpp tcpp(m_string_view);
+      std::string cpp_type = tcpp.get_type(m_refclass);
+      if (cpp_type.empty()) {
+        cpp_type = "__internal__umison" + additiona_text + "::" + m_refclass;
+      }
+      return move_setter("std::multimap<std::string," + cpp_type + ">", append_new_line, indentation, basic_indentation);
+    }
+
+    /**
+     * Returns the method inserting one element built in place, it returns its iterator
+     * */
+    virtual std::string emplace_method(const std::string &additiona_text, bool append_new_line,
+                                       const std::string &indentation,
+                                       int basic_indentation) {
+      umi::type_to_cpp tcpp(m_string_view);
+      std::string cpp_type = tcpp.get_type(m_refclass);
+      if (cpp_type.empty()) {
+        cpp_type = "__internal__umison" + additiona_text + "::" + m_refclass;
+      }
+      return emplace("std::multimap<std::string," + cpp_type + ">::iterator", "emplace", "", append_new_line,
+                     indentation, basic_indentation);
+    }
+
     /**
      * Returns the get method
      * */
     virtual std::string mutable_method(const std::string &additiona_text, bool append_new_line,
                                        const std::string &indentation,
                                        int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
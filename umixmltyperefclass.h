@@ -58,7 +58,7 @@ namespace umi {
      * append the new line
      * */
     virtual std::string header_type(const std::string &additiona_text, bool append_new_line = true) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass); // Suport for reference of basic types
       if (cpp_type.empty()) {
@@ -117,7 +117,7 @@ namespace umi {
     virtual std::string getter_method(const std::string &additiona_text, bool append_new_line,
                                       const std::string &indentation,
                                       int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -159,7 +159,7 @@ namespace umi {
     virtual std::string setter_method(const std::string &additiona_text, bool append_new_line,
                                       const std::string &indentation,
                                       int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -194,13 +194,30 @@ namespace umi {
       return retval;
     }
 
+    /**
+     * Returns the set method moving the object, basic types are copied
+     * */
+    virtual std::string move_setter_method(const std::string &additiona_text, bool append_new_line,
+                                           const std::string &indentation,
+                                           int basic_indentation) {
+      umi::type_to_cpp tcpp(m_string_view);
+      std::string cpp_type = tcpp.get_type(m_refclass);
+      if (cpp_type == "std::string") {
+        return move_setter(cpp_type, append_new_line, indentation, basic_indentation);
+      } else if (!cpp_type.empty()) {
+        return std::string();
+      }
+      return move_setter("__internal__umison" + additiona_text + "::" + m_refclass, append_new_line, indentation,
+                         basic_indentation);
+    }
+
     /**
      * Returns the mutable method
      * */
     virtual std::string mutable_method(const std::string &additiona_text, bool append_new_line,
                                        const std::string &indentation,
                                        int basic_indentation) {
-      umi::type_to_cpp tcpp;
+      umi::type_to_cpp tcpp(m_string_view);
       std::string retval;
       std::string cpp_type = tcpp.get_type(m_refclass);
       for (int i = 0; i < basic_indentation; ++i) {
@@ -35,5 +35,6 @@
 #include "umixmltypeclass.h"
 #include "umixmltyperefclass.h"
 #include "umixmltypemap.h"
+#include "umixmltypeenum.h"
 
 #endif
@@ -46,6 +46,20 @@ namespace umi {
     virtual ~umixmltypestring() {
     }
 
+    /**
+     * C++ type used for the string, the interned ones are a handle into the intern pool and the
+     * ones with a maximum length are kept inline
+     * */
+    std::string string_type(const std::string &additional_text) const {
+      if (m_intern) {
+        return "__internal__umison" + additional_text + "::umison_interned";
+      }
+      if (bounded()) {
+        return "__internal__umison" + additional_text + "::umison_inline_string<" + std::to_string(m_maxlen) + ">";
+      }
+      return m_string_view ? "std::string_view" : "std::string";
+    }
+
     /**
      * It is a string
      * */
@@ -57,8 +71,9 @@ namespace umi {
      * Returns the type we want to use in the header, it will
      * append the new line
      * */
-    virtual std::string header_type(const std::string &, bool append_new_line = true) {
-      std::string retval = "std::string ";
+    virtual std::string header_type(const std::string &additional_text, bool append_new_line = true) {
+      std::string retval = string_type(additional_text);
+      retval += " ";
       retval += umi::umixmltype::attribute_prepocess(m_name);
       if (append_new_line) {
         retval += ";\n";
@@ -103,14 +118,16 @@ namespace umi {
     /**
      * Returns the get method
      * */
-    virtual std::string getter_method(const std::string &, bool append_new_line, const std::string &indentation,
-                                      int basic_indentation) {
+    virtual std::string getter_method(const std::string &additional_text, bool append_new_line,
+                                      const std::string &indentation, int basic_indentation) {
       std::string retval;
       for (int i = 0; i < basic_indentation; ++i) {
         retval += indentation;
       }
       retval += "inline ";
-      retval += "const std::string& get_";
+      retval += "const ";
+      retval += string_type(additional_text);
+      retval += "& get_";
       retval += m_name;
       retval += "() const {\n";
       for (int i = 0; i < basic_indentation + 1; ++i) {
@@ -132,8 +149,8 @@ namespace umi {
     /**
      * Returns the set method
      * */
-    virtual std::string setter_method(const std::string &, bool append_new_line, const std::string &indentation,
-                                      int basic_indentation) {
+    virtual std::string setter_method(const std::string &additional_text, bool append_new_line,
+                                      const std::string &indentation, int basic_indentation) {
       std::string retval;
       for (int i = 0; i < basic_indentation; ++i) {
         retval += indentation;
@@ -141,7 +158,9 @@ namespace umi {
       retval += "inline ";
       retval += "void set_";
       retval += m_name;
-      retval += "(const std::string &val) {\n";
+      retval += "(const ";
+      retval += string_type(additional_text);
+      retval += " &val) {\n";
       for (int i = 0; i < basic_indentation + 1; ++i) {
         retval += indentation;
       }
@@ -151,23 +170,76 @@ namespace umi {
         retval += indentation;
       }
       retval += "}";
+      if (m_intern) {
+        // The interned strings are also set from their text, it is added to the pool
+        retval += "\n";
+        for (int i = 0; i < basic_indentation; ++i) {
+          retval += indentation;
+        }
+        retval += "inline void set_";
+        retval += m_name;
+        retval += "(const std::string &val) {\n";
+        for (int i = 0; i < basic_indentation + 1; ++i) {
+          retval += indentation;
+        }
+        retval += umi::umixmltype::attribute_prepocess(m_name);
+        retval += " = __internal__umison";
+        retval += additional_text;
+        retval += "::umison_intern(val);\n";
+        for (int i = 0; i < basic_indentation; ++i) {
+          retval += indentation;
+        }
+        retval += "}";
+      }
+      if (bounded()) {
+        // The inline strings are also set from their text, false when it is longer than the maximum
+        retval += "\n";
+        for (int i = 0; i < basic_indentation; ++i) {
+          retval += indentation;
+        }
+        retval += "inline bool set_";
+        retval += m_name;
+        retval += m_string_view ? "(std::string_view val) {\n" : "(const std::string &val) {\n";
+        for (int i = 0; i < basic_indentation + 1; ++i) {
+          retval += indentation;
+        }
+        retval += "return ";
+        retval += umi::umixmltype::attribute_prepocess(m_name);
+        retval += ".assign(val.data(), val.size());\n";
+        for (int i = 0; i < basic_indentation; ++i) {
+          retval += indentation;
+        }
+        retval += "}";
+      }
       if (append_new_line) {
         retval += "\n";
       }
       return retval;
     }
 
+    /**
+     * Returns the set method moving the string, views, handles and inline strings are copied
+     * */
+    virtual std::string move_setter_method(const std::string &additional_text, bool append_new_line,
+                                           const std::string &indentation, int basic_indentation) {
+      if (m_string_view || m_intern || bounded()) {
+        return std::string();
+      }
+      return move_setter(string_type(additional_text), append_new_line, indentation, basic_indentation);
+    }
+
     /**
      * Returns the mutable method
      * */
-    virtual std::string mutable_method(const std::string &, bool append_new_line, const std::string &indentation,
-                                       int basic_indentation) {
+    virtual std::string mutable_method(const std::string &additional_text, bool append_new_line,
+                                       const std::string &indentation, int basic_indentation) {
       std::string retval;
       for (int i = 0; i < basic_indentation; ++i) {
         retval += indentation;
       }
       retval += "inline ";
-      retval += "std::string& mutable_";
+      retval += string_type(additional_text);
+      retval += "& mutable_";
       retval += m_name;
       retval += "() {\n";
       for (int i = 0; i < basic_indentation + 1; ++i) {
@@ -185,36 +257,6 @@ namespace umi {
       }
       return retval;
     }
-    /**
-     * Returns the write method into a string
-     * */
-    std::string write_to_string(const std::string &input_string, bool append_new_line, const std::string &indentation,
-                                int basic_indentation, const std::string &, int ,
-                                const std::string &) {
-      std::stringstream retval;
-      std::string base_indentation;
-      std::string base_indentation_1p;
-      std::string base_indentation_2p;
-      std::string quoted_name;
-      for (int i = 0; i < basic_indentation; ++i) {
-        base_indentation += indentation;
-      }
-      base_indentation_1p += base_indentation + indentation;
-      base_indentation_2p += base_indentation_1p + indentation;
-      quoted_name = "\\\"";
-      quoted_name += m_name;
-      quoted_name += "\\\"";
-      retval << base_indentation << "{\n"
-             << base_indentation_1p << input_string << " += \"" << quoted_name << ": \";\n"
-             << base_indentation_1p << input_string << " += \"\\\"\";\n"
-             << base_indentation_1p << input_string << " += " << umi::umixmltype::attribute_prepocess(m_name) << ";\n"
-             << base_indentation_1p << input_string << " += \"\\\"\";\n"
-             << base_indentation << "}\n";
-      if (append_new_line) {
-        retval << "\n";
-      }
-      return retval.str();
-    }
   };
 }
 
@@ -0,0 +1,101 @@
+/****************************************************************************************
+ *	Copyright (c) 2015, Jose Gerardo Palma Duran
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without modification,
+ *	are permitted provided that the following conditions are met:
+ *
+ *	1. Redistributions of source code must retain the above copyright notice,
+ *	   this list of conditions and the following disclaimer.
+ *
+ *	2. Redistributions in binary form must reproduce the above copyright notice, this
+ *	   list of conditions and the following disclaimer in the documentation and/or
+ *	   other materials provided with the distribution.
+ *
+ *	 THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *	 ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *	 WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ *	 IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ *	 INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ *	 NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ *	 PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *	 WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *	 ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	 POSSIBILITY OF SUCH DAMAGE.
+ ****************************************************************************************/
+#ifndef UMISON_UMIXMLVARIANT_H
+#define UMISON_UMIXMLVARIANT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace umi {
+  /**
+   * Case of a variant, the value of the tag selecting it and the class it holds
+   * */
+  struct umixmlvariantcase {
+    std::string value;
+    std::string refclass;
+  };
+
+  /**
+   * Variant, a json object that is one of several classes told apart by the string member tag.
+   * The members and lists refer to it with refclass as they do to a class, the generated struct
+   * is a tagged union of its classes
+   * */
+  class umixmlvariant {
+  public:
+    /**
+     * Name of the variant, the struct generated
+     * */
+    inline const std::string &name() const {
+      return m_name;
+    }
+
+    inline void name(const std::string &value) {
+      m_name = value;
+    }
+
+    /**
+     * Name of the member holding the value of the case
+     * */
+    inline const std::string &tag() const {
+      return m_tag;
+    }
+
+    inline void tag(const std::string &value) {
+      m_tag = value;
+    }
+
+    /**
+     * Cases of the variant, in the order they are declared
+     * */
+    inline const std::vector<umixmlvariantcase> &cases() const {
+      return m_cases;
+    }
+
+    inline void add_case(const umixmlvariantcase &value) {
+      m_cases.push_back(value);
+    }
+
+    /**
+     * Number of classes declared before the variant, the struct is generated after them
+     * */
+    inline std::size_t position() const {
+      return m_position;
+    }
+
+    inline void position(std::size_t value) {
+      m_position = value;
+    }
+
+  protected:
+    std::string m_name;
+    std::string m_tag;
+    std::vector<umixmlvariantcase> m_cases;
+    std::size_t m_position = 0;
+  };
+}
+
+#endif